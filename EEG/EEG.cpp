@@ -93,7 +93,38 @@ integer EEG_getChannelNumber (EEG me, conststring32 channelName) {
 	return 0;
 }
 
+/*
+	Decodes one channel of one data record, for samples ifirst through ilast of that record.
+*/
+static void decodeBdfSamples (const uint8 *bytes, bool is24bit, integer ifirst, integer ilast, double factor, double *to) {
+	if (is24bit) {
+		const uint8 *p = bytes + 3 * (ifirst - 1);
+		for (integer i = ifirst; i <= ilast; i ++, p += 3) {
+			const int32 value = (int32) ((uint32) p [2] << 24 | (uint32) p [1] << 16 | (uint32) p [0] << 8) >> 8;   // the shift extends the 24-bit sign
+			* to ++ = value * factor;
+		}
+	} else {
+		const uint8 *p = bytes + 2 * (ifirst - 1);
+		for (integer i = ifirst; i <= ilast; i ++, p += 2) {
+			const int16 value = (int16) (uint16) ((uint16) p [1] << 8 | (uint16) p [0]);
+			* to ++ = value * factor;
+		}
+	}
+}
+
+static void decodeBdfStatus (const uint8 *bytes, bool is24bit, integer numberOfSamples, int32 *to) {
+	const integer numberOfBytesPerSample = is24bit ? 3 : 2;
+	for (integer i = 1; i <= numberOfSamples; i ++, bytes += numberOfBytesPerSample)
+		* to ++ = is24bit ?
+			(int32) ((uint32) bytes [2] << 24 | (uint32) bytes [1] << 16 | (uint32) bytes [0] << 8) >> 8 :
+			(int32) (int16) (uint16) ((uint16) bytes [1] << 8 | (uint16) bytes [0]);
+}
+
 autoEEG EEG_readFromBdfFile (MelderFile file) {
+	return EEG_readFromBdfFile_part (file, 0.0, 0.0, constVEC ());
+}
+
+autoEEG EEG_readFromBdfFile_part (MelderFile file, double fromTime, double toTime, constVEC channelNumbers) {
 	try {
 		autofile f = Melder_fopen (file, "rb");
 		char buffer [81];
@@ -188,43 +219,79 @@ autoEEG EEG_readFromBdfFile (MelderFile file) {
 			fread (buffer, 1, 32, f); buffer [32] = '\0';   // reserved
 		}
 		double duration = numberOfDataRecords * durationOfDataRecord;
+		const bool wholeDuration = ( fromTime == toTime );
+		if (! wholeDuration)
+			Melder_require (fromTime >= 0.0 && fromTime < toTime && toTime <= duration,
+				U"The time range should lie within the duration of the recording (0 to ", duration, U" seconds).");
+		for (integer ichannel = 1; ichannel <= channelNumbers.size; ichannel ++)
+			Melder_require (channelNumbers [ichannel] == round (channelNumbers [ichannel]) &&
+					channelNumbers [ichannel] >= 1.0 && channelNumbers [ichannel] <= numberOfChannels,
+				U"Channel number ", channelNumbers [ichannel], U" does not exist; the file has ", numberOfChannels, U" channels.");
 		autoEEG him = EEG_create (0, duration);
 		his numberOfChannels = numberOfChannels;
-		autoSound me = Sound_createSimple (numberOfChannels, duration, samplingFrequency);
-		Melder_assert (my nx == numberOfSamplesPerDataRecord * numberOfDataRecords);
-		autoNUMvector <uint8> dataBuffer ((integer) 0, 3 * numberOfSamplesPerDataRecord - 1);
+		/*
+			Only the requested channels are decoded, and only the data records that overlap the requested time range;
+			the sample times are the same as when the whole file is read.
+			The status channel is read from all records, because the marks depend on its whole history.
+		*/
+		const integer numberOfSelectedChannels = ( channelNumbers.size > 0 ? channelNumbers.size : numberOfChannels );
+		autoINTVEC selectedChannels (numberOfSelectedChannels, kTensorInitializationType::RAW);
+		for (integer ichannel = 1; ichannel <= numberOfSelectedChannels; ichannel ++)
+			selectedChannels [ichannel] = ( channelNumbers.size > 0 ? Melder_iround (channelNumbers [ichannel]) : ichannel );
+		const integer numberOfSamples = numberOfSamplesPerDataRecord * numberOfDataRecords;
+		const double samplingPeriod = 1.0 / samplingFrequency, firstSampleTime = 0.5 / samplingFrequency;   // as in Sound_createSimple
+		autoSound me;
+		integer firstSample = 1, lastSample = numberOfSamples;
+		if (wholeDuration) {
+			me = Sound_createSimple (numberOfSelectedChannels, duration, samplingFrequency);
+		} else {
+			firstSample = 1 + Melder_iceiling ((fromTime - firstSampleTime) / samplingPeriod);   // as in Sound_extractPart
+			lastSample = 1 + Melder_ifloor ((toTime - firstSampleTime) / samplingPeriod);
+			Melder_require (lastSample >= firstSample,
+				U"The time range should contain at least one sample.");
+			me = Sound_create (numberOfSelectedChannels, fromTime, toTime, lastSample - firstSample + 1,
+				samplingPeriod, firstSampleTime + (firstSample - 1) * samplingPeriod);
+		}
+		Melder_assert (wholeDuration ? my nx == numberOfSamples : lastSample <= numberOfSamples);
+		const integer numberOfBytesPerSample = ( is24bit ? 3 : 2 );
+		const integer numberOfBytesPerChannel = numberOfBytesPerSample * numberOfSamplesPerDataRecord;
+		const integer numberOfBytesPerDataRecord = numberOfBytesPerChannel * numberOfChannels;
+		const integer firstRecord = (firstSample - 1) / numberOfSamplesPerDataRecord + 1;
+		const integer lastRecord = (lastSample - 1) / numberOfSamplesPerDataRecord + 1;
+		const integer numberOfExtraSensors = EEG_getNumberOfExtraSensors (him.get());
+		autoVEC factors (numberOfChannels, kTensorInitializationType::RAW);
+		for (integer channel = 1; channel <= numberOfChannels; channel ++) {
+			factors [channel] = channel == numberOfChannels ? 1.0 : physicalMinimum [channel] / digitalMinimum [channel];
+			if (channel < numberOfChannels - numberOfExtraSensors)
+				factors [channel] /= 1000000.0;
+		}
+		autoNUMvector <uint8> dataBuffer ((integer) 0, numberOfBytesPerDataRecord - 1);
+		const uint8 *statusBytes = & dataBuffer [(numberOfChannels - 1) * numberOfBytesPerChannel];
+		autoNUMvector <int32> status (1, numberOfSamples);
 		for (integer record = 1; record <= numberOfDataRecords; record ++) {
-			for (integer channel = 1; channel <= numberOfChannels; channel ++) {
-				double factor = channel == numberOfChannels ? 1.0 : physicalMinimum [channel] / digitalMinimum [channel];
-				if (channel < numberOfChannels - EEG_getNumberOfExtraSensors (him.get())) factor /= 1000000.0;
-				if (is24bit) {
-					fread (& dataBuffer [0], 3, (size_t) numberOfSamplesPerDataRecord, f);
-					uint8 *p = & dataBuffer [0];
-					for (integer i = 1; i <= numberOfSamplesPerDataRecord; i ++) {
-						integer sample = i + (record - 1) * numberOfSamplesPerDataRecord;
-						Melder_assert (sample <= my nx);
-						uint8 lowByte = *p ++, midByte = *p ++, highByte = *p ++;
-						uint32 externalValue = ((uint32) highByte << 16) | ((uint32) midByte << 8) | (uint32) lowByte;
-						if ((highByte & 128) != 0)   // is the 24-bit sign bit on?
-							externalValue |= 0xFF00'0000;   // extend negative sign to 32 bits
-						my z [channel] [sample] = (int32) externalValue * factor;
-					}
-				} else {
-					fread (& dataBuffer [0], 2, (size_t) numberOfSamplesPerDataRecord, f);
-					uint8 *p = & dataBuffer [0];
-					for (integer i = 1; i <= numberOfSamplesPerDataRecord; i ++) {
-						integer sample = i + (record - 1) * numberOfSamplesPerDataRecord;
-						Melder_assert (sample <= my nx);
-						uint8 lowByte = *p ++, highByte = *p ++;
-						uint16 externalValue = (uint16) ((uint16) highByte << 8) | (uint16) lowByte;
-						my z [channel] [sample] = (int16) externalValue * factor;
-					}
+			const integer recordOffset = (record - 1) * numberOfSamplesPerDataRecord;
+			if (record >= firstRecord && record <= lastRecord) {
+				if (fread (& dataBuffer [0], 1, (size_t) numberOfBytesPerDataRecord, f) != (size_t) numberOfBytesPerDataRecord)
+					Melder_throw (U"Data record ", record, U" is incomplete.");
+				const integer ifirst = std::max (firstSample - recordOffset, integer (1));
+				const integer ilast = std::min (lastSample - recordOffset, numberOfSamplesPerDataRecord);
+				for (integer ichannel = 1; ichannel <= numberOfSelectedChannels; ichannel ++) {
+					const integer channel = selectedChannels [ichannel];
+					decodeBdfSamples (& dataBuffer [(channel - 1) * numberOfBytesPerChannel], is24bit, ifirst, ilast,
+						factors [channel], & my z [ichannel] [recordOffset + ifirst - firstSample + 1]);
+				}
+			} else {
+				if (fseek (f, (long) (numberOfBytesPerDataRecord - numberOfBytesPerChannel), SEEK_CUR) != 0 ||
+					fread (& dataBuffer [(numberOfChannels - 1) * numberOfBytesPerChannel], 1, (size_t) numberOfBytesPerChannel, f) != (size_t) numberOfBytesPerChannel)
+				{
+					Melder_throw (U"Data record ", record, U" is incomplete.");
 				}
 			}
+			decodeBdfStatus (statusBytes, is24bit, numberOfSamplesPerDataRecord, & status [recordOffset + 1]);
 		}
 		int numberOfStatusBits = 8;
-		for (integer i = 1; i <= my nx; i ++) {
-			uint32 value = (uint32) (int32) my z [numberOfChannels] [i];
+		for (integer i = 1; i <= numberOfSamples; i ++) {
+			uint32 value = (uint32) status [i];
 			if (value & 0x0000'FF00) {
 				numberOfStatusBits = 16;
 			}
@@ -234,8 +301,8 @@ autoEEG EEG_readFromBdfFile (MelderFile file) {
 			thee = TextGrid_create (0, duration, U"Mark Trigger", U"Mark Trigger");
 			autoMelderString letters;
 			double time = undefined;
-			for (integer i = 1; i <= my nx; i ++) {
-				uint32 value = (uint32) (int32) my z [numberOfChannels] [i];
+			for (integer i = 1; i <= numberOfSamples; i ++) {
+				uint32 value = (uint32) status [i];
 				for (int ibyte = 1; ibyte <= numberOfStatusBits / 8; ibyte ++) {
 					uint32 mask = ( ibyte == 1 ? 0x0000'00ff : 0x0000'ff00 );
 					char32 kar = ( ibyte == 1 ? (value & mask) : (value & mask) >> 8 );
@@ -287,11 +354,11 @@ autoEEG EEG_readFromBdfFile (MelderFile file) {
 			for (int bit = 1; bit <= numberOfStatusBits; bit ++) {
 				uint32 bitValue = 1 << (bit - 1);
 				IntervalTier tier = (IntervalTier) thy tiers->at [bit];
-				for (integer i = 1; i <= my nx; i ++) {
-					uint32 previousValue = i == 1 ? 0 : (uint32) (int32) my z [numberOfChannels] [i - 1];
-					uint32 thisValue = (uint32) (int32) my z [numberOfChannels] [i];
+				for (integer i = 1; i <= numberOfSamples; i ++) {
+					uint32 previousValue = i == 1 ? 0 : (uint32) status [i - 1];
+					uint32 thisValue = (uint32) status [i];
 					if ((thisValue & bitValue) != (previousValue & bitValue)) {
-						double time = i == 1 ? 0.0 : my x1 + (i - 1.5) * my dx;
+						double time = i == 1 ? 0.0 : firstSampleTime + (i - 1.5) * samplingPeriod;
 						if (time != 0.0)
 							TextGrid_insertBoundary (thee.get(), bit, time);
 						if ((thisValue & bitValue) != 0)
@@ -303,7 +370,13 @@ autoEEG EEG_readFromBdfFile (MelderFile file) {
 		f.close (file);
 		his channelNames = std::move (channelNames);
 		his sound = me.move();
-		his textgrid = thee.move();
+		if (wholeDuration) {
+			his textgrid = thee.move();
+		} else {
+			his textgrid = TextGrid_extractPart (thee.get(), fromTime, toTime, true);
+			his xmin = his textgrid -> xmin;   // as in EEG_extractPart
+			his xmax = his textgrid -> xmax;
+		}
 		if (EEG_getNumberOfCapElectrodes (him.get()) == 32) {
 			EEG_setChannelName (him.get(), 1, U"Fp1");
 			EEG_setChannelName (him.get(), 2, U"AF3");
@@ -403,6 +476,13 @@ autoEEG EEG_readFromBdfFile (MelderFile file) {
 			EEG_setChannelName (him.get(), 63, U"PO4");
 			EEG_setChannelName (him.get(), 64, U"O2");
 		}
+		if (channelNumbers.size > 0) {
+			autostring32vector selectedChannelNames (numberOfSelectedChannels);
+			for (integer ichannel = 1; ichannel <= numberOfSelectedChannels; ichannel ++)
+				selectedChannelNames [ichannel] = Melder_dup (his channelNames [selectedChannels [ichannel]].get());
+			his channelNames = std::move (selectedChannelNames);
+			his numberOfChannels = numberOfSelectedChannels;
+		}
 		return him;
 	} catch (MelderError) {
 		Melder_throw (U"BDF file not read.");
@@ -425,24 +505,13 @@ void EEG_detrend (EEG me) {
 
 void EEG_filter (EEG me, double lowFrequency, double lowWidth, double highFrequency, double highWidth, bool doNotch50Hz) {
 	try {
-/*
-	integer nsampFFT = 1;
-	while (nsampFFT < my sound -> nx)
-		nsampFFT *= 2;
-	autoNUMfft_Table fftTable;
-	NUMfft_Table_init (& fftTable, nsampFFT);
-*/
-		for (integer ichan = 1; ichan <= my numberOfChannels - EEG_getNumberOfExtraSensors (me); ichan ++) {
-			autoSound channel = Sound_extractChannel (my sound.get(), ichan);
-			autoSpectrum spec = Sound_to_Spectrum (channel.get(), true);
-			Spectrum_passHannBand (spec.get(), lowFrequency, 0.0, lowWidth);
-			Spectrum_passHannBand (spec.get(), 0.0, highFrequency, highWidth);
-			if (doNotch50Hz) {
-				Spectrum_stopHannBand (spec.get(), 48.0, 52.0, 1.0);
-			}
-			autoSound him = Spectrum_to_Sound (spec.get());
-			NUMvector_copyElements (& his z [1] [0], & my sound -> z [ichan] [0], 1, my sound -> nx);
-		}
+		const SpectrumHannBand bands [3] = {
+			{ true, lowFrequency, 0.0, lowWidth },
+			{ true, 0.0, highFrequency, highWidth },
+			{ false, 48.0, 52.0, 1.0 }
+		};
+		Sound_filterChannelsWithHannBands_inplace (my sound.get(), 1, my numberOfChannels - EEG_getNumberOfExtraSensors (me),
+			doNotch50Hz ? 3 : 2, bands, true);   // the kernel: the edges of a long recording do not matter
 	} catch (MelderError) {
 		Melder_throw (me, U": not filtered.");
 	}
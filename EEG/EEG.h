@@ -27,6 +27,14 @@
 autoEEG EEG_create (double tmin, double tmax);
 
 autoEEG EEG_readFromBdfFile (MelderFile file);
+autoEEG EEG_readFromBdfFile_part (MelderFile file, double fromTime, double toTime, constVEC channelNumbers);
+/*
+	Reads only the samples between fromTime and toTime (all samples if fromTime == toTime),
+	and only the given channels, in the given order (all channels if channelNumbers is empty).
+	The result is the same as that of reading the whole file, extracting the channels,
+	and extracting the part with preserved times, but the other channels and records are never decoded,
+	so that epochs can be read one at a time from recordings that would not fit into memory.
+*/
 
 autoEEG EEGs_concatenate (OrderedOf<structEEG>* me);
 
@@ -17,6 +17,7 @@
  */
 
 #include "ERPTier.h"
+#include "MelderThread.h"
 
 #include "oo_DESTROY.h"
 #include "ERPTier_def.h"
@@ -45,6 +46,50 @@ Thing_implement (ERPPoint, AnyPoint, 0);
 
 Thing_implement (ERPTier, AnyTier, 0);
 
+/***** ERPEpochs *****/
+
+Thing_implement (ERPEpochs, Sampled, 0);
+
+void structERPEpochs :: v_copy (Daata thee_Daata) {
+	ERPEpochs thee = static_cast <ERPEpochs> (thee_Daata);
+	ERPEpochs_Parent :: v_copy (thee);
+	thy numberOfChannels = our numberOfChannels;
+	thy channelNames = STRVECclone (our channelNames.get());
+	thy eventTimes = VECcopy (our eventTimes.get());
+	thy z = TEN3copy (our z.get());
+}
+
+bool structERPEpochs :: v_equal (Daata thee_Daata) {
+	ERPEpochs thee = static_cast <ERPEpochs> (thee_Daata);
+	if (! ERPEpochs_Parent :: v_equal (thee)) return false;
+	if (thy numberOfChannels != our numberOfChannels) return false;
+	for (integer ichannel = 1; ichannel <= our numberOfChannels; ichannel ++)
+		if (! Melder_equ (thy channelNames [ichannel].get(), our channelNames [ichannel].get())) return false;
+	if (thy eventTimes.size != our eventTimes.size) return false;
+	for (integer ievent = 1; ievent <= our eventTimes.size; ievent ++) {
+		if (thy eventTimes [ievent] != our eventTimes [ievent]) return false;
+		for (integer ichannel = 1; ichannel <= our numberOfChannels; ichannel ++)
+			for (integer isample = 1; isample <= our nx; isample ++)
+				if (thy z [ievent] [ichannel] [isample] != our z [ievent] [ichannel] [isample]) return false;
+	}
+	return true;
+}
+
+void structERPEpochs :: v_info () {
+	structDaata :: v_info ();
+	MelderInfo_writeLine (U"Time domain of each epoch:");
+	MelderInfo_writeLine (U"   Start time: ", our xmin, U" seconds");
+	MelderInfo_writeLine (U"   End time: ", our xmax, U" seconds");
+	MelderInfo_writeLine (U"   Total duration: ", our xmax - our xmin, U" seconds");
+	MelderInfo_writeLine (U"Time sampling of each epoch:");
+	MelderInfo_writeLine (U"   Number of samples: ", our nx);
+	MelderInfo_writeLine (U"   Sampling period: ", our dx, U" seconds");
+	MelderInfo_writeLine (U"   Sampling frequency: ", Melder_single (1.0 / our dx), U" Hz");
+	MelderInfo_writeLine (U"   First sample centred at: ", our x1, U" seconds");
+	MelderInfo_writeLine (U"Number of channels: ", our numberOfChannels);
+	MelderInfo_writeLine (U"Number of events: ", our eventTimes.size);
+}
+
 integer ERPTier_getChannelNumber (ERPTier me, conststring32 channelName) {
 	for (integer ichan = 1; ichan <= my numberOfChannels; ichan ++) {
 		if (Melder_equ (my channelNames [ichan].get(), channelName))
@@ -64,45 +109,240 @@ double ERPTier_getMean (ERPTier me, integer pointNumber, conststring32 channelNa
 	return ERPTier_getMean (me, pointNumber, ERPTier_getChannelNumber (me, channelName), tmin, tmax);
 }
 
+/*
+	The epochs of an ERPTier or of an ERPEpochs, and what is to be done with them,
+	for a range of events (each thread has its own range).
+*/
+Thing_define (ERPEpochs_Args, Thing) { public:
+	ERPTier tier;   // either the events of this tier...
+	ERPEpochs epochs;   // ...or the epochs of this tensor
+	integer firstEvent, lastEvent;
+	EEG eeg;   // if not null, extract the epochs from this EEG first
+	double firstTime;
+	constVEC baselineWeights;   // if not empty, subtract the baseline
+	double threshold;   // if defined, check for artefacts
+	BOOLVEC rejected;
+};
+
+Thing_implement (ERPEpochs_Args, Thing, 0);
+
+static MATVU ERPEpochs_Args_getEpoch (ERPEpochs_Args me, integer ievent) {
+	return my tier ? MATVU (my tier -> points.at [ievent] -> erp -> z.get()) : my epochs -> z [ievent];
+}
+
+static double ERPEpochs_Args_getEventTime (ERPEpochs_Args me, integer ievent) {
+	return my tier ? my tier -> points.at [ievent] -> number : my epochs -> eventTimes [ievent];
+}
+
+static void EEG_getEpochSamples (EEG me, double fromTime, double toTime, integer *out_numberOfSamples, double *out_firstTime) {
+	const double soundDuration = toTime - fromTime;
+	const double samplingPeriod = my sound -> dx;
+	const integer numberOfSamples = Melder_ifloor (soundDuration / samplingPeriod) + 1;
+	if (numberOfSamples < 1)
+		Melder_throw (U"Time window too short.");
+	const double midTime = 0.5 * (fromTime + toTime);
+	const double soundPhysicalDuration = numberOfSamples * samplingPeriod;
+	*out_numberOfSamples = numberOfSamples;
+	*out_firstTime = midTime - 0.5 * soundPhysicalDuration + 0.5 * samplingPeriod;   // distribute the samples evenly over the time domain
+}
+
+static void EEG_extractEpoch (EEG me, double eegEventTime, double firstTime, MATVU epoch) {
+	const double samplingPeriod = my sound -> dx;
+	const double erpEventTime = 0.0;
+	const double eegSample = 1 + (eegEventTime - my sound -> x1) / samplingPeriod;
+	const double erpSample = 1 + (erpEventTime - firstTime) / samplingPeriod;
+	const integer sampleDifference = Melder_iround (eegSample - erpSample);
+	for (integer ichannel = 1; ichannel <= epoch.nrow; ichannel ++) {
+		VECVU channel = epoch [ichannel];
+		for (integer isample = 1; isample <= epoch.ncol; isample ++) {
+			const integer jsample = isample + sampleDifference;
+			channel [isample] = jsample < 1 || jsample > my sound -> nx ? 0.0 : my sound -> z [ichannel] [jsample];
+		}
+	}
+}
+
+/*
+	The baseline of a channel (its interpolated mean between tmin and tmax, as computed by Vector_getMean)
+	is a linear combination of its samples, with weights that are the same for every channel and every event.
+	We compute these weights once, as the means of unit impulses.
+*/
+static autoVEC getBaselineWeights (double xmin, double xmax, integer nx, double dx, double x1, double tmin, double tmax) {
+	autoSound impulse = Sound_create (1, xmin, xmax, nx, dx, x1);
+	autoVEC weights = VECraw (nx);
+	for (integer isample = 1; isample <= nx; isample ++) {
+		impulse -> z [1] [isample] = 1.0;
+		weights [isample] = Vector_getMean (impulse.get(), tmin, tmax, 1);
+		impulse -> z [1] [isample] = 0.0;
+	}
+	return weights;
+}
+
+static void subtractBaseline (MATVU epoch, constVEC weights) {
+	for (integer ichannel = 1; ichannel <= epoch.nrow; ichannel ++) {
+		VECVU channel = epoch [ichannel];
+		double mean = 0.0;
+		for (integer isample = 1; isample <= channel.size; isample ++)
+			mean += weights [isample] * channel [isample];
+		for (integer isample = 1; isample <= channel.size; isample ++)
+			channel [isample] -= mean;
+	}
+}
+
+static bool exceedsThreshold (constMATVU epoch, double threshold) {
+	if (epoch.ncol < 1)
+		return false;
+	double minimum = epoch [1] [1];
+	double maximum = minimum;
+	for (integer ichannel = 1; ichannel <= (epoch.nrow & ~ 15); ichannel ++) {
+		constVECVU channel = epoch [ichannel];
+		for (integer isample = 1; isample <= channel.size; isample ++) {
+			const double value = channel [isample];
+			if (value < minimum) minimum = value;
+			if (value > maximum) maximum = value;
+		}
+	}
+	return minimum < - threshold || maximum > threshold;
+}
+
+static MelderThread_RETURN_TYPE ERPEpochs_process (ERPEpochs_Args me) {
+	for (integer ievent = my firstEvent; ievent <= my lastEvent; ievent ++) {
+		MATVU epoch = ERPEpochs_Args_getEpoch (me, ievent);
+		if (my eeg)
+			EEG_extractEpoch (my eeg, ERPEpochs_Args_getEventTime (me, ievent), my firstTime, epoch);
+		if (my baselineWeights.size > 0)
+			subtractBaseline (epoch, my baselineWeights);
+		if (isdefined (my threshold))
+			my rejected [ievent] = exceedsThreshold (epoch, my threshold);
+	}
+	MelderThread_RETURN;
+}
+
+static void ERPEpochs_processInThreads (ERPTier tier, ERPEpochs epochs, integer numberOfEvents,
+	EEG eeg, double firstTime, constVEC baselineWeights, double threshold, BOOLVEC rejected)
+{
+	if (numberOfEvents < 1)
+		return;
+	const integer numberOfThreads = std::min (numberOfEvents, integer (MelderThread_getNumberOfProcessors ()));
+	std::vector <autoERPEpochs_Args> args ((size_t) numberOfThreads);
+	for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+		autoERPEpochs_Args arg = Thing_new (ERPEpochs_Args);
+		arg -> tier = tier;
+		arg -> epochs = epochs;
+		arg -> firstEvent = 1 + (ithread - 1) * numberOfEvents / numberOfThreads;
+		arg -> lastEvent = ithread * numberOfEvents / numberOfThreads;
+		arg -> eeg = eeg;
+		arg -> firstTime = firstTime;
+		arg -> baselineWeights = baselineWeights;
+		arg -> threshold = threshold;
+		arg -> rejected = rejected;
+		args [(size_t) ithread - 1] = arg.move();
+	}
+	MelderThread_run (ERPEpochs_process, args.data(), (int) numberOfThreads);
+}
+
+/*
+	The mean over the events, a range of channels per thread;
+	as the events are added in order, the mean does not depend on the number of threads.
+*/
+Thing_define (ERPEpochs_mean_Args, Thing) { public:
+	ERPTier tier;
+	ERPEpochs epochs;
+	integer numberOfEvents, firstChannel, lastChannel;
+	MAT mean;
+};
+
+Thing_implement (ERPEpochs_mean_Args, Thing, 0);
+
+static MelderThread_RETURN_TYPE ERPEpochs_mean (ERPEpochs_mean_Args me) {
+	for (integer ichannel = my firstChannel; ichannel <= my lastChannel; ichannel ++) {
+		VEC mean = my mean.row (ichannel);
+		for (integer ievent = 1; ievent <= my numberOfEvents; ievent ++) {
+			constVECVU channel = ( my tier ? constVECVU (my tier -> points.at [ievent] -> erp -> z.row (ichannel)) : my epochs -> z [ievent] [ichannel] );
+			if (ievent == 1) {
+				for (integer isample = 1; isample <= mean.size; isample ++)
+					mean [isample] = channel [isample];
+			} else {
+				for (integer isample = 1; isample <= mean.size; isample ++)
+					mean [isample] += channel [isample];
+			}
+		}
+		const double factor = 1.0 / my numberOfEvents;
+		for (integer isample = 1; isample <= mean.size; isample ++)
+			mean [isample] *= factor;
+	}
+	MelderThread_RETURN;
+}
+
+static void ERPEpochs_meanInThreads (ERPTier tier, ERPEpochs epochs, integer numberOfEvents, MAT mean) {
+	const integer numberOfChannels = mean.nrow;
+	if (numberOfChannels < 1)
+		return;
+	const integer numberOfThreads = std::min (numberOfChannels, integer (MelderThread_getNumberOfProcessors ()));
+	std::vector <autoERPEpochs_mean_Args> args ((size_t) numberOfThreads);
+	for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+		autoERPEpochs_mean_Args arg = Thing_new (ERPEpochs_mean_Args);
+		arg -> tier = tier;
+		arg -> epochs = epochs;
+		arg -> numberOfEvents = numberOfEvents;
+		arg -> firstChannel = 1 + (ithread - 1) * numberOfChannels / numberOfThreads;
+		arg -> lastChannel = ithread * numberOfChannels / numberOfThreads;
+		arg -> mean = mean;
+		args [(size_t) ithread - 1] = arg.move();
+	}
+	MelderThread_run (ERPEpochs_mean, args.data(), (int) numberOfThreads);
+}
+
+static autoERP ERP_create (integer numberOfChannels, double xmin, double xmax, integer nx, double dx, double x1, constSTRVEC channelNames) {
+	autoERP me = Thing_new (ERP);
+	Matrix_init (me.get(), xmin, xmax, nx, dx, x1, 1, numberOfChannels, numberOfChannels, 1, 1);
+	my channelNames = STRVECclone (channelNames.part (1, numberOfChannels));
+	return me;
+}
+
 static autoERPTier EEG_PointProcess_to_ERPTier (EEG me, PointProcess events, double fromTime, double toTime) {
 	try {
 		autoERPTier thee = Thing_new (ERPTier);
 		Function_init (thee.get(), fromTime, toTime);
 		thy numberOfChannels = my numberOfChannels - EEG_getNumberOfExtraSensors (me);
 		Melder_assert (thy numberOfChannels > 0);
-		thy channelNames = STRVECclone (my channelNames.get());
-		integer numberOfEvents = events -> nt;
-		double soundDuration = toTime - fromTime;
-		double samplingPeriod = my sound -> dx;
-		integer numberOfSamples = Melder_ifloor (soundDuration / samplingPeriod) + 1;
-		if (numberOfSamples < 1)
-			Melder_throw (U"Time window too short.");
-		double midTime = 0.5 * (fromTime + toTime);
-		double soundPhysicalDuration = numberOfSamples * samplingPeriod;
-		double firstTime = midTime - 0.5 * soundPhysicalDuration + 0.5 * samplingPeriod;   // distribute the samples evenly over the time domain
-		for (integer ievent = 1; ievent <= numberOfEvents; ievent ++) {
-			double eegEventTime = events -> t [ievent];
+		thy channelNames = STRVECclone (my channelNames.part (1, thy numberOfChannels));
+		integer numberOfSamples;
+		double firstTime;
+		EEG_getEpochSamples (me, fromTime, toTime, & numberOfSamples, & firstTime);
+		for (integer ievent = 1; ievent <= events -> nt; ievent ++) {
 			autoERPPoint event = Thing_new (ERPPoint);
-			event -> number = eegEventTime;
-			event -> erp = Sound_create (thy numberOfChannels, fromTime, toTime, numberOfSamples, samplingPeriod, firstTime);
-			double erpEventTime = 0.0;
-			double eegSample = 1 + (eegEventTime - my sound -> x1) / samplingPeriod;
-			double erpSample = 1 + (erpEventTime - firstTime) / samplingPeriod;
-			integer sampleDifference = Melder_iround (eegSample - erpSample);
-			for (integer ichannel = 1; ichannel <= thy numberOfChannels; ichannel ++) {
-				for (integer isample = 1; isample <= numberOfSamples; isample ++) {
-					integer jsample = isample + sampleDifference;
-					event -> erp -> z [ichannel] [isample] = jsample < 1 || jsample > my sound -> nx ? 0.0 : my sound -> z [ichannel] [jsample];
-				}
-			}
+			event -> number = events -> t [ievent];
+			event -> erp = Sound_create (thy numberOfChannels, fromTime, toTime, numberOfSamples, my sound -> dx, firstTime);
 			thy points. addItem_move (event.move());
 		}
+		ERPEpochs_processInThreads (thee.get(), nullptr, thy points.size, me, firstTime, constVEC (), undefined, BOOLVEC ());
 		return thee;
 	} catch (MelderError) {
 		Melder_throw (me, U": ERP analysis not performed.");
 	}
 }
 
+static autoERPEpochs EEG_PointProcess_to_ERPEpochs (EEG me, PointProcess events, double fromTime, double toTime) {
+	try {
+		autoERPEpochs thee = Thing_new (ERPEpochs);
+		integer numberOfSamples;
+		double firstTime;
+		EEG_getEpochSamples (me, fromTime, toTime, & numberOfSamples, & firstTime);
+		Sampled_init (thee.get(), fromTime, toTime, numberOfSamples, my sound -> dx, firstTime);
+		thy numberOfChannels = my numberOfChannels - EEG_getNumberOfExtraSensors (me);
+		Melder_assert (thy numberOfChannels > 0);
+		thy channelNames = STRVECclone (my channelNames.part (1, thy numberOfChannels));
+		thy eventTimes = VECraw (events -> nt);
+		for (integer ievent = 1; ievent <= events -> nt; ievent ++)
+			thy eventTimes [ievent] = events -> t [ievent];
+		thy z = TEN3raw (events -> nt, thy numberOfChannels, numberOfSamples);
+		ERPEpochs_processInThreads (nullptr, thee.get(), events -> nt, me, firstTime, constVEC (), undefined, BOOLVEC ());
+		return thee;
+	} catch (MelderError) {
+		Melder_throw (me, U": epochs not extracted.");
+	}
+}
+
 autoERPTier EEG_to_ERPTier_bit (EEG me, double fromTime, double toTime, int markerBit) {
 	try {
 		autoPointProcess events = TextGrid_getStartingPoints (my textgrid.get(), markerBit, kMelder_string::EQUAL_TO, U"1");
@@ -166,6 +406,97 @@ autoERPTier EEG_to_ERPTier_triggers (EEG me, double fromTime, double toTime,
 	}
 }
 
+autoERPEpochs EEG_to_ERPEpochs_triggers (EEG me, double fromTime, double toTime,
+	kMelder_string which, conststring32 criterion)
+{
+	try {
+		autoPointProcess events = TextGrid_getPoints (my textgrid.get(), 2, which, criterion);
+		autoERPEpochs thee = EEG_PointProcess_to_ERPEpochs (me, events.get(), fromTime, toTime);
+		return thee;
+	} catch (MelderError) {
+		Melder_throw (me, U": ERPEpochs not created.");
+	}
+}
+
+Thing_define (EEG_to_ERP_mean_Args, Thing) { public:
+	EEG eeg;
+	constVEC eventTimes;
+	integer firstEvent, lastEvent;
+	double firstTime;
+	constVEC baselineWeights;
+	double threshold;
+	autoMAT epoch, sum;
+	integer numberOfAcceptedEvents;
+};
+
+Thing_implement (EEG_to_ERP_mean_Args, Thing, 0);
+
+static MelderThread_RETURN_TYPE EEG_to_ERP_mean (EEG_to_ERP_mean_Args me) {
+	my numberOfAcceptedEvents = 0;
+	for (integer ievent = my firstEvent; ievent <= my lastEvent; ievent ++) {
+		EEG_extractEpoch (my eeg, my eventTimes [ievent], my firstTime, my epoch.get());
+		if (my baselineWeights.size > 0)
+			subtractBaseline (my epoch.get(), my baselineWeights);
+		if (isdefined (my threshold) && exceedsThreshold (my epoch.get(), my threshold))
+			continue;
+		MATadd_inplace (my sum.get(), my epoch.get());
+		my numberOfAcceptedEvents += 1;
+	}
+	MelderThread_RETURN;
+}
+
+autoERP EEG_to_ERP_mean_triggers (EEG me, double fromTime, double toTime,
+	kMelder_string which, conststring32 criterion,
+	double baselineStartTime, double baselineEndTime, double threshold)
+{
+	try {
+		autoPointProcess events = TextGrid_getPoints (my textgrid.get(), 2, which, criterion);
+		const integer numberOfEvents = events -> nt;
+		if (numberOfEvents < 1)
+			Melder_throw (U"No events.");
+		const integer numberOfChannels = my numberOfChannels - EEG_getNumberOfExtraSensors (me);
+		Melder_assert (numberOfChannels > 0);
+		integer numberOfSamples;
+		double firstTime;
+		EEG_getEpochSamples (me, fromTime, toTime, & numberOfSamples, & firstTime);
+		autoVEC baselineWeights = getBaselineWeights (fromTime, toTime, numberOfSamples, my sound -> dx, firstTime,
+			baselineStartTime, baselineEndTime);
+		autoVEC eventTimes = VECraw (numberOfEvents);
+		for (integer ievent = 1; ievent <= numberOfEvents; ievent ++)
+			eventTimes [ievent] = events -> t [ievent];
+
+		const integer numberOfThreads = std::min (numberOfEvents, integer (MelderThread_getNumberOfProcessors ()));
+		std::vector <autoEEG_to_ERP_mean_Args> args ((size_t) numberOfThreads);
+		for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+			autoEEG_to_ERP_mean_Args arg = Thing_new (EEG_to_ERP_mean_Args);
+			arg -> eeg = me;
+			arg -> eventTimes = eventTimes.get();
+			arg -> firstEvent = 1 + (ithread - 1) * numberOfEvents / numberOfThreads;
+			arg -> lastEvent = ithread * numberOfEvents / numberOfThreads;
+			arg -> firstTime = firstTime;
+			arg -> baselineWeights = baselineWeights.get();
+			arg -> threshold = threshold;
+			arg -> epoch = MATraw (numberOfChannels, numberOfSamples);
+			arg -> sum = MATzero (numberOfChannels, numberOfSamples);
+			args [(size_t) ithread - 1] = arg.move();
+		}
+		MelderThread_run (EEG_to_ERP_mean, args.data(), (int) numberOfThreads);
+
+		autoERP mean = ERP_create (numberOfChannels, fromTime, toTime, numberOfSamples, my sound -> dx, firstTime, my channelNames.get());
+		integer numberOfAcceptedEvents = 0;
+		for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+			MATadd_inplace (mean -> z.get(), args [(size_t) ithread - 1] -> sum.get());
+			numberOfAcceptedEvents += args [(size_t) ithread - 1] -> numberOfAcceptedEvents;
+		}
+		if (numberOfAcceptedEvents == 0)
+			Melder_throw (U"All ", numberOfEvents, U" events were rejected as artefacts.");
+		MATmultiply_inplace (mean -> z.get(), 1.0 / numberOfAcceptedEvents);
+		return mean;
+	} catch (MelderError) {
+		Melder_throw (me, U": mean ERP not computed.");
+	}
+}
+
 autoERPTier EEG_to_ERPTier_triggers_preceded (EEG me, double fromTime, double toTime,
 	kMelder_string which, conststring32 criterion,
 	kMelder_string precededBy, conststring32 criterion_precededBy)
@@ -184,46 +515,20 @@ void ERPTier_subtractBaseline (ERPTier me, double tmin, double tmax) {
 	integer numberOfEvents = my points.size;
 	if (numberOfEvents < 1)
 		return;   // nothing to do
-	ERPPoint firstEvent = my points.at [1];
-	integer numberOfChannels = firstEvent -> erp -> ny;
-	integer numberOfSamples = firstEvent -> erp -> nx;
-	for (integer ievent = 1; ievent <= numberOfEvents; ievent ++) {
-		ERPPoint event = my points.at [ievent];
-		for (integer ichannel = 1; ichannel <= numberOfChannels; ichannel ++) {
-			double mean = Vector_getMean (event -> erp.get(), tmin, tmax, ichannel);
-			VEC channel = event -> erp -> z.row (ichannel);
-			for (integer isample = 1; isample <= numberOfSamples; isample ++) {
-				channel [isample] -= mean;
-			}
-		}
-	}
+	Sound firstErp = my points.at [1] -> erp.get();
+	autoVEC baselineWeights = getBaselineWeights (firstErp -> xmin, firstErp -> xmax, firstErp -> nx, firstErp -> dx, firstErp -> x1, tmin, tmax);
+	ERPEpochs_processInThreads (me, nullptr, numberOfEvents, nullptr, 0.0, baselineWeights.get(), undefined, BOOLVEC ());
 }
 
 void ERPTier_rejectArtefacts (ERPTier me, double threshold) {
 	integer numberOfEvents = my points.size;
 	if (numberOfEvents < 1)
 		return;   // nothing to do
-	ERPPoint firstEvent = my points.at [1];
-	integer numberOfChannels = firstEvent -> erp -> ny;
-	integer numberOfSamples = firstEvent -> erp -> nx;
-	if (numberOfSamples < 1)
-		return;   // nothing to do
-	for (integer ievent = numberOfEvents; ievent >= 1; ievent --) {   // cycle down because of removal
-		ERPPoint event = my points.at [ievent];
-		double minimum = event -> erp -> z [1] [1];
-		double maximum = minimum;
-		for (integer ichannel = 1; ichannel <= (numberOfChannels & ~ 15); ichannel ++) {
-			constVEC channel = event -> erp -> z.row (ichannel);
-			for (integer isample = 1; isample <= numberOfSamples; isample ++) {
-				double value = channel [isample];
-				if (value < minimum) minimum = value;
-				if (value > maximum) maximum = value;
-			}
-		}
-		if (minimum < - threshold || maximum > threshold) {
+	autoBOOLVEC rejected = BOOLVECzero (numberOfEvents);
+	ERPEpochs_processInThreads (me, nullptr, numberOfEvents, nullptr, 0.0, constVEC (), threshold, rejected.get());
+	for (integer ievent = numberOfEvents; ievent >= 1; ievent --)   // cycle down because of removal
+		if (rejected [ievent])
 			my points. removeItem (ievent);
-		}
-	}
 }
 
 autoERP ERPTier_extractERP (ERPTier me, integer eventNumber) {
@@ -248,18 +553,102 @@ autoERP ERPTier_to_ERP_mean (ERPTier me) {
 		integer numberOfEvents = my points.size;
 		if (numberOfEvents < 1)
 			Melder_throw (U"No events.");
-		ERPPoint firstEvent = my points.at [1];
-		Melder_assert (firstEvent -> erp -> ny == my numberOfChannels);
-		autoERP mean = Thing_new (ERP);
-		firstEvent -> erp -> structSound :: v_copy (mean.get());
-		Melder_assert (mean -> ny == my numberOfChannels);
-		for (integer ievent = 2; ievent <= numberOfEvents; ievent ++) {
+		Sound firstErp = my points.at [1] -> erp.get();
+		Melder_assert (firstErp -> ny == my numberOfChannels);
+		for (integer ievent = 2; ievent <= numberOfEvents; ievent ++)
+			Melder_assert (my points.at [ievent] -> erp -> ny == my numberOfChannels);
+		autoERP mean = ERP_create (my numberOfChannels, firstErp -> xmin, firstErp -> xmax, firstErp -> nx, firstErp -> dx, firstErp -> x1,
+				my channelNames.get());
+		ERPEpochs_meanInThreads (me, nullptr, numberOfEvents, mean -> z.get());
+		return mean;
+	} catch (MelderError) {
+		Melder_throw (me, U": mean not computed.");
+	}
+}
+
+autoERPEpochs ERPTier_to_ERPEpochs (ERPTier me) {
+	try {
+		integer numberOfEvents = my points.size;
+		if (numberOfEvents < 1)
+			Melder_throw (U"No events.");
+		Sound firstErp = my points.at [1] -> erp.get();
+		autoERPEpochs thee = Thing_new (ERPEpochs);
+		Sampled_init (thee.get(), firstErp -> xmin, firstErp -> xmax, firstErp -> nx, firstErp -> dx, firstErp -> x1);
+		thy numberOfChannels = my numberOfChannels;
+		thy channelNames = STRVECclone (my channelNames.get());
+		thy eventTimes = VECraw (numberOfEvents);
+		thy z = TEN3raw (numberOfEvents, my numberOfChannels, firstErp -> nx);
+		for (integer ievent = 1; ievent <= numberOfEvents; ievent ++) {
 			ERPPoint event = my points.at [ievent];
-			Melder_assert (event -> erp -> ny == my numberOfChannels);
-			MATadd_inplace (mean -> z.get(), event -> erp -> z.get());
+			Melder_assert (event -> erp -> ny == my numberOfChannels && event -> erp -> nx == thy nx);
+			thy eventTimes [ievent] = event -> number;
+			for (integer ichannel = 1; ichannel <= my numberOfChannels; ichannel ++)
+				thy z [ievent] [ichannel] <<= event -> erp -> z.row (ichannel);
+		}
+		return thee;
+	} catch (MelderError) {
+		Melder_throw (me, U": not converted to ERPEpochs.");
+	}
+}
+
+autoERPTier ERPEpochs_to_ERPTier (ERPEpochs me) {
+	try {
+		autoERPTier thee = Thing_new (ERPTier);
+		Function_init (thee.get(), my xmin, my xmax);
+		thy numberOfChannels = my numberOfChannels;
+		thy channelNames = STRVECclone (my channelNames.get());
+		for (integer ievent = 1; ievent <= my z.ndim1; ievent ++) {
+			autoERPPoint event = Thing_new (ERPPoint);
+			event -> number = my eventTimes [ievent];
+			event -> erp = Sound_create (my numberOfChannels, my xmin, my xmax, my nx, my dx, my x1);
+			for (integer ichannel = 1; ichannel <= my numberOfChannels; ichannel ++)
+				event -> erp -> z.row (ichannel) <<= my z [ievent] [ichannel];
+			thy points. addItem_move (event.move());
 		}
-		MATmultiply_inplace (mean -> z.get(), 1.0 / numberOfEvents);
-		mean -> channelNames = STRVECclone (my channelNames.get());
+		return thee;
+	} catch (MelderError) {
+		Melder_throw (me, U": not converted to ERPTier.");
+	}
+}
+
+void ERPEpochs_subtractBaseline (ERPEpochs me, double tmin, double tmax) {
+	autoVEC baselineWeights = getBaselineWeights (my xmin, my xmax, my nx, my dx, my x1, tmin, tmax);
+	ERPEpochs_processInThreads (nullptr, me, my z.ndim1, nullptr, 0.0, baselineWeights.get(), undefined, BOOLVEC ());
+}
+
+void ERPEpochs_rejectArtefacts (ERPEpochs me, double threshold) {
+	const integer numberOfEvents = my z.ndim1;
+	if (numberOfEvents < 1)
+		return;   // nothing to do
+	autoBOOLVEC rejected = BOOLVECzero (numberOfEvents);
+	ERPEpochs_processInThreads (nullptr, me, numberOfEvents, nullptr, 0.0, constVEC (), threshold, rejected.get());
+	integer numberOfAcceptedEvents = 0;
+	for (integer ievent = 1; ievent <= numberOfEvents; ievent ++)
+		numberOfAcceptedEvents += ! rejected [ievent];
+	if (numberOfAcceptedEvents == numberOfEvents)
+		return;
+	autoVEC eventTimes = VECraw (numberOfAcceptedEvents);
+	autoTEN3 z = TEN3raw (numberOfAcceptedEvents, my numberOfChannels, my nx);
+	integer iaccepted = 0;
+	for (integer ievent = 1; ievent <= numberOfEvents; ievent ++) {
+		if (rejected [ievent])
+			continue;
+		iaccepted ++;
+		eventTimes [iaccepted] = my eventTimes [ievent];
+		for (integer ichannel = 1; ichannel <= my numberOfChannels; ichannel ++)
+			z [iaccepted] [ichannel] <<= my z [ievent] [ichannel];
+	}
+	my eventTimes = eventTimes.move();
+	my z = z.move();
+}
+
+autoERP ERPEpochs_to_ERP_mean (ERPEpochs me) {
+	try {
+		const integer numberOfEvents = my z.ndim1;
+		if (numberOfEvents < 1)
+			Melder_throw (U"No events.");
+		autoERP mean = ERP_create (my numberOfChannels, my xmin, my xmax, my nx, my dx, my x1, my channelNames.get());
+		ERPEpochs_meanInThreads (nullptr, me, numberOfEvents, mean -> z.get());
 		return mean;
 	} catch (MelderError) {
 		Melder_throw (me, U": mean not computed.");
@@ -306,10 +695,11 @@ autoERPTier ERPTier_extractEventsWhereColumn_string (ERPTier me, Table table,
 		Function_init (thee.get(), my xmin, my xmax);
 		thy numberOfChannels = my numberOfChannels;
 		thy channelNames = STRVECclone (my channelNames.get());
+		MelderStringMatcher matcher (which, criterion, true);
 		for (integer ievent = 1; ievent <= my points.size; ievent ++) {
 			ERPPoint oldEvent = my points.at [ievent];
 			TableRow row = table -> rows.at [ievent];
-			if (Melder_stringMatchesCriterion (row -> cells [columnNumber]. string.get(), which, criterion, true)) {
+			if (matcher. matches (row -> cells [columnNumber]. string.get())) {
 				autoERPPoint newEvent = Data_copy (oldEvent);
 				thy points. addItem_move (std::move (newEvent));
 			}
@@ -39,6 +39,46 @@ autoERP ERPTier_to_ERP_mean (ERPTier me);
 autoERPTier ERPTier_extractEventsWhereColumn_number (ERPTier me, Table table, integer columnNumber, kMelder_number which, double criterion);
 autoERPTier ERPTier_extractEventsWhereColumn_string (ERPTier me, Table table, integer columnNumber, kMelder_string which, conststring32 criterion);
 
+/*
+	ERPEpochs: the same pieces of EEG as in an ERPTier, but in a single tensor of events x channels x samples,
+	so that they can be extracted, baseline-corrected, checked for artefacts and averaged
+	without an ERPPoint (with its own Sound) per event. Not meant to be written to disk.
+*/
+Thing_define (ERPEpochs, Sampled) {
+	integer numberOfChannels;
+	autoSTRVEC channelNames;
+	autoVEC eventTimes;
+	autoTEN3 z;   // z [event] [channel] [sample]
+
+	void v_copy (Daata data_to)
+		override;
+	bool v_equal (Daata otherData)
+		override;
+	void v_info ()
+		override;
+	bool v_writable ()
+		override { return false; }
+	int v_domainQuantity ()
+		override { return MelderQuantity_TIME_SECONDS; }
+};
+
+autoERPEpochs ERPTier_to_ERPEpochs (ERPTier me);
+autoERPTier ERPEpochs_to_ERPTier (ERPEpochs me);
+void ERPEpochs_subtractBaseline (ERPEpochs me, double tmin, double tmax);
+void ERPEpochs_rejectArtefacts (ERPEpochs me, double threshold);
+autoERP ERPEpochs_to_ERP_mean (ERPEpochs me);
+
+autoERPEpochs EEG_to_ERPEpochs_triggers (EEG me, double fromTime, double toTime,
+	kMelder_string which, conststring32 criterion);
+
+/*
+	Extraction, baseline subtraction, artefact rejection and averaging in a single pass over the events,
+	without storing the epochs. If `threshold` is undefined, no epochs are rejected.
+*/
+autoERP EEG_to_ERP_mean_triggers (EEG me, double fromTime, double toTime,
+	kMelder_string which, conststring32 criterion,
+	double baselineStartTime, double baselineEndTime, double threshold);
+
 autoERPTier EEG_to_ERPTier_bit (EEG me, double fromTime, double toTime, int markerBit);
 autoERPTier EEG_to_ERPTier_marker (EEG me, double fromTime, double toTime, uint16 marker);
 autoERPTier EEG_to_ERPTier_triggers (EEG me, double fromTime, double toTime,
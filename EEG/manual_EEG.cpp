@@ -30,6 +30,11 @@ NORMAL (U"You typically create an EEG object in Praat by opening a BDF/EDF file
 	"Praat tries to read the whole file into memory, so you may want to work with a 64-bit edition of Praat "
 	"if you want to avoid \"out of memory\" messages.")
 NORMAL (U"After you do ##Read from file...#, an EEG object will appear in the list of objects.")
+NORMAL (U"If the recording is too long or has too many channels to fit into memory, "
+	"you can use ##Read EEG from BDF/EDF file (part)...# from the #Open menu instead, "
+	"which reads only the time range and the channels that you specify. "
+	"The samples keep their times in the recording, and the marks are read from the whole file "
+	"and then restricted to the time range. If you leave the channel numbers empty, all channels are read.")
 ENTRY (U"2. How to look into an EEG object")
 NORMAL (U"Once you have an EEG object in the list, you can click ##View & Edit# to look into it. "
 	"You will typically see the first 8 channels, but you scroll to the other channels by clicking on the up and down arrows. "
@@ -83,6 +88,9 @@ NORMAL (U"After you subtract the baseline, the part after the event contains the
 NORMAL (U"Once you have an ERPTier, you can extract each of the 150 ERPs from it with ##Extract ERP...#. "
 	"It is perhaps more interesting to compute the average of all those 150 ERPs with ##To ERP (mean)#. "
 	"These commands put a new ERP object in the list.")
+NORMAL (U"If all you need is the average, and the events are triggers, ##To ERP (triggers, mean)...# does all of the above in one go: "
+	"it extracts the EEG around each event, subtracts the baseline, leaves out the events with artefacts, and averages the rest, "
+	"without creating an ERPTier. This is much faster and takes much less memory if there are thousands of events.")
 NORMAL (U"Once you have an ERP object, you can look into it with ##View & Edit#. "
 	"If you want to see in the ERP window the scalp distribution at the time of the cursor, or the average scalp distribution in the selected time stretch, "
 	"you have to switch on ##Show selection viewer# in the #Preferences window (available from the #File menu).")
@@ -294,6 +294,37 @@ DO
 	CONVERT_EACH_END (my name.get(), U"_trigger", text2)
 }
 
+FORM (NEW_EEG_to_ERPEpochs_triggers, U"To ERPEpochs (triggers)", nullptr) {
+	REAL (fromTime, U"From time (s)", U"-0.11")
+	REAL (toTime, U"To time (s)", U"0.39")
+	OPTIONMENU_ENUM (kMelder_string, getEveryEventWithATriggerThat,
+			U"Get every event with a trigger that", kMelder_string::DEFAULT)
+	SENTENCE (theText, U"...the text", U"1")
+	OK
+DO
+	CONVERT_EACH (EEG)
+		autoERPEpochs result = EEG_to_ERPEpochs_triggers (me, fromTime, toTime, getEveryEventWithATriggerThat, theText);
+	CONVERT_EACH_END (my name.get(), U"_trigger", theText)
+}
+
+FORM (NEW_EEG_to_ERP_triggers_mean, U"To ERP (triggers, mean)", nullptr) {
+	REAL (fromTime, U"From time (s)", U"-0.11")
+	REAL (toTime, U"To time (s)", U"0.39")
+	OPTIONMENU_ENUM (kMelder_string, getEveryEventWithATriggerThat,
+			U"Get every event with a trigger that", kMelder_string::DEFAULT)
+	SENTENCE (theText, U"...the text", U"1")
+	REAL (baselineStartTime, U"Baseline start time (s)", U"-0.11")
+	REAL (baselineEndTime, U"Baseline end time (s)", U"0.0")
+	BOOLEAN (rejectArtefacts, U"Reject artefacts", true)
+	POSITIVE (threshold, U"Threshold (V)", U"75e-6")
+	OK
+DO
+	CONVERT_EACH (EEG)
+		autoERP result = EEG_to_ERP_mean_triggers (me, fromTime, toTime, getEveryEventWithATriggerThat, theText,
+			baselineStartTime, baselineEndTime, rejectArtefacts ? threshold : undefined);
+	CONVERT_EACH_END (my name.get(), U"_trigger", theText, U"_mean")
+}
+
 // MARK: Convert
 
 DIRECT (NEW1_EEGs_concatenate) {
@@ -706,6 +737,57 @@ DIRECT (NEW_ERPTier_to_ERP_mean) {
 	CONVERT_EACH_END (my name.get(), U"_mean")
 }
 
+DIRECT (NEW_ERPTier_to_ERPEpochs) {
+	CONVERT_EACH (ERPTier)
+		autoERPEpochs result = ERPTier_to_ERPEpochs (me);
+	CONVERT_EACH_END (my name.get())
+}
+
+// MARK: - ERPEPOCHS
+
+// MARK: Query
+
+DIRECT (INTEGER_ERPEpochs_getNumberOfEvents) {
+	NUMBER_ONE (ERPEpochs)
+		integer result = my eventTimes.size;
+	NUMBER_ONE_END (U" events")
+}
+
+// MARK: Modify
+
+FORM (MODIFY_ERPEpochs_subtractBaseline, U"Subtract baseline", nullptr) {
+	REAL (baselineStartTime, U"Baseline start time (s)", U"-0.11")
+	REAL (baselineEndTime, U"Baseline end time (s)", U"0.0")
+	OK
+DO
+	MODIFY_EACH (ERPEpochs)
+		ERPEpochs_subtractBaseline (me, baselineStartTime, baselineEndTime);
+	MODIFY_EACH_END
+}
+
+FORM (MODIFY_ERPEpochs_rejectArtefacts, U"Reject artefacts", nullptr) {
+	POSITIVE (threshold, U"Threshold (V)", U"75e-6")
+	OK
+DO
+	MODIFY_EACH (ERPEpochs)
+		ERPEpochs_rejectArtefacts (me, threshold);
+	MODIFY_EACH_END
+}
+
+// MARK: Convert
+
+DIRECT (NEW_ERPEpochs_to_ERPTier) {
+	CONVERT_EACH (ERPEpochs)
+		autoERPTier result = ERPEpochs_to_ERPTier (me);
+	CONVERT_EACH_END (my name.get())
+}
+
+DIRECT (NEW_ERPEpochs_to_ERP_mean) {
+	CONVERT_EACH (ERPEpochs)
+		autoERP result = ERPEpochs_to_ERP_mean (me);
+	CONVERT_EACH_END (my name.get(), U"_mean")
+}
+
 // MARK: - ERPTIER & TABLE
 
 FORM (NEW1_ERPTier_Table_extractEventsWhereColumn_number, U"Extract events where column (number)", nullptr) {
@@ -732,6 +814,22 @@ DO
 	CONVERT_TWO_END (my name.get())
 }
 
+// MARK: - reading
+
+FORM (NEW1_EEG_readFromBdfFile_part, U"Read EEG from BDF/EDF file (part)", nullptr) {
+	TEXTFIELD (bdfFile, U"BDF/EDF file:", U"")
+	REAL (fromTime, U"left Time range (s)", U"0.0")
+	REAL (toTime, U"right Time range (s)", U"0.0 (= all)")
+	NUMVEC (channels, U"Channel numbers (empty = all):", U"zero# (0)")
+	OK
+DO
+	structMelderFile file { };
+	Melder_relativePathToFile (bdfFile, & file);
+	CREATE_ONE
+		autoEEG result = EEG_readFromBdfFile_part (& file, fromTime, toTime, channels);
+	CREATE_ONE_END (MelderFile_name (& file))
+}
+
 // MARK: - file recognizers
 
 static autoDaata bdfFileRecognizer (integer nread, const char [] /* header */, MelderFile file) {
@@ -747,10 +845,12 @@ static autoDaata bdfFileRecognizer (integer nread, const char [] /* header */, M
 void praat_EEG_init ();
 void praat_EEG_init () {
 
-	Thing_recognizeClassesByName (classEEG, classERPTier, classERP, nullptr);
+	Thing_recognizeClassesByName (classEEG, classERPTier, classERPEpochs, classERP, nullptr);
 
 	Data_recognizeFileType (bdfFileRecognizer);
 
+	praat_addMenuCommand (U"Objects", U"Open", U"Read EEG from BDF/EDF file (part)...", nullptr, 0, NEW1_EEG_readFromBdfFile_part);
+
 	praat_addAction1 (classEEG, 0, U"EEG help", nullptr, 0, HELP_EEG_help);
 	praat_addAction1 (classEEG, 1, U"View & Edit", nullptr, praat_ATTRACTIVE, WINDOW_EEG_viewAndEdit);
 	praat_addAction1 (classEEG, 0, U"Query -", nullptr, 0, nullptr);
@@ -777,6 +877,8 @@ void praat_EEG_init () {
 		praat_addAction1 (classEEG, 0, U"To ERPTier (triggers)...", nullptr, 1, NEW_EEG_to_ERPTier_triggers);
 		praat_addAction1 (classEEG, 0, U"To ERPTier (triggers, preceded)...", nullptr, 1, NEW_EEG_to_ERPTier_triggers_preceded);
 		praat_addAction1 (classEEG, 0, U"To ERPTier...", nullptr, praat_DEPTH_1 + praat_HIDDEN, NEW_EEG_to_ERPTier_bit);
+		praat_addAction1 (classEEG, 0, U"To ERPEpochs (triggers)...", nullptr, 0, NEW_EEG_to_ERPEpochs_triggers);
+		praat_addAction1 (classEEG, 0, U"To ERP (triggers, mean)...", nullptr, 0, NEW_EEG_to_ERP_triggers_mean);
 		praat_addAction1 (classEEG, 0, U"To MixingMatrix...", nullptr, 0, NEW_EEG_to_MixingMatrix);
 	praat_addAction1 (classEEG, 0, U"Synthesize", nullptr, 0, nullptr);
 		praat_addAction1 (classEEG, 0, U"Concatenate", nullptr, 0, NEW1_EEGs_concatenate);
@@ -829,6 +931,18 @@ void praat_EEG_init () {
 	praat_addAction1 (classERPTier, 0, U"Analyse", nullptr, 0, nullptr);
 		praat_addAction1 (classERPTier, 0, U"Extract ERP...", nullptr, 0, NEW_ERPTier_to_ERP);
 		praat_addAction1 (classERPTier, 0, U"To ERP (mean)", nullptr, 0, NEW_ERPTier_to_ERP_mean);
+	praat_addAction1 (classERPTier, 0, U"Convert", nullptr, 0, nullptr);
+		praat_addAction1 (classERPTier, 0, U"To ERPEpochs", nullptr, 0, NEW_ERPTier_to_ERPEpochs);
+
+	praat_addAction1 (classERPEpochs, 0, U"Query -", nullptr, 0, nullptr);
+		praat_addAction1 (classERPEpochs, 1, U"Get number of events", nullptr, 1, INTEGER_ERPEpochs_getNumberOfEvents);
+	praat_addAction1 (classERPEpochs, 0, U"Modify -", nullptr, 0, nullptr);
+		praat_addAction1 (classERPEpochs, 0, U"Subtract baseline...", nullptr, 1, MODIFY_ERPEpochs_subtractBaseline);
+		praat_addAction1 (classERPEpochs, 0, U"Reject artefacts...", nullptr, 1, MODIFY_ERPEpochs_rejectArtefacts);
+	praat_addAction1 (classERPEpochs, 0, U"Analyse", nullptr, 0, nullptr);
+		praat_addAction1 (classERPEpochs, 0, U"To ERP (mean)", nullptr, 0, NEW_ERPEpochs_to_ERP_mean);
+	praat_addAction1 (classERPEpochs, 0, U"Convert", nullptr, 0, nullptr);
+		praat_addAction1 (classERPEpochs, 0, U"To ERPTier", nullptr, 0, NEW_ERPEpochs_to_ERPTier);
 
 	praat_addAction2 (classEEG, 1, classMixingMatrix, 1, U"To EEG (unmix)", nullptr, 0, NEW_EEG_MixingMatrix_to_EEG_unmix);
 	praat_addAction2 (classEEG, 1, classMixingMatrix, 1, U"To EEG (mix)", nullptr, 0, NEW_EEG_MixingMatrix_to_EEG_mix);
@@ -25,6 +25,8 @@
 #include "LPC_and_Formant.h"
 #include "LPC_and_Polynomial.h"
 #include "NUM2.h"
+#include "NUMmachar.h"
+#include "MelderThread.h"
 
 void Formant_Frame_init (Formant_Frame me, integer nFormants) {
 	my nFormants = nFormants;
@@ -40,14 +42,12 @@ void Formant_Frame_scale (Formant_Frame me, double scale) {
 	}
 }
 
-void Roots_into_Formant_Frame (Roots me, Formant_Frame thee, double samplingFrequency, double margin) {
-	integer n = my max - my min + 1;
-	autoVEC fc = VECzero (n);
-	autoVEC bc = VECzero (n);
-
-	// Determine the formants and bandwidths
-
-	thy nFormants = 0;
+/*
+	The formants and bandwidths of the roots in the upper half plane, in fc [1..] and bc [1..],
+	which should have room for all the roots. Returns the number of formants.
+*/
+static integer Roots_getFormants (Roots me, double samplingFrequency, double margin, VEC const& fc, VEC const& bc) {
+	integer numberOfFormants = 0;
 	double fLow = margin, fHigh = samplingFrequency / 2 - margin;
 	for (integer i = my min; i <= my max; i ++) {
 		if (my v [i].im < 0) {
@@ -57,11 +57,22 @@ void Roots_into_Formant_Frame (Roots me, Formant_Frame thee, double samplingFreq
 		if (f >= fLow && f <= fHigh) {
 			/*b = - log (my v [i].re * my v [i].re + my v [i].im * my v [i].im) * samplingFrequency / 2 / NUMpi;*/
 			double b = - log (dcomplex_abs (my v [i])) * samplingFrequency / NUMpi;
-			thy nFormants ++;
-			fc [thy nFormants] = f;
-			bc [thy nFormants] = b;
+			numberOfFormants ++;
+			fc [numberOfFormants] = f;
+			bc [numberOfFormants] = b;
 		}
 	}
+	return numberOfFormants;
+}
+
+void Roots_into_Formant_Frame (Roots me, Formant_Frame thee, double samplingFrequency, double margin) {
+	integer n = my max - my min + 1;
+	autoVEC fc = VECzero (n);
+	autoVEC bc = VECzero (n);
+
+	// Determine the formants and bandwidths
+
+	thy nFormants = Roots_getFormants (me, samplingFrequency, margin, fc.get(), bc.get());
 
 	Formant_Frame_init (thee, thy nFormants);
 
@@ -83,6 +94,72 @@ void LPC_Frame_into_Formant_Frame (LPC_Frame me, Formant_Frame thee, double samp
 	Roots_into_Formant_Frame (r.get(), thee, 1 / samplingPeriod, margin);
 }
 
+/*
+	The frames are divided over threads in blocks. Within a block, the roots of each frame are found
+	with Aberth-Ehrlich iterations that start from the roots of the previous frame;
+	the few frames for which these fail are analysed afterwards, one by one, with the companion matrix.
+	The threads allocate nothing: the main thread gives every frame room for maxnFormants formants beforehand,
+	and a frame with more formants than that (possible only with a zero margin) also goes to the companion matrix.
+*/
+#define LPC_to_Formant_FRAMES_PER_THREAD  64
+
+Thing_define (LPC_into_Formant_Args, Thing) { public:
+	LPC lpc;
+	Formant formant;
+	integer firstFrame, lastFrame;
+	double margin;
+	bool *frameNeedsCompanionMatrix;
+	autoPolynomial polynomial;
+	autoRoots roots, unitCircleRoots;
+	autoVEC frequencies, bandwidths;
+};
+
+Thing_implement (LPC_into_Formant_Args, Thing, 0);
+
+static MelderThread_RETURN_TYPE LPC_into_Formant (LPC_into_Formant_Args me) {
+	Polynomial p = my polynomial.get();
+	Roots roots = my roots.get(), unitCircleRoots = my unitCircleRoots.get();
+	bool warmStart = false;
+	for (integer iframe = my firstFrame; iframe <= my lastFrame; iframe ++) {
+		LPC_Frame lpc = & my lpc -> d_frames [iframe];
+		Formant_Frame formant = & my formant -> d_frames [iframe];
+		formant -> intensity = lpc -> gain;
+		const integer degree = lpc -> nCoefficients;
+		if (degree == 0) {
+			warmStart = false;
+			continue;
+		}
+		/*
+			As in LPC_Frame_to_Polynomial.
+		*/
+		p -> numberOfCoefficients = degree + 1;
+		for (integer i = 1; i <= degree; i ++)
+			p -> coefficients [i] = lpc -> a [degree - i + 1];
+		p -> coefficients [degree + 1] = 1.0;
+		warmStart = Polynomial_into_Roots_aberth (p, roots, warmStart);
+		if (! warmStart) {
+			my frameNeedsCompanionMatrix [iframe] = true;
+			continue;
+		}
+		unitCircleRoots -> max = roots -> max;
+		for (integer i = 1; i <= roots -> max; i ++)
+			unitCircleRoots -> v [i] = roots -> v [i];
+		Roots_fixIntoUnitCircle (unitCircleRoots);
+		const integer numberOfFormants = Roots_getFormants (unitCircleRoots, 1.0 / my lpc -> samplingPeriod, my margin,
+				my frequencies.get(), my bandwidths.get());
+		if (numberOfFormants > my formant -> maxnFormants) {
+			my frameNeedsCompanionMatrix [iframe] = true;
+			continue;
+		}
+		formant -> nFormants = numberOfFormants;
+		for (integer i = 1; i <= numberOfFormants; i ++) {
+			formant -> formant [i]. frequency = my frequencies [i];
+			formant -> formant [i]. bandwidth = my bandwidths [i];
+		}
+	}
+	MelderThread_RETURN;
+}
+
 autoFormant LPC_to_Formant (LPC me, double margin) {
 	try {
 		double samplingFrequency = 1.0 / my samplingPeriod;
@@ -95,8 +172,59 @@ autoFormant LPC_to_Formant (LPC me, double margin) {
 
 		autoMelderProgress progress (U"LPC to Formant");
 
+		/*
+			Debug option 56 sends all frames to the companion matrix, without threads.
+		*/
+		autoNUMvector <bool> frameNeedsCompanionMatrix (1, my nx);
+		if (Melder_debug == 56 || nmax == 0) {
+			for (integer i = 1; i <= my nx; i ++)
+				frameNeedsCompanionMatrix [i] = true;
+		} else {
+			if (! NUMfpp)
+				NUMmachar ();   // before the threads start
+			for (integer i = 1; i <= my nx; i ++)
+				if (my d_frames [i]. nCoefficients > 0 && thy maxnFormants > 0)
+					thy d_frames [i]. formant = NUMvector <structFormant_Formant> (1, thy maxnFormants);
+			const integer framesPerThread = LPC_to_Formant_FRAMES_PER_THREAD;
+			const integer numberOfThreads = std::min ((my nx - 1) / framesPerThread + 1, integer (MelderThread_getNumberOfProcessors ()));
+			std::vector <autoLPC_into_Formant_Args> args ((size_t) numberOfThreads);
+			for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+				autoLPC_into_Formant_Args arg = Thing_new (LPC_into_Formant_Args);
+				arg -> lpc = me;
+				arg -> formant = thee.get();
+				arg -> margin = margin;
+				arg -> frameNeedsCompanionMatrix = frameNeedsCompanionMatrix.peek();
+				arg -> polynomial = Polynomial_create (-1.0, 1.0, nmax);
+				arg -> roots = Roots_create (nmax);
+				arg -> unitCircleRoots = Roots_create (nmax);
+				arg -> frequencies = VECraw (nmax);
+				arg -> bandwidths = VECraw (nmax);
+				args [(size_t) ithread - 1] = arg.move();
+			}
+			for (integer firstFrame = 1; firstFrame <= my nx; firstFrame += numberOfThreads * framesPerThread) {
+				Melder_progress (firstFrame / (my nx + 1.0), U"LPC to Formant: frame ", firstFrame, U" out of ", my nx, U".");
+				integer numberOfThreadsNeeded = 0;
+				for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+					const integer threadFirstFrame = firstFrame + (ithread - 1) * framesPerThread;
+					if (threadFirstFrame > my nx)
+						break;
+					args [(size_t) ithread - 1] -> firstFrame = threadFirstFrame;
+					args [(size_t) ithread - 1] -> lastFrame = std::min (threadFirstFrame + framesPerThread - 1, my nx);
+					numberOfThreadsNeeded = ithread;
+				}
+				MelderThread_run (LPC_into_Formant, args.data(), (int) numberOfThreadsNeeded);
+			}
+		}
+
 		for (integer i = 1; i <= my nx; i ++) {
 			Formant_Frame formant = & thy d_frames [i];
+			if (formant -> formant && (frameNeedsCompanionMatrix [i] || formant -> nFormants == 0)) {
+				NUMvector_free (formant -> formant, 1);   // the room given to the threads is not needed
+				formant -> formant = nullptr;
+				formant -> nFormants = 0;
+			}
+			if (! frameNeedsCompanionMatrix [i])
+				continue;
 			LPC_Frame lpc = & my d_frames [i];
 
 			// Initialisation of Formant_Frame is taken care of in Roots_into_Formant_Frame!
@@ -24,6 +24,8 @@
 #include "LPC_and_LineSpectralFrequencies.h"
 #include "NUM2.h"
 #include "Polynomial.h"
+#include "NUMmachar.h"
+#include "MelderThread.h"
 
 
 /*
@@ -191,12 +193,15 @@ static integer Roots_fromPolynomial_grid (Roots me, Polynomial thee, double grid
 	return numberOfRootsFound;
 }
 
-static void LineSpectralFrequencies_Frame_initFromLPC_Frame_grid (LineSpectralFrequencies_Frame me, LPC_Frame thee, Polynomial g1, Polynomial g2, Roots roots, double gridSize, double maximumFrequency) {
+/*
+	The frame should have been initialized to thy nCoefficients frequencies.
+	Returns false if the roots of g1 could not be found, without throwing, so that it can run in a thread.
+*/
+static bool LineSpectralFrequencies_Frame_initFromLPC_Frame_grid (LineSpectralFrequencies_Frame me, LPC_Frame thee, Polynomial g1, Polynomial g2, Roots roots, double gridSize, double maximumFrequency) {
 	/* Construct Fs and Fa
 		divide out the zeros
 		transform to polynomial equations g1 and g2 of half the order
 	*/
-	LineSpectralFrequencies_Frame_init (me, thy nCoefficients);
 	Polynomial_fromLPC_Frame_lspsum (g1, thee);
 	integer half_order_g1 = g1 -> numberOfCoefficients - 1;
 	Polynomial_fromLPC_Frame_lspdif (g2, thee);
@@ -208,7 +213,8 @@ static void LineSpectralFrequencies_Frame_initFromLPC_Frame_grid (LineSpectralFr
 		gridSize *= 0.5; numberOfBisections++;
 	}
 	
-	Melder_require (numberOfBisections < 10, U"Too many bisections.");
+	if (numberOfBisections >= 10)
+		return false;
 	
 	// [g1-> xmin, g1 -> xmax] <==> [nyquistFrequency, 0] i.e. highest root corresponds to lowest frequency
 	
@@ -228,6 +234,32 @@ static void LineSpectralFrequencies_Frame_initFromLPC_Frame_grid (LineSpectralFr
 			my numberOfFrequencies --;
 		}	
 	}
+	return true;
+}
+
+#define LPC_to_LineSpectralFrequencies_FRAMES_PER_THREAD  64
+
+Thing_define (LPC_into_LineSpectralFrequencies_Args, Thing) { public:
+	LPC lpc;
+	LineSpectralFrequencies lsf;
+	integer firstFrame, lastFrame;
+	double gridSize;
+	autoPolynomial g1, g2;
+	autoRoots roots;
+	integer firstFailedFrame;
+};
+
+Thing_implement (LPC_into_LineSpectralFrequencies_Args, Thing, 0);
+
+static MelderThread_RETURN_TYPE LPC_into_LineSpectralFrequencies (LPC_into_LineSpectralFrequencies_Args me) {
+	for (integer iframe = my firstFrame; iframe <= my lastFrame; iframe ++) {
+		if (! LineSpectralFrequencies_Frame_initFromLPC_Frame_grid (& my lsf -> d_frames [iframe], & my lpc -> d_frames [iframe],
+			my g1.get(), my g2.get(), my roots.get(), my gridSize, my lsf -> maximumFrequency) && my firstFailedFrame == 0)
+		{
+			my firstFailedFrame = iframe;
+		}
+	}
+	MelderThread_RETURN;
 }
 
 autoLineSpectralFrequencies LPC_to_LineSpectralFrequencies (LPC me, double gridSize) {
@@ -237,20 +269,37 @@ autoLineSpectralFrequencies LPC_to_LineSpectralFrequencies (LPC me, double gridS
 		}
 		double nyquistFrequency = 0.5 / my samplingPeriod;
 		autoLineSpectralFrequencies thee = LineSpectralFrequencies_create (my xmin, my xmax, my nx, my dx, my x1, my maxnCoefficients, nyquistFrequency);
-		autoPolynomial g1 = Polynomial_create (-2.0, 2.0, my maxnCoefficients + 1); // large enough
-		autoPolynomial g2 = Polynomial_create (-2.0, 2.0, my maxnCoefficients + 1);
-		autoRoots roots = Roots_create ((my maxnCoefficients + 1) / 2);
-		
-		for (integer iframe = 1; iframe <= my nx; iframe ++) {
-			LPC_Frame lpc_frame = & my d_frames [iframe];
-			LineSpectralFrequencies_Frame lsf_frame = & thy d_frames [iframe];
-			/* Construct Fs and Fa
-				divide out the zeros
-				transform to polynomial equations g1 and g2 of half the order
-				find zeros
-			 */
-			LineSpectralFrequencies_Frame_initFromLPC_Frame_grid (lsf_frame, lpc_frame, g1.get(), g2.get(), roots.get(), gridSize, nyquistFrequency);
+		for (integer iframe = 1; iframe <= my nx; iframe ++)
+			LineSpectralFrequencies_Frame_init (& thy d_frames [iframe], my d_frames [iframe]. nCoefficients);   // before the threads start
+		if (! NUMfpp)
+			NUMmachar ();   // for NUMridders, before the threads start
+
+		/*
+			The frames are independent, so they are divided over threads in blocks,
+			each thread with its own polynomials and roots as buffers.
+			Debug option 56 analyses them all in one thread.
+		*/
+		const integer framesPerThread = LPC_to_LineSpectralFrequencies_FRAMES_PER_THREAD;
+		const integer numberOfThreads = Melder_debug == 56 ? 1 :
+				std::min ((my nx - 1) / framesPerThread + 1, integer (MelderThread_getNumberOfProcessors ()));
+		std::vector <autoLPC_into_LineSpectralFrequencies_Args> args ((size_t) numberOfThreads);
+		for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+			autoLPC_into_LineSpectralFrequencies_Args arg = Thing_new (LPC_into_LineSpectralFrequencies_Args);
+			arg -> lpc = me;
+			arg -> lsf = thee.get();
+			arg -> gridSize = gridSize;
+			arg -> g1 = Polynomial_create (-2.0, 2.0, my maxnCoefficients + 1); // large enough
+			arg -> g2 = Polynomial_create (-2.0, 2.0, my maxnCoefficients + 1);
+			arg -> roots = Roots_create ((my maxnCoefficients + 1) / 2);
+			const integer numberOfFramesPerThread = (my nx - 1) / numberOfThreads + 1;
+			arg -> firstFrame = 1 + (ithread - 1) * numberOfFramesPerThread;
+			arg -> lastFrame = std::min (ithread * numberOfFramesPerThread, my nx);
+			args [(size_t) ithread - 1] = arg.move();
 		}
+		MelderThread_run (LPC_into_LineSpectralFrequencies, args.data(), (int) numberOfThreads);
+		for (integer ithread = 1; ithread <= numberOfThreads; ithread ++)
+			Melder_require (args [(size_t) ithread - 1] -> firstFailedFrame == 0,
+				U"Too many bisections (frame ", args [(size_t) ithread - 1] -> firstFailedFrame, U").");
 		return thee;
 	} catch (MelderError) {
 		Melder_throw (me, U": no LineSpectralFrequencies created.");
@@ -30,6 +30,7 @@
 #include "Vector.h"
 #include "Spectrum.h"
 #include "NUM2.h"
+#include "MelderThread.h"
 
 #define LPC_METHOD_AUTO 1
 #define LPC_METHOD_COVAR 2
@@ -67,17 +68,17 @@ void LPC_Frame_Sound_filterInverse (LPC_Frame me, Sound thee, integer channel) {
 	}
 }
 
-static int Sound_into_LPC_Frame_auto (Sound me, LPC_Frame thee) {
+static int VEC_into_LPC_Frame_auto (constVEC x, LPC_Frame thee, VEC work) {
 	integer i = 1; // For error condition at end
 	integer m = thy nCoefficients;
 
-	autoNUMvector<double> r (1, m + 1);
-	autoNUMvector<double> a (1, m + 1);
-	autoNUMvector<double> rc (1, m);
+	VECset (work.part (1, 3 * m + 2), 0.0);
+	VEC r = work.part (1, m + 1);
+	VEC a = work.part (m + 2, 2 * m + 2);
+	VEC rc = work.part (2 * m + 3, 3 * m + 2);
 
-	VEC x = my z.row (1);
 	for (i = 1; i <= m + 1; i ++) {
-		for (integer j = 1; j <= my nx - i + 1; j ++) {
+		for (integer j = 1; j <= x.size - i + 1; j ++) {
 			r [i] += x [j] * x [j + i - 1];
 		}
 	}
@@ -127,15 +128,16 @@ end:
 	cc = & work [m+1)/2+m+m+1+m+1]
 	for (i=1; i<=m(m+1)/2+m+m+1+m+m+1;i ++) work [i] = 0;
 */
-static int Sound_into_LPC_Frame_covar (Sound me, LPC_Frame thee) {
-	integer i = 1, n = my nx, m = thy nCoefficients;
-	constVEC x = my z.row (1);
+static int VEC_into_LPC_Frame_covar (constVEC x, LPC_Frame thee, VEC work) {
+	integer i = 1, n = x.size, m = thy nCoefficients;
 
-	autoNUMvector<double> b (1, m * (m + 1) / 2);
-	autoNUMvector<double> grc (1, m);
-	autoNUMvector<double> a (1, m + 1);
-	autoNUMvector<double> beta (1, m);
-	autoNUMvector<double> cc (1, m + 1);
+	const integer nb = m * (m + 1) / 2;
+	VECset (work.part (1, nb + 4 * m + 2), 0.0);
+	VEC b = work.part (1, nb);
+	VEC grc = work.part (nb + 1, nb + m);
+	VEC a = work.part (nb + m + 1, nb + 2 * m + 1);
+	VEC beta = work.part (nb + 2 * m + 2, nb + 3 * m + 1);
+	VEC cc = work.part (nb + 3 * m + 2, nb + 4 * m + 2);
 
 	thy gain = 0.0;
 	for (i = m + 1; i <= n; i ++) {
@@ -220,23 +222,23 @@ end:
 	return 0; // Melder_warning ("Less coefficienst than asked for.");
 }
 
-static int Sound_into_LPC_Frame_burg (Sound me, LPC_Frame thee) {
-	thy gain = NUMburg_preallocated (thy a.get(), my z.row(1));
-	thy gain *= my nx;
+static int VEC_into_LPC_Frame_burg (constVEC x, LPC_Frame thee, VEC work) {
+	thy gain = NUMburg_preallocated (thy a.get(), x, work);
+	thy gain *= x.size;
 	for (integer i = 1; i <= thy nCoefficients; i ++) {
 		thy a [i] = -thy a [i];
 	}
 	return thy gain != 0.0;
 }
 
-static int Sound_into_LPC_Frame_marple (Sound me, LPC_Frame thee, double tol1, double tol2) {
-	integer m = 1, n = my nx, mmax = thy nCoefficients;
+static int VEC_into_LPC_Frame_marple (constVEC x, LPC_Frame thee, double tol1, double tol2, VEC work) {
+	integer m = 1, n = x.size, mmax = thy nCoefficients;
 	int status = 1;
-	constVEC x = my z.row (1);
 
-	autoVEC c = VECzero (mmax + 1);
-	autoVEC d = VECzero (mmax + 1);
-	autoVEC r = VECzero (mmax + 1);
+	VECset (work.part (1, 3 * mmax + 3), 0.0);
+	VEC c = work.part (1, mmax + 1);
+	VEC d = work.part (mmax + 2, 2 * mmax + 2);
+	VEC r = work.part (2 * mmax + 3, 3 * mmax + 3);
 	double e0 = 0.0;
 	for (integer k = 1; k <= n; k ++) {
 		e0 += x [k] * x [k];
@@ -367,6 +369,77 @@ end:
 	return status == 1 || status == 4 || status == 5;
 }
 
+/*
+	The workspace of every method, for frames of frameSize samples; the methods allocate nothing,
+	so that they can run in threads.
+*/
+static integer VEC_into_LPC_Frame_workspaceSize (integer frameSize, integer predictionOrder) {
+	const integer m = predictionOrder;
+	return std::max ({
+		3 * m + 2,   // auto
+		m * (m + 1) / 2 + 4 * m + 2,   // covar
+		2 * frameSize + m,   // burg
+		3 * m + 3   // marple
+	});
+}
+
+static int VEC_into_LPC_Frame (constVEC x, LPC_Frame thee, int method, double tol1, double tol2, VEC work) {
+	if (method == LPC_METHOD_AUTO)
+		return VEC_into_LPC_Frame_auto (x, thee, work);
+	else if (method == LPC_METHOD_COVAR)
+		return VEC_into_LPC_Frame_covar (x, thee, work);
+	else if (method == LPC_METHOD_BURG)
+		return VEC_into_LPC_Frame_burg (x, thee, work);
+	else
+		return VEC_into_LPC_Frame_marple (x, thee, tol1, tol2, work);
+}
+
+/*
+	Copy the samples of the first channel around startTime into the frame, pre-emphasized if preEmphasis is not zero,
+	subtract the mean and multiply by the window; the result is identical to that of
+	Sound_preEmphasis on a copy of the whole Sound, followed by Sound_into_Sound, Vector_subtractMean and Sounds_multiply.
+*/
+static void Sound_into_LPC_windowedFrame (Sound me, double startTime, double preEmphasis, constVEC window, VEC frame) {
+	const integer index = Sampled_xToNearestIndex (me, startTime);
+	constVEC s = my z.row (1);
+	for (integer i = 1; i <= frame.size; i ++) {
+		const integer j = index - 1 + i;
+		frame [i] = ( j < 1 || j > my nx ? 0.0 : j == 1 || preEmphasis == 0.0 ? s [j] : s [j] - preEmphasis * s [j - 1] );
+	}
+	VECcentre_inplace (frame);
+	for (integer i = 1; i <= frame.size; i ++)
+		frame [i] *= window [i];
+}
+
+/*
+	The frames are windowed straight from the samples and analysed in parallel;
+	every thread has its own frame buffer and workspace.
+*/
+#define Sound_to_LPC_FRAMES_PER_THREAD  64
+
+Thing_define (Sound_into_LPC_Args, Thing) { public:
+	Sound sound;
+	LPC lpc;
+	integer firstFrame, lastFrame;
+	int method;
+	double windowDuration, preEmphasis, tol1, tol2;
+	constVEC window;
+	autoVEC frame, workspace;
+	integer frameErrorCount;
+};
+
+Thing_implement (Sound_into_LPC_Args, Thing, 0);
+
+static MelderThread_RETURN_TYPE Sound_into_LPC (Sound_into_LPC_Args me) {
+	for (integer iframe = my firstFrame; iframe <= my lastFrame; iframe ++) {
+		const double t = Sampled_indexToX (my lpc, iframe);
+		Sound_into_LPC_windowedFrame (my sound, t - my windowDuration / 2, my preEmphasis, my window, my frame.get());
+		if (! VEC_into_LPC_Frame (my frame.get(), & my lpc -> d_frames [iframe], my method, my tol1, my tol2, my workspace.get()))
+			my frameErrorCount ++;
+	}
+	MelderThread_RETURN;
+}
+
 static autoLPC _Sound_to_LPC (Sound me, int predictionOrder, double analysisWidth, double dt, double preEmphasisFrequency, int method, double tol1, double tol2) {
 	double t1, samplingFrequency = 1.0 / my dx;
 	double windowDuration = 2.0 * analysisWidth; /* gaussian window */
@@ -380,44 +453,70 @@ static autoLPC _Sound_to_LPC (Sound me, int predictionOrder, double analysisWidt
 		windowDuration = my dx * my nx;
 	}
 	Sampled_shortTermAnalysis (me, windowDuration, dt, & numberOfFrames, & t1);
-	autoSound sound = Data_copy (me);
-	autoSound sframe = Sound_createSimple (1, windowDuration, samplingFrequency);
 	autoSound window = Sound_createGaussian (windowDuration, samplingFrequency);
 	autoLPC thee = LPC_create (my xmin, my xmax, numberOfFrames, dt, t1, predictionOrder, my dx);
+	for (integer i = 1; i <= numberOfFrames; i ++)
+		LPC_Frame_init (& thy d_frames [i], predictionOrder);
 
 	autoMelderProgress progress (U"LPC analysis");
 
-	if (preEmphasisFrequency < samplingFrequency / 2.0) {
-		Sound_preEmphasis (sound.get(), preEmphasisFrequency);
-	}
-
-	for (integer i = 1; i <= numberOfFrames; i ++) {
-		LPC_Frame lpcframe = & thy d_frames [i];
-		double t = Sampled_indexToX (thee.get(), i);
-		LPC_Frame_init (lpcframe, predictionOrder);
-		Sound_into_Sound (sound.get(), sframe.get(), t - windowDuration / 2);
-		Vector_subtractMean (sframe.get());
-		Sounds_multiply (sframe.get(), window.get());
-		if (method == LPC_METHOD_AUTO) {
-			if (! Sound_into_LPC_Frame_auto (sframe.get(), lpcframe)) {
-				frameErrorCount ++;
-			}
-		} else if (method == LPC_METHOD_COVAR) {
-			if (! Sound_into_LPC_Frame_covar (sframe.get(), lpcframe)) {
-				frameErrorCount ++;
-			}
-		} else if (method == LPC_METHOD_BURG) {
-			if (! Sound_into_LPC_Frame_burg (sframe.get(), lpcframe)) {
-				frameErrorCount ++;
-			}
-		} else if (method == LPC_METHOD_MARPLE) {
-			if (! Sound_into_LPC_Frame_marple (sframe.get(), lpcframe, tol1, tol2)) {
+	if (Melder_debug == 55) {
+		/*
+			One frame at a time, through a Sound object per frame.
+		*/
+		autoSound sound = Data_copy (me);
+		autoSound sframe = Sound_createSimple (1, windowDuration, samplingFrequency);
+		autoVEC workspace = VECraw (VEC_into_LPC_Frame_workspaceSize (sframe -> nx, predictionOrder));
+		if (preEmphasisFrequency < samplingFrequency / 2.0) {
+			Sound_preEmphasis (sound.get(), preEmphasisFrequency);
+		}
+		for (integer i = 1; i <= numberOfFrames; i ++) {
+			double t = Sampled_indexToX (thee.get(), i);
+			Sound_into_Sound (sound.get(), sframe.get(), t - windowDuration / 2);
+			Vector_subtractMean (sframe.get());
+			Sounds_multiply (sframe.get(), window.get());
+			if (! VEC_into_LPC_Frame (sframe -> z.row (1), & thy d_frames [i], method, tol1, tol2, workspace.get())) {
 				frameErrorCount ++;
 			}
+			if (i % 10 == 1)
+				Melder_progress ( (double) i / numberOfFrames, U"LPC analysis of frame ", i, U" out of ", numberOfFrames, U".");
+		}
+		return thee;
+	}
+
+	const double preEmphasis = ( preEmphasisFrequency < samplingFrequency / 2.0 ? exp (- 2.0 * NUMpi * preEmphasisFrequency * my dx) : 0.0 );
+	const integer framesPerThread = Sound_to_LPC_FRAMES_PER_THREAD;
+	const integer numberOfThreads = std::min ((numberOfFrames - 1) / framesPerThread + 1, integer (MelderThread_getNumberOfProcessors ()));
+	std::vector <autoSound_into_LPC_Args> args ((size_t) numberOfThreads);
+	for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+		autoSound_into_LPC_Args arg = Thing_new (Sound_into_LPC_Args);
+		arg -> sound = me;
+		arg -> lpc = thee.get();
+		arg -> method = method;
+		arg -> windowDuration = windowDuration;
+		arg -> preEmphasis = preEmphasis;
+		arg -> tol1 = tol1;
+		arg -> tol2 = tol2;
+		arg -> window = window -> z.row (1);
+		arg -> frame = VECzero (window -> nx);
+		arg -> workspace = VECraw (VEC_into_LPC_Frame_workspaceSize (window -> nx, predictionOrder));
+		args [(size_t) ithread - 1] = arg.move();
+	}
+	for (integer firstFrame = 1; firstFrame <= numberOfFrames; firstFrame += numberOfThreads * framesPerThread) {
+		Melder_progress (firstFrame / (numberOfFrames + 1.0), U"LPC analysis of frame ", firstFrame, U" out of ", numberOfFrames, U".");
+		integer numberOfThreadsNeeded = 0;
+		for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+			const integer threadFirstFrame = firstFrame + (ithread - 1) * framesPerThread;
+			if (threadFirstFrame > numberOfFrames)
+				break;
+			args [(size_t) ithread - 1] -> firstFrame = threadFirstFrame;
+			args [(size_t) ithread - 1] -> lastFrame = std::min (threadFirstFrame + framesPerThread - 1, numberOfFrames);
+			numberOfThreadsNeeded = ithread;
 		}
-		if (i % 10 == 1)
-			Melder_progress ( (double) i / numberOfFrames, U"LPC analysis of frame ", i, U" out of ", numberOfFrames, U".");
+		MelderThread_run (Sound_into_LPC, args.data(), (int) numberOfThreadsNeeded);
 	}
+	for (integer ithread = 1; ithread <= numberOfThreads; ithread ++)
+		frameErrorCount += args [(size_t) ithread - 1] -> frameErrorCount;
 	return thee;
 }
 
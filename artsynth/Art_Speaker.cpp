@@ -249,7 +249,7 @@ static double arcLength (double from, double to) {
 }
 
 static int Art_Speaker_meshCount = 27;
-static double bodyX, bodyY, bodyRadius;
+static thread_local double bodyX, bodyY, bodyRadius;   // set by Art_Speaker_meshVocalTract, which runs in threads during batch synthesis
 
 static double toLine (double x, double y, const double intX [], const double intY [], integer i) {
 	integer nearby;
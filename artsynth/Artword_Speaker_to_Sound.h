@@ -19,6 +19,7 @@
 #include "Artword.h"
 #include "Speaker.h"
 #include "Sound.h"
+#include "SynthesisBatch.h"
 
 autoSound Artword_Speaker_to_Sound (Artword artword, Speaker speaker,
    double samplingFrequency, int oversampling,
@@ -26,4 +27,20 @@ autoSound Artword_Speaker_to_Sound (Artword artword, Speaker speaker,
    autoSound *p1, int ip1, autoSound *p2, int ip2, autoSound *p3, int ip3,
    autoSound *v1, int iv1, autoSound *v2, int iv2, autoSound *v3, int iv3);
 
+/*
+	Without the monitor window and the nine optional Sounds, for synthesis in a batch.
+	The turbulence noise comes from randomStream, or from the main stream if that is null.
+	Synthesis changes the Artword (its interpolation position).
+*/
+autoSound Artword_Speaker_to_Sound_headless (Artword artword, Speaker speaker,
+	double samplingFrequency, int oversampling, NUMrandomStream *randomStream);
+
+/*
+	A batch (see SynthesisBatch.h) that synthesizes the Artwords with the Speakers in pairs, in order,
+	or all Artwords with a single Speaker, or a single Artword with all Speakers.
+	The batch works on copies of the Artwords.
+*/
+autoSynthesisBatch Artwords_Speakers_createSynthesisBatch (OrderedOf<structArtword>* artwords, OrderedOf<structSpeaker>* speakers,
+	double samplingFrequency, int oversampling);
+
 /* End of file Artword_Speaker_to_Sound.h */
@@ -198,6 +198,40 @@ DO
 	END
 }
 
+#define FIND_ARTWORDS_AND_SPEAKERS  \
+	OrderedOf<structArtword> artwords; \
+	OrderedOf<structSpeaker> speakers; \
+	LOOP { if (CLASS == classArtword) artwords. addItem_ref ((Artword) OBJECT); \
+	else if (CLASS == classSpeaker) speakers. addItem_ref ((Speaker) OBJECT); }
+
+FORM (NEW2_Artwords_Speakers_to_Sound_batch, U"Articulatory synthesizer (batch)", U"Artword & Speaker: To Sound...") {
+	POSITIVE (samplingFrequency, U"Sampling frequency (Hz)", U"22050.0")
+	NATURAL (oversamplingFactor, U"Oversampling factor", U"25")
+	OK
+DO
+	FIND_ARTWORDS_AND_SPEAKERS
+		autoSynthesisBatch batch = Artwords_Speakers_createSynthesisBatch (& artwords, & speakers, samplingFrequency, oversamplingFactor);
+		autoSound sound;
+		autoTextGrid textGrid;
+		SynthesisBatch_to_Sound_TextGrid (batch.get(), & sound, & textGrid);
+		praat_new (sound.move(), U"batch");
+		praat_new (textGrid.move(), U"batch");
+	END
+}
+
+FORM (SAVE_Artwords_Speakers_saveAsWavFiles_batch, U"Articulatory synthesizer: Save as WAV files (batch)", U"Artword & Speaker: To Sound...") {
+	POSITIVE (samplingFrequency, U"Sampling frequency (Hz)", U"22050.0")
+	NATURAL (oversamplingFactor, U"Oversampling factor", U"25")
+	TEXTFIELD (folder, U"Folder:", U"")
+	OK
+DO
+	FIND_ARTWORDS_AND_SPEAKERS
+		autoSynthesisBatch batch = Artwords_Speakers_createSynthesisBatch (& artwords, & speakers, samplingFrequency, oversamplingFactor);
+		SynthesisBatch_saveAsWavFiles (batch.get(), folder);
+		SynthesisBatch_infoThroughput (batch.get());
+	END_NO_NEW_DATA
+}
+
 DIRECT (MOVIE_Artword_Speaker_movie) {
 	MOVIE_TWO (Artword, Speaker, U"Artword & Speaker movie", 300, 300)
 		Artword_Speaker_movie (me, you, graphics);
@@ -358,6 +392,9 @@ void praat_uvafon_Artsynth_init () {
 	praat_addAction2 (classArtword, 1, classSpeaker, 1, U"Draw...", nullptr, 0, GRAPHICS_Artword_Speaker_draw);
 	praat_addAction2 (classArtword, 1, classSpeaker, 1, U"Synthesize", nullptr, 0, nullptr);
 	praat_addAction2 (classArtword, 1, classSpeaker, 1, U"To Sound...", nullptr, 0, NEW1_Artword_Speaker_to_Sound);
+	praat_addAction2 (classArtword, 0, classSpeaker, 0, U"Synthesize (batch) -", nullptr, 0, nullptr);
+	praat_addAction2 (classArtword, 0, classSpeaker, 0, U"To Sound (batch)...", nullptr, 1, NEW2_Artwords_Speakers_to_Sound_batch);
+	praat_addAction2 (classArtword, 0, classSpeaker, 0, U"Save as WAV files (batch)...", nullptr, 1, SAVE_Artwords_Speakers_saveAsWavFiles_batch);
 
 	praat_addAction3 (classArtword, 1, classSpeaker, 1, classSound, 1, U"Movie", nullptr, 0, MOVIE_Artword_Speaker_Sound_movie);
 
@@ -114,9 +114,10 @@ autoFileInMemorySet FilesInMemory_to_FileInMemorySet (OrderedOf<structFileInMemo
 autoFileInMemorySet FileInMemorySet_extractFiles (FileInMemorySet me, kMelder_string which, conststring32 criterion) {
 	try {
 		autoFileInMemorySet thee = Thing_new (FileInMemorySet);
+		MelderStringMatcher matcher (which, criterion, true);
 		for (integer ifile = 1; ifile <= my size; ifile ++) {
 			FileInMemory fim = static_cast <FileInMemory> (my at [ifile]);
-			if (Melder_stringMatchesCriterion (fim -> d_path.get(), which, criterion, true)) {
+			if (matcher. matches (fim -> d_path.get())) {
 				autoFileInMemory item = Data_copy (fim);
 				thy addItem_move (item.move());
 			}
@@ -130,9 +131,10 @@ autoFileInMemorySet FileInMemorySet_extractFiles (FileInMemorySet me, kMelder_st
 autoFileInMemorySet FileInMemorySet_listFiles (FileInMemorySet me, kMelder_string which, conststring32 criterion) {
 	try {
 		autoFileInMemorySet thee = Thing_new (FileInMemorySet);
+		MelderStringMatcher matcher (which, criterion, true);
 		for (integer ifile = 1; ifile <= my size; ifile ++) {
 			FileInMemory fim = static_cast<FileInMemory> (my at [ifile]);
-			if (Melder_stringMatchesCriterion (fim -> d_path.get(), which, criterion, true)) {
+			if (matcher. matches (fim -> d_path.get())) {
 				thy addItem_ref (fim);
 			}
 		}
@@ -207,9 +209,10 @@ integer FileInMemorySet_lookUp (FileInMemorySet me, conststring32 path) {
 
 integer FileInMemorySet_findNumberOfMatches_path (FileInMemorySet me, kMelder_string which, conststring32 criterion) {
 	integer numberOfMatches = 0;
+	MelderStringMatcher matcher (which, criterion, true);
 	for (integer ifile = 1; ifile <= my size; ifile ++) {
 		FileInMemory fim = static_cast <FileInMemory> (my at [ifile]);
-		if (Melder_stringMatchesCriterion (fim -> d_path.get(), which, criterion, true)) {
+		if (matcher. matches (fim -> d_path.get())) {
 			numberOfMatches ++;
 		}
 	}
@@ -64,6 +64,7 @@
 #include "NUMclapack.h"
 #include "NUM2.h"
 #include "NUMmachar.h"
+#include "MelderThread.h"
 #include "melder.h"
 
 #include "gsl_randist.h"
@@ -272,7 +273,7 @@ void MATlowerCholeskyInverse_inplace (MAT a, double *out_lnd) {
 		for (integer i = 1; i <= a.nrow; i ++) {
 			lnd += log (a [i] [i]);
 		}
-		*out_lnd *= 2.0 * lnd; /* because A = L . L' */
+		*out_lnd = 2.0 * lnd; /* because A = L . L' */
 	}
 
 	// Get the inverse */
@@ -316,6 +317,106 @@ double NUMmahalanobisDistance (constMAT lowerInverse, constVEC v, constVEC m) {
 	return (double) chisq;
 }
 
+void NUMmahalanobisDistances_preallocated (constMATVU const& data, const std::vector <constMAT>& lowerInverses,
+	const std::vector <constVEC>& centroids, MATVU const& out_distances, MAT const& differences)
+{
+	const integer dimension = data.ncol, numberOfGroups = uinteger_to_integer (lowerInverses.size());
+	Melder_assert (differences.nrow >= 1 && differences.ncol == dimension);
+	for (integer firstRow = 1; firstRow <= data.nrow; firstRow += differences.nrow) {
+		const integer blockSize = std::min (differences.nrow, data.nrow - firstRow + 1);
+		for (integer igroup = 1; igroup <= numberOfGroups; igroup ++) {
+			constMAT lowerInverse = lowerInverses [(size_t) igroup - 1];
+			constVEC centroid = centroids [(size_t) igroup - 1];
+			if (lowerInverse.nrow == 1) {   // diagonal: a single row of the inverse, so nothing to reuse across the block
+				for (integer i = 1; i <= blockSize; i ++) {
+					const constVECVU x = data [firstRow + i - 1];
+					double chisq = 0.0;
+					for (integer k = 1; k <= dimension; k ++) {
+						const double t = lowerInverse [1] [k] * (x [k] - centroid [k]);
+						chisq += t * t;
+					}
+					out_distances [firstRow + i - 1] [igroup] = chisq;
+				}
+				continue;
+			}
+			for (integer i = 1; i <= blockSize; i ++) {
+				for (integer k = 1; k <= dimension; k ++)
+					differences [i] [k] = data [firstRow + i - 1] [k] - centroid [k];
+				out_distances [firstRow + i - 1] [igroup] = 0.0;
+			}
+			for (integer irow = 1; irow <= dimension; irow ++) {
+				constVEC l = lowerInverse.row (irow);
+				for (integer i = 1; i <= blockSize; i ++) {
+					double t = 0.0;
+					for (integer k = 1; k <= irow; k ++)
+						t += l [k] * differences [i] [k];
+					out_distances [firstRow + i - 1] [igroup] += t * t;
+				}
+			}
+		}
+	}
+}
+
+Thing_define (NUMmahalanobisDistances_Args, Thing) {
+public:
+	constMATVU data;
+	const std::vector <constMAT> *lowerInverses;
+	const std::vector <constVEC> *centroids;
+	MATVU distances;
+	autoMAT differences;   // a block of rows minus a centroid
+	integer firstRow, lastRow;
+};
+
+Thing_implement (NUMmahalanobisDistances_Args, Thing, 0);
+
+#define NUMmahalanobisDistances_BLOCK_SIZE  32
+
+static MelderThread_RETURN_TYPE NUMmahalanobisDistances_block (NUMmahalanobisDistances_Args me) {
+	NUMmahalanobisDistances_preallocated (my data.part (my firstRow, my lastRow, 1, my data.ncol), *my lowerInverses, *my centroids,
+		my distances.part (my firstRow, my lastRow, 1, my distances.ncol), my differences.get());
+	MelderThread_RETURN;
+}
+
+#define NUMmahalanobisDistances_MINIMUM_PRODUCTS_PER_THREAD  100000
+
+void NUMmahalanobisDistances (constMATVU const& data, const std::vector <constMAT>& lowerInverses, const std::vector <constVEC>& centroids,
+	MATVU const& out_distances)
+{
+	const integer numberOfGroups = uinteger_to_integer (lowerInverses.size());
+	Melder_assert (centroids.size() == lowerInverses.size());
+	Melder_assert (out_distances.nrow == data.nrow && out_distances.ncol == numberOfGroups);
+	if (Melder_debug == 68) {
+		autoVEC x = VECraw (data.ncol);
+		for (integer irow = 1; irow <= data.nrow; irow ++) {
+			x.all() <<= data [irow];
+			for (integer igroup = 1; igroup <= numberOfGroups; igroup ++)
+				out_distances [irow] [igroup] = NUMmahalanobisDistance (lowerInverses [(size_t) igroup - 1],
+					x.get(), centroids [(size_t) igroup - 1]);
+		}
+		return;
+	}
+	const double numberOfProducts = 0.5 * data.nrow * numberOfGroups * data.ncol * (data.ncol + 1);
+	const integer numberOfBlocks = (data.nrow - 1) / NUMmahalanobisDistances_BLOCK_SIZE + 1;
+	const integer numberOfThreads = std::max (integer (1), std::min ({ Melder_ifloor (numberOfProducts / NUMmahalanobisDistances_MINIMUM_PRODUCTS_PER_THREAD),
+		numberOfBlocks, integer (MelderThread_getNumberOfProcessors ()) }));
+	std::vector <autoNUMmahalanobisDistances_Args> args ((size_t) numberOfThreads);
+	integer firstBlock = 1;
+	for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+		autoNUMmahalanobisDistances_Args arg = Thing_new (NUMmahalanobisDistances_Args);
+		arg -> data = data;
+		arg -> lowerInverses = & lowerInverses;
+		arg -> centroids = & centroids;
+		arg -> distances = out_distances;
+		arg -> differences = MATraw (NUMmahalanobisDistances_BLOCK_SIZE, data.ncol);
+		const integer lastBlock = ithread * numberOfBlocks / numberOfThreads;
+		arg -> firstRow = (firstBlock - 1) * NUMmahalanobisDistances_BLOCK_SIZE + 1;
+		arg -> lastRow = std::min (lastBlock * NUMmahalanobisDistances_BLOCK_SIZE, data.nrow);
+		firstBlock = lastBlock + 1;
+		args [(size_t) ithread - 1] = arg.move();
+	}
+	MelderThread_run (NUMmahalanobisDistances_block, args.data(), (int) numberOfThreads);
+}
+
 void NUMdominantEigenvector (constMAT m, VEC inout_q, double *out_lambda, double tolerance) {
 	Melder_assert (m.nrow == m.ncol && inout_q.size == m.nrow);
 
@@ -1477,12 +1578,20 @@ aa = & work [n+n+1];
 for (i=1; i<=n+n+n; i ++) work [i]=0;
 */
 double NUMburg_preallocated (VEC a, constVEC x) {
+	autoVEC workspace = VECraw (2 * x.size + a.size);
+	return NUMburg_preallocated (a, x, workspace.get());
+}
+
+double NUMburg_preallocated (VEC a, constVEC x, VEC workspace) {
 	integer n = x.size, m = a.size;
+	Melder_assert (workspace.size >= 2 * n + m);
 	for (integer j = 1; j <= m; j ++) {
 		a [j] = 0.0;
 	}
 
-	autoVEC b1 = VECzero (n), b2 = VECzero (n), aa = VECzero (m);
+	VEC b1 = workspace.part (1, n), b2 = workspace.part (n + 1, 2 * n);
+	VEC aa = ( m > 0 ? workspace.part (2 * n + 1, 2 * n + m) : VEC () );
+	VECset (workspace.part (1, 2 * n + m), 0.0);
 
 	// (3)
 
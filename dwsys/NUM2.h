@@ -433,6 +433,25 @@ double NUMmahalanobisDistance (constMAT lowerInverse, constVEC v, constVEC m);
 			(L**-1.(x-m))' . (L**-1.(x-m))
 */
 
+void NUMmahalanobisDistances (constMATVU const& data, const std::vector <constMAT>& lowerInverses, const std::vector <constVEC>& centroids,
+	MATVU const& out_distances);
+/*
+	The squared Mahalanobis distances of all the rows of data to all the centroids:
+	out_distances [irow] [igroup] = NUMmahalanobisDistance (lowerInverses [igroup - 1], data.row (irow), centroids [igroup - 1]).
+	The rows are processed in blocks, so that every row of a lower inverse is applied to all the rows of a block
+	while it is in the cache, and the blocks are distributed over threads.
+	A diagonal (one-row) lower inverse has nothing to reuse, so its distances are computed row by row.
+	Debug option 68 computes the distances one by one with NUMmahalanobisDistance, in a single thread.
+*/
+
+void NUMmahalanobisDistances_preallocated (constMATVU const& data, const std::vector <constMAT>& lowerInverses,
+	const std::vector <constVEC>& centroids, MATVU const& out_distances, MAT const& differences);
+/*
+	The same distances, in the calling thread, in blocks of differences.nrow rows;
+	differences (at least one row, data.ncol columns) is the caller's workspace.
+	Allocates nothing and does not throw, so that a thread can call it on its own part of the data.
+*/
+
 double NUMtrace (const constMATVU& a);
 double NUMtrace2 (const constMATVU& x, const constMATVU& y);
 double NUMtrace2_nn (const constMAT& x, const constMAT& y);
@@ -832,6 +851,10 @@ double NUMburg_preallocated (VEC a, constVEC x);
 	Spectrum Analysis, IEEE Press, 1978, 252-255.
 	Returns the sum of squared sample values or 0.0 if failure
 */
+double NUMburg_preallocated (VEC a, constVEC x, VEC workspace);
+/*
+	The same, without allocating: workspace should have at least 2 * x.size + a.size elements.
+*/
 
 autoVEC NUMburg (constVEC x, integer numberOfPredictionCoefficients, double *out_xms);
 
@@ -998,6 +1021,8 @@ struct structNUMfft_Table
   integer n;
   autoVEC trigcache;
   autoINTVEC splitcache;
+  bool isVectorised;   // n is a power of two (at least 128): use the engine in NUMfft_simd.h
+  autoVEC stageTwiddles, realTwiddles;   // only if isVectorised
 };
 
 typedef struct structNUMfft_Table *NUMfft_Table;
@@ -1005,11 +1030,23 @@ typedef struct structNUMfft_Table *NUMfft_Table;
 void NUMfft_Table_init (NUMfft_Table table, integer n);
 /*
 	n : data size
+	After initialisation the table is read-only for NUMfft_forward and NUMfft_backward,
+	so that one table can be used by several threads simultaneously.
+*/
+
+NUMfft_Table NUMfft_getSharedTable (integer n);
+/*
+	Returns a process-wide table for data size n, initialised on first use; thread-safe.
+	Tables for sizes up to 65536 are kept for the lifetime of the program;
+	the caller should not modify or free the table.
+	For larger sizes, planning is cheap compared to the transform itself,
+	so use NUMfft_Table_init on a local autoNUMfft_Table instead.
 */
 
 struct autoNUMfft_Table : public structNUMfft_Table {
 	autoNUMfft_Table () throw () {
 		n = 0;
+		isVectorised = false;
 	}
 	~autoNUMfft_Table () { }
 };
@@ -1089,6 +1126,36 @@ void NUMfft_backward (NUMfft_Table table, VEC data);
 	sequence by n.
 */
 
+void NUMfft_forward_batch (NUMfft_Table table, MAT frames);
+void NUMfft_backward_batch (NUMfft_Table table, MAT frames);
+/*
+	Function:
+		Transforms every row of `frames` in place, exactly as NUMfft_forward or NUMfft_backward would.
+	Preconditions:
+		frames.ncol == table -> n
+	Remarks:
+		The rows share the table and the workspace, which stay in the cache from one row to the next.
+		Like NUMfft_forward and NUMfft_backward, these functions can be called from several threads at once,
+		though threads had better use the versions with a workspace below.
+		(Interleaving several rows for the vector engine was tried and was slower, because it multiplies the working set.)
+*/
+
+integer NUMfft_getWorkspaceSize (integer n);
+void NUMfft_forward (NUMfft_Table table, VEC data, VEC workspace);
+void NUMfft_backward (NUMfft_Table table, VEC data, VEC workspace);
+void NUMfft_forward_batch (NUMfft_Table table, MAT frames, VEC workspace);
+void NUMfft_backward_batch (NUMfft_Table table, MAT frames, VEC workspace);
+/*
+	Function:
+		As above, but with a workspace supplied by the caller, so that the transforms allocate nothing.
+	Preconditions:
+		workspace.size >= NUMfft_getWorkspaceSize (table -> n)
+	Remarks:
+		Threaded callers allocate one workspace per thread in the main thread and hand it to the worker;
+		the versions without a workspace use a workspace per thread that grows on demand,
+		and are meant for serial callers.
+*/
+
 /**** Compatibility with NR fft's */
 
 void NUMforwardRealFastFourierTransform (VEC data);
@@ -21,16 +21,82 @@
 	djmw 20110308 struct renaming
  */
 
+#include <map>
+#include <memory>
 #include "NUM2.h"
 #include "melder.h"
+#include "MelderThread.h"
 
 #define FFT_DATA_TYPE double
 #include "NUMfft_core.h"
+#include "NUMfft_simd.h"
+
+#define NUMfft_MAXIMUM_SHARED_SIZE  65536
+
+/*
+	Workspace for one transform: n doubles for FFTPACK, 2n for the vectorised engine.
+	For the versions without a workspace argument, which are meant for serial callers,
+	each thread keeps its own workspace for sizes that could be shared, so that tables stay read-only.
+*/
+integer NUMfft_getWorkspaceSize (integer n) {
+	return 2 * n;
+}
+
+static double *NUMfft_getWorkspace (integer size, autoVEC *largeWorkspace) {
+	static thread_local autoVEC workspace;
+	if (size > 2 * NUMfft_MAXIMUM_SHARED_SIZE) {
+		*largeWorkspace = VECraw (size);
+		return largeWorkspace -> begin();
+	}
+	if (workspace.size < size)
+		workspace = VECraw (size);
+	return workspace.begin();
+}
+
+MelderThread_MUTEX (sharedTablesMutex);
+
+NUMfft_Table NUMfft_getSharedTable (integer n) {
+	static std::map <integer, std::unique_ptr <autoNUMfft_Table>> sharedTables;
+	Melder_assert (n >= 1 && n <= NUMfft_MAXIMUM_SHARED_SIZE);
+	MelderThread_LOCK (sharedTablesMutex);
+	try {
+		std::unique_ptr <autoNUMfft_Table> & table = sharedTables [n];
+		if (! table) {
+			std::unique_ptr <autoNUMfft_Table> newTable (new autoNUMfft_Table);
+			NUMfft_Table_init (newTable.get(), n);
+			table = std::move (newTable);
+		}
+		NUMfft_Table result = table.get();
+		MelderThread_UNLOCK (sharedTablesMutex);
+		return result;
+	} catch (MelderError) {
+		MelderThread_UNLOCK (sharedTablesMutex);
+		throw;
+	}
+}
+
+static void NUMfft_forward_shared (VEC data) {
+	if (data.size <= NUMfft_MAXIMUM_SHARED_SIZE) {
+		NUMfft_forward (NUMfft_getSharedTable (data.size), data);
+	} else {
+		autoNUMfft_Table table;
+		NUMfft_Table_init (& table, data.size);
+		NUMfft_forward (& table, data);
+	}
+}
+
+static void NUMfft_backward_shared (VEC data) {
+	if (data.size <= NUMfft_MAXIMUM_SHARED_SIZE) {
+		NUMfft_backward (NUMfft_getSharedTable (data.size), data);
+	} else {
+		autoNUMfft_Table table;
+		NUMfft_Table_init (& table, data.size);
+		NUMfft_backward (& table, data);
+	}
+}
 
 void NUMforwardRealFastFourierTransform (VEC data) {
-	autoNUMfft_Table table;
-	NUMfft_Table_init (& table, data.size);
-	NUMfft_forward (& table, data);
+	NUMfft_forward_shared (data);
 
 	if (data.size > 1) {
 		// To be compatible with old behaviour
@@ -43,8 +109,6 @@ void NUMforwardRealFastFourierTransform (VEC data) {
 }
 
 void NUMreverseRealFastFourierTransform (VEC data) {
-	autoNUMfft_Table table;
-
 	if (data.size > 1) {
 		// To be compatible with old behaviour
 		double tmp = data [2];
@@ -54,8 +118,24 @@ void NUMreverseRealFastFourierTransform (VEC data) {
 		data [data.size] = tmp;
 	}
 
-	NUMfft_Table_init (& table, data.size);
-	NUMfft_backward (& table, data);
+	NUMfft_backward_shared (data);
+}
+
+/*
+	Melder_debug 52 switches the vectorised engine off, for comparison with the FFTPACK kernels.
+*/
+static void NUMfft_forward_ (NUMfft_Table me, VEC data, double *workspace) {
+	if (my isVectorised && Melder_debug != 52)
+		NUMfft_simd_forward (my n, data.begin(), my stageTwiddles.begin(), my realTwiddles.begin(), workspace);
+	else
+		drftf1 (my n, data.begin(), workspace, my trigcache.begin() + my n, my splitcache.begin());
+}
+
+static void NUMfft_backward_ (NUMfft_Table me, VEC data, double *workspace) {
+	if (my isVectorised && Melder_debug != 52)
+		NUMfft_simd_backward (my n, data.begin(), my stageTwiddles.begin(), my realTwiddles.begin(), workspace);
+	else
+		drftb1 (my n, data.begin(), workspace, my trigcache.begin() + my n, my splitcache.begin());
 }
 
 void NUMfft_forward (NUMfft_Table me, VEC data) {
@@ -63,7 +143,8 @@ void NUMfft_forward (NUMfft_Table me, VEC data) {
 		return;
 	}
 	Melder_assert (my n == data.size);
-	drftf1 (my n, data.begin(), my trigcache.begin(), my trigcache.begin() + my n, my splitcache.begin());
+	autoVEC largeWorkspace;
+	NUMfft_forward_ (me, data, NUMfft_getWorkspace (NUMfft_getWorkspaceSize (my n), & largeWorkspace));
 }
 
 void NUMfft_backward (NUMfft_Table me, VEC data) {
@@ -71,7 +152,50 @@ void NUMfft_backward (NUMfft_Table me, VEC data) {
 		return;
 	}
 	Melder_assert (my n == data.size);
-	drftb1 (my n, data.begin(), my trigcache.begin(), my trigcache.begin() + my n, my splitcache.begin());
+	autoVEC largeWorkspace;
+	NUMfft_backward_ (me, data, NUMfft_getWorkspace (NUMfft_getWorkspaceSize (my n), & largeWorkspace));
+}
+
+void NUMfft_forward (NUMfft_Table me, VEC data, VEC workspace) {
+	if (my n == 1) {
+		return;
+	}
+	Melder_assert (my n == data.size);
+	Melder_assert (workspace.size >= NUMfft_getWorkspaceSize (my n));
+	NUMfft_forward_ (me, data, workspace.begin());
+}
+
+void NUMfft_backward (NUMfft_Table me, VEC data, VEC workspace) {
+	if (my n == 1) {
+		return;
+	}
+	Melder_assert (my n == data.size);
+	Melder_assert (workspace.size >= NUMfft_getWorkspaceSize (my n));
+	NUMfft_backward_ (me, data, workspace.begin());
+}
+
+void NUMfft_forward_batch (NUMfft_Table me, MAT frames) {
+	Melder_assert (frames.nrow == 0 || frames.ncol == my n);
+	for (integer irow = 1; irow <= frames.nrow; irow ++)
+		NUMfft_forward (me, frames [irow]);
+}
+
+void NUMfft_backward_batch (NUMfft_Table me, MAT frames) {
+	Melder_assert (frames.nrow == 0 || frames.ncol == my n);
+	for (integer irow = 1; irow <= frames.nrow; irow ++)
+		NUMfft_backward (me, frames [irow]);
+}
+
+void NUMfft_forward_batch (NUMfft_Table me, MAT frames, VEC workspace) {
+	Melder_assert (frames.nrow == 0 || frames.ncol == my n);
+	for (integer irow = 1; irow <= frames.nrow; irow ++)
+		NUMfft_forward (me, frames [irow], workspace);
+}
+
+void NUMfft_backward_batch (NUMfft_Table me, MAT frames, VEC workspace) {
+	Melder_assert (frames.nrow == 0 || frames.ncol == my n);
+	for (integer irow = 1; irow <= frames.nrow; irow ++)
+		NUMfft_backward (me, frames [irow], workspace);
 }
 
 void NUMfft_Table_init (NUMfft_Table me, integer n) {
@@ -79,6 +203,12 @@ void NUMfft_Table_init (NUMfft_Table me, integer n) {
 	my trigcache = VECzero (3 * n);
 	my splitcache = INTVECzero (32);
 	NUMrffti (n, my trigcache.begin(), my splitcache.begin());
+	my isVectorised = NUMfft_simd_isApplicable (n);
+	if (my isVectorised) {
+		my stageTwiddles = VECraw (n - 2);
+		my realTwiddles = VECraw (n);
+		NUMfft_simd_initTwiddles (n, my stageTwiddles.begin(), my realTwiddles.begin());
+	}
 }
 
 void NUMrealft (VEC data, int isign) {
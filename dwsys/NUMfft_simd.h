@@ -0,0 +1,396 @@
+/* NUMfft_simd.h
+ *
+ * Copyright (C) 2026 Praat developers
+ *
+ * This code is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this work. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+	Vectorised real FFT for sizes that are powers of two (n >= 128; below that, FFTPACK is as fast).
+
+	A real sequence x [0..n-1] is transformed as the complex sequence z [j] = x [2j] + i x [2j+1]
+	of size m = n/2, followed by an O(n) untangling step that produces the spectrum in FFTPACK order,
+	so that the results can stand in for those of drftf1 and drftb1.
+
+	The complex transform is a radix-4 Stockham autosort in split format (separate arrays for the
+	real and imaginary parts), which makes every butterfly stage a set of contiguous loads and stores.
+	Stages are run with AVX2 (4 doubles) if the processor has it, else with SSE2 (2 doubles),
+	else with scalar code. All three paths perform the same operations in the same order
+	(no fused multiply-add), so the results are bit-identical on all machines.
+
+	Only to be included by NUMfft_d.cpp.
+*/
+
+#if defined (__GNUC__) && (defined (__x86_64__) || (defined (__i386__) && defined (__SSE2__)))
+	#define NUMfft_USE_SSE2  1
+	#define NUMfft_USE_AVX2  1
+	#include <immintrin.h>
+#else
+	#define NUMfft_USE_SSE2  0
+	#define NUMfft_USE_AVX2  0
+#endif
+
+static bool NUMfft_simd_isApplicable (integer n) {
+	if (n < 128)
+		return false;
+	return (n & (n - 1)) == 0;
+}
+
+static bool NUMfft_simd_hasAVX2 () {
+	#if NUMfft_USE_AVX2
+		static const bool hasAVX2 = __builtin_cpu_supports ("avx2");
+		return hasAVX2;
+	#else
+		return false;
+	#endif
+}
+
+/*
+	For the complex transform of size m, radix-4 stage by stage (length = m, m/4, m/16, ... while length >= 4),
+	the `quarter` = length/4 twiddle factors w^p, w^2p and w^3p with w = e^{-2 pi i / length}:
+	six arrays of size `quarter`, namely the real and imaginary parts of w^p, w^2p, w^3p.
+	If m is not a power of four, a final radix-2 stage needs no twiddle factors.
+	For the untangling step, cos (2 pi k / n) and sin (2 pi k / n) for k = 0 .. m-1.
+	Sizes: at most n - 2 and n.
+*/
+static void NUMfft_simd_initTwiddles (integer n, double *stageTwiddles, double *realTwiddles) {
+	const double twoPi = 6.28318530717958647692528676655900577;
+	const integer m = n / 2;
+	double *w = stageTwiddles;
+	for (integer length = m; length >= 4; length /= 4) {
+		const integer quarter = length / 4;
+		for (integer p = 0; p < quarter; p ++) {
+			for (integer power = 1; power <= 3; power ++) {
+				const double phi = twoPi * (double) (power * p) / (double) length;
+				w [(2 * power - 2) * quarter + p] = cos (phi);
+				w [(2 * power - 1) * quarter + p] = - sin (phi);
+			}
+		}
+		w += 6 * quarter;
+	}
+	for (integer k = 0; k < m; k ++) {
+		const double phi = twoPi * (double) k / (double) n;
+		realTwiddles [k] = cos (phi);
+		realTwiddles [m + k] = sin (phi);
+	}
+}
+
+/*
+	One radix-4 Stockham stage: for 0 <= p < quarter and 0 <= q < s (with s * quarter = m / 4),
+	with a_j = x [q + s * (p + j quarter)],
+		b0 = a0 + a2, b1 = a0 - a2, b2 = a1 + a3, b3 = -i (a1 - a3),
+		y [q + s * 4p]       = b0 + b2
+		y [q + s * (4p + 1)] = (b1 + b3) w^p
+		y [q + s * (4p + 2)] = (b0 - b2) w^2p
+		y [q + s * (4p + 3)] = (b1 - b3) w^3p
+*/
+static void NUMfft_simd_stage4_scalar (integer quarter, integer s,
+	const double *xr, const double *xi, double *yr, double *yi, const double *w)
+{
+	const integer offset = s * quarter;
+	for (integer p = 0; p < quarter; p ++) {
+		const double w1r = w [p], w1i = w [quarter + p];
+		const double w2r = w [2 * quarter + p], w2i = w [3 * quarter + p];
+		const double w3r = w [4 * quarter + p], w3i = w [5 * quarter + p];
+		const double *x0r = xr + s * p, *x0i = xi + s * p;
+		double *y0r = yr + s * 4 * p, *y0i = yi + s * 4 * p;
+		for (integer q = 0; q < s; q ++) {
+			const double a0r = x0r [q], a0i = x0i [q];
+			const double a1r = x0r [q + offset], a1i = x0i [q + offset];
+			const double a2r = x0r [q + 2 * offset], a2i = x0i [q + 2 * offset];
+			const double a3r = x0r [q + 3 * offset], a3i = x0i [q + 3 * offset];
+			const double b0r = a0r + a2r, b0i = a0i + a2i, b1r = a0r - a2r, b1i = a0i - a2i;
+			const double b2r = a1r + a3r, b2i = a1i + a3i, b3r = a1i - a3i, b3i = a3r - a1r;
+			y0r [q] = b0r + b2r;
+			y0i [q] = b0i + b2i;
+			const double c1r = b1r + b3r, c1i = b1i + b3i;
+			y0r [q + s] = c1r * w1r - c1i * w1i;
+			y0i [q + s] = c1r * w1i + c1i * w1r;
+			const double c2r = b0r - b2r, c2i = b0i - b2i;
+			y0r [q + 2 * s] = c2r * w2r - c2i * w2i;
+			y0i [q + 2 * s] = c2r * w2i + c2i * w2r;
+			const double c3r = b1r - b3r, c3i = b1i - b3i;
+			y0r [q + 3 * s] = c3r * w3r - c3i * w3i;
+			y0i [q + 3 * s] = c3r * w3i + c3i * w3r;
+		}
+	}
+}
+
+/*
+	The final radix-2 stage, if m is not a power of four: length 2, s = m / 2, no twiddles.
+*/
+#if ! NUMfft_USE_SSE2
+static void NUMfft_simd_stage2_scalar (integer s, const double *xr, const double *xi, double *yr, double *yi) {
+	for (integer q = 0; q < s; q ++) {
+		const double ar = xr [q], ai = xi [q], br = xr [q + s], bi = xi [q + s];
+		yr [q] = ar + br;
+		yi [q] = ai + bi;
+		yr [q + s] = ar - br;
+		yi [q + s] = ai - bi;
+	}
+}
+#endif
+
+#if NUMfft_USE_SSE2
+#define NUMfft_SSE2_BUTTERFLY4 \
+	const __m128d b0r = _mm_add_pd (a0r, a2r), b0i = _mm_add_pd (a0i, a2i); \
+	const __m128d b1r = _mm_sub_pd (a0r, a2r), b1i = _mm_sub_pd (a0i, a2i); \
+	const __m128d b2r = _mm_add_pd (a1r, a3r), b2i = _mm_add_pd (a1i, a3i); \
+	const __m128d b3r = _mm_sub_pd (a1i, a3i), b3i = _mm_sub_pd (a3r, a1r); \
+	const __m128d o0r = _mm_add_pd (b0r, b2r), o0i = _mm_add_pd (b0i, b2i); \
+	const __m128d c1r = _mm_add_pd (b1r, b3r), c1i = _mm_add_pd (b1i, b3i); \
+	const __m128d o1r = _mm_sub_pd (_mm_mul_pd (c1r, w1r), _mm_mul_pd (c1i, w1i)); \
+	const __m128d o1i = _mm_add_pd (_mm_mul_pd (c1r, w1i), _mm_mul_pd (c1i, w1r)); \
+	const __m128d c2r = _mm_sub_pd (b0r, b2r), c2i = _mm_sub_pd (b0i, b2i); \
+	const __m128d o2r = _mm_sub_pd (_mm_mul_pd (c2r, w2r), _mm_mul_pd (c2i, w2i)); \
+	const __m128d o2i = _mm_add_pd (_mm_mul_pd (c2r, w2i), _mm_mul_pd (c2i, w2r)); \
+	const __m128d c3r = _mm_sub_pd (b1r, b3r), c3i = _mm_sub_pd (b1i, b3i); \
+	const __m128d o3r = _mm_sub_pd (_mm_mul_pd (c3r, w3r), _mm_mul_pd (c3i, w3i)); \
+	const __m128d o3i = _mm_add_pd (_mm_mul_pd (c3r, w3i), _mm_mul_pd (c3i, w3r));
+
+/*
+	The first stage (s = 1) is vectorised over p, with a 2 x 2 transposition on output;
+	the other stages are vectorised over q.
+*/
+static void NUMfft_simd_stage4_sse2 (integer quarter, integer s,
+	const double *xr, const double *xi, double *yr, double *yi, const double *w)
+{
+	const integer offset = s * quarter;
+	if (s == 1) {
+		if (quarter < 2) {
+			NUMfft_simd_stage4_scalar (quarter, s, xr, xi, yr, yi, w);
+			return;
+		}
+		for (integer p = 0; p < quarter; p += 2) {
+			const __m128d w1r = _mm_loadu_pd (w + p), w1i = _mm_loadu_pd (w + quarter + p);
+			const __m128d w2r = _mm_loadu_pd (w + 2 * quarter + p), w2i = _mm_loadu_pd (w + 3 * quarter + p);
+			const __m128d w3r = _mm_loadu_pd (w + 4 * quarter + p), w3i = _mm_loadu_pd (w + 5 * quarter + p);
+			const __m128d a0r = _mm_loadu_pd (xr + p), a0i = _mm_loadu_pd (xi + p);
+			const __m128d a1r = _mm_loadu_pd (xr + p + offset), a1i = _mm_loadu_pd (xi + p + offset);
+			const __m128d a2r = _mm_loadu_pd (xr + p + 2 * offset), a2i = _mm_loadu_pd (xi + p + 2 * offset);
+			const __m128d a3r = _mm_loadu_pd (xr + p + 3 * offset), a3i = _mm_loadu_pd (xi + p + 3 * offset);
+			NUMfft_SSE2_BUTTERFLY4
+			double *y0r = yr + 4 * p, *y0i = yi + 4 * p;
+			_mm_storeu_pd (y0r, _mm_unpacklo_pd (o0r, o1r));
+			_mm_storeu_pd (y0r + 2, _mm_unpacklo_pd (o2r, o3r));
+			_mm_storeu_pd (y0r + 4, _mm_unpackhi_pd (o0r, o1r));
+			_mm_storeu_pd (y0r + 6, _mm_unpackhi_pd (o2r, o3r));
+			_mm_storeu_pd (y0i, _mm_unpacklo_pd (o0i, o1i));
+			_mm_storeu_pd (y0i + 2, _mm_unpacklo_pd (o2i, o3i));
+			_mm_storeu_pd (y0i + 4, _mm_unpackhi_pd (o0i, o1i));
+			_mm_storeu_pd (y0i + 6, _mm_unpackhi_pd (o2i, o3i));
+		}
+		return;
+	}
+	for (integer p = 0; p < quarter; p ++) {
+		const __m128d w1r = _mm_set1_pd (w [p]), w1i = _mm_set1_pd (w [quarter + p]);
+		const __m128d w2r = _mm_set1_pd (w [2 * quarter + p]), w2i = _mm_set1_pd (w [3 * quarter + p]);
+		const __m128d w3r = _mm_set1_pd (w [4 * quarter + p]), w3i = _mm_set1_pd (w [5 * quarter + p]);
+		const double *x0r = xr + s * p, *x0i = xi + s * p;
+		double *y0r = yr + s * 4 * p, *y0i = yi + s * 4 * p;
+		for (integer q = 0; q < s; q += 2) {
+			const __m128d a0r = _mm_loadu_pd (x0r + q), a0i = _mm_loadu_pd (x0i + q);
+			const __m128d a1r = _mm_loadu_pd (x0r + q + offset), a1i = _mm_loadu_pd (x0i + q + offset);
+			const __m128d a2r = _mm_loadu_pd (x0r + q + 2 * offset), a2i = _mm_loadu_pd (x0i + q + 2 * offset);
+			const __m128d a3r = _mm_loadu_pd (x0r + q + 3 * offset), a3i = _mm_loadu_pd (x0i + q + 3 * offset);
+			NUMfft_SSE2_BUTTERFLY4
+			_mm_storeu_pd (y0r + q, o0r);
+			_mm_storeu_pd (y0i + q, o0i);
+			_mm_storeu_pd (y0r + q + s, o1r);
+			_mm_storeu_pd (y0i + q + s, o1i);
+			_mm_storeu_pd (y0r + q + 2 * s, o2r);
+			_mm_storeu_pd (y0i + q + 2 * s, o2i);
+			_mm_storeu_pd (y0r + q + 3 * s, o3r);
+			_mm_storeu_pd (y0i + q + 3 * s, o3i);
+		}
+	}
+}
+
+static void NUMfft_simd_stage2_sse2 (integer s, const double *xr, const double *xi, double *yr, double *yi) {
+	for (integer q = 0; q < s; q += 2) {
+		const __m128d ar = _mm_loadu_pd (xr + q), ai = _mm_loadu_pd (xi + q);
+		const __m128d br = _mm_loadu_pd (xr + q + s), bi = _mm_loadu_pd (xi + q + s);
+		_mm_storeu_pd (yr + q, _mm_add_pd (ar, br));
+		_mm_storeu_pd (yi + q, _mm_add_pd (ai, bi));
+		_mm_storeu_pd (yr + q + s, _mm_sub_pd (ar, br));
+		_mm_storeu_pd (yi + q + s, _mm_sub_pd (ai, bi));
+	}
+}
+#endif
+
+#if NUMfft_USE_AVX2
+__attribute__ ((target ("avx2")))
+static void NUMfft_simd_stage4_avx2 (integer quarter, integer s,
+	const double *xr, const double *xi, double *yr, double *yi, const double *w)
+{
+	if (s < 4) {
+		NUMfft_simd_stage4_sse2 (quarter, s, xr, xi, yr, yi, w);
+		return;
+	}
+	const integer offset = s * quarter;
+	for (integer p = 0; p < quarter; p ++) {
+		const __m256d w1r = _mm256_set1_pd (w [p]), w1i = _mm256_set1_pd (w [quarter + p]);
+		const __m256d w2r = _mm256_set1_pd (w [2 * quarter + p]), w2i = _mm256_set1_pd (w [3 * quarter + p]);
+		const __m256d w3r = _mm256_set1_pd (w [4 * quarter + p]), w3i = _mm256_set1_pd (w [5 * quarter + p]);
+		const double *x0r = xr + s * p, *x0i = xi + s * p;
+		double *y0r = yr + s * 4 * p, *y0i = yi + s * 4 * p;
+		for (integer q = 0; q < s; q += 4) {
+			const __m256d a0r = _mm256_loadu_pd (x0r + q), a0i = _mm256_loadu_pd (x0i + q);
+			const __m256d a1r = _mm256_loadu_pd (x0r + q + offset), a1i = _mm256_loadu_pd (x0i + q + offset);
+			const __m256d a2r = _mm256_loadu_pd (x0r + q + 2 * offset), a2i = _mm256_loadu_pd (x0i + q + 2 * offset);
+			const __m256d a3r = _mm256_loadu_pd (x0r + q + 3 * offset), a3i = _mm256_loadu_pd (x0i + q + 3 * offset);
+			const __m256d b0r = _mm256_add_pd (a0r, a2r), b0i = _mm256_add_pd (a0i, a2i);
+			const __m256d b1r = _mm256_sub_pd (a0r, a2r), b1i = _mm256_sub_pd (a0i, a2i);
+			const __m256d b2r = _mm256_add_pd (a1r, a3r), b2i = _mm256_add_pd (a1i, a3i);
+			const __m256d b3r = _mm256_sub_pd (a1i, a3i), b3i = _mm256_sub_pd (a3r, a1r);
+			_mm256_storeu_pd (y0r + q, _mm256_add_pd (b0r, b2r));
+			_mm256_storeu_pd (y0i + q, _mm256_add_pd (b0i, b2i));
+			const __m256d c1r = _mm256_add_pd (b1r, b3r), c1i = _mm256_add_pd (b1i, b3i);
+			_mm256_storeu_pd (y0r + q + s, _mm256_sub_pd (_mm256_mul_pd (c1r, w1r), _mm256_mul_pd (c1i, w1i)));
+			_mm256_storeu_pd (y0i + q + s, _mm256_add_pd (_mm256_mul_pd (c1r, w1i), _mm256_mul_pd (c1i, w1r)));
+			const __m256d c2r = _mm256_sub_pd (b0r, b2r), c2i = _mm256_sub_pd (b0i, b2i);
+			_mm256_storeu_pd (y0r + q + 2 * s, _mm256_sub_pd (_mm256_mul_pd (c2r, w2r), _mm256_mul_pd (c2i, w2i)));
+			_mm256_storeu_pd (y0i + q + 2 * s, _mm256_add_pd (_mm256_mul_pd (c2r, w2i), _mm256_mul_pd (c2i, w2r)));
+			const __m256d c3r = _mm256_sub_pd (b1r, b3r), c3i = _mm256_sub_pd (b1i, b3i);
+			_mm256_storeu_pd (y0r + q + 3 * s, _mm256_sub_pd (_mm256_mul_pd (c3r, w3r), _mm256_mul_pd (c3i, w3i)));
+			_mm256_storeu_pd (y0i + q + 3 * s, _mm256_add_pd (_mm256_mul_pd (c3r, w3i), _mm256_mul_pd (c3i, w3r)));
+		}
+	}
+	_mm256_zeroupper ();   // otherwise the non-AVX code that follows runs several times slower
+}
+
+__attribute__ ((target ("avx2")))
+static void NUMfft_simd_stage2_avx2 (integer s, const double *xr, const double *xi, double *yr, double *yi) {
+	if (s < 4) {
+		NUMfft_simd_stage2_sse2 (s, xr, xi, yr, yi);
+		return;
+	}
+	for (integer q = 0; q < s; q += 4) {
+		const __m256d ar = _mm256_loadu_pd (xr + q), ai = _mm256_loadu_pd (xi + q);
+		const __m256d br = _mm256_loadu_pd (xr + q + s), bi = _mm256_loadu_pd (xi + q + s);
+		_mm256_storeu_pd (yr + q, _mm256_add_pd (ar, br));
+		_mm256_storeu_pd (yi + q, _mm256_add_pd (ai, bi));
+		_mm256_storeu_pd (yr + q + s, _mm256_sub_pd (ar, br));
+		_mm256_storeu_pd (yi + q + s, _mm256_sub_pd (ai, bi));
+	}
+	_mm256_zeroupper ();
+}
+#endif
+
+/*
+	Forward complex transform of size m (a power of two, at least 4) of (xr, xi), in place;
+	(yr, yi) is workspace of size m.
+	The inverse transform is obtained by swapping the real and imaginary arrays.
+*/
+static void NUMfft_simd_complexForward (integer m, double *xr, double *xi, double *yr, double *yi, const double *stageTwiddles) {
+	const bool useAVX2 = NUMfft_simd_hasAVX2 ();
+	(void) useAVX2;
+	double *ar = xr, *ai = xi, *br = yr, *bi = yi;
+	const double *w = stageTwiddles;
+	integer s = 1, length = m;
+	for (; length >= 4; length /= 4) {
+		const integer quarter = length / 4;
+		#if NUMfft_USE_AVX2
+			if (useAVX2)
+				NUMfft_simd_stage4_avx2 (quarter, s, ar, ai, br, bi, w);
+			else
+				NUMfft_simd_stage4_sse2 (quarter, s, ar, ai, br, bi, w);
+		#elif NUMfft_USE_SSE2
+			NUMfft_simd_stage4_sse2 (quarter, s, ar, ai, br, bi, w);
+		#else
+			NUMfft_simd_stage4_scalar (quarter, s, ar, ai, br, bi, w);
+		#endif
+		std::swap (ar, br);
+		std::swap (ai, bi);
+		w += 6 * quarter;
+		s *= 4;
+	}
+	if (length == 2) {
+		#if NUMfft_USE_AVX2
+			if (useAVX2)
+				NUMfft_simd_stage2_avx2 (s, ar, ai, br, bi);
+			else
+				NUMfft_simd_stage2_sse2 (s, ar, ai, br, bi);
+		#elif NUMfft_USE_SSE2
+			NUMfft_simd_stage2_sse2 (s, ar, ai, br, bi);
+		#else
+			NUMfft_simd_stage2_scalar (s, ar, ai, br, bi);
+		#endif
+		std::swap (ar, br);
+		std::swap (ai, bi);
+	}
+	if (ar != xr) {
+		memcpy (xr, ar, (size_t) m * sizeof (double));
+		memcpy (xi, ai, (size_t) m * sizeof (double));
+	}
+}
+
+/*
+	x [0..n-1] in, FFTPACK-ordered spectrum out (as drftf1).
+	workspace: 2n doubles.
+*/
+static void NUMfft_simd_forward (integer n, double *x, const double *stageTwiddles, const double *realTwiddles, double *workspace) {
+	const integer m = n / 2;
+	double *zr = workspace, *zi = workspace + m, *yr = workspace + 2 * m, *yi = workspace + 3 * m;
+	for (integer j = 0; j < m; j ++) {
+		zr [j] = x [2 * j];
+		zi [j] = x [2 * j + 1];
+	}
+	NUMfft_simd_complexForward (m, zr, zi, yr, yi, stageTwiddles);
+	const double *cosine = realTwiddles, *sine = realTwiddles + m;
+	x [0] = zr [0] + zi [0];
+	x [n - 1] = zr [0] - zi [0];
+	for (integer k = 1; k < m; k ++) {
+		/*
+			E = (Z [k] + conj Z [m-k]) / 2, O = (Z [k] - conj Z [m-k]) / 2i, X [k] = E + e^{-2 pi i k / n} O
+		*/
+		const double er = 0.5 * (zr [k] + zr [m - k]), ei = 0.5 * (zi [k] - zi [m - k]);
+		const double orr = 0.5 * (zi [k] + zi [m - k]), oi = - 0.5 * (zr [k] - zr [m - k]);
+		const double c = cosine [k], s = sine [k];
+		x [2 * k - 1] = er + c * orr + s * oi;
+		x [2 * k] = ei + c * oi - s * orr;
+	}
+}
+
+/*
+	FFTPACK-ordered spectrum in, unnormalized real sequence out (as drftb1).
+	workspace: 2n doubles.
+*/
+static void NUMfft_simd_backward (integer n, double *x, const double *stageTwiddles, const double *realTwiddles, double *workspace) {
+	const integer m = n / 2;
+	double *zr = workspace, *zi = workspace + m, *yr = workspace + 2 * m, *yi = workspace + 3 * m;
+	const double *cosine = realTwiddles, *sine = realTwiddles + m;
+	zr [0] = x [0] + x [n - 1];
+	zi [0] = x [0] - x [n - 1];
+	for (integer k = 1; k < m; k ++) {
+		/*
+			Z [k] = (X [k] + conj X [m-k]) + i e^{2 pi i k / n} (X [k] - conj X [m-k])
+		*/
+		const double ar = x [2 * k - 1], ai = x [2 * k];
+		const double br = x [2 * (m - k) - 1], bi = x [2 * (m - k)];
+		const double fer = ar + br, fei = ai - bi;
+		const double dr = ar - br, di = ai + bi;
+		const double c = cosine [k], s = sine [k];
+		const double forr = dr * c - di * s, foi = dr * s + di * c;
+		zr [k] = fer - foi;
+		zi [k] = fei + forr;
+	}
+	NUMfft_simd_complexForward (m, zi, zr, yi, yr, stageTwiddles);   // inverse, by swapping real and imaginary parts
+	for (integer j = 0; j < m; j ++) {
+		x [2 * j] = zr [j];
+		x [2 * j + 1] = zi [j];
+	}
+}
+
+/* End of file NUMfft_simd.h */
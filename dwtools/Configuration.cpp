@@ -400,7 +400,7 @@ autoConfiguration TableOfReal_to_Configuration_pca (TableOfReal me, integer numb
 	try {
 		if (numberOfDimensions < 1 || numberOfDimensions > my numberOfColumns)
 			numberOfDimensions = my numberOfColumns;
-		autoPCA pca = TableOfReal_to_PCA_byRows (me);
+		autoPCA pca = TableOfReal_to_PCA_byRows (me, kPCA_method::Svd, 0);
 		autoConfiguration thee = PCA_TableOfReal_to_Configuration (pca.get(), me, numberOfDimensions);
 		return thee;
 	} catch (MelderError) {
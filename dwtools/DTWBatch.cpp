@@ -0,0 +1,554 @@
+/* DTWBatch.cpp
+ *
+ * Copyright (C) 2026 Praat developers
+ *
+ * This code is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this work. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DTWBatch.h"
+#include "Sound_to_MFCC.h"
+#include "MelderThread.h"
+#include <algorithm>
+
+Thing_implement (DTWBatch, Thing, 0);
+
+autoDTWBatch DTWBatch_create (autoMAT query, double voicingCosts) {
+	try {
+		Melder_require (query.nrow > 0,
+			U"The query should have frames.");
+		autoDTWBatch me = Thing_new (DTWBatch);
+		my query = query.move();
+		my voicingCosts = voicingCosts;
+		return me;
+	} catch (MelderError) {
+		Melder_throw (U"DTWBatch not created.");
+	}
+}
+
+void DTWBatch_addReference (DTWBatch me, autoMAT features, double timeStep, conststring32 name) {
+	try {
+		Melder_require (features.nrow > 0,
+			U"The reference ", name, U" should have frames.");
+		Melder_require (features.ncol == my query.ncol,
+			U"The reference ", name, U" should have as many features as the query.");
+		my references. push_back (features.move());
+		my referenceTimeSteps. push_back (timeStep);
+		my referenceNames. push_back (Melder_dup (name));
+	} catch (MelderError) {
+		Melder_throw (me, U": reference not added.");
+	}
+}
+
+inline static double DTWBatch_getLocalDistance (DTWBatch me, const double *x, const double *y, integer numberOfFeatures) {
+	double sum = 0.0;
+	integer first = 1;
+	if (isdefined (my voicingCosts)) {
+		const double difference = ( isundef (x [1]) ? ( isundef (y [1]) ? 0.0 : my voicingCosts ) :
+			isundef (y [1]) ? my voicingCosts : x [1] - y [1] );
+		sum = difference * difference;
+		first = 2;
+	}
+	for (integer k = first; k <= numberOfFeatures; k ++) {
+		const double difference = x [k] - y [k];
+		sum += difference * difference;
+	}
+	return sqrt (sum);
+}
+
+/*
+	The frames first [i] .. last [i] of the reference that query frame i can be aligned with:
+	a band of `halfWidth` frames around the diagonal that joins the first frames with the last frames.
+	The half width is at least one frame more than the slope of that diagonal, so that neighbouring windows overlap
+	and a path from the first to the last frames exists; first [i] and last [i] never decrease.
+*/
+static void getWindows (integer numberOfQueryFrames, integer numberOfReferenceFrames, double halfWidth, INTVEC first, INTVEC last) {
+	const double slope = double (numberOfReferenceFrames - 1) / std::max (numberOfQueryFrames - 1, integer (1));
+	halfWidth = std::max (halfWidth, 1.0 + slope);
+	for (integer i = 1; i <= numberOfQueryFrames; i ++) {
+		const double centre = 1.0 + (i - 1) * slope;
+		first [i] = std::max (integer (1), (integer) ceil (centre - halfWidth));
+		last [i] = std::min (numberOfReferenceFrames, (integer) floor (centre + halfWidth));
+	}
+}
+
+/*
+	The lowest and highest value in every column of frames first [i] .. last [i], for every window i,
+	with a monotonic wedge per column (Lemire 2009), which works because the windows move forward only.
+	Undefined values are left out; a window without defined values gets undefined extremes.
+	The wedges `minima` and `maxima` should have room for frames.nrow frame numbers.
+*/
+static void getEnvelope (constMAT frames, constINTVEC first, constINTVEC last, MAT lower, MAT upper, INTVEC minima, INTVEC maxima) {
+	Melder_assert (minima.size >= frames.nrow && maxima.size >= frames.nrow);
+	for (integer icol = 1; icol <= frames.ncol; icol ++) {
+		integer minimaHead = 1, minimaTail = 0, maximaHead = 1, maximaTail = 0, next = 1;
+		for (integer iwindow = 1; iwindow <= first.size; iwindow ++) {
+			for (; next <= last [iwindow]; next ++) {
+				const double value = frames [next] [icol];
+				if (isundef (value))
+					continue;
+				while (minimaTail >= minimaHead && frames [minima [minimaTail]] [icol] >= value)
+					minimaTail --;
+				minima [++ minimaTail] = next;
+				while (maximaTail >= maximaHead && frames [maxima [maximaTail]] [icol] <= value)
+					maximaTail --;
+				maxima [++ maximaTail] = next;
+			}
+			while (minimaHead <= minimaTail && minima [minimaHead] < first [iwindow])
+				minimaHead ++;
+			while (maximaHead <= maximaTail && maxima [maximaHead] < first [iwindow])
+				maximaHead ++;
+			lower [iwindow] [icol] = ( minimaHead <= minimaTail ? frames [minima [minimaHead]] [icol] : undefined );
+			upper [iwindow] [icol] = ( maximaHead <= maximaTail ? frames [maxima [maximaHead]] [icol] : undefined );
+		}
+	}
+}
+
+/*
+	For every frame i, the distance to the nearest point of the box between lower [i] and upper [i],
+	which is not more than the distance to any of the frames of its window.
+	In the pitch column, a window that contains unvoiced frames is at most voicingCosts away,
+	and an unvoiced frame is 0 or voicingCosts away.
+	Returns the sum, which is not more than the cumulative distance along any path.
+*/
+static double DTWBatch_getKeoghBounds (DTWBatch me, constMAT frames, constMAT lower, constMAT upper,
+	constINTVEC numberOfUnvoicedBefore, constINTVEC first, constINTVEC last, VEC out_bounds)
+{
+	double total = 0.0;
+	for (integer i = 1; i <= frames.nrow; i ++) {
+		double sum = 0.0;
+		integer firstFeature = 1;
+		if (isdefined (my voicingCosts)) {
+			const bool windowHasUnvoicedFrames = ( numberOfUnvoicedBefore [last [i] + 1] > numberOfUnvoicedBefore [first [i]] );
+			const double value = frames [i] [1];
+			double difference;
+			if (isundef (value)) {
+				difference = ( windowHasUnvoicedFrames ? 0.0 : my voicingCosts );
+			} else {
+				difference = ( isundef (lower [i] [1]) ? my voicingCosts :
+					value < lower [i] [1] ? lower [i] [1] - value : value > upper [i] [1] ? value - upper [i] [1] : 0.0 );
+				if (windowHasUnvoicedFrames && my voicingCosts < difference)
+					difference = my voicingCosts;
+			}
+			sum = difference * difference;
+			firstFeature = 2;
+		}
+		for (integer k = firstFeature; k <= frames.ncol; k ++) {
+			const double value = frames [i] [k];
+			const double difference = ( value < lower [i] [k] ? lower [i] [k] - value : value > upper [i] [k] ? value - upper [i] [k] : 0.0 );
+			sum += difference * difference;
+		}
+		out_bounds [i] = sqrt (sum);
+		total += out_bounds [i];
+	}
+	return total;
+}
+
+/*
+	Everything that the path search of a single reference needs, kept by a thread from reference to reference.
+	It is created in the main thread, with room for the longest reference, so that the threads allocate nothing.
+*/
+Thing_define (DTWBatch_Workspace, Thing) { public:
+	autoINTVEC first, last, referenceUnvoicedBefore, minima, maxima;
+	autoMAT referenceLower, referenceUpper;
+	autoVEC queryBounds, remainingBounds;
+	autoVEC previous, current;
+	autoINTVEC previousLength, currentLength;
+};
+
+Thing_implement (DTWBatch_Workspace, Thing, 0);
+
+static autoDTWBatch_Workspace DTWBatch_Workspace_create (DTWBatch batch) {
+	const integer numberOfQueryFrames = batch -> query.nrow, numberOfFeatures = batch -> query.ncol;
+	integer numberOfReferenceFrames = 0;
+	for (const autoMAT& reference : batch -> references)
+		numberOfReferenceFrames = std::max (numberOfReferenceFrames, reference.nrow);
+	autoDTWBatch_Workspace me = Thing_new (DTWBatch_Workspace);
+	my first = INTVECraw (numberOfQueryFrames);
+	my last = INTVECraw (numberOfQueryFrames);
+	my referenceLower = MATraw (numberOfQueryFrames, numberOfFeatures);
+	my referenceUpper = MATraw (numberOfQueryFrames, numberOfFeatures);
+	my queryBounds = VECraw (numberOfQueryFrames);
+	my remainingBounds = VECraw (numberOfQueryFrames + 1);
+	my referenceUnvoicedBefore = INTVECraw (numberOfReferenceFrames + 1);
+	my minima = INTVECraw (numberOfReferenceFrames);
+	my maxima = INTVECraw (numberOfReferenceFrames);
+	my previous = VECraw (numberOfReferenceFrames);
+	my current = VECraw (numberOfReferenceFrames);
+	my previousLength = INTVECraw (numberOfReferenceFrames);
+	my currentLength = INTVECraw (numberOfReferenceFrames);
+	return me;
+}
+
+/*
+	The number of unvoiced frames before frame i, in `out_counts [i]`,
+	so that frames first .. last contain out_counts [last + 1] - out_counts [first] unvoiced frames.
+*/
+static void countUnvoicedFrames (constMAT frames, INTVEC out_counts) {
+	out_counts [1] = 0;
+	for (integer i = 1; i <= frames.nrow; i ++)
+		out_counts [i + 1] = out_counts [i] + ( isundef (frames [i] [1]) ? 1 : 0 );
+}
+
+static void DTWBatch_getWindows (DTWBatch me, integer ireference, double sakoeChibaBand, DTWBatch_Workspace ws) {
+	const integer numberOfReferenceFrames = my references [(size_t) ireference - 1].nrow;
+	const double halfWidth = ( sakoeChibaBand > 0.0 ? sakoeChibaBand / my referenceTimeSteps [(size_t) ireference - 1] :
+		(double) numberOfReferenceFrames );
+	getWindows (my query.nrow, numberOfReferenceFrames, halfWidth, ws -> first.get(), ws -> last.get());
+}
+
+/*
+	The lower bound of the cumulative distance between the query and reference `ireference`
+	from the query frames against the envelope of the reference in the windows of DTWBatch_getWindows,
+	with the bound of the query frames i .. in `out_remainingBounds [i]`.
+	The envelope costs about as much as a narrow band of the path search, so it is computed only when it can prune.
+*/
+static double DTWBatch_getKeoghBound (DTWBatch me, integer ireference, DTWBatch_Workspace ws, VEC out_remainingBounds) {
+	constMAT query = my query.get(), reference = my references [(size_t) ireference - 1].get();
+	const integer numberOfQueryFrames = query.nrow, numberOfReferenceFrames = reference.nrow;
+	INTVEC referenceUnvoicedBefore = ws -> referenceUnvoicedBefore.part (1, numberOfReferenceFrames + 1);
+	if (isdefined (my voicingCosts))
+		countUnvoicedFrames (reference, referenceUnvoicedBefore);
+	getEnvelope (reference, ws -> first.get(), ws -> last.get(), ws -> referenceLower.get(), ws -> referenceUpper.get(),
+		ws -> minima.get(), ws -> maxima.get());
+	const double bound = DTWBatch_getKeoghBounds (me, query, ws -> referenceLower.get(), ws -> referenceUpper.get(),
+		referenceUnvoicedBefore, ws -> first.get(), ws -> last.get(), ws -> queryBounds.get());
+	out_remainingBounds [numberOfQueryFrames + 1] = 0.0;
+	for (integer i = numberOfQueryFrames; i >= 1; i --)
+		out_remainingBounds [i] = out_remainingBounds [i + 1] + ws -> queryBounds [i];
+	return bound;
+}
+
+/*
+	The frames that every path passes through: the first frames, with a diagonal weight, and the last frames (Kim et al. 2001).
+*/
+static double DTWBatch_getEndpointBound (DTWBatch me, integer ireference) {
+	constMAT query = my query.get(), reference = my references [(size_t) ireference - 1].get();
+	const double first = DTWBatch_getLocalDistance (me, & query [1] [0], & reference [1] [0], query.ncol);
+	if (query.nrow == 1 && reference.nrow == 1)
+		return 2.0 * first;
+	return 2.0 * first + DTWBatch_getLocalDistance (me, & query [query.nrow] [0], & reference [reference.nrow] [0], query.ncol);
+}
+
+/*
+	The cumulative distance along the best path within the windows, and the number of frame pairs on that path.
+	Gives up, and returns undefined, as soon as the smallest cumulative distance in a row i of the query
+	plus the lower bound of the rest of the query, remainingBounds [i + 1], exceeds `limit`.
+*/
+static double DTWBatch_align (DTWBatch me, integer ireference, constVEC remainingBounds, double limit, DTWBatch_Workspace ws,
+	integer *out_pathLength)
+{
+	constMAT query = my query.get(), reference = my references [(size_t) ireference - 1].get();
+	const integer numberOfQueryFrames = query.nrow, numberOfReferenceFrames = reference.nrow, numberOfFeatures = query.ncol;
+	constINTVEC first = ws -> first.get(), last = ws -> last.get();
+	double *previous = & ws -> previous [0], *current = & ws -> current [0];
+	integer *previousLength = & ws -> previousLength [0], *currentLength = & ws -> currentLength [0];
+	const double infinity = std::numeric_limits <double>::infinity ();
+	for (integer i = 1; i <= numberOfQueryFrames; i ++) {
+		const double *x = & query [i] [0];
+		const integer previousFirst = ( i > 1 ? first [i - 1] : 1 ), previousLast = ( i > 1 ? last [i - 1] : 0 );
+		double rowMinimum = infinity;
+		for (integer j = first [i]; j <= last [i]; j ++) {
+			const double distance = DTWBatch_getLocalDistance (me, x, & reference [j] [0], numberOfFeatures);
+			double cumulative;
+			integer length;
+			if (i == 1 && j == 1) {
+				cumulative = 2.0 * distance;
+				length = 1;
+			} else {
+				cumulative = infinity;
+				length = 0;
+				if (j > previousFirst && j - 1 <= previousLast) {   // diagonal
+					cumulative = previous [j - 1] + 2.0 * distance;
+					length = previousLength [j - 1] + 1;
+				}
+				if (j >= previousFirst && j <= previousLast && previous [j] + distance < cumulative) {   // vertical
+					cumulative = previous [j] + distance;
+					length = previousLength [j] + 1;
+				}
+				if (j > first [i] && current [j - 1] + distance < cumulative) {   // horizontal
+					cumulative = current [j - 1] + distance;
+					length = currentLength [j - 1] + 1;
+				}
+			}
+			current [j] = cumulative;
+			currentLength [j] = length;
+			if (cumulative < rowMinimum)
+				rowMinimum = cumulative;
+		}
+		if (limit < infinity && rowMinimum + remainingBounds [i + 1] > limit)
+			return undefined;
+		std::swap (previous, current);
+		std::swap (previousLength, currentLength);
+	}
+	if (out_pathLength)
+		*out_pathLength = previousLength [numberOfReferenceFrames];
+	return previous [numberOfReferenceFrames];
+}
+
+/*
+	The references order [firstRank], order [firstRank + numberOfThreads], ..., handled by a single thread.
+	Once the threads together have found numberOfBestMatches distances, a reference is skipped if a lower bound exceeds the threshold,
+	which is the distance of the worst of the best matches so far, and its path search stops as soon as its distance
+	can no longer come below the threshold. The threads share these best matches, in a heap with the worst on top.
+	The references come in the order of their endpoint bounds, so that the threshold drops early.
+*/
+Thing_define (DTWBatch_Args, Thing) { public:
+	DTWBatch batch;
+	constINTVEC order;
+	constVEC endpointBounds;
+	integer firstRank, rankStep;
+	double sakoeChibaBand;
+	integer numberOfBestMatches;
+	bool prune;
+	autoDTWBatch_Workspace workspace;
+	std::vector <double> *distances;
+	std::vector <integer> *pathLengths;
+	VEC best;   // room for numberOfBestMatches + 1 distances
+	integer *numberOfBest;
+};
+
+Thing_implement (DTWBatch_Args, Thing, 0);
+
+/*
+	A little room for the rounding of the bounds, which are summed in a different order than the distances.
+*/
+#define DTWBatch_BOUND_TOLERANCE  1e-9
+
+MelderThread_MUTEX (bestMatchesMutex);
+static bool bestMatchesMutex_inited;
+
+/*
+	Adds a distance to the heap of the best matches, and drops the worst if there are more than numberOfBestMatches.
+*/
+static void addBestMatch (VEC best, integer *numberOfBest, integer numberOfBestMatches, double distance) {
+	double *heap = & best [1];
+	heap [(*numberOfBest) ++] = distance;
+	std::push_heap (heap, heap + *numberOfBest);
+	if (*numberOfBest > numberOfBestMatches)
+		std::pop_heap (heap, heap + (*numberOfBest) --);
+}
+
+static MelderThread_RETURN_TYPE DTWBatch_alignReferences (DTWBatch_Args me) {
+	DTWBatch batch = my batch;
+	const integer numberOfReferences = (integer) batch -> references.size ();
+	const double infinity = std::numeric_limits <double>::infinity ();
+	DTWBatch_Workspace ws = my workspace.get();
+	for (integer irank = my firstRank; irank <= numberOfReferences; irank += my rankStep) {
+		const integer ireference = my order [irank];
+		const double normalization = double (batch -> query.nrow + batch -> references [(size_t) ireference - 1].nrow);
+		DTWBatch_getWindows (batch, ireference, my sakoeChibaBand, ws);
+		double threshold = infinity, limit = infinity;
+		if (my prune) {
+			MelderThread_LOCK (bestMatchesMutex);
+			if (*my numberOfBest == my numberOfBestMatches)
+				threshold = my best [1];
+			MelderThread_UNLOCK (bestMatchesMutex);
+		}
+		if (threshold < infinity) {
+			limit = threshold * normalization * (1.0 + DTWBatch_BOUND_TOLERANCE);
+			if (my endpointBounds [ireference] > limit ||
+					DTWBatch_getKeoghBound (batch, ireference, ws, ws -> remainingBounds.get()) > limit)
+				continue;
+		}
+		integer pathLength = 0;
+		const double cumulative = DTWBatch_align (batch, ireference, ws -> remainingBounds.get(), limit, ws, & pathLength);
+		if (isundef (cumulative))
+			continue;
+		const double distance = cumulative / normalization;
+		(*my distances) [(size_t) ireference - 1] = distance;
+		(*my pathLengths) [(size_t) ireference - 1] = pathLength;
+		if (my prune) {
+			MelderThread_LOCK (bestMatchesMutex);
+			addBestMatch (my best, my numberOfBest, my numberOfBestMatches, distance);
+			MelderThread_UNLOCK (bestMatchesMutex);
+		}
+	}
+	MelderThread_RETURN;
+}
+
+#define DTWBatch_MINIMUM_REFERENCES_PER_THREAD  4
+
+autoTable DTWBatch_to_Table (DTWBatch me, double sakoeChibaBand, integer numberOfBestMatches) {
+	try {
+		const integer numberOfReferences = (integer) my references.size ();
+		Melder_require (numberOfReferences > 0,
+			U"There should be at least one reference.");
+		Melder_require (numberOfBestMatches >= 0,
+			U"The number of best matches should not be negative.");
+		if (numberOfBestMatches == 0 || numberOfBestMatches > numberOfReferences)
+			numberOfBestMatches = numberOfReferences;
+		std::vector <double> distances ((size_t) numberOfReferences, undefined);
+		std::vector <integer> pathLengths ((size_t) numberOfReferences, 0);
+		/*
+			Debug option 70: a single thread, and the distances of all the references.
+		*/
+		const bool prune = ( Melder_debug != 70 && numberOfBestMatches < numberOfReferences );
+		const integer numberOfThreads = ( Melder_debug == 70 ? 1 :
+			std::max (integer (1), std::min (numberOfReferences / DTWBatch_MINIMUM_REFERENCES_PER_THREAD,
+				integer (MelderThread_getNumberOfProcessors ()))) );
+		autoVEC endpointBounds = VECraw (numberOfReferences);
+		autoINTVEC order = INTVECraw (numberOfReferences);
+		for (integer ireference = 1; ireference <= numberOfReferences; ireference ++) {
+			endpointBounds [ireference] = DTWBatch_getEndpointBound (me, ireference);
+			order [ireference] = ireference;
+		}
+		if (prune) {
+			auto normalizedBound = [&] (integer ireference) {
+				return endpointBounds [ireference] / double (my query.nrow + my references [(size_t) ireference - 1].nrow);
+			};
+			std::stable_sort (& order [1], & order [1] + numberOfReferences, [&] (integer a, integer b) {
+				return normalizedBound (a) < normalizedBound (b);
+			});
+		}
+		autoVEC best = VECraw (numberOfBestMatches + 1);
+		integer numberOfBest = 0;
+		if (! bestMatchesMutex_inited) {
+			MelderThread_MUTEX_INIT (bestMatchesMutex);
+			bestMatchesMutex_inited = true;
+		}
+		std::vector <autoDTWBatch_Args> args ((size_t) numberOfThreads);
+		for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+			autoDTWBatch_Args arg = Thing_new (DTWBatch_Args);
+			arg -> batch = me;
+			arg -> order = order.get();
+			arg -> endpointBounds = endpointBounds.get();
+			arg -> firstRank = ithread;
+			arg -> rankStep = numberOfThreads;
+			arg -> sakoeChibaBand = sakoeChibaBand;
+			arg -> numberOfBestMatches = numberOfBestMatches;
+			arg -> prune = prune;
+			arg -> workspace = DTWBatch_Workspace_create (me);
+			arg -> distances = & distances;
+			arg -> pathLengths = & pathLengths;
+			arg -> best = best.get();
+			arg -> numberOfBest = & numberOfBest;
+			args [(size_t) ithread - 1] = arg.move();
+		}
+		MelderThread_run (DTWBatch_alignReferences, args.data(), (int) numberOfThreads);
+
+		std::vector <integer> ranking;
+		for (integer ireference = 1; ireference <= numberOfReferences; ireference ++)
+			if (isdefined (distances [(size_t) ireference - 1]))
+				ranking. push_back (ireference);
+		std::sort (ranking.begin (), ranking.end (), [&] (integer a, integer b) {
+			const double da = distances [(size_t) a - 1], db = distances [(size_t) b - 1];
+			return da < db || (da == db && a < b);
+		});
+		Melder_assert ((integer) ranking.size () >= numberOfBestMatches);
+		autoTable thee = Table_createWithColumnNames (numberOfBestMatches, U"rank index reference distance pathLength");
+		for (integer irank = 1; irank <= numberOfBestMatches; irank ++) {
+			const integer ireference = ranking [(size_t) irank - 1];
+			Table_setNumericValue (thee.get(), irank, 1, irank);
+			Table_setNumericValue (thee.get(), irank, 2, ireference);
+			Table_setStringValue (thee.get(), irank, 3, my referenceNames [(size_t) ireference - 1].get());
+			Table_setNumericValue (thee.get(), irank, 4, distances [(size_t) ireference - 1]);
+			Table_setNumericValue (thee.get(), irank, 5, pathLengths [(size_t) ireference - 1]);
+		}
+		return thee;
+	} catch (MelderError) {
+		Melder_throw (me, U": no Table with DTW distances created.");
+	}
+}
+
+static autoMAT CC_to_MAT_dtwFeatures (CC me, double cepstralWeight, double logEnergyWeight) {
+	const double weightSum = cepstralWeight + logEnergyWeight;
+	const double cepstralScale = sqrt (cepstralWeight / weightSum), logEnergyScale = sqrt (logEnergyWeight / weightSum);
+	const integer numberOfCoefficients = my maximumNumberOfCoefficients;
+	autoMAT features = MATzero (my nx, numberOfCoefficients + ( logEnergyWeight != 0.0 ? 1 : 0 ));   // missing coefficients are zero
+	for (integer iframe = 1; iframe <= my nx; iframe ++) {
+		CC_Frame frame = & my frame [iframe];
+		for (integer k = 1; k <= frame -> numberOfCoefficients; k ++)
+			features [iframe] [k] = cepstralScale * frame -> c [k];
+		if (logEnergyWeight != 0.0)
+			features [iframe] [numberOfCoefficients + 1] = logEnergyScale * frame -> c0;
+	}
+	return features;
+}
+
+autoTable CCs_to_Table_dtw (OrderedOf<structCC>* ccs, double cepstralWeight, double logEnergyWeight,
+	double sakoeChibaBand, integer numberOfBestMatches)
+{
+	try {
+		Melder_require (ccs -> size >= 2,
+			U"There should be a query and at least one reference.");
+		Melder_require (cepstralWeight >= 0.0 && logEnergyWeight >= 0.0 && cepstralWeight + logEnergyWeight > 0.0,
+			U"The weights should not be negative, and at least one of them should be positive.");
+		CC query = ccs -> at [1];
+		autoDTWBatch batch = DTWBatch_create (CC_to_MAT_dtwFeatures (query, cepstralWeight, logEnergyWeight), undefined);
+		for (integer iref = 2; iref <= ccs -> size; iref ++) {
+			CC reference = ccs -> at [iref];
+			Melder_require (reference -> maximumNumberOfCoefficients == query -> maximumNumberOfCoefficients,
+				U"CC orders should be equal.");
+			DTWBatch_addReference (batch.get(), CC_to_MAT_dtwFeatures (reference, cepstralWeight, logEnergyWeight),
+				reference -> dx, reference -> name.get());
+		}
+		return DTWBatch_to_Table (batch.get(), sakoeChibaBand, numberOfBestMatches);
+	} catch (MelderError) {
+		Melder_throw (U"No Table with DTW distances created from CCs.");
+	}
+}
+
+autoTable Sounds_to_Table_dtw (OrderedOf<structSound>* sounds, double analysisWidth, double dt,
+	double sakoeChibaBand, integer numberOfBestMatches)
+{
+	try {
+		const integer numberOfCoefficients = 12;
+		const double fmin_mel = 100.0, df_mel = 100.0, fmax_mel = 0.0;
+		OrderedOf<structCC> ccs;
+		std::vector <autoMFCC> mfccs;
+		for (integer isound = 1; isound <= sounds -> size; isound ++) {
+			Sound sound = sounds -> at [isound];
+			autoMFCC mfcc = Sound_to_MFCC (sound, numberOfCoefficients, analysisWidth, dt, fmin_mel, fmax_mel, df_mel);
+			Thing_setName (mfcc.get(), sound -> name.get());
+			ccs. addItem_ref (mfcc.get());
+			mfccs. push_back (mfcc.move());
+		}
+		return CCs_to_Table_dtw (& ccs, 1.0, 0.0, sakoeChibaBand, numberOfBestMatches);
+	} catch (MelderError) {
+		Melder_throw (U"No Table with DTW distances created from Sounds.");
+	}
+}
+
+static autoMAT Pitch_to_MAT_dtwFeatures (Pitch me, double time_weight) {
+	autoMAT features = MATraw (my nx, 2);
+	const double timeScale = sqrt (time_weight);
+	for (integer iframe = 1; iframe <= my nx; iframe ++) {
+		features [iframe] [1] = Sampled_getValueAtSample (me, iframe, Pitch_LEVEL_FREQUENCY, (int) kPitch_unit::SEMITONES_100);
+		features [iframe] [2] = timeScale * Sampled_indexToX (me, iframe);
+	}
+	return features;
+}
+
+autoTable Pitches_to_Table_dtw (OrderedOf<structPitch>* pitches, double vuv_costs, double time_weight,
+	double sakoeChibaBand, integer numberOfBestMatches)
+{
+	try {
+		Melder_require (pitches -> size >= 2,
+			U"There should be a query and at least one reference.");
+		Melder_require (vuv_costs >= 0.0,
+			U"Voiced-unvoiced costs should not be negative.");
+		Melder_require (time_weight >= 0.0,
+			U"Time costs weight should not be negative.");
+		autoDTWBatch batch = DTWBatch_create (Pitch_to_MAT_dtwFeatures (pitches -> at [1], time_weight), vuv_costs);
+		for (integer iref = 2; iref <= pitches -> size; iref ++) {
+			Pitch reference = pitches -> at [iref];
+			DTWBatch_addReference (batch.get(), Pitch_to_MAT_dtwFeatures (reference, time_weight), reference -> dx, reference -> name.get());
+		}
+		return DTWBatch_to_Table (batch.get(), sakoeChibaBand, numberOfBestMatches);
+	} catch (MelderError) {
+		Melder_throw (U"No Table with DTW distances created from Pitches.");
+	}
+}
+
+/* End of file DTWBatch.cpp */
@@ -0,0 +1,80 @@
+#ifndef _DTWBatch_h_
+#define _DTWBatch_h_
+/* DTWBatch.h
+ *
+ * Copyright (C) 2026 Praat developers
+ *
+ * This code is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this work. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CC.h"
+#include "Pitch.h"
+#include "Sound.h"
+#include "Table.h"
+
+/*
+	The DTW distances between one query and many references, each given as a matrix with one row of features per frame.
+
+	The local distance between two frames is the Euclidean distance between their rows.
+	If `voicingCosts` is defined, the first column holds a pitch, which is undefined in unvoiced frames:
+	a voiced frame differs from an unvoiced frame by `voicingCosts` in that column, and two unvoiced frames do not differ.
+
+	The path goes from the first frames to the last frames with horizontal, vertical and diagonal steps
+	within a Sakoe-Chiba band around the diagonal; a diagonal step counts the local distance twice,
+	and the distance is the cumulative distance along the best path divided by the sum of the numbers of frames
+	(the weights and the normalization of DTW_Polygon_findPathInside).
+*/
+Thing_define (DTWBatch, Thing) {
+	autoMAT query;
+	std::vector <autoMAT> references;
+	std::vector <double> referenceTimeSteps;
+	std::vector <autostring32> referenceNames;
+	double voicingCosts;
+};
+
+autoDTWBatch DTWBatch_create (autoMAT query, double voicingCosts);
+
+void DTWBatch_addReference (DTWBatch me, autoMAT features, double timeStep, conststring32 name);
+
+/*
+	The `numberOfBestMatches` references nearest to the query (all if 0), sorted by distance, in threads,
+	in a Table with the columns rank, index (of the reference), reference (its name), distance and pathLength.
+	A reference whose LB_Keogh lower bound (Keogh & Ratanamahatana 2005) exceeds the distance of the worst match found so far
+	is skipped, and the path search stops as soon as the distance can no longer become small enough
+	(Debug option 70 computes all the distances, in a single thread).
+	A `sakoeChibaBand` of 0 seconds does not restrict the path.
+*/
+autoTable DTWBatch_to_Table (DTWBatch me, double sakoeChibaBand, integer numberOfBestMatches);
+
+/*
+	The first CC is the query, the others are the references.
+	The features are the coefficients c [1..] times sqrt (cepstralWeight / (cepstralWeight + logEnergyWeight))
+	and c0 times sqrt (logEnergyWeight / (cepstralWeight + logEnergyWeight)), as in CCs_to_DTW without regression weights.
+*/
+autoTable CCs_to_Table_dtw (OrderedOf<structCC>* ccs, double cepstralWeight, double logEnergyWeight,
+	double sakoeChibaBand, integer numberOfBestMatches);
+
+/*
+	The first Sound is the query, the others are the references; the features are the MFCCs of Sounds_to_DTW.
+*/
+autoTable Sounds_to_Table_dtw (OrderedOf<structSound>* sounds, double analysisWidth, double dt,
+	double sakoeChibaBand, integer numberOfBestMatches);
+
+/*
+	The first Pitch is the query, the others are the references; the local distance is the one of Pitches_to_DTW.
+*/
+autoTable Pitches_to_Table_dtw (OrderedOf<structPitch>* pitches, double vuv_costs, double time_weight,
+	double sakoeChibaBand, integer numberOfBestMatches);
+
+#endif /* _DTWBatch_h_ */
@@ -589,12 +589,17 @@ autoClassificationTable Discriminant_TableOfReal_to_ClassificationTable (Discrim
 		// Generalized squared distance function:
 		// D^2(x) = (x - mu)' S^-1 (x - mu) + ln (determinant(S)) - 2 ln (apriori)
 
+		std::vector <constMAT> lowerInverses;
+		std::vector <constVEC> centroids;
+		for (integer j = 1; j <= numberOfGroups; j ++) {
+			lowerInverses.push_back (sscpvec [j] -> data.get());
+			centroids.push_back (groups->at [j] -> centroid.get());
+		}
+		NUMmahalanobisDistances (thy data.get(), lowerInverses, centroids, his data.get());
 		for (integer i = 1; i <= thy numberOfRows; i ++) {
 			double norm = 0.0, pt_max = -1e308;
 			for (integer j = 1; j <= numberOfGroups; j ++) {
-				SSCP t = groups->at [j];
-				double md = NUMmahalanobisDistance (sscpvec [j] -> data.get(), thy data.row (i),t -> centroid.get());
-				//double md = mahalanobisDistanceSq (sscpvec [j] -> data.at, dimension, thy data [i], t -> centroid, buf.at);
+				double md = his data [i] [j];
 				double pt = log_apriori [j] - 0.5 * (ln_determinant [j] + md);
 				if (pt > pt_max) {
 					pt_max = pt;
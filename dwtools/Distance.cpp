@@ -23,6 +23,7 @@
 
 #include "Distance.h"
 #include "TableOfReal_extensions.h"
+#include "MelderThread.h"
 
 Thing_implement (Distance, Proximity, 0);
 
@@ -48,40 +49,106 @@ double Distance_getMaximumDistance (Distance me) {
 	return dmax;
 }
 
-autoDistance Configuration_to_Distance (Configuration me) {
-	try {
-		autoDistance thee = Distance_create (my numberOfRows);
-		TableOfReal_copyLabels (me, thee.get(), 1, -1);
-		for (integer i = 1; i <= thy numberOfRows - 1; i ++) {
-			for (integer j = i + 1; j <= thy numberOfColumns; j ++) {
-				/*
-					first divide distance by maximum to prevent overflow when metric is a large number.
-					d = (x^n)^(1/n) may overflow if x>1 & n >>1 even if d would not overflow!
-					metric changed 24/11/97
-					my w [k] * pow (|i-j|) instead of pow (my w [k] * |i-j|)
-				*/
-				double dmax = 0.0;
-				for (integer k = 1; k <= my numberOfColumns; k ++) {
-					double dtmp  = fabs (my data [i] [k] - my data [j] [k]);
-					if (dtmp > dmax) dmax = dtmp;
-				}
-				longdouble d = 0.0;
-				if (dmax > 0.0) {
-					for (integer k = 1; k <= my numberOfColumns; k ++) {
-						double arg = fabs (my data [i] [k] - my data [j] [k]) / dmax;
-						d += my w [k] * pow (arg, my metric);
+/*
+	The distances of the rows firstRow through lastRow to the rows after them.
+	Every distance is computed by a single thread and written into both halves of the symmetric matrix,
+	so the result does not depend on the number of threads.
+*/
+Thing_define (Configuration_distances_Args, Thing) { public:
+	Configuration configuration;
+	Distance distance;
+	integer firstRow, lastRow;
+};
+
+Thing_implement (Configuration_distances_Args, Thing, 0);
+
+static MelderThread_RETURN_TYPE Configuration_distances (Configuration_distances_Args me) {
+	const Configuration configuration = my configuration;
+	const integer numberOfPoints = configuration -> numberOfRows, numberOfDimensions = configuration -> numberOfColumns;
+	const double metric = configuration -> metric;
+	const bool euclidean = ( metric == 2.0 && Melder_debug != 62 );
+	MAT d = my distance -> data.get();
+	for (integer i = my firstRow; i <= my lastRow; i ++) {
+		constVEC xi = configuration -> data.row (i);
+		for (integer j = i + 1; j <= numberOfPoints; j ++) {
+			constVEC xj = configuration -> data.row (j);
+			/*
+				first divide distance by maximum to prevent overflow when metric is a large number.
+				d = (x^n)^(1/n) may overflow if x>1 & n >>1 even if d would not overflow!
+				metric changed 24/11/97
+				my w [k] * pow (|i-j|) instead of pow (my w [k] * |i-j|)
+			*/
+			double dmax = 0.0;
+			for (integer k = 1; k <= numberOfDimensions; k ++) {
+				const double dtmp = fabs (xi [k] - xj [k]);
+				if (dtmp > dmax) dmax = dtmp;
+			}
+			longdouble dsum = 0.0;
+			if (dmax > 0.0) {
+				if (euclidean) {
+					for (integer k = 1; k <= numberOfDimensions; k ++) {
+						const double arg = (xi [k] - xj [k]) / dmax;
+						dsum += configuration -> w [k] * arg * arg;
+					}
+				} else {
+					for (integer k = 1; k <= numberOfDimensions; k ++) {
+						const double arg = fabs (xi [k] - xj [k]) / dmax;
+						dsum += configuration -> w [k] * pow (arg, metric);
 					}
 				}
-				thy data [i] [j] = thy data [j] [i] = dmax * pow ((double) d, 1.0 / my metric);
 			}
+			d [i] [j] = d [j] [i] = dmax * ( euclidean ? sqrt ((double) dsum) : pow ((double) dsum, 1.0 / metric) );
+		}
+	}
+	MelderThread_RETURN;
+}
+
+#define Configuration_MINIMUM_DISTANCES_PER_THREAD  10000
+
+void Configuration_into_Distance (Configuration me, Distance thee) {
+	const integer numberOfPoints = my numberOfRows;
+	Melder_assert (thy numberOfRows == numberOfPoints && thy numberOfColumns == numberOfPoints);
+	for (integer i = 1; i <= numberOfPoints; i ++)
+		thy data [i] [i] = 0.0;
+	const integer numberOfDistances = numberOfPoints * (numberOfPoints - 1) / 2;
+	const integer numberOfThreads = ( Melder_debug == 62 ? 1 :
+		std::max (integer (1), std::min (numberOfDistances * my numberOfColumns / Configuration_MINIMUM_DISTANCES_PER_THREAD,
+			integer (MelderThread_getNumberOfProcessors ()))) );
+	/*
+		Row i has numberOfPoints - i distances; give every thread about the same number of distances.
+	*/
+	std::vector <autoConfiguration_distances_Args> args ((size_t) numberOfThreads);
+	integer firstRow = 1, numberOfDistancesDone = 0;
+	for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+		autoConfiguration_distances_Args arg = Thing_new (Configuration_distances_Args);
+		arg -> configuration = me;
+		arg -> distance = thee;
+		integer lastRow = numberOfPoints - 1;
+		if (ithread < numberOfThreads) {
+			const integer nextThreadStart = ithread * numberOfDistances / numberOfThreads;
+			lastRow = firstRow - 1;
+			while (lastRow < numberOfPoints - 1 && numberOfDistancesDone < nextThreadStart)
+				numberOfDistancesDone += numberOfPoints - (++ lastRow);
 		}
+		arg -> firstRow = firstRow;
+		arg -> lastRow = lastRow;   // may be firstRow - 1
+		firstRow = lastRow + 1;
+		args [(size_t) ithread - 1] = arg.move();
+	}
+	MelderThread_run (Configuration_distances, args.data(), (int) numberOfThreads);
+}
+
+autoDistance Configuration_to_Distance (Configuration me) {
+	try {
+		autoDistance thee = Distance_create (my numberOfRows);
+		TableOfReal_copyLabels (me, thee.get(), 1, -1);
+		Configuration_into_Distance (me, thee.get());
 		return thee;
 	} catch (MelderError) {
 		Melder_throw (me, U": no Distance created.");
 	}
 }
 
-
 void Distance_drawDendogram (Distance me, Graphics g, int method) {
 	(void) me;
 	(void) g;
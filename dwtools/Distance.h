@@ -29,6 +29,15 @@ autoDistance Distance_create (integer numberOfPoints);
 
 autoDistance Configuration_to_Distance (Configuration me);
 
+void Configuration_into_Distance (Configuration me, Distance thee);
+/*
+	Preconditions:
+		thy numberOfRows == thy numberOfColumns == my numberOfRows
+	Postcondition:
+		the same distances as in Configuration_to_Distance, without allocating a new matrix
+		(the labels are not copied).
+*/
+
 void Distance_drawDendogram (Distance me, Graphics g, int method);
 
 double Distance_getMaximumDistance (Distance me);
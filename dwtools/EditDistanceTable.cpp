@@ -21,6 +21,9 @@
 */
 
 #include "EditDistanceTable.h"
+#include "MelderThread.h"
+#include <string>
+#include <unordered_map>
 
 #include "oo_DESTROY.h"
 #include "EditDistanceTable_def.h"
@@ -340,6 +343,67 @@ autoTableOfReal EditCostsTable_to_TableOfReal (EditCostsTable me) {
 	}
 }
 
+/*
+	The symbols of the strings to be aligned, each interned once as a number,
+	with the row and the column that it has in an EditCostsTable (the "others" row or column if it has none),
+	so that the dynamic programming looks up its costs without comparing strings.
+	Two symbols that are both "others" are equal if they are the same symbol,
+	which is what structEditCostsTable :: v_matchTargetWithSourceSymbol says.
+*/
+Thing_define (EditSymbols, Thing) { public:
+	EditCostsTable costs;
+	bool costsAreNonnegative;
+	std::unordered_map <std::u32string, integer> numbers;
+	std::vector <std::u32string> strings;   // [symbol - 1]
+	std::vector <integer> rows, columns;   // [symbol - 1]
+	std::vector <double> insertionCosts, deletionCosts;   // [symbol - 1]
+};
+
+Thing_implement (EditSymbols, Thing, 0);
+
+static autoEditSymbols EditSymbols_create (EditCostsTable costs) {
+	autoEditSymbols me = Thing_new (EditSymbols);
+	my costs = costs;
+	my costsAreNonnegative = true;
+	for (integer irow = 1; irow <= costs -> numberOfRows; irow ++)
+		for (integer icol = 1; icol <= costs -> numberOfColumns; icol ++)
+			if (costs -> data [irow] [icol] < 0.0)
+				my costsAreNonnegative = false;
+	return me;
+}
+
+static integer EditSymbols_intern (EditSymbols me, conststring32 symbol) {
+	if (! symbol)
+		symbol = U"";
+	const auto found = my numbers.find (symbol);
+	if (found != my numbers.end ())
+		return found -> second;
+	EditCostsTable costs = my costs;
+	integer row = EditCostsTable_getTargetIndex (costs, symbol);
+	integer column = EditCostsTable_getSourceIndex (costs, symbol);
+	row = ( row > 0 ? row : costs -> numberOfRows - 1 );   // others is penultimate row
+	column = ( column > 0 ? column : costs -> numberOfColumns - 1 );   // others is penultimate column
+	my strings. push_back (symbol);
+	my rows. push_back (row);
+	my columns. push_back (column);
+	my insertionCosts. push_back (costs -> data [row] [costs -> numberOfColumns]);
+	my deletionCosts. push_back (costs -> data [costs -> numberOfRows] [column]);
+	const integer number = (integer) my strings.size ();
+	my numbers [symbol] = number;
+	return number;
+}
+
+/*
+	The same cost as EditCostsTable_getSubstitutionCost (costs, target, source) for the strings of the two symbols.
+*/
+inline static double EditSymbols_getSubstitutionCost (EditSymbols me, integer target, integer source) {
+	const integer row = my rows [(size_t) target - 1], column = my columns [(size_t) source - 1];
+	const integer othersRow = my costs -> numberOfRows - 1, othersColumn = my costs -> numberOfColumns - 1;
+	if (row == othersRow && column == othersColumn && target != source)
+		return my costs -> data [othersRow + 1] [othersColumn + 1];
+	return my costs -> data [row] [column];
+}
+
 Thing_implement (EditDistanceTable, TableOfReal, 0);
 
 void structEditDistanceTable :: v_info () {
@@ -557,21 +621,38 @@ void EditDistanceTable_findPath (EditDistanceTable me, autoTableOfReal *out_dire
 		autoNUMmatrix<short> psi (0, numberOfTargets, 0, numberOfSources);
 		autoNUMmatrix<double> delta (0, numberOfTargets, 0, numberOfSources);
 
+		/*
+			The costs of every symbol are looked up once; Debug option 66 compares the strings in every cell.
+		*/
+		const bool interned = ( Melder_debug != 66 );
+		autoEditSymbols symbols = EditSymbols_create (my editCostsTable.get());
+		autoINTVEC targetSymbols = INTVECraw (numberOfTargets), sourceSymbols = INTVECraw (numberOfSources);
+		autoVEC insertionCosts = VECraw (numberOfTargets), deletionCosts = VECraw (numberOfSources);
+		for (integer i = 1; i <= numberOfTargets; i ++) {
+			targetSymbols [i] = EditSymbols_intern (symbols.get(), my rowLabels [i + 1].get());
+			insertionCosts [i] = symbols -> insertionCosts [(size_t) targetSymbols [i] - 1];
+		}
 		for (integer j = 1; j <= numberOfSources; j ++) {
-			delta [0] [j] = delta [0] [j - 1] + EditCostsTable_getDeletionCost (my editCostsTable.get(), my columnLabels [j+1].get());
+			sourceSymbols [j] = EditSymbols_intern (symbols.get(), my columnLabels [j + 1].get());
+			deletionCosts [j] = symbols -> deletionCosts [(size_t) sourceSymbols [j] - 1];
+		}
+
+		for (integer j = 1; j <= numberOfSources; j ++) {
+			delta [0] [j] = delta [0] [j - 1] + deletionCosts [j];
 			psi [0] [j] = WARPING_fromLeft;
 		}
 		for (integer i = 1; i <= numberOfTargets; i ++) {
-			delta [i] [0] = delta [i - 1] [0] + EditCostsTable_getInsertionCost (my editCostsTable.get(), my rowLabels [i+1].get());
+			delta [i] [0] = delta [i - 1] [0] + insertionCosts [i];
 			psi [i] [0] = WARPING_fromBelow;
 		}
 		for (integer j = 1; j <= numberOfSources; j ++) {
 			for (integer i = 1; i <= numberOfTargets; i ++) {
 				// the substitution, deletion and insertion costs.
-				double left = delta [i] [j - 1] + EditCostsTable_getInsertionCost (my editCostsTable.get(), my rowLabels [i+1].get());
-				double bottom = delta [i - 1] [j] + EditCostsTable_getDeletionCost (my editCostsTable.get(), my columnLabels [j+1].get());
-				double mindist = delta [i - 1] [j - 1] +
-					EditCostsTable_getSubstitutionCost (my editCostsTable.get(), my rowLabels [i+1].get(), my columnLabels [j+1].get()); // diag
+				double left = delta [i] [j - 1] + insertionCosts [i];
+				double bottom = delta [i - 1] [j] + deletionCosts [j];
+				double mindist = delta [i - 1] [j - 1] + ( interned ?
+					EditSymbols_getSubstitutionCost (symbols.get(), targetSymbols [i], sourceSymbols [j]) :
+					EditCostsTable_getSubstitutionCost (my editCostsTable.get(), my rowLabels [i+1].get(), my columnLabels [j+1].get()) ); // diag
 				psi [i] [j] = WARPING_fromDiag;
 				if (bottom < mindist) {
 					mindist = bottom;
@@ -612,6 +693,263 @@ void EditDistanceTable_findPath (EditDistanceTable me, autoTableOfReal *out_dire
 	}
 }
 
+/*
+	The rows firstRow through lastRow of an edit distance batch, each aligned by a single thread.
+	The thread fills in the distance and the steps of the path back from the end of each row;
+	`delta` and `psi` are sized for the longest target and source of these rows, and every row has room
+	for targets.size + sources.size steps, all allocated in the main thread, so that the threads allocate nothing.
+*/
+Thing_define (EditDistanceBatch_Args, Thing) { public:
+	EditSymbols symbols;
+	const std::vector <autoINTVEC> *targets, *sources;
+	integer firstRow, lastRow;
+	double maximumDistance;
+	bool useBand;
+	autoMAT delta;
+	autoINTMAT psi;
+	std::vector <double> *distances;
+	std::vector <autoINTVEC> *steps;
+	std::vector <integer> *numbersOfSteps;
+};
+
+Thing_implement (EditDistanceBatch_Args, Thing, 0);
+
+/*
+	The distance between `targets` and `sources` with the same costs, and the same choice between equal costs, as EditDistanceTable_findPath,
+	plus the alignment, in `delta` and `psi`, which should have at least targets.size + 1 rows and sources.size + 1 columns.
+	If the costs are nonnegative and `maximumDistance` is finite, a path that goes `band` cells off the diagonal
+	costs at least `band` times the smallest insertion or deletion cost, so that only the cells within
+	maximumDistance / (that cost) of the diagonal are computed, and the computation stops as soon as
+	all the cells of a row exceed `maximumDistance` (Ukkonen's cutoff).
+	Returns undefined if the distance exceeds `maximumDistance`.
+*/
+static double EditSymbols_align (EditSymbols me, constINTVEC targets, constINTVEC sources, double maximumDistance, bool useBand,
+	MAT const& delta, INTMAT const& psi)
+{
+	const integer numberOfTargets = targets.size, numberOfSources = sources.size;
+	Melder_assert (delta.nrow > numberOfTargets && delta.ncol > numberOfSources);
+	Melder_assert (psi.nrow == delta.nrow && psi.ncol == delta.ncol);
+	#define DELTA(i,j)  delta [(i) + 1] [(j) + 1]
+	#define PSI(i,j)  psi [(i) + 1] [(j) + 1]
+	integer band = std::max (numberOfTargets, numberOfSources);
+	const bool cutoff = ( useBand && my costsAreNonnegative && isdefined (maximumDistance) );
+	if (cutoff) {
+		double minimumIndelCost = undefined;
+		for (integer i = 1; i <= numberOfTargets; i ++)
+			if (isundef (minimumIndelCost) || my insertionCosts [(size_t) targets [i] - 1] < minimumIndelCost)
+				minimumIndelCost = my insertionCosts [(size_t) targets [i] - 1];
+		for (integer j = 1; j <= numberOfSources; j ++)
+			if (isundef (minimumIndelCost) || my deletionCosts [(size_t) sources [j] - 1] < minimumIndelCost)
+				minimumIndelCost = my deletionCosts [(size_t) sources [j] - 1];
+		if (minimumIndelCost > 0.0)
+			band = std::min (band, (integer) floor (maximumDistance / minimumIndelCost));
+		if (std::abs (numberOfTargets - numberOfSources) > band)
+			return undefined;
+	}
+	const double infinity = std::numeric_limits <double>::infinity ();
+	DELTA (0, 0) = 0.0;
+	for (integer j = 1; j <= std::min (numberOfSources, band); j ++) {
+		DELTA (0, j) = DELTA (0, j - 1) + my deletionCosts [(size_t) sources [j] - 1];
+		PSI (0, j) = WARPING_fromLeft;
+	}
+	for (integer i = 1; i <= numberOfTargets; i ++) {
+		const integer target = targets [i];
+		const double insertionCost = my insertionCosts [(size_t) target - 1];
+		const integer jmin = std::max (integer (0), i - band), jmax = std::min (numberOfSources, i + band);
+		double rowMinimum = infinity;
+		if (jmin == 0) {
+			DELTA (i, 0) = DELTA (i - 1, 0) + insertionCost;
+			PSI (i, 0) = WARPING_fromBelow;
+			rowMinimum = DELTA (i, 0);
+		}
+		for (integer j = std::max (jmin, integer (1)); j <= jmax; j ++) {
+			const integer source = sources [j];
+			const double left = ( j - 1 >= jmin ? DELTA (i, j - 1) + insertionCost : infinity );
+			const double bottom = ( j <= i - 1 + band ? DELTA (i - 1, j) + my deletionCosts [(size_t) source - 1] : infinity );
+			double mindist = ( j - 1 >= i - 1 - band ? DELTA (i - 1, j - 1) + EditSymbols_getSubstitutionCost (me, target, source) : infinity );
+			integer direction = WARPING_fromDiag;
+			if (bottom < mindist) {
+				mindist = bottom;
+				direction = WARPING_fromBelow;
+			}
+			if (left < mindist) {
+				mindist = left;
+				direction = WARPING_fromLeft;
+			}
+			DELTA (i, j) = mindist;
+			PSI (i, j) = direction;
+			if (mindist < rowMinimum)
+				rowMinimum = mindist;
+		}
+		if (cutoff && rowMinimum > maximumDistance)
+			return undefined;
+	}
+	const double distance = DELTA (numberOfTargets, numberOfSources);
+	#undef DELTA
+	#undef PSI
+	return ( isdefined (maximumDistance) && distance > maximumDistance ? undefined : distance );
+}
+
+static MelderThread_RETURN_TYPE EditDistanceBatch_align (EditDistanceBatch_Args me) {
+	EditSymbols symbols = my symbols;
+	for (integer irow = my firstRow; irow <= my lastRow; irow ++) {
+		constINTVEC targets = (*my targets) [(size_t) irow - 1].get(), sources = (*my sources) [(size_t) irow - 1].get();
+		const double distance = EditSymbols_align (symbols, targets, sources, my maximumDistance, my useBand,
+				my delta.get(), my psi.get());
+		(*my distances) [(size_t) irow - 1] = distance;
+		if (isundef (distance))
+			continue;
+		/*
+			Trace the path back from the end, as WarpingPath_getPath does.
+		*/
+		INTVEC steps = (*my steps) [(size_t) irow - 1].get();
+		integer numberOfSteps = 0;
+		integer i = targets.size, j = sources.size;
+		while (! (i == 0 && j == 0)) {
+			const integer direction = my psi [i + 1] [j + 1];
+			steps [++ numberOfSteps] = direction;
+			if (direction == WARPING_fromLeft) {
+				j --;
+			} else if (direction == WARPING_fromBelow) {
+				i --;
+			} else {
+				i --;
+				j --;
+			}
+		}
+		(*my numbersOfSteps) [(size_t) irow - 1] = numberOfSteps;
+	}
+	MelderThread_RETURN;
+}
+
+#define EditDistanceBatch_MINIMUM_PAIRS_PER_THREAD  100
+
+autoTable Table_EditCostsTable_to_Table_editDistances (Table me, conststring32 targetColumnLabel, conststring32 sourceColumnLabel,
+	bool symbolsAreSeparatedBySpaces, double maximumDistance, EditCostsTable costs)
+{
+	try {
+		const integer targetColumn = Table_getColumnIndexFromColumnLabel (me, targetColumnLabel);
+		const integer sourceColumn = Table_getColumnIndexFromColumnLabel (me, sourceColumnLabel);
+		const integer numberOfRows = my rows.size;
+		autoEditCostsTable defaultCosts;
+		if (! costs) {
+			defaultCosts = EditCostsTable_createDefault ();
+			costs = defaultCosts.get();
+		}
+		/*
+			Intern all the symbols in this thread, so that the threads only read the symbols.
+		*/
+		autoEditSymbols symbols = EditSymbols_create (costs);
+		auto symbolize = [&] (conststring32 string) -> autoINTVEC {
+			if (symbolsAreSeparatedBySpaces) {
+				autostring32vector tokens = STRVECtokenize (string);
+				autoINTVEC result = INTVECraw (tokens.size);
+				for (integer itoken = 1; itoken <= tokens.size; itoken ++)
+					result [itoken] = EditSymbols_intern (symbols.get(), tokens [itoken].get());
+				return result;
+			}
+			autoINTVEC result = INTVECraw (str32len (string));
+			for (integer ichar = 1; ichar <= result.size; ichar ++) {
+				const char32 character [2] = { string [ichar - 1], U'\0' };
+				result [ichar] = EditSymbols_intern (symbols.get(), character);
+			}
+			return result;
+		};
+		std::vector <autoINTVEC> targets, sources;
+		targets. reserve ((size_t) numberOfRows);
+		sources. reserve ((size_t) numberOfRows);
+		for (integer irow = 1; irow <= numberOfRows; irow ++) {
+			targets. push_back (symbolize (Table_getStringValue_Assert (me, irow, targetColumn)));
+			sources. push_back (symbolize (Table_getStringValue_Assert (me, irow, sourceColumn)));
+		}
+
+		std::vector <double> distances ((size_t) numberOfRows);
+		std::vector <autoINTVEC> steps;
+		steps. reserve ((size_t) numberOfRows);
+		for (integer irow = 1; irow <= numberOfRows; irow ++)
+			steps. push_back (INTVECraw (targets [(size_t) irow - 1].size + sources [(size_t) irow - 1].size));
+		std::vector <integer> numbersOfSteps ((size_t) numberOfRows);
+		/*
+			Debug option 66: a single thread, and all the cells of every table.
+		*/
+		const integer numberOfThreads = ( Melder_debug == 66 ? 1 :
+			std::max (integer (1), std::min (numberOfRows / EditDistanceBatch_MINIMUM_PAIRS_PER_THREAD,
+				integer (MelderThread_getNumberOfProcessors ()))) );
+		std::vector <autoEditDistanceBatch_Args> args ((size_t) numberOfThreads);
+		for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+			autoEditDistanceBatch_Args arg = Thing_new (EditDistanceBatch_Args);
+			arg -> symbols = symbols.get();
+			arg -> targets = & targets;
+			arg -> sources = & sources;
+			arg -> firstRow = (ithread - 1) * numberOfRows / numberOfThreads + 1;
+			arg -> lastRow = ithread * numberOfRows / numberOfThreads;
+			arg -> maximumDistance = ( maximumDistance > 0.0 ? maximumDistance : undefined );
+			arg -> useBand = ( Melder_debug != 66 );
+			integer longestTarget = 0, longestSource = 0;
+			for (integer irow = arg -> firstRow; irow <= arg -> lastRow; irow ++) {
+				longestTarget = std::max (longestTarget, targets [(size_t) irow - 1].size);
+				longestSource = std::max (longestSource, sources [(size_t) irow - 1].size);
+			}
+			arg -> delta = MATraw (longestTarget + 1, longestSource + 1);
+			arg -> psi = INTMATraw (longestTarget + 1, longestSource + 1);
+			arg -> distances = & distances;
+			arg -> steps = & steps;
+			arg -> numbersOfSteps = & numbersOfSteps;
+			args [(size_t) ithread - 1] = arg.move();
+		}
+		MelderThread_run (EditDistanceBatch_align, args.data(), (int) numberOfThreads);
+
+		autoTable thee = Table_createWithColumnNames (numberOfRows, U"target source distance targetAlignment sourceAlignment operations");
+		std::u32string targetAlignment, sourceAlignment, operations;
+		for (integer irow = 1; irow <= numberOfRows; irow ++) {
+			const double distance = distances [(size_t) irow - 1];
+			Table_setStringValue (thee.get(), irow, 1, Table_getStringValue_Assert (me, irow, targetColumn));
+			Table_setStringValue (thee.get(), irow, 2, Table_getStringValue_Assert (me, irow, sourceColumn));
+			Table_setNumericValue (thee.get(), irow, 3, distance);
+			/*
+				Label the steps as EditDistanceTable_drawEditOperations does.
+			*/
+			targetAlignment. clear ();
+			sourceAlignment. clear ();
+			operations. clear ();
+			if (isdefined (distance)) {
+				constINTVEC rowTargets = targets [(size_t) irow - 1].get(), rowSources = sources [(size_t) irow - 1].get();
+				constINTVEC rowSteps = steps [(size_t) irow - 1].get();
+				const integer numberOfSteps = numbersOfSteps [(size_t) irow - 1];
+				integer i = 0, j = 0;
+				for (integer istep = numberOfSteps; istep > 0; istep --) {
+					const integer direction = rowSteps [istep];
+					if (istep < numberOfSteps) {
+						targetAlignment += U' ';
+						sourceAlignment += U' ';
+						operations += U' ';
+					}
+					if (direction == WARPING_fromBelow) {   // insertion
+						targetAlignment += symbols -> strings [(size_t) rowTargets [++ i] - 1];
+						sourceAlignment += U'*';
+						operations += U'i';
+					} else if (direction == WARPING_fromLeft) {   // deletion
+						targetAlignment += U'*';
+						sourceAlignment += symbols -> strings [(size_t) rowSources [++ j] - 1];
+						operations += U'd';
+					} else {   // substitution?
+						const integer target = rowTargets [++ i], source = rowSources [++ j];
+						targetAlignment += symbols -> strings [(size_t) target - 1];
+						sourceAlignment += symbols -> strings [(size_t) source - 1];
+						operations += ( target == source ? U'=' : U's' );
+					}
+				}
+			}
+			Table_setStringValue (thee.get(), irow, 4, targetAlignment.c_str ());
+			Table_setStringValue (thee.get(), irow, 5, sourceAlignment.c_str ());
+			Table_setStringValue (thee.get(), irow, 6, operations.c_str ());
+		}
+		return thee;
+	} catch (MelderError) {
+		Melder_throw (me, U": edit distances not computed.");
+	}
+}
+
 autoTableOfReal EditDistanceTable_to_TableOfReal (EditDistanceTable me) {
 	try {
 		autoTableOfReal thee = TableOfReal_create (my numberOfRows, my numberOfColumns);
@@ -20,6 +20,7 @@
 
 #include "Strings_extensions.h"
 #include "TableOfReal.h"
+#include "Table.h"
 
 #define WARPING_fromLeft 1
 #define WARPING_fromBelow 2
@@ -90,4 +91,15 @@ autoTableOfReal EditDistanceTable_to_TableOfReal_directions (EditDistanceTable m
 
 autoTableOfReal EditDistanceTable_to_TableOfReal (EditDistanceTable me);
 
+autoTable Table_EditCostsTable_to_Table_editDistances (Table me, conststring32 targetColumnLabel, conststring32 sourceColumnLabel,
+	bool symbolsAreSeparatedBySpaces, double maximumDistance, EditCostsTable costs);
+/* The edit distance and the alignment of the target and source strings in every row of a Table, computed in threads.
+ * The symbols are interned once, for all the rows together, so that the costs are looked up without comparing strings.
+ * costs == nullptr: the default costs of EditDistanceTable_create.
+ * The distances, and the alignments (with '*' for a missing symbol and i, d, s or = for the operation), are the same as
+ * with an EditDistanceTable for each pair. If maximumDistance > 0, pairs that are further apart get an undefined distance
+ * and no alignment, and with nonnegative costs these are recognized early (Ukkonen's cutoff).
+ * Debug option 66: a single thread, and all the cells of every pair.
+ */
+
 #endif /* _EditDistanceTable_h_ */
@@ -23,6 +23,7 @@
 #include "GaussianMixture.h"
 #include "NUMmachar.h"
 #include "NUM2.h"
+#include "MelderThread.h"
 #include "Strings_extensions.h"
 
 #include "oo_DESTROY.h"
@@ -48,7 +49,7 @@ Thing_implement (GaussianMixture, Daata, 0);
 
 conststring32 GaussianMixture_criterionText (int criterion) {
 	conststring32 criterionText [6] =  { U"(1/n)*LLH", U"(1/n)*MML", U"(1/n)*BIC", U"(1/n)*AIC", U"(1/n)*AICc", U"(1/n)*CD_LLH" };
-	return criterion >= 0 && criterion < 7 ? criterionText [criterion] : U"(1/n)*ln(p)";
+	return criterion >= 0 && criterion < 6 ? criterionText [criterion] : U"(1/n)*ln(p)";
 }
 
 void GaussianMixture_removeComponent (GaussianMixture me, integer component);
@@ -56,6 +57,7 @@ autoMAT GaussianMixture_removeComponent_bookkeeping (GaussianMixture me, integer
 void GaussianMixture_TableOfReal_getProbabilities (GaussianMixture me, TableOfReal thee, integer component, MAT p);
 autoMAT GaussianMixture_TableOfReal_getGammas (GaussianMixture me, TableOfReal thee, double *out_lnp);
 double GaussianMixture_getLikelihoodValue (GaussianMixture me, constMAT p, int onlyLikelyhood);
+static double GaussianMixture_getCriterionValue (GaussianMixture me, double lnp, integer numberOfRows, int criterion);
 void GaussianMixture_updateProbabilityMarginals (GaussianMixture me, MAT p);
 integer GaussianMixture_getNumberOfParametersInComponent (GaussianMixture me);
 
@@ -609,6 +611,23 @@ void GaussianMixture_initialGuess (GaussianMixture me, TableOfReal thee, double
 }
 
 
+/*
+	The squared Mahalanobis distances of all the rows of thee to components firstComponent .. lastComponent,
+	whose lower Cholesky inverses have to be expanded already.
+*/
+static void GaussianMixture_TableOfReal_getMahalanobisDistances (GaussianMixture me, TableOfReal thee,
+	integer firstComponent, integer lastComponent, MATVU const& out_distances)
+{
+	std::vector <constMAT> lowerInverses;
+	std::vector <constVEC> centroids;
+	for (integer ic = firstComponent; ic <= lastComponent; ic ++) {
+		Covariance cov = my covariances->at [ic];
+		lowerInverses.push_back (cov -> lowerCholeskyInverse.get());
+		centroids.push_back (cov -> centroid.get());
+	}
+	NUMmahalanobisDistances (thy data.get(), lowerInverses, centroids, out_distances);
+}
+
 autoClassificationTable GaussianMixture_TableOfReal_to_ClassificationTable (GaussianMixture me, TableOfReal thee) {
 	try {
 		autoClassificationTable him = ClassificationTable_create (thy numberOfRows, my numberOfComponents);
@@ -619,12 +638,13 @@ autoClassificationTable GaussianMixture_TableOfReal_to_ClassificationTable (Gaus
 		}
 
 		double ln2pid = -0.5 * my dimension * log (NUM2pi);
+		GaussianMixture_TableOfReal_getMahalanobisDistances (me, thee, 1, my numberOfComponents, his data.get());
 		autoVEC lnN = VECraw (my numberOfComponents);
 		for (integer irow = 1; irow <=  thy numberOfRows; irow ++) {
 			longdouble psum = 0.0;
 			for (integer ic = 1; ic <= my numberOfComponents; ic ++) {
 				Covariance cov = my covariances->at [ic];
-				double dsq = NUMmahalanobisDistance (cov -> lowerCholeskyInverse.get(), thy data.row (irow), cov -> centroid.get());
+				double dsq = his data [irow] [ic];
 				lnN [ic] = ln2pid - 0.5 * (cov -> lnd + dsq);
 				psum += his data [irow] [ic] = my mixingProbabilities [ic] * exp (lnN [ic]);
 			}
@@ -758,12 +778,13 @@ void GaussianMixture_TableOfReal_getProbabilities (GaussianMixture me, TableOfRe
 		if (component > 0 && component <= my numberOfComponents) // if component == 0 update all probabilities
 			icb = ice = component;
 		
+		for (integer ic = icb; ic <= ice; ic ++)
+			SSCP_expandLowerCholeskyInverse (my covariances->at [ic]);
+		GaussianMixture_TableOfReal_getMahalanobisDistances (me, thee, icb, ice, p.part (1, thy numberOfRows, icb, ice));
 		for (integer ic = icb; ic <= ice; ic ++) {
 			Covariance covi = my covariances->at [ic];
-			SSCP_expandLowerCholeskyInverse (covi);
-
 			for (integer i = 1; i <= thy numberOfRows; i++) {
-				double dsq = NUMmahalanobisDistance (covi -> lowerCholeskyInverse.get(), thy data.row (i), covi -> centroid.get());
+				double dsq = p [i] [ic];
 				p [i] [ic] = std::max (1e-300, exp (- 0.5 * (ln2pid + covi -> lnd + dsq))); // prevent p from being zero
 			}
 		}
@@ -788,6 +809,204 @@ void GaussianMixture_unExpandPCA (GaussianMixture me) {
 	}
 }
 
+/*
+	The E-step without a probability matrix: the rows are streamed in blocks on several threads,
+	and every thread accumulates the sufficient statistics of the components for its own rows.
+	The sums and the scatter matrices are taken around the centroids of the E-step,
+	which keeps them small and the M-step accurate.
+	All buffers are allocated in the main thread; the threads allocate nothing.
+*/
+Thing_define (GaussianMixture_sufficientStatistics_Args, Thing) {
+public:
+	GaussianMixture gaussianMixture;
+	constMAT data;
+	const std::vector <constMAT> *lowerInverses;
+	const std::vector <constVEC> *centroids;
+	integer firstRow, lastRow;
+	bool accumulate;   // the statistics of the components, or only the log likelihoods
+	autoMAT distances, probabilities, differences;   // of a block of rows
+	autoVEC row;
+	autoVEC numberOfObservations;   // [component]: the sum of the responsibilities
+	autoMAT sums;   // [component] [column]
+	std::vector <autoMAT> scatters;   // [component - 1]: the upper triangle, or one row if diagonal
+	longdouble lnp, lnpcd;
+};
+
+Thing_implement (GaussianMixture_sufficientStatistics_Args, Thing, 0);
+
+#define GaussianMixture_BLOCK_SIZE  32
+
+static MelderThread_RETURN_TYPE GaussianMixture_sufficientStatistics_block (GaussianMixture_sufficientStatistics_Args me) {
+	GaussianMixture gm = my gaussianMixture;
+	const integer numberOfComponents = gm -> numberOfComponents, dimension = gm -> dimension;
+	const double ln2pid = dimension * log (NUM2pi);
+	for (integer firstRow = my firstRow; firstRow <= my lastRow; firstRow += GaussianMixture_BLOCK_SIZE) {
+		const integer lastRow = std::min (firstRow + GaussianMixture_BLOCK_SIZE - 1, my lastRow), blockSize = lastRow - firstRow + 1;
+		MATVU distances = my distances.part (1, blockSize, 1, numberOfComponents);
+		NUMmahalanobisDistances_preallocated (my data.part (firstRow, lastRow, 1, dimension), *my lowerInverses, *my centroids,
+			distances, my differences.get());
+		for (integer i = 1; i <= blockSize; i ++) {
+			/*
+				The same probabilities as in GaussianMixture_TableOfReal_getProbabilities,
+				and the same log likelihoods as in GaussianMixture_getLikelihoodValue.
+			*/
+			VEC p = my probabilities.row (i);
+			for (integer ic = 1; ic <= numberOfComponents; ic ++) {
+				Covariance cov = gm -> covariances->at [ic];
+				p [ic] = std::max (1e-300, exp (- 0.5 * (ln2pid + cov -> lnd + distances [i] [ic])));
+			}
+			const double psum = NUMinner (gm -> mixingProbabilities.get(), p);
+			if (psum > 0.0)
+				my lnp += (longdouble) log (psum);
+			longdouble ppsum = 0.0, lnsum = 0.0;
+			for (integer ic = 1; ic <= numberOfComponents; ic ++) {
+				longdouble pp = gm -> mixingProbabilities [ic] * p [ic];
+				ppsum += pp;
+				lnsum += pp * log (pp);
+			}
+			if (ppsum > 0)
+				my lnpcd += lnsum / ppsum;
+			if (! my accumulate || psum == 0.0)
+				continue;
+			/*
+				The responsibilities (Bishop eq. 9.13) and their weighted sums (eqs. 9.17 and 9.19).
+			*/
+			constVEC x = my data.row (firstRow + i - 1);
+			for (integer ic = 1; ic <= numberOfComponents; ic ++) {
+				const double gamma = gm -> mixingProbabilities [ic] * p [ic] / psum;
+				if (gamma == 0.0)
+					continue;
+				constVEC centroid = (*my centroids) [(size_t) ic - 1];
+				for (integer j = 1; j <= dimension; j ++)
+					my row [j] = x [j] - centroid [j];
+				my numberOfObservations [ic] += gamma;
+				VECaxpy (my sums.row (ic), my row.get(), gamma);
+				MAT scatter = my scatters [(size_t) ic - 1].get();
+				if (scatter.nrow == 1) {
+					for (integer j = 1; j <= dimension; j ++)
+						scatter [1] [j] += gamma * my row [j] * my row [j];
+				} else {
+					for (integer j = 1; j <= dimension; j ++) {
+						const double gx = gamma * my row [j];
+						for (integer k = j; k <= dimension; k ++)
+							scatter [j] [k] += gx * my row [k];
+					}
+				}
+			}
+		}
+	}
+	MelderThread_RETURN;
+}
+
+#define GaussianMixture_MINIMUM_PRODUCTS_PER_THREAD  100000
+
+/*
+	One pass over the rows of thee with the current parameters of me.
+	Returns in args [0] the reduced statistics and log likelihoods.
+*/
+static void GaussianMixture_TableOfReal_getSufficientStatistics (GaussianMixture me, TableOfReal thee, bool accumulate,
+	std::vector <autoGaussianMixture_sufficientStatistics_Args>& args)
+{
+	std::vector <constMAT> lowerInverses;
+	std::vector <constVEC> centroids;
+	for (integer ic = 1; ic <= my numberOfComponents; ic ++) {
+		Covariance cov = my covariances->at [ic];
+		SSCP_expandLowerCholeskyInverse (cov);
+		lowerInverses.push_back (cov -> lowerCholeskyInverse.get());
+		centroids.push_back (cov -> centroid.get());
+	}
+	if (args.size() == 0) {
+		const double numberOfProducts = (double) thy numberOfRows * my numberOfComponents * my dimension * (my dimension + 1);
+		const integer numberOfBlocks = (thy numberOfRows - 1) / GaussianMixture_BLOCK_SIZE + 1;
+		const integer numberOfThreads = std::max (integer (1), std::min ({ Melder_ifloor (numberOfProducts / GaussianMixture_MINIMUM_PRODUCTS_PER_THREAD),
+			numberOfBlocks, integer (MelderThread_getNumberOfProcessors ()) }));
+		integer firstBlock = 1;
+		for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+			autoGaussianMixture_sufficientStatistics_Args arg = Thing_new (GaussianMixture_sufficientStatistics_Args);
+			arg -> gaussianMixture = me;
+			arg -> data = thy data.get();
+			arg -> distances = MATraw (GaussianMixture_BLOCK_SIZE, my numberOfComponents);
+			arg -> probabilities = MATraw (GaussianMixture_BLOCK_SIZE, my numberOfComponents);
+			arg -> differences = MATraw (GaussianMixture_BLOCK_SIZE, my dimension);
+			arg -> row = VECraw (my dimension);
+			arg -> numberOfObservations = VECzero (my numberOfComponents);
+			arg -> sums = MATzero (my numberOfComponents, my dimension);
+			for (integer ic = 1; ic <= my numberOfComponents; ic ++) {
+				Covariance cov = my covariances->at [ic];
+				arg -> scatters.push_back (MATzero (cov -> numberOfRows == 1 ? 1 : my dimension, my dimension));
+			}
+			const integer lastBlock = ithread * numberOfBlocks / numberOfThreads;
+			arg -> firstRow = (firstBlock - 1) * GaussianMixture_BLOCK_SIZE + 1;
+			arg -> lastRow = std::min (lastBlock * GaussianMixture_BLOCK_SIZE, thy numberOfRows);
+			firstBlock = lastBlock + 1;
+			args.push_back (arg.move());
+		}
+	}
+	for (size_t ithread = 0; ithread < args.size(); ithread ++) {
+		GaussianMixture_sufficientStatistics_Args arg = args [ithread].get();
+		arg -> lowerInverses = & lowerInverses;
+		arg -> centroids = & centroids;
+		arg -> accumulate = accumulate;
+		arg -> lnp = arg -> lnpcd = 0.0;
+		VECmultiply_inplace (arg -> numberOfObservations.get(), 0.0);
+		MATmultiply_inplace (arg -> sums.get(), 0.0);
+		for (integer ic = 1; ic <= my numberOfComponents; ic ++)
+			MATmultiply_inplace (arg -> scatters [(size_t) ic - 1].get(), 0.0);
+	}
+	MelderThread_run (GaussianMixture_sufficientStatistics_block, args.data(), (int) args.size());
+	GaussianMixture_sufficientStatistics_Args total = args [0].get();
+	for (size_t ithread = 1; ithread < args.size(); ithread ++) {
+		GaussianMixture_sufficientStatistics_Args arg = args [ithread].get();
+		total -> lnp += arg -> lnp;
+		total -> lnpcd += arg -> lnpcd;
+		if (! accumulate)
+			continue;
+		VECadd_inplace (total -> numberOfObservations.get(), arg -> numberOfObservations.get());
+		MATadd_inplace (total -> sums.get(), arg -> sums.get());
+		for (integer ic = 1; ic <= my numberOfComponents; ic ++)
+			MATadd_inplace (total -> scatters [(size_t) ic - 1].get(), arg -> scatters [(size_t) ic - 1].get());
+	}
+}
+
+static double GaussianMixture_sufficientStatistics_getCriterionValue (GaussianMixture me, GaussianMixture_sufficientStatistics_Args total,
+	integer numberOfRows, int criterion)
+{
+	return criterion == GaussianMixture_CD_LIKELIHOOD ? (double) total -> lnpcd :
+		GaussianMixture_getCriterionValue (me, (double) total -> lnp, numberOfRows, criterion);
+}
+
+/*
+	The M-step from the statistics, with the same results as GaussianMixture_updateCovariance
+	and the update of the mixing probabilities in the probability-matrix version.
+*/
+static void GaussianMixture_updateFromSufficientStatistics (GaussianMixture me, GaussianMixture_sufficientStatistics_Args total,
+	integer numberOfRows, Covariance covg, double lambda)
+{
+	for (integer ic = 1; ic <= my numberOfComponents; ic ++) {
+		Covariance thee = my covariances->at [ic];
+		const double gsum = total -> numberOfObservations [ic];
+		constVEC sum = total -> sums.row (ic);
+		constMAT scatter = total -> scatters [(size_t) ic - 1].get();
+		autoVEC shift = VECraw (my dimension);   // from the old to the new centroid
+		for (integer j = 1; j <= my dimension; j ++) {
+			shift [j] = sum [j] / gsum;
+			thy centroid [j] += shift [j];
+		}
+		if (thy numberOfRows == 1) {
+			for (integer j = 1; j <= my dimension; j ++)
+				thy data [1] [j] = scatter [1] [j] / gsum - shift [j] * shift [j];
+		} else {
+			for (integer j = 1; j <= my dimension; j ++)
+				for (integer k = j; k <= my dimension; k ++)
+					thy data [j] [k] = thy data [k] [j] = scatter [j] [k] / gsum - shift [j] * shift [k];
+		}
+		thy numberOfObservations = my mixingProbabilities [ic] * numberOfRows;
+		GaussianMixture_addCovarianceFraction (me, ic, covg, lambda);
+	}
+	for (integer ic = 1; ic <= my numberOfComponents; ic ++)
+		my mixingProbabilities [ic] = total -> numberOfObservations [ic] / numberOfRows;
+}
+
 void GaussianMixture_TableOfReal_improveLikelihood (GaussianMixture me, TableOfReal thee, double delta_lnp, integer maxNumberOfIterations, double lambda, int criterion) {
 	try {
 		conststring32 criterionText = GaussianMixture_criterionText (criterion);
@@ -796,12 +1015,23 @@ void GaussianMixture_TableOfReal_improveLikelihood (GaussianMixture me, TableOfR
 		// mixture covariances to prevent numerical instabilities.
 
 		autoCovariance covg = TableOfReal_to_Covariance (thee);
+		/*
+			The E-step streams the rows and only keeps the sufficient statistics of the components;
+			Debug option 69 keeps all the probabilities in a matrix instead.
+		*/
+		const bool streaming = ( Melder_debug != 69 );
+		std::vector <autoGaussianMixture_sufficientStatistics_Args> args;
 		// p's last row has the column marginals n(k)
-		autoMAT p = MATraw (thy numberOfRows + 1, my numberOfComponents + 1);
-		
-		GaussianMixture_TableOfReal_getProbabilities (me, thee, 0, p.get()); // get initial p's
-
-		double lnp = GaussianMixture_getLikelihoodValue (me, p.get(), criterion);
+		autoMAT p;
+		double lnp;
+		if (streaming) {
+			GaussianMixture_TableOfReal_getSufficientStatistics (me, thee, true, args);
+			lnp = GaussianMixture_sufficientStatistics_getCriterionValue (me, args [0].get(), thy numberOfRows, criterion);
+		} else {
+			p = MATraw (thy numberOfRows + 1, my numberOfComponents + 1);
+			GaussianMixture_TableOfReal_getProbabilities (me, thee, 0, p.get()); // get initial p's
+			lnp = GaussianMixture_getLikelihoodValue (me, p.get(), criterion);
+		}
 		integer iter = 0;
 		autoMelderProgress progress (U"Improve likelihood...");
 		try {
@@ -813,20 +1043,26 @@ void GaussianMixture_TableOfReal_improveLikelihood (GaussianMixture me, TableOfR
 
 				lnp_prev = lnp;
 				iter ++;
-				// M-step: 1. new means & covariances
+				if (streaming) {
+					GaussianMixture_updateFromSufficientStatistics (me, args [0].get(), thy numberOfRows, covg.get(), lambda);
+					GaussianMixture_TableOfReal_getSufficientStatistics (me, thee, true, args);
+					lnp = GaussianMixture_sufficientStatistics_getCriterionValue (me, args [0].get(), thy numberOfRows, criterion);
+				} else {
+					// M-step: 1. new means & covariances
 
-				for (integer im = 1; im <= my numberOfComponents; im ++) {
-					GaussianMixture_updateCovariance (me, im, thy data.get(), p.get());
-					GaussianMixture_addCovarianceFraction (me, im, covg.get(), lambda);
-				}
+					for (integer im = 1; im <= my numberOfComponents; im ++) {
+						GaussianMixture_updateCovariance (me, im, thy data.get(), p.get());
+						GaussianMixture_addCovarianceFraction (me, im, covg.get(), lambda);
+					}
+
+					// M-step: 2. new mixingProbabilities
+					my mixingProbabilities.all() <<= p.row (p.nrow).part (1, p.ncol - 1);
+					VECmultiply_inplace (my mixingProbabilities.get(), 1.0 / thy numberOfRows);
 
-				// M-step: 2. new mixingProbabilities
-				my mixingProbabilities.all() <<= p.row (p.nrow).part (1, p.ncol - 1);
-				VECmultiply_inplace (my mixingProbabilities.get(), 1.0 / thy numberOfRows);
-				
-				GaussianMixture_TableOfReal_getProbabilities (me, thee, 0, p.get());
-				
-				lnp = GaussianMixture_getLikelihoodValue (me, p.get(), criterion);
+					GaussianMixture_TableOfReal_getProbabilities (me, thee, 0, p.get());
+
+					lnp = GaussianMixture_getLikelihoodValue (me, p.get(), criterion);
+				}
 				Melder_progress ((double) iter / (double) maxNumberOfIterations, criterionText, U": ", lnp / thy numberOfRows, U", L0: ", lnp_start);
 			} while (fabs ((lnp - lnp_prev) / lnp_prev) > delta_lnp && iter < maxNumberOfIterations);
 		} catch (MelderError) {
@@ -894,9 +1130,14 @@ autoMAT GaussianMixture_removeComponent_bookkeeping (GaussianMixture me, integer
 }
 
 double GaussianMixture_TableOfReal_getLikelihoodValue (GaussianMixture me, TableOfReal thee, int criterion) {
-	autoMAT p = MATraw (thy numberOfRows + 1, my numberOfComponents + 1);
-	GaussianMixture_TableOfReal_getProbabilities (me, thee, 0, p.get());
-	return GaussianMixture_getLikelihoodValue (me, p.get(), criterion);;
+	if (Melder_debug == 69) {
+		autoMAT p = MATraw (thy numberOfRows + 1, my numberOfComponents + 1);
+		GaussianMixture_TableOfReal_getProbabilities (me, thee, 0, p.get());
+		return GaussianMixture_getLikelihoodValue (me, p.get(), criterion);
+	}
+	std::vector <autoGaussianMixture_sufficientStatistics_Args> args;
+	GaussianMixture_TableOfReal_getSufficientStatistics (me, thee, false, args);
+	return GaussianMixture_sufficientStatistics_getCriterionValue (me, args [0].get(), thy numberOfRows, criterion);
 }
 
 double GaussianMixture_getLikelihoodValue (GaussianMixture me, constMAT p, int criterion) {
@@ -926,7 +1167,10 @@ double GaussianMixture_getLikelihoodValue (GaussianMixture me, constMAT p, int c
 		if (psum > 0.0)
 			lnp += (longdouble) log (psum);
 	}
+	return GaussianMixture_getCriterionValue (me, (double) lnp, p.nrow - 1, criterion);
+}
 
+static double GaussianMixture_getCriterionValue (GaussianMixture me, double lnp, integer numberOfRows, int criterion) {
 	if (criterion == GaussianMixture_LIKELIHOOD)
 		return lnp;
 
@@ -945,15 +1189,15 @@ double GaussianMixture_getLikelihoodValue (GaussianMixture me, constMAT p, int c
 
 		// a rewritten L(theta,Y) is
 
-		return lnp - 0.5 * my numberOfComponents * (npars + 1) * (log ((p.nrow - 1) / 12.0) + 1.0)
+		return lnp - 0.5 * my numberOfComponents * (npars + 1) * (log (numberOfRows / 12.0) + 1.0)
 		       + 0.5 * npars * logmpn;
 	} else if (criterion == GaussianMixture_BIC)
-		return 2.0 * lnp - np * log (p.nrow - 1.0);
+		return 2.0 * lnp - np * log ((double) numberOfRows);
 	else if (criterion == GaussianMixture_AIC)
 		return 2.0 * (lnp - np);
 	else if (criterion == GaussianMixture_AICC) {
 		np = npars * my numberOfComponents;
-		return 2.0 * (lnp - np * ((p.nrow - 1.0) / (p.nrow - 1.0 - np - 1.0)));
+		return 2.0 * (lnp - np * (numberOfRows / (numberOfRows - np - 1.0)));
 	}
 	return lnp;
 }
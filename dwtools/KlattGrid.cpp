@@ -42,6 +42,7 @@
 #include "Sound_to_Formant.h"
 #include "Sound_to_Intensity.h"
 #include "Sound_to_Pitch.h"
+#include "MelderThread.h"
 
 #include "oo_DESTROY.h"
 #include "KlattGrid_def.h"
@@ -284,38 +285,36 @@ static void _Sounds_add_inplace (Sound me, Sound thee) {
 		my z [1] [i] += thy z [1] [i];
 }
 
-static autoSound _Sound_diff (Sound me, int scale) {
-	try {
-		autoSound thee = Data_copy (me);
-
-		// extremum
-		double amax1 = -1.0e34, amax2 = amax1, val, pval = 0.0;
-		if (scale) {
-			for (integer i = 1; i <= thy nx; i ++) {
-				val = fabs (thy z [1] [i]);
-				if (val > amax1)
-					amax1 = val;
-			}
-		}
-		// x [n]-x [n-1]
+/*
+	The first difference of `me` into `thee`, which has the same shape.
+*/
+static void _Sound_diff_inplace (Sound me, Sound thee, int scale) {
+	thy z.all() <<= my z.all();
+
+	// extremum
+	double amax1 = -1.0e34, amax2 = amax1, val, pval = 0.0;
+	if (scale) {
 		for (integer i = 1; i <= thy nx; i ++) {
-			val = thy z [1] [i];
-			thy z [1] [i] -=  pval;
-			pval = val;
+			val = fabs (thy z [1] [i]);
+			if (val > amax1)
+				amax1 = val;
 		}
-		if (scale) {
-			for (integer i = 1; i <= thy nx; i ++) {
-				val = fabs (thy z [1] [i]);
-				if (val > amax2)
-					amax2 = val;
-			}
-			// scale
-			for (integer i = 1; i <= thy nx; i ++)
-				thy z [1] [i] *= amax1 / amax2;
+	}
+	// x [n]-x [n-1]
+	for (integer i = 1; i <= thy nx; i ++) {
+		val = thy z [1] [i];
+		thy z [1] [i] -=  pval;
+		pval = val;
+	}
+	if (scale) {
+		for (integer i = 1; i <= thy nx; i ++) {
+			val = fabs (thy z [1] [i]);
+			if (val > amax2)
+				amax2 = val;
 		}
-		return thee;
-	} catch (MelderError) {
-		Melder_throw (me, U": not differenced.");
+		// scale
+		for (integer i = 1; i <= thy nx; i ++)
+			thy z [1] [i] *= amax1 / amax2;
 	}
 }
 
@@ -449,6 +448,62 @@ static void draw_oneSection (Graphics g, double xmin, double xmax, double ymin,
 
 /************************ Sound & FormantGrid *********************************************/
 
+/*
+	The tiers of a formant are sampled only at the block boundaries, every KlattGrid_FILTER_BLOCK_SIZE samples,
+	and the filter coefficients are interpolated linearly within each block (Filter_filterBlock_inplace).
+	At the block boundaries the coefficients are exactly those that setting them at every sample would give.
+	A block with an unusable frequency, bandwidth or amplitude at one of its boundaries is filtered sample by sample,
+	and Debug option 63 filters all blocks sample by sample, as before.
+*/
+#define KlattGrid_FILTER_BLOCK_SIZE  32
+
+/*
+	Set the coefficients at time t as the per-sample filtering does,
+	and tell whether they can be interpolated to or from.
+*/
+static bool Filter_setFromTiers (Filter me, RealTier ftier, RealTier btier, RealTier atier, double t, double nyquist) {
+	const double f = RealTier_getValueAtTime (ftier, t);
+	const double b = RealTier_getValueAtTime (btier, t);
+	if (! (f <= nyquist && isdefined (b)))
+		return false;
+	Filter_setFB (me, f, b);
+	if (atier) {
+		const double a = RealTier_getValueAtTime (atier, t);
+		if (isundef (a))
+			return false;
+		my a *= DB_to_A (a);
+	}
+	return b > 0.0;
+}
+
+static void Sound_Filter_filterWithFormantTiers_inplace (Sound me, Filter r, RealTier ftier, RealTier btier, RealTier atier) {
+	const double nyquist = 0.5 / my dx;
+	const integer blockSize = ( Melder_debug == 63 ? 1 : KlattGrid_FILTER_BLOCK_SIZE );
+	VEC samples = my z.row (1);
+	bool interpolatable = Filter_setFromTiers (r, ftier, btier, atier, my x1, nyquist);
+	for (integer firstSample = 1; firstSample <= my nx; firstSample += blockSize) {
+		const integer nextBlockStart = firstSample + blockSize;
+		const integer lastSample = std::min (nextBlockStart - 1, my nx);
+		const double a1 = r -> a, b1 = r -> b, c1 = r -> c;   // at firstSample
+		const bool interpolatableAtStart = interpolatable;
+		const double nextBlockTime = my x1 + (nextBlockStart - 1) * my dx;
+		interpolatable = Filter_setFromTiers (r, ftier, btier, atier, nextBlockTime, nyquist);
+		if (interpolatableAtStart && interpolatable) {
+			Filter_filterBlock_inplace (r, samples.part (firstSample, lastSample), a1, b1, c1, blockSize);
+		} else {
+			r -> a = a1;
+			r -> b = b1;
+			r -> c = c1;
+			for (integer is = firstSample; is <= lastSample; is ++) {
+				if (is > firstSample)
+					(void) Filter_setFromTiers (r, ftier, btier, atier, my x1 + (is - 1) * my dx, nyquist);
+				samples [is] = Filter_getOutput (r, samples [is]);
+			}
+			interpolatable = Filter_setFromTiers (r, ftier, btier, atier, nextBlockTime, nyquist);
+		}
+	}
+}
+
 static void _Sound_FormantGrid_filterWithOneFormant_inplace (Sound me, FormantGrid thee, integer iformant, int antiformant) {
 	if (iformant < 1 || iformant > thy formants.size) {
 		Melder_warning (U"Formant ", iformant, U" does not exist.");
@@ -460,21 +515,12 @@ static void _Sound_FormantGrid_filterWithOneFormant_inplace (Sound me, FormantGr
 		return;
 	if (ftier -> points.size == 0 || btier -> points.size == 0)
 		Melder_throw (U"Empty tier");
-	double nyquist = 0.5 / my dx;
 	autoFilter r;
 	if (antiformant != 0)
 		r = AntiResonator_create (my dx);
 	else
 		r = Resonator_create (my dx, Resonator_NORMALISATION_H0);
-
-	for (integer is = 1; is <= my nx; is ++) {
-		double t = my x1 + (is - 1) * my dx;
-		double f = RealTier_getValueAtTime (ftier, t);
-		double b = RealTier_getValueAtTime (btier, t);
-		if (f <= nyquist && isdefined (b))
-			Filter_setFB (r.get(), f, b);
-		my z [1] [is] = Filter_getOutput (r.get(), my z [1] [is]);
-	}
+	Sound_Filter_filterWithFormantTiers_inplace (me, r.get(), ftier, btier, nullptr);
 }
 
 void Sound_FormantGrid_filterWithOneAntiFormant_inplace (Sound me, FormantGrid thee, integer iformant) {
@@ -488,8 +534,6 @@ void Sound_FormantGrid_filterWithOneFormant_inplace (Sound me, FormantGrid thee,
 void Sound_FormantGrid_Intensities_filterWithOneFormant_inplace (Sound me, FormantGrid thee, OrderedOf<structIntensityTier>* amplitudes, integer iformant) {
 	try {
 		Melder_require (iformant > 0 && iformant <= thy formants.size, U"Formant ", iformant, U" not defined.");
-		
-		double nyquist = 0.5 / my dx;
 
 		RealTier ftier = thy formants.at [iformant];
 		RealTier btier = thy bandwidths.at [iformant];
@@ -498,46 +542,119 @@ void Sound_FormantGrid_Intensities_filterWithOneFormant_inplace (Sound me, Forma
 		if (ftier -> points.size == 0 || btier -> points.size == 0 || atier -> points.size == 0)
 			return;    // nothing to do
 		autoResonator r = Resonator_create (my dx, Resonator_NORMALISATION_HMAX);
-		for (integer is = 1; is <= my nx; is ++) {
-			double t = my x1 + (is - 1) * my dx;
-			double f = RealTier_getValueAtTime (ftier, t);
-			double b = RealTier_getValueAtTime (btier, t);
-			double a;
-			if (f <= nyquist && isdefined (b)) {
-				Filter_setFB (r.get(), f, b);
-				a = RealTier_getValueAtTime (atier, t);
-				if (isdefined (a))
-					r -> a *= DB_to_A (a);
-			}
-			my z [1] [is] = Filter_getOutput (r.get(), my z [1] [is]);
-		}
+		Sound_Filter_filterWithFormantTiers_inplace (me, r.get(), ftier, btier, atier);
 	} catch (MelderError) {
 		Melder_throw (me, U": not filtered with one formant filter.");
 	}
 }
 
-autoSound Sound_FormantGrid_Intensities_filter (Sound me, FormantGrid thee, OrderedOf<structIntensityTier>* amplitudes, integer iformantb, integer iformante, int alternatingSign) {
-	try {
-		if (iformantb > iformante) {
-			iformantb = 1;
-			iformante = thy formants.size;
-		}
-		Melder_require (iformantb > 0 && iformantb <= thy formants.size , U"From formant ", iformantb, U" not defined.");
-		Melder_require (iformante > 0 && iformante <= thy formants.size , U"To formant ", iformante, U" not defined.");
+/*
+	The formants of a parallel synthesizer are independent branches, which are filtered in threads;
+	their outputs are added afterwards in the order of the formants, so that the sum does not depend on the number of threads.
+	The branches, their resonators and the output are created beforehand, in the main thread,
+	so that filling them allocates nothing; a synthesis is created for a single fill.
+*/
+Thing_define (Sound_FormantGrid_Intensities_filter_Args, Thing) { public:
+	FormantGrid formantGrid;
+	OrderedOf<structIntensityTier>* amplitudes;
+	OrderedOf<structSound>* branches;
+	OrderedOf<structResonator>* resonators;
+	constINTVEC formantNumbers;
+	integer firstBranch, lastBranch;
+};
 
-		autoSound him = Sound_create (my ny, my xmin, my xmax, my nx, my dx, my x1);
+Thing_implement (Sound_FormantGrid_Intensities_filter_Args, Thing, 0);
 
-		for (integer iformant = iformantb; iformant <= iformante; iformant ++) {
-			if (FormantGrid_Intensities_isFormantDefined (thee, amplitudes, iformant)) {
-				autoSound tmp = Data_copy (me);
-				Sound_FormantGrid_Intensities_filterWithOneFormant_inplace (tmp.get(), thee, amplitudes, iformant);
-				for (integer is = 1; is <= my nx; is ++)
-					his z [1] [is] += ( alternatingSign >= 0 ? tmp -> z [1] [is] : - tmp -> z [1] [is] );
-				if (alternatingSign != 0)
-					alternatingSign = - alternatingSign;
-			}
-		}
-		return him;
+static MelderThread_RETURN_TYPE Sound_FormantGrid_Intensities_filterBranches (Sound_FormantGrid_Intensities_filter_Args me) {
+	FormantGrid thee = my formantGrid;
+	for (integer ibranch = my firstBranch; ibranch <= my lastBranch; ibranch ++) {
+		const integer iformant = my formantNumbers [ibranch];
+		Sound_Filter_filterWithFormantTiers_inplace (my branches->at [ibranch], my resonators->at [ibranch],
+				thy formants.at [iformant], thy bandwidths.at [iformant], my amplitudes->at [iformant]);
+	}
+	MelderThread_RETURN;
+}
+
+Thing_define (ParallelFormantSynthesis, Thing) {
+	int alternatingSign;
+	OrderedOf<structSound> branches;
+	OrderedOf<structResonator> resonators;
+	autoINTVEC formantNumbers;
+	std::vector <autoSound_FormantGrid_Intensities_filter_Args> args;   // one per thread
+	autoSound output;
+};
+
+Thing_implement (ParallelFormantSynthesis, Thing, 0);
+
+/*
+	For input Sounds with the shape of `me`; with useThreads false, filling it runs in the calling thread.
+*/
+static autoParallelFormantSynthesis Sound_FormantGrid_Intensities_createParallelSynthesis (Sound me, FormantGrid thee,
+	OrderedOf<structIntensityTier>* amplitudes, integer iformantb, integer iformante, int alternatingSign, bool useThreads)
+{
+	if (iformantb > iformante) {
+		iformantb = 1;
+		iformante = thy formants.size;
+	}
+	Melder_require (iformantb > 0 && iformantb <= thy formants.size , U"From formant ", iformantb, U" not defined.");
+	Melder_require (iformante > 0 && iformante <= thy formants.size , U"To formant ", iformante, U" not defined.");
+
+	autoParallelFormantSynthesis synthesis = Thing_new (ParallelFormantSynthesis);
+	synthesis -> alternatingSign = alternatingSign;
+	synthesis -> output = Sound_create (my ny, my xmin, my xmax, my nx, my dx, my x1);
+	synthesis -> formantNumbers = INTVECraw (iformante - iformantb + 1);
+	integer numberOfBranches = 0;
+	for (integer iformant = iformantb; iformant <= iformante; iformant ++) {
+		if (FormantGrid_Intensities_isFormantDefined (thee, amplitudes, iformant)) {
+			synthesis -> branches. addItem_move (Sound_create (my ny, my xmin, my xmax, my nx, my dx, my x1));
+			synthesis -> resonators. addItem_move (Resonator_create (my dx, Resonator_NORMALISATION_HMAX));
+			synthesis -> formantNumbers [++ numberOfBranches] = iformant;
+		}
+	}
+	if (numberOfBranches == 0)
+		return synthesis;
+	const integer numberOfThreads = ( ! useThreads || Melder_debug == 63 ? 1 :
+		std::min (numberOfBranches, integer (MelderThread_getNumberOfProcessors ())) );
+	synthesis -> args. resize ((size_t) numberOfThreads);
+	for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+		autoSound_FormantGrid_Intensities_filter_Args arg = Thing_new (Sound_FormantGrid_Intensities_filter_Args);
+		arg -> formantGrid = thee;
+		arg -> amplitudes = amplitudes;
+		arg -> branches = & synthesis -> branches;
+		arg -> resonators = & synthesis -> resonators;
+		arg -> formantNumbers = synthesis -> formantNumbers.get();
+		arg -> firstBranch = 1 + (ithread - 1) * numberOfBranches / numberOfThreads;
+		arg -> lastBranch = ithread * numberOfBranches / numberOfThreads;
+		synthesis -> args [(size_t) ithread - 1] = arg.move();
+	}
+	return synthesis;
+}
+
+static void ParallelFormantSynthesis_fill (ParallelFormantSynthesis me, Sound input) {
+	const integer numberOfBranches = my branches.size;
+	if (numberOfBranches == 0)
+		return;
+	for (integer ibranch = 1; ibranch <= numberOfBranches; ibranch ++)
+		my branches.at [ibranch] -> z.all() <<= input -> z.all();
+	MelderThread_run (Sound_FormantGrid_Intensities_filterBranches, my args.data(), (int) my args.size());
+
+	int alternatingSign = my alternatingSign;
+	VEC output = my output -> z.row (1);
+	for (integer ibranch = 1; ibranch <= numberOfBranches; ibranch ++) {
+		Sound branch = my branches.at [ibranch];
+		for (integer is = 1; is <= output.size; is ++)
+			output [is] += ( alternatingSign >= 0 ? branch -> z [1] [is] : - branch -> z [1] [is] );
+		if (alternatingSign != 0)
+			alternatingSign = - alternatingSign;
+	}
+}
+
+autoSound Sound_FormantGrid_Intensities_filter (Sound me, FormantGrid thee, OrderedOf<structIntensityTier>* amplitudes, integer iformantb, integer iformante, int alternatingSign) {
+	try {
+		autoParallelFormantSynthesis synthesis = Sound_FormantGrid_Intensities_createParallelSynthesis (me, thee,
+				amplitudes, iformantb, iformante, alternatingSign, true);
+		ParallelFormantSynthesis_fill (synthesis.get(), me);
+		return synthesis -> output.move();
 	} catch (MelderError) {
 		Melder_throw (me, U": not filtered.");
 	}
@@ -804,25 +921,44 @@ static autoPointProcess PitchTier_to_PointProcess_flutter (PitchTier pitch, Real
 	}
 }
 
-autoSound PhonationGrid_to_Sound_aspiration (PhonationGrid me, double samplingFrequency) {
-	try {
-		autoSound thee = Sound_createEmptyMono (my xmin, my xmax, samplingFrequency);
+/*
+	Uniform noise between -1 and 1, from the given random stream (in a SynthesisBatch),
+	or else from the main stream.
+*/
+static void KlattGrid_fillNoise (VEC const& noise, NUMrandomStream *randomStream) {
+	if (randomStream)
+		randomStream -> fillUniform (noise, -1.0, 1.0);
+	else
+		VECrandomUniform_inplace (noise, -1.0, 1.0);
+}
 
-		// Noise spectrum is tilted down by soft low-pass filter having a pole near
-		// the origin in the z-plane, i.e. y [n] = x [n] + (0.75 * y [n-1])
-		double lastval = 0.0;
-		if (my aspirationAmplitude -> points.size > 0) {
-			for (integer i = 1; i <= thy nx; i ++) {
-				double t = thy x1 + (i - 1) * thy dx;
-				double val = NUMrandomUniform (-1.0, 1.0);
-				double a = DBSPL_to_A (RealTier_getValueAtTime (my aspirationAmplitude.get(), t));
-				if (isdefined (a)) {
-					thy z [1] [i] = lastval = val + 0.75 * lastval;
-					lastval = (val += 0.75 * lastval); // soft low-pass
-					thy z [1] [i] = val * a;
-				}
+/*
+	Into `thee`, which is zero, with `noise` as scratch.
+*/
+static void PhonationGrid_fillAspiration (PhonationGrid me, Sound thee, VEC const& noise, NUMrandomStream *randomStream) {
+	// Noise spectrum is tilted down by soft low-pass filter having a pole near
+	// the origin in the z-plane, i.e. y [n] = x [n] + (0.75 * y [n-1])
+	double lastval = 0.0;
+	if (my aspirationAmplitude -> points.size > 0) {
+		KlattGrid_fillNoise (noise, randomStream);
+		for (integer i = 1; i <= thy nx; i ++) {
+			double t = thy x1 + (i - 1) * thy dx;
+			double val = noise [i];
+			double a = DBSPL_to_A (RealTier_getValueAtTime (my aspirationAmplitude.get(), t));
+			if (isdefined (a)) {
+				thy z [1] [i] = lastval = val + 0.75 * lastval;
+				lastval = (val += 0.75 * lastval); // soft low-pass
+				thy z [1] [i] = val * a;
 			}
 		}
+	}
+}
+
+autoSound PhonationGrid_to_Sound_aspiration (PhonationGrid me, double samplingFrequency, NUMrandomStream *randomStream) {
+	try {
+		autoSound thee = Sound_createEmptyMono (my xmin, my xmax, samplingFrequency);
+		autoVEC noise = VECraw (thy nx);
+		PhonationGrid_fillAspiration (me, thee.get(), noise.get(), randomStream);
 		return thee;
 	} catch (MelderError) {
 		Melder_throw (me, U": no aspiration Sound created.");
@@ -1001,162 +1137,183 @@ autoPhonationTier PhonationGrid_to_PhonationTier (PhonationGrid me) {
 	}
 }
 
-static autoSound PhonationGrid_PhonationTier_to_Sound_voiced (PhonationGrid me, PhonationTier thee, double samplingFrequency) {
-	try {
-		PhonationGridPlayOptions p = my options.get();
-		double lastVal = undefined;
-
-		Melder_require (my voicingAmplitude -> points.size > 0,
-			U"Voicing amplitude tier should not be empty.");
-
-		autoSound him = Sound_createEmptyMono (my xmin, my xmax, samplingFrequency);
-		autoSound breathy;
-		if (p -> breathiness && my breathinessAmplitude -> points.size > 0)
-			breathy = Sound_createEmptyMono (my xmin, my xmax, samplingFrequency);
+/*
+	Into `him`, which is zero, with the breathiness into `breathy` (zero as well), if the latter exists.
+*/
+static void PhonationGrid_PhonationTier_fillVoiced (PhonationGrid me, PhonationTier thee, Sound him, Sound breathy, NUMrandomStream *randomStream) {
+	PhonationGridPlayOptions p = my options.get();
+	double lastVal = undefined;
 
-		/*
-			Cycle through the points of the PhonationTier. Each will become a period.
-			We assume that the planning for the pitch period occurs approximately at a time T before the glottal closure.
-			For each point t [i]:
-				Determine the f0 -> period T [i]
-				Determine time t [i]-T [i] the open quotient, power1, power2, collisionphase etc.
-				Generate the period.
-		*/
-		VEC sound = his z.row (1);
-		for (integer it = 1; it <= thy points.size; it ++) {
-			PhonationPoint point = thy points.at [it];
-			double t = point -> number;		// the glottis "closing" point
-			double te = point -> te;
-			double period = point -> period; // duration of the current period
-			double openPhase = point -> openPhase;
-			double collisionPhase = point -> collisionPhase;
-			double pulseScale = point -> pulseScale;        // For alternate pulses in case of diplophonia
-			double power1 = point -> power1, power2 = point -> power2;
-			double phase;                 // 0..1
-			double flow;
-
-			//- double amplitude = pulseScale * (power1 + power2 + 1.0) / (power2 - power1);
-			//- amplitude /= period * openPhase;
-
-			// Maximum of U(x) = x^n - x^m is where the derivative U'(x) = n x^(n-1) - m x^(m-1) == 0,
-			//	i.e. (n/m) = x^(m-n), so xmax = (n/m)^(1/(m-n))
-			//	U(xmax) = x^n (1-x^(m-n)) = (n/m)^(n/(m-n))(1-n/m)
-
-			double amplitude = pulseScale / (pow (power1 / power2, 1.0 / (power2 / power1 - 1.0)) * (1.0 - power1 / power2));
-
-			// Fill in the samples to the left of the current point.
-
-			integer midSample = Sampled_xToLowIndex (him.get(), t), beginSample;
-			beginSample = midSample - Melder_ifloor (te / his dx);
-			if (beginSample < 1)
-				beginSample = 0;
-			if (midSample > his nx)
-				midSample = his nx;
-			for (integer i = beginSample; i <= midSample; i ++) {
-				double tsamp = his x1 + (i - 1) * his dx;
-				phase = (tsamp - (t - te)) / (period * openPhase);
-				if (phase > 0.0) {
-					flow = amplitude * (pow (phase, power1) - pow (phase, power2));
-					if (i == 0) {
-						lastVal = flow;    // For the derivative
-						continue;
-					}
-					sound [i] += flow;
+	/*
+		Cycle through the points of the PhonationTier. Each will become a period.
+		We assume that the planning for the pitch period occurs approximately at a time T before the glottal closure.
+		For each point t [i]:
+			Determine the f0 -> period T [i]
+			Determine time t [i]-T [i] the open quotient, power1, power2, collisionphase etc.
+			Generate the period.
+	*/
+	VEC sound = his z.row (1);
+	for (integer it = 1; it <= thy points.size; it ++) {
+		PhonationPoint point = thy points.at [it];
+		double t = point -> number;		// the glottis "closing" point
+		double te = point -> te;
+		double period = point -> period; // duration of the current period
+		double openPhase = point -> openPhase;
+		double collisionPhase = point -> collisionPhase;
+		double pulseScale = point -> pulseScale;        // For alternate pulses in case of diplophonia
+		double power1 = point -> power1, power2 = point -> power2;
+		double phase;                 // 0..1
+		double flow;
+
+		//- double amplitude = pulseScale * (power1 + power2 + 1.0) / (power2 - power1);
+		//- amplitude /= period * openPhase;
+
+		// Maximum of U(x) = x^n - x^m is where the derivative U'(x) = n x^(n-1) - m x^(m-1) == 0,
+		//	i.e. (n/m) = x^(m-n), so xmax = (n/m)^(1/(m-n))
+		//	U(xmax) = x^n (1-x^(m-n)) = (n/m)^(n/(m-n))(1-n/m)
+
+		double amplitude = pulseScale / (pow (power1 / power2, 1.0 / (power2 / power1 - 1.0)) * (1.0 - power1 / power2));
+
+		// Fill in the samples to the left of the current point.
+
+		integer midSample = Sampled_xToLowIndex (him, t), beginSample;
+		beginSample = midSample - Melder_ifloor (te / his dx);
+		if (beginSample < 1)
+			beginSample = 0;
+		if (midSample > his nx)
+			midSample = his nx;
+		for (integer i = beginSample; i <= midSample; i ++) {
+			double tsamp = his x1 + (i - 1) * his dx;
+			phase = (tsamp - (t - te)) / (period * openPhase);
+			if (phase > 0.0) {
+				flow = amplitude * (pow (phase, power1) - pow (phase, power2));
+				if (i == 0) {
+					lastVal = flow;    // For the derivative
+					continue;
+				}
+				sound [i] += flow;
 
-					// Breathiness only during open part modulated by the flow
-					if (breathy) {
-						double val = flow * NUMrandomUniform (-1.0, 1.0);
-						double a = RealTier_getValueAtTime (my breathinessAmplitude.get(), t);
-						breathy -> z [1] [i] += val * DBSPL_to_A (a);
-					}
+				// Breathiness only during open part modulated by the flow
+				if (breathy) {
+					double val = flow * ( randomStream ? randomStream -> uniform (-1.0, 1.0) : NUMrandomUniform (-1.0, 1.0) );
+					double a = RealTier_getValueAtTime (my breathinessAmplitude.get(), t);
+					breathy -> z [1] [i] += val * DBSPL_to_A (a);
 				}
 			}
+		}
 
-			// Determine the signal parameters at the current point.
-
-			phase = te / (period * openPhase);
+		// Determine the signal parameters at the current point.
 
-			//- double flow = amplitude * (period * openPhase) * (pow (phase, power1) - pow (phase, power2));
+		phase = te / (period * openPhase);
 
-			flow = amplitude * (pow (phase, power1) - pow (phase, power2));
+		//- double flow = amplitude * (period * openPhase) * (pow (phase, power1) - pow (phase, power2));
 
-			// Fill in the samples to the right of the current point.
+		flow = amplitude * (pow (phase, power1) - pow (phase, power2));
 
-			if (flow > 0.0) {
-				double ta = collisionPhase * (period * openPhase);
-				double factorPerSample = exp (- his dx / ta);
-				double value = flow * exp (- (his x1 + midSample * his dx - t) / ta);
-				integer endSample = midSample + Melder_ifloor (20.0 * ta / his dx);
-				if (endSample > his nx)
-					endSample = his nx;
-				for (integer i = midSample + 1; i <= endSample; i ++) {
-					sound [i] += value;
-					value *= factorPerSample;
-				}
-			}
-		}
+		// Fill in the samples to the right of the current point.
 
-		// Scale voiced part and add breathiness during open phase
-		if (p -> flowDerivative) {
-			double extremum = Vector_getAbsoluteExtremum (him.get(), 0.0, 0.0, Vector_VALUE_INTERPOLATION_CUBIC);
-			if (isundef (lastVal))
-				lastVal = 0.0;
-			for (integer i = 1; i <= his nx; i ++) {
-				double val = his z [1] [i];
-				his z [1] [i] -= lastVal;
-				lastVal = val;
+		if (flow > 0.0) {
+			double ta = collisionPhase * (period * openPhase);
+			double factorPerSample = exp (- his dx / ta);
+			double value = flow * exp (- (his x1 + midSample * his dx - t) / ta);
+			integer endSample = midSample + Melder_ifloor (20.0 * ta / his dx);
+			if (endSample > his nx)
+				endSample = his nx;
+			for (integer i = midSample + 1; i <= endSample; i ++) {
+				sound [i] += value;
+				value *= factorPerSample;
 			}
-			Vector_scale (him.get(), extremum);
 		}
+	}
 
+	// Scale voiced part and add breathiness during open phase
+	if (p -> flowDerivative) {
+		double extremum = Vector_getAbsoluteExtremum (him, 0.0, 0.0, Vector_VALUE_INTERPOLATION_CUBIC);
+		if (isundef (lastVal))
+			lastVal = 0.0;
 		for (integer i = 1; i <= his nx; i ++) {
-			double t = his x1 + (i - 1) * his dx;
-			his z [1] [i] *= DBSPL_to_A (RealTier_getValueAtTime (my voicingAmplitude.get(), t));
-			if (breathy)
-				his z [1] [i] += breathy -> z [1] [i];
+			double val = his z [1] [i];
+			his z [1] [i] -= lastVal;
+			lastVal = val;
 		}
-		return him;
-	} catch (MelderError) {
-		Melder_throw (me, U": no Sound created.");
+		Vector_scale (him, extremum);
 	}
-}
 
-static autoSound PhonationGrid_to_Sound_voiced (PhonationGrid me, double samplingFrequency) {
-	try {
-		autoPhonationTier thee = PhonationGrid_to_PhonationTier (me);
-		return PhonationGrid_PhonationTier_to_Sound_voiced (me, thee.get(), samplingFrequency);
-	} catch (MelderError) {
-		Melder_throw (me, U": no voiced Sound created.");
+	for (integer i = 1; i <= his nx; i ++) {
+		double t = his x1 + (i - 1) * his dx;
+		his z [1] [i] *= DBSPL_to_A (RealTier_getValueAtTime (my voicingAmplitude.get(), t));
+		if (breathy)
+			his z [1] [i] += breathy -> z [1] [i];
 	}
 }
 
-static autoSound PhonationGrid_to_Sound (PhonationGrid me, CouplingGrid him, double samplingFrequency) {
+/*
+	The sources of a PhonationGrid, created beforehand (in the main thread), so that filling them allocates nothing.
+*/
+Thing_define (PhonationSynthesis, Thing) {
+	PhonationGrid phonationGrid;
+	PhonationTier glottis;   // the glottis of the coupling, or ownGlottis
+	autoPhonationTier ownGlottis;
+	autoSound breathy, aspiration;
+	autoVEC aspirationNoise;
+};
+
+Thing_implement (PhonationSynthesis, Thing, 0);
+
+static autoPhonationSynthesis PhonationGrid_createSynthesis (PhonationGrid me, CouplingGrid him, double samplingFrequency) {
 	try {
 		PhonationGridPlayOptions pp = my options.get();
-		autoSound thee;
+		autoPhonationSynthesis synthesis = Thing_new (PhonationSynthesis);
+		synthesis -> phonationGrid = me;
 		if (pp -> voicing) {
-			if (him && his glottis -> points.size > 0)
-				thee = PhonationGrid_PhonationTier_to_Sound_voiced (me, his glottis.get(), samplingFrequency);
-			else
-				thee = PhonationGrid_to_Sound_voiced (me, samplingFrequency);
-			if (pp -> spectralTilt)
-				Sound_PhonationGrid_spectralTilt_inplace (thee.get(), me);
+			if (him && his glottis -> points.size > 0) {
+				synthesis -> glottis = his glottis.get();
+			} else {
+				synthesis -> ownGlottis = PhonationGrid_to_PhonationTier (me);
+				synthesis -> glottis = synthesis -> ownGlottis.get();
+			}
+			Melder_require (my voicingAmplitude -> points.size > 0,
+				U"Voicing amplitude tier should not be empty.");
+			if (pp -> breathiness && my breathinessAmplitude -> points.size > 0)
+				synthesis -> breathy = Sound_createEmptyMono (my xmin, my xmax, samplingFrequency);
 		}
 		if (pp -> aspiration) {
-			autoSound aspiration = PhonationGrid_to_Sound_aspiration (me, samplingFrequency);
-			if (thee)
-				_Sounds_add_inplace (thee.get(), aspiration.get());
-			else
-				thee = aspiration.move();
+			synthesis -> aspiration = Sound_createEmptyMono (my xmin, my xmax, samplingFrequency);
+			synthesis -> aspirationNoise = VECraw (synthesis -> aspiration -> nx);
 		}
-		if (! thee)
-			thee = Sound_createEmptyMono (my xmin, my xmax, samplingFrequency);
-		return thee;
+		return synthesis;
 	} catch (MelderError) {
 		Melder_throw (me, U": no Sound created.");
 	}
 }
 
+/*
+	Into `thee`, which is zero.
+*/
+static void PhonationSynthesis_fill (PhonationSynthesis me, Sound thee, NUMrandomStream *randomStream) {
+	PhonationGrid grid = my phonationGrid;
+	PhonationGridPlayOptions pp = grid -> options.get();
+	if (pp -> voicing) {
+		PhonationGrid_PhonationTier_fillVoiced (grid, my glottis, thee, my breathy.get(), randomStream);
+		if (pp -> spectralTilt)
+			Sound_PhonationGrid_spectralTilt_inplace (thee, grid);
+	}
+	if (pp -> aspiration) {
+		PhonationGrid_fillAspiration (grid, my aspiration.get(), my aspirationNoise.get(), randomStream);
+		if (pp -> voicing)
+			_Sounds_add_inplace (thee, my aspiration.get());
+		else
+			thy z.all() <<= my aspiration -> z.all();
+	}
+}
+
+static autoSound PhonationGrid_to_Sound (PhonationGrid me, CouplingGrid him, double samplingFrequency, NUMrandomStream *randomStream) {
+	autoPhonationSynthesis synthesis = PhonationGrid_createSynthesis (me, him, samplingFrequency);
+	autoSound thee = Sound_createEmptyMono (my xmin, my xmax, samplingFrequency);
+	PhonationSynthesis_fill (synthesis.get(), thee.get(), randomStream);
+	return thee;
+}
+
 static void formantsAmplitudes_create (OrderedOf<structIntensityTier>* me, double tmin, double tmax, integer numberOfFormants) {
 	try {
 		for (integer i = 1; i <= numberOfFormants; i ++) {
@@ -1462,7 +1619,38 @@ static void VocalTractGrid_CouplingGrid_draw (VocalTractGrid me, CouplingGrid th
 	Graphics_unsetInner (g);
 }
 
-static autoSound Sound_VocalTractGrid_CouplingGrid_filter_cascade (Sound me, VocalTractGrid thee, CouplingGrid coupling) {
+/*
+	The filters of a VocalTractGrid, created beforehand (in the main thread), so that filling them allocates nothing.
+	Cascade: the formants in the order of filtering, each with its tiers.
+	Parallel: the first oral formant on the source, the nasal formants on the source,
+	the other oral formants and the tracheal formants on the differentiated source.
+*/
+Thing_define (VocalTractSynthesis, Thing) {
+	autoFormantGrid oralFormants;   // a copy, if updated with the open phases of the glottis or (cascade) filtered with
+
+	OrderedOf<structFilter> filters;
+	OrderedOf<structRealTier> frequencyTiers, bandwidthTiers;   // not owned
+
+	bool firstOralFormant;
+	autoResonator firstOralResonator;   // null if one of the tiers is empty
+	RealTier firstOralFrequencyTier, firstOralBandwidthTier;
+	IntensityTier firstOralAmplitudeTier;
+	autoParallelFormantSynthesis nasal, oral, trachea;
+	autoSound differentiatedSource;
+};
+
+Thing_implement (VocalTractSynthesis, Thing, 0);
+
+static void VocalTractSynthesis_addFilter (VocalTractSynthesis me, FormantGrid formants, integer iformant, double dx, bool antiformant) {
+	if (antiformant)
+		my filters. addItem_move (AntiResonator_create (dx));
+	else
+		my filters. addItem_move (Resonator_create (dx, Resonator_NORMALISATION_H0));
+	my frequencyTiers. addItem_ref (formants -> formants.at [iformant]);
+	my bandwidthTiers. addItem_ref (formants -> bandwidths.at [iformant]);
+}
+
+static autoVocalTractSynthesis Sound_VocalTractGrid_CouplingGrid_createCascadeSynthesis (Sound me, VocalTractGrid thee, CouplingGrid coupling) {
 	try {
 		VocalTractGridPlayOptions pv = thy options.get();
 		CouplingGridPlayOptions pc = coupling -> options.get();
@@ -1473,7 +1661,7 @@ static autoSound Sound_VocalTractGrid_CouplingGrid_filter_cascade (Sound me, Voc
 		FormantGrid tracheal_formants = coupling -> tracheal_formants.get();
 		FormantGrid tracheal_antiformants = coupling -> tracheal_antiformants.get();
 
-		int antiformants = 0;
+		bool antiformants = false;
 		integer numberOfFormants = oral_formants -> formants.size;
 		integer numberOfTrachealFormants = tracheal_formants -> formants.size;
 		integer numberOfTrachealAntiFormants = tracheal_antiformants -> formants.size;
@@ -1485,20 +1673,19 @@ static autoSound Sound_VocalTractGrid_CouplingGrid_filter_cascade (Sound me, Voc
 		check_formants (numberOfNasalAntiFormants, & pv -> startNasalAntiFormant, & pv -> endNasalAntiFormant);
 		check_formants (numberOfTrachealAntiFormants, & pc -> startTrachealAntiFormant, & pc -> endTrachealAntiFormant);
 
-		autoSound him = Data_copy (me);
+		autoVocalTractSynthesis synthesis = Thing_new (VocalTractSynthesis);
 
-		autoFormantGrid formants;
 		if (useOpenGlottisInfo) {
-			formants = Data_copy (thy oral_formants.get());
-			FormantGrid_CouplingGrid_updateOpenPhases (formants.get(), coupling);
+			synthesis -> oralFormants = Data_copy (thy oral_formants.get());
+			FormantGrid_CouplingGrid_updateOpenPhases (synthesis -> oralFormants.get(), coupling);
 		}
 
 		integer nasal_formant_warning = 0, any_warning = 0;
 		if (pv -> endNasalFormant > 0) {   // nasal formants
-			antiformants = 0;
+			antiformants = false;
 			for (integer iformant = pv -> startNasalFormant; iformant <= pv -> endNasalFormant; iformant ++) {
 				if (FormantGrid_isFormantDefined (thy nasal_formants.get(), iformant)) {
-					_Sound_FormantGrid_filterWithOneFormant_inplace (him.get(), thy nasal_formants.get(), iformant, antiformants);
+					VocalTractSynthesis_addFilter (synthesis.get(), thy nasal_formants.get(), iformant, my dx, antiformants);
 				} else {
 					// Melder_warning ("Nasal formant", iformant, ": frequency and/or bandwidth missing.");
 					nasal_formant_warning ++; any_warning ++;
@@ -1508,10 +1695,10 @@ static autoSound Sound_VocalTractGrid_CouplingGrid_filter_cascade (Sound me, Voc
 
 		integer nasal_antiformant_warning = 0;
 		if (pv -> endNasalAntiFormant > 0) {   // nasal antiformants
-			antiformants = 1;
+			antiformants = true;
 			for (integer iformant = pv -> startNasalAntiFormant; iformant <= pv -> endNasalAntiFormant; iformant ++) {
 				if (FormantGrid_isFormantDefined (thy nasal_antiformants.get(), iformant)) {
-					_Sound_FormantGrid_filterWithOneFormant_inplace (him.get(), thy nasal_antiformants.get(), iformant, antiformants);
+					VocalTractSynthesis_addFilter (synthesis.get(), thy nasal_antiformants.get(), iformant, my dx, antiformants);
 				} else {
 					// Melder_warning ("Nasal antiformant", iformant, ": frequency and/or bandwidth missing.");
 					nasal_antiformant_warning ++; any_warning ++;
@@ -1521,10 +1708,10 @@ static autoSound Sound_VocalTractGrid_CouplingGrid_filter_cascade (Sound me, Voc
 
 		integer tracheal_formant_warning = 0;
 		if (pc -> endTrachealFormant > 0) {   // tracheal formants
-			antiformants = 0;
+			antiformants = false;
 			for (integer iformant = pc -> startTrachealFormant; iformant <= pc -> endTrachealFormant; iformant ++) {
 				if (FormantGrid_isFormantDefined (tracheal_formants, iformant)) {
-					_Sound_FormantGrid_filterWithOneFormant_inplace (him.get(), tracheal_formants, iformant, antiformants);
+					VocalTractSynthesis_addFilter (synthesis.get(), tracheal_formants, iformant, my dx, antiformants);
 				} else {
 					// Melder_warning ("Tracheal formant", iformant, ": frequency and/or bandwidth missing.");
 					tracheal_formant_warning ++; any_warning ++;
@@ -1534,10 +1721,10 @@ static autoSound Sound_VocalTractGrid_CouplingGrid_filter_cascade (Sound me, Voc
 
 		integer tracheal_antiformant_warning = 0;
 		if (pc -> endTrachealAntiFormant > 0) {   // tracheal antiformants
-			antiformants = 1;
+			antiformants = true;
 			for (integer iformant = pc -> startTrachealAntiFormant; iformant <= pc -> endTrachealAntiFormant; iformant ++) {
 				if (FormantGrid_isFormantDefined (tracheal_antiformants, iformant)) {
-					_Sound_FormantGrid_filterWithOneFormant_inplace (him.get(), tracheal_antiformants, iformant, antiformants);
+					VocalTractSynthesis_addFilter (synthesis.get(), tracheal_antiformants, iformant, my dx, antiformants);
 				} else {
 					// Melder_warning ("Tracheal antiformant", iformant, ": frequency and/or bandwidth missing.");
 					tracheal_antiformant_warning ++; any_warning ++;
@@ -1547,13 +1734,13 @@ static autoSound Sound_VocalTractGrid_CouplingGrid_filter_cascade (Sound me, Voc
 
 		integer oral_formant_warning = 0;
 		if (pv -> endOralFormant > 0) {   // oral formants
-			antiformants = 0;
-			if (! formants) {
-				formants = Data_copy (thy oral_formants.get());
+			antiformants = false;
+			if (! synthesis -> oralFormants) {
+				synthesis -> oralFormants = Data_copy (thy oral_formants.get());
 			}
 			for (integer iformant = pv -> startOralFormant; iformant <= pv -> endOralFormant; iformant ++) {
-				if (FormantGrid_isFormantDefined (formants.get(), iformant)) {
-					_Sound_FormantGrid_filterWithOneFormant_inplace (him.get(), formants.get(), iformant, antiformants);
+				if (FormantGrid_isFormantDefined (synthesis -> oralFormants.get(), iformant)) {
+					VocalTractSynthesis_addFilter (synthesis.get(), synthesis -> oralFormants.get(), iformant, my dx, antiformants);
 				} else {
 					// Melder_warning ("Oral formant", iformant, ": frequency and/or bandwidth missing.");
 					oral_formant_warning ++; any_warning ++;
@@ -1581,22 +1768,19 @@ static autoSound Sound_VocalTractGrid_CouplingGrid_filter_cascade (Sound me, Voc
 			MelderInfo_write (U"\nWarning:\n", warning.string);
 			MelderInfo_drain ();
 		}
-		return him;
+		return synthesis;
 	} catch (MelderError) {
 		Melder_throw (me, U": not filtered by vocaltract and coupling grid.");
 	}
 }
 
-static autoSound Sound_VocalTractGrid_CouplingGrid_filter_parallel (Sound me, VocalTractGrid thee, CouplingGrid coupling) {
+static autoVocalTractSynthesis Sound_VocalTractGrid_CouplingGrid_createParallelSynthesis (Sound me, VocalTractGrid thee, CouplingGrid coupling, bool useThreads) {
 	try {
 		VocalTractGridPlayOptions pv = thy options.get();
 		CouplingGridPlayOptions pc = coupling -> options.get();
-		autoSound him;
 		FormantGrid oral_formants = thy oral_formants.get();
-		autoFormantGrid aof;
 		int alternatingSign = 0; // 0: no alternating signs in parallel adding of filter outputs, 1/-1 start sign
 		bool useOpenGlottisInfo = pc -> openglottis && coupling -> glottis && coupling -> glottis -> points.size > 0;
-		int scale = 1;
 		integer numberOfFormants = thy oral_formants -> formants.size;
 		integer numberOfNasalFormants = thy nasal_formants -> formants.size;
 		integer numberOfTrachealFormants = coupling -> tracheal_formants -> formants.size;
@@ -1605,30 +1789,34 @@ static autoSound Sound_VocalTractGrid_CouplingGrid_filter_parallel (Sound me, Vo
 		check_formants (numberOfNasalFormants, & (pv -> startNasalFormant), & (pv -> endNasalFormant));
 		check_formants (numberOfTrachealFormants, & (pc -> startTrachealFormant), & (pc -> endTrachealFormant));
 
+		autoVocalTractSynthesis synthesis = Thing_new (VocalTractSynthesis);
+
 		if (useOpenGlottisInfo) {
-			aof = Data_copy (thy oral_formants.get());
-			oral_formants = aof.get();
+			synthesis -> oralFormants = Data_copy (thy oral_formants.get());
+			oral_formants = synthesis -> oralFormants.get();
 			FormantGrid_CouplingGrid_updateOpenPhases (oral_formants, coupling);
 		}
 
 		if (pv -> endOralFormant > 0) {
 			if (pv -> startOralFormant == 1) {
-				him = Data_copy (me);
+				synthesis -> firstOralFormant = true;
 				if (oral_formants -> formants.size > 0) {
-					Sound_FormantGrid_Intensities_filterWithOneFormant_inplace (him.get(), oral_formants, & thy oral_formants_amplitudes, 1);
+					synthesis -> firstOralFrequencyTier = oral_formants -> formants.at [1];
+					synthesis -> firstOralBandwidthTier = oral_formants -> bandwidths.at [1];
+					synthesis -> firstOralAmplitudeTier = thy oral_formants_amplitudes.at [1];
+					if (synthesis -> firstOralFrequencyTier -> points.size > 0 &&
+						synthesis -> firstOralBandwidthTier -> points.size > 0 &&
+						synthesis -> firstOralAmplitudeTier -> points.size > 0
+					)
+						synthesis -> firstOralResonator = Resonator_create (my dx, Resonator_NORMALISATION_HMAX);
 				}
 			}
 		}
 
 		if (pv -> endNasalFormant > 0) {
 			alternatingSign = 0;
-			autoSound nasal = Sound_FormantGrid_Intensities_filter (me, thy nasal_formants.get(), & thy nasal_formants_amplitudes, pv -> startNasalFormant, pv -> endNasalFormant, alternatingSign);
-
-			if (! him) {
-				him = Data_copy (nasal.get());
-			} else {
-				_Sounds_add_inplace (him.get(), nasal.get());
-			}
+			synthesis -> nasal = Sound_FormantGrid_Intensities_createParallelSynthesis (me, thy nasal_formants.get(),
+					& thy nasal_formants_amplitudes, pv -> startNasalFormant, pv -> endNasalFormant, alternatingSign, useThreads);
 		}
 
 		// Formants 2 and up, with alternating signs.
@@ -1637,47 +1825,94 @@ static autoSound Sound_VocalTractGrid_CouplingGrid_filter_parallel (Sound me, Vo
 		// energy from them. This energy would otherwise distort the spectrum in the region of F1 during the synthesis
 		// of some vowels.
 
-		autoSound me_diff = _Sound_diff (me, scale);
-
 		if (pv -> endOralFormant >= 2) {
 			integer startOralFormant2 = pv -> startOralFormant > 2 ? pv -> startOralFormant : 2;
 			alternatingSign = ( startOralFormant2 % 2 == 0 ? -1 : 1 );   // 2 starts with negative sign
 			if (startOralFormant2 <= oral_formants -> formants.size) {
-				autoSound vocalTract = Sound_FormantGrid_Intensities_filter (me_diff.get(), oral_formants, & thy oral_formants_amplitudes, startOralFormant2, pv -> endOralFormant, alternatingSign);
-
-				if (! him) {
-					him = Data_copy (vocalTract.get());
-				} else {
-					_Sounds_add_inplace (him.get(), vocalTract.get());
-				}
+				synthesis -> oral = Sound_FormantGrid_Intensities_createParallelSynthesis (me, oral_formants,
+						& thy oral_formants_amplitudes, startOralFormant2, pv -> endOralFormant, alternatingSign, useThreads);
 			}
 		}
 
 		if (pc -> endTrachealFormant > 0) {   // tracheal formants
 			alternatingSign = 0;
-			autoSound trachea = Sound_FormantGrid_Intensities_filter (me_diff.get(), coupling -> tracheal_formants.get(), & coupling -> tracheal_formants_amplitudes,
-								pc -> startTrachealFormant, pc -> endTrachealFormant, alternatingSign);
-
-			if (! him) {
-				him = Data_copy (trachea.get());
-			} else {
-				_Sounds_add_inplace (him.get(), trachea.get());
-			}
+			synthesis -> trachea = Sound_FormantGrid_Intensities_createParallelSynthesis (me, coupling -> tracheal_formants.get(),
+					& coupling -> tracheal_formants_amplitudes, pc -> startTrachealFormant, pc -> endTrachealFormant, alternatingSign, useThreads);
 		}
 
-		if (! him) {
-			him = Data_copy (me);
-		}
-		return him;
+		if (synthesis -> oral || synthesis -> trachea)
+			synthesis -> differentiatedSource = Sound_create (my ny, my xmin, my xmax, my nx, my dx, my x1);
+		return synthesis;
 	} catch (MelderError) {
 		Melder_throw (me, U": not filtered in parallel.");
 	}
 }
 
-autoSound Sound_VocalTractGrid_CouplingGrid_filter (Sound me, VocalTractGrid thee, CouplingGrid coupling) {
+static autoVocalTractSynthesis Sound_VocalTractGrid_CouplingGrid_createSynthesis (Sound me, VocalTractGrid thee, CouplingGrid coupling, bool useThreads) {
 	return thy options -> filterModel == KlattGrid_FILTER_CASCADE ?
-	       Sound_VocalTractGrid_CouplingGrid_filter_cascade (me, thee, coupling) :
-	       Sound_VocalTractGrid_CouplingGrid_filter_parallel (me, thee, coupling);
+	       Sound_VocalTractGrid_CouplingGrid_createCascadeSynthesis (me, thee, coupling) :
+	       Sound_VocalTractGrid_CouplingGrid_createParallelSynthesis (me, thee, coupling, useThreads);
+}
+
+/*
+	The first contribution to `thee` is copied, the others are added.
+*/
+static void _Sound_addContribution_inplace (Sound me, Sound thee, bool *inout_hasContribution) {
+	if (*inout_hasContribution)
+		_Sounds_add_inplace (me, thee);
+	else
+		my z.all() <<= thy z.all();
+	*inout_hasContribution = true;
+}
+
+/*
+	`source` filtered into `thee`.
+*/
+static void VocalTractSynthesis_fill (VocalTractSynthesis me, Sound source, Sound thee) {
+	/*
+		Cascade.
+	*/
+	if (my filters.size > 0) {
+		thy z.all() <<= source -> z.all();
+		for (integer ifilter = 1; ifilter <= my filters.size; ifilter ++)
+			Sound_Filter_filterWithFormantTiers_inplace (thee, my filters.at [ifilter],
+					my frequencyTiers.at [ifilter], my bandwidthTiers.at [ifilter], nullptr);
+		return;
+	}
+	/*
+		Parallel (or a cascade without formants).
+	*/
+	bool hasContribution = false;
+	if (my firstOralFormant) {
+		thy z.all() <<= source -> z.all();
+		if (my firstOralResonator)
+			Sound_Filter_filterWithFormantTiers_inplace (thee, my firstOralResonator.get(),
+					my firstOralFrequencyTier, my firstOralBandwidthTier, my firstOralAmplitudeTier);
+		hasContribution = true;
+	}
+	if (my nasal) {
+		ParallelFormantSynthesis_fill (my nasal.get(), source);
+		_Sound_addContribution_inplace (thee, my nasal -> output.get(), & hasContribution);
+	}
+	if (my differentiatedSource)
+		_Sound_diff_inplace (source, my differentiatedSource.get(), 1);
+	if (my oral) {
+		ParallelFormantSynthesis_fill (my oral.get(), my differentiatedSource.get());
+		_Sound_addContribution_inplace (thee, my oral -> output.get(), & hasContribution);
+	}
+	if (my trachea) {
+		ParallelFormantSynthesis_fill (my trachea.get(), my differentiatedSource.get());
+		_Sound_addContribution_inplace (thee, my trachea -> output.get(), & hasContribution);
+	}
+	if (! hasContribution)
+		thy z.all() <<= source -> z.all();
+}
+
+autoSound Sound_VocalTractGrid_CouplingGrid_filter (Sound me, VocalTractGrid thee, CouplingGrid coupling) {
+	autoVocalTractSynthesis synthesis = Sound_VocalTractGrid_CouplingGrid_createSynthesis (me, thee, coupling, true);
+	autoSound him = Sound_create (my ny, my xmin, my xmax, my nx, my dx, my x1);
+	VocalTractSynthesis_fill (synthesis.get(), me, him.get());
+	return him;
 }
 
 /********************** CouplingGridPlayOptions **********************/
@@ -1922,61 +2157,107 @@ void FricationGrid_draw (FricationGrid me, Graphics g) {
 	Graphics_unsetInner (g);
 }
 
-autoSound FricationGrid_to_Sound (FricationGrid me, double samplingFrequency) {
-	try {
-		autoSound thee = Sound_createEmptyMono (my xmin, my xmax, samplingFrequency);
+/*
+	The noise and filters of a FricationGrid, created beforehand (in the main thread), so that filling them allocates nothing.
+*/
+Thing_define (FricationSynthesis, Thing) {
+	FricationGrid fricationGrid;
+	autoVEC noise;
+	autoSound source;
+	autoParallelFormantSynthesis formants;   // null if the frication formants from 2 on are off
+};
 
-		double lastval = 0.0;
-		for (integer i = 1; i <= thy nx; i ++) {
-			double t = thy x1 + (i - 1) * thy dx;
-			double val = NUMrandomUniform (-1.0, 1.0);
-			double a = 0.0;
-			if (my fricationAmplitude -> points.size > 0) {
-				double dba = RealTier_getValueAtTime (my fricationAmplitude.get(), t);
-				a = ( isdefined (dba) ? DBSPL_to_A (dba) : 0.0 );
+Thing_implement (FricationSynthesis, Thing, 0);
+
+static autoParallelFormantSynthesis Sound_FricationGrid_createFormantSynthesis (Sound me, FricationGrid thee, bool useThreads) {
+	FricationGridPlayOptions pf = thy options.get();
+	integer numberOfFricationFormants = thy frication_formants -> formants.size;
+
+	check_formants (numberOfFricationFormants, & (pf -> startFricationFormant), & (pf -> endFricationFormant));
+
+	if (pf -> endFricationFormant > 1) {
+		integer startFricationFormant2 = pf -> startFricationFormant > 2 ? pf -> startFricationFormant : 2;
+		int alternatingSign = startFricationFormant2 % 2 == 0 ? 1 : -1; // 2 starts with positive sign
+		return Sound_FormantGrid_Intensities_createParallelSynthesis (me, thy frication_formants.get(),
+				& thy frication_formants_amplitudes, startFricationFormant2, pf -> endFricationFormant, alternatingSign, useThreads);
+	}
+	return autoParallelFormantSynthesis ();
+}
+
+/*
+	`me` filtered into `him`.
+*/
+static void Sound_FricationGrid_fillFiltered (Sound me, FricationGrid thee, ParallelFormantSynthesis formants, Sound him) {
+	FricationGridPlayOptions pf = thy options.get();
+	if (formants) {
+		ParallelFormantSynthesis_fill (formants, me);
+		his z.all() <<= formants -> output -> z.all();
+	} else {
+		his z.all() <<= my z.all();
+	}
+
+	if (pf -> bypass) {
+		for (integer is = 1; is <= his nx; is ++) {	// Bypass
+			double t = his x1 + (is - 1) * his dx;
+			double ab = 0.0;
+			if (thy bypass -> points.size > 0) {
+				double val = RealTier_getValueAtTime (thy bypass.get(), t);
+				ab = ( isundef (val) ? 0.0 : DB_to_A (val) );
 			}
-			lastval = (val += 0.75 * lastval); // TODO: soft low-pass coefficient should be Fs dependent!
-			thy z [1] [i] = val * a;
+			his z [1] [is] += my z [1] [is] * ab;
 		}
+	}
+}
 
-		autoSound him = Sound_FricationGrid_filter (thee.get(), me);
-		return him;
+static autoFricationSynthesis FricationGrid_createSynthesis (FricationGrid me, double samplingFrequency, bool useThreads) {
+	try {
+		autoFricationSynthesis synthesis = Thing_new (FricationSynthesis);
+		synthesis -> fricationGrid = me;
+		synthesis -> source = Sound_createEmptyMono (my xmin, my xmax, samplingFrequency);
+		synthesis -> noise = VECraw (synthesis -> source -> nx);
+		synthesis -> formants = Sound_FricationGrid_createFormantSynthesis (synthesis -> source.get(), me, useThreads);
+		return synthesis;
 	} catch (MelderError) {
 		Melder_throw (me, U": no frication Sound created.");
 	}
 }
 
+/*
+	Into `thee`, which has the shape of the source.
+*/
+static void FricationSynthesis_fill (FricationSynthesis me, Sound thee, NUMrandomStream *randomStream) {
+	FricationGrid grid = my fricationGrid;
+	Sound source = my source.get();
+	double lastval = 0.0;
+	KlattGrid_fillNoise (my noise.get(), randomStream);
+	for (integer i = 1; i <= source -> nx; i ++) {
+		double t = source -> x1 + (i - 1) * source -> dx;
+		double val = my noise [i];
+		double a = 0.0;
+		if (grid -> fricationAmplitude -> points.size > 0) {
+			double dba = RealTier_getValueAtTime (grid -> fricationAmplitude.get(), t);
+			a = ( isdefined (dba) ? DBSPL_to_A (dba) : 0.0 );
+		}
+		lastval = (val += 0.75 * lastval); // TODO: soft low-pass coefficient should be Fs dependent!
+		source -> z [1] [i] = val * a;
+	}
+	Sound_FricationGrid_fillFiltered (source, grid, my formants.get(), thee);
+}
+
+autoSound FricationGrid_to_Sound (FricationGrid me, double samplingFrequency, NUMrandomStream *randomStream) {
+	autoFricationSynthesis synthesis = FricationGrid_createSynthesis (me, samplingFrequency, true);
+	autoSound thee = Sound_createEmptyMono (my xmin, my xmax, samplingFrequency);
+	FricationSynthesis_fill (synthesis.get(), thee.get(), randomStream);
+	return thee;
+}
+
 /************************ Sound & FricationGrid *********************************************/
 
 autoSound Sound_FricationGrid_filter (Sound me, FricationGrid thee) {
 	try {
-		FricationGridPlayOptions pf = thy options.get();
-		autoSound him;
-		integer numberOfFricationFormants = thy frication_formants -> formants.size;
-
-		check_formants (numberOfFricationFormants, & (pf -> startFricationFormant), & (pf -> endFricationFormant));
-
-		if (pf -> endFricationFormant > 1) {
-			integer startFricationFormant2 = pf -> startFricationFormant > 2 ? pf -> startFricationFormant : 2;
-			int alternatingSign = startFricationFormant2 % 2 == 0 ? 1 : -1; // 2 starts with positive sign
-			him = Sound_FormantGrid_Intensities_filter (me, thy frication_formants.get(), & thy frication_formants_amplitudes, startFricationFormant2, pf -> endFricationFormant, alternatingSign);
-		}
-
-		if (! him) {
-			him = Data_copy (me);
-		}
-
-		if (pf -> bypass) {
-			for (integer is = 1; is <= his nx; is ++) {	// Bypass
-				double t = his x1 + (is - 1) * his dx;
-				double ab = 0.0;
-				if (thy bypass -> points.size > 0) {
-					double val = RealTier_getValueAtTime (thy bypass.get(), t);
-					ab = ( isundef (val) ? 0.0 : DB_to_A (val) );
-				}
-				his z [1] [is] += my z [1] [is] * ab;
-			}
-		}
+		autoParallelFormantSynthesis formants = Sound_FricationGrid_createFormantSynthesis (me, thee, true);
+		autoSound him = Sound_create (my ny, my xmin, my xmax, my nx, my dx, my x1);
+		Sound_FricationGrid_fillFiltered (me, thee, formants.get(), him.get());
 		return him;
 	} catch (MelderError) {
 		Melder_throw (me, U": not filtered by frication filter.");
@@ -2680,53 +2961,144 @@ void KlattGrid_setGlottisCoupling (KlattGrid me) {
 
 #if 0
 static autoSound KlattGrid_to_Sound_aspiration (KlattGrid me, double samplingFrequency) {
-	return PhonationGrid_to_Sound_aspiration (my phonation.get(), samplingFrequency);
+	return PhonationGrid_to_Sound_aspiration (my phonation.get(), samplingFrequency, nullptr);
 }
 #endif
 
 autoSound KlattGrid_to_Sound_phonation (KlattGrid me) {
-	return PhonationGrid_to_Sound (my phonation.get(), 0, my options -> samplingFrequency);
+	return PhonationGrid_to_Sound (my phonation.get(), 0, my options -> samplingFrequency, nullptr);
 }
 
-autoSound KlattGrid_to_Sound (KlattGrid me) {
-	try {
-		autoSound thee;
-		PhonationGridPlayOptions pp = my phonation -> options.get();
-		FricationGridPlayOptions pf = my frication -> options.get();
-		double samplingFrequency = my options -> samplingFrequency;
+/*
+	The stages of a KlattGrid, created beforehand (in the main thread), so that filling them allocates nothing.
+	Creating it sets the glottis coupling and the play options of the KlattGrid.
+*/
+Thing_define (KlattGridSynthesis, Thing) {
+	autoPhonationSynthesis phonation;   // null if there is no glottal source signal, which then is not filtered
+	autoSound source;
+	autoVocalTractSynthesis vocalTract;
+	autoFricationSynthesis frication;   // null if off
+	autoSound fricationOutput;   // if added to the output of the vocal tract
+};
 
-		if (pp -> voicing) {
-			KlattGrid_setGlottisCoupling (me);
-		}
+Thing_implement (KlattGridSynthesis, Thing, 0);
 
-		if (pp -> aspiration || pp -> voicing) { // No vocal tract filtering if no glottal source signal present
-			autoSound source = PhonationGrid_to_Sound (my phonation.get(), my coupling.get(), samplingFrequency);
-			thee = Sound_VocalTractGrid_CouplingGrid_filter (source.get(), my vocalTract.get(), my coupling.get());
-		}
+static autoKlattGridSynthesis KlattGrid_createSynthesis (KlattGrid me, bool useThreads) {
+	PhonationGridPlayOptions pp = my phonation -> options.get();
+	FricationGridPlayOptions pf = my frication -> options.get();
+	double samplingFrequency = my options -> samplingFrequency;
 
-		if (pf -> endFricationFormant > 0 || pf -> bypass) {
-			autoSound frication = FricationGrid_to_Sound (my frication.get(), samplingFrequency);
-			if (thee) {
-				_Sounds_add_inplace (thee.get(), frication.get());
-			} else {
-				thee = frication.move();
-			}
-		}
+	autoKlattGridSynthesis synthesis = Thing_new (KlattGridSynthesis);
+	if (pp -> voicing) {
+		KlattGrid_setGlottisCoupling (me);
+	}
 
-		if (thee) {
-			Vector_scale (thee.get(), 0.99);
-		} else if (my options -> scalePeak) {
-			thee = Sound_createEmptyMono (my xmin, my xmax, samplingFrequency);
+	if (pp -> aspiration || pp -> voicing) { // No vocal tract filtering if no glottal source signal present
+		synthesis -> phonation = PhonationGrid_createSynthesis (my phonation.get(), my coupling.get(), samplingFrequency);
+		synthesis -> source = Sound_createEmptyMono (my xmin, my xmax, samplingFrequency);
+		synthesis -> vocalTract = Sound_VocalTractGrid_CouplingGrid_createSynthesis (synthesis -> source.get(),
+				my vocalTract.get(), my coupling.get(), useThreads);
+	}
+
+	if (pf -> endFricationFormant > 0 || pf -> bypass) {
+		synthesis -> frication = FricationGrid_createSynthesis (my frication.get(), samplingFrequency, useThreads);
+		if (synthesis -> phonation)
+			synthesis -> fricationOutput = Sound_createEmptyMono (my xmin, my xmax, samplingFrequency);
+	}
+	return synthesis;
+}
+
+/*
+	Into `thee`, which is zero and has the duration and sampling frequency of the KlattGrid.
+*/
+static void KlattGridSynthesis_fill (KlattGridSynthesis me, Sound thee, NUMrandomStream *randomStream) {
+	if (my phonation) {
+		PhonationSynthesis_fill (my phonation.get(), my source.get(), randomStream);
+		VocalTractSynthesis_fill (my vocalTract.get(), my source.get(), thee);
+	}
+	if (my frication) {
+		if (my phonation) {
+			FricationSynthesis_fill (my frication.get(), my fricationOutput.get(), randomStream);
+			_Sounds_add_inplace (thee, my fricationOutput.get());
+		} else {
+			FricationSynthesis_fill (my frication.get(), thee, randomStream);
 		}
+	}
+	if (my phonation || my frication)
+		Vector_scale (thee, 0.99);
+}
+
+autoSound KlattGrid_to_Sound (KlattGrid me, NUMrandomStream *randomStream) {
+	try {
+		autoKlattGridSynthesis synthesis = KlattGrid_createSynthesis (me, true);
+		if (! synthesis -> phonation && ! synthesis -> frication && ! my options -> scalePeak)
+			return autoSound ();
+		autoSound thee = Sound_createEmptyMono (my xmin, my xmax, my options -> samplingFrequency);
+		KlattGridSynthesis_fill (synthesis.get(), thee.get(), randomStream);
 		return thee;
 	} catch (MelderError) {
 		Melder_throw (me, U": no Sound created.");
 	}
 }
 
+/*
+	The synthesis of an item is created in the main thread, on a copy of its KlattGrid,
+	because the synthesis changes the glottis coupling and the play options.
+*/
+Thing_define (KlattGridBatchItem, SynthesisBatchItem) {
+	autoKlattGrid klattGrid;
+	autoKlattGridSynthesis synthesis;
+};
+
+Thing_implement (KlattGridBatchItem, SynthesisBatchItem, 0);
+
+Thing_define (KlattGridBatch, SynthesisBatch) {
+	OrderedOf<structKlattGrid> klattGrids;   // not owned
+
+	autoSynthesisBatchItem v_prepare (integer item)
+		override;
+	bool v_synthesize (SynthesisBatchItem item, NUMrandomStream *randomStream)
+		override;
+	conststring32 v_getItemName (integer item)
+		override;
+};
+
+Thing_implement (KlattGridBatch, SynthesisBatch, 0);
+
+autoSynthesisBatchItem structKlattGridBatch :: v_prepare (integer item) {
+	autoKlattGridBatchItem thee = Thing_new (KlattGridBatchItem);
+	thy klattGrid = Data_copy (klattGrids.at [item]);
+	thy synthesis = KlattGrid_createSynthesis (thy klattGrid.get(), false);
+	thy sound = Sound_createEmptyMono (thy klattGrid -> xmin, thy klattGrid -> xmax, thy klattGrid -> options -> samplingFrequency);
+	return thee.move();
+}
+
+bool structKlattGridBatch :: v_synthesize (SynthesisBatchItem item, NUMrandomStream *randomStream) {
+	KlattGridBatchItem thee = static_cast <KlattGridBatchItem> (item);
+	KlattGridSynthesis_fill (thy synthesis.get(), thy sound.get(), randomStream);
+	return true;
+}
+
+conststring32 structKlattGridBatch :: v_getItemName (integer item) {
+	conststring32 klattGridName = klattGrids.at [item] -> name.get();
+	return klattGridName ? klattGridName : KlattGridBatch_Parent :: v_getItemName (item);
+}
+
+autoSynthesisBatch KlattGrids_createSynthesisBatch (OrderedOf<structKlattGrid>* klattGrids) {
+	try {
+		autoKlattGridBatch me = Thing_new (KlattGridBatch);
+		for (integer igrid = 1; igrid <= klattGrids->size; igrid ++)
+			my klattGrids. addItem_ref (klattGrids->at [igrid]);
+		my numberOfItems = klattGrids->size;
+		return me.move();
+	} catch (MelderError) {
+		Melder_throw (U"KlattGrid batch not created.");
+	}
+}
+
 void KlattGrid_playSpecial (KlattGrid me) {
 	try {
-		autoSound thee = KlattGrid_to_Sound (me);
+		autoSound thee = KlattGrid_to_Sound (me, nullptr);
 		KlattGridPlayOptions him = my options.get();
 		if (his scalePeak) {
 			Vector_scale (thee.get(), 0.99);
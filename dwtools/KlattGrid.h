@@ -25,6 +25,7 @@
 #include "PitchTier.h"
 #include "FormantGrid.h"
 #include "KlattTable.h"
+#include "SynthesisBatch.h"
 Thing_declare (Interpreter);
 
 #include "KlattGrid_def.h"
@@ -43,7 +44,7 @@ autoPhonationGrid PhonationGrid_create (double tmin, double tmax);
 autoPhonationGridPlayOptions PhonationGridPlayOptions_create ();
 void PhonationGrid_setNames (PhonationGrid me);
 
-autoSound PhonationGrid_to_Sound_aspiration (PhonationGrid me, double samplingFrequency);
+autoSound PhonationGrid_to_Sound_aspiration (PhonationGrid me, double samplingFrequency, NUMrandomStream *randomStream);
 
 void PhonationGrid_draw (PhonationGrid me, Graphics g);
 
@@ -85,7 +86,7 @@ autoFricationGridPlayOptions FricationGridPlayOptions_create ();
 void FricationGrid_setNames (FricationGrid me);
 void FricationGrid_draw (FricationGrid me, Graphics g);
 
-autoSound FricationGrid_to_Sound (FricationGrid me, double samplingFrequency);
+autoSound FricationGrid_to_Sound (FricationGrid me, double samplingFrequency, NUMrandomStream *randomStream);
 
 autoSound Sound_FricationGrid_filter (Sound me, FricationGrid thee);
 
@@ -217,7 +218,16 @@ void KlattGrid_playSpecial (KlattGrid me);
 
 void KlattGrid_setDefaultPlayOptions (KlattGrid me);
 
-autoSound KlattGrid_to_Sound (KlattGrid me);
+/*
+	The noise (aspiration, breathiness, frication) comes from randomStream, or from the main stream if that is null.
+*/
+autoSound KlattGrid_to_Sound (KlattGrid me, NUMrandomStream *randomStream);
+
+/*
+	A batch that synthesizes the KlattGrids with their current play options (see SynthesisBatch.h).
+	The KlattGrids should be different objects, because synthesis changes their coupling.
+*/
+autoSynthesisBatch KlattGrids_createSynthesisBatch (OrderedOf<structKlattGrid>* klattGrids);
 
 autoSound KlattGrid_to_Sound_phonation (KlattGrid me);
 
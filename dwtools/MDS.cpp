@@ -36,6 +36,7 @@
 #include "Proximity_and_Distance.h"
 #include "SSCP.h"
 #include "PCA.h"
+#include "MelderThread.h"
 
 #define TINY 1e-30
 
@@ -1209,10 +1210,10 @@ autoDissimilarityList DistanceList_to_DissimilarityList (DistanceList me) {
 
 /*****************  Kruskal *****************************************/
 
-static void smacof_guttmanTransform (Configuration cx, Configuration cz, Distance disp, Weight weight, constMAT vplus) {
+static void smacof_guttmanTransform_byQuadrupleSums (Configuration cx, Configuration cz, Distance disp, Weight weight, constMAT vplus) {
 	integer nPoints = cx -> numberOfRows, nDimensions = cx -> numberOfColumns;
 
-	autoMAT b = MATraw (nPoints, nPoints);
+	autoMAT b = MATzero (nPoints, nPoints);
 	autoDistance distZ = Configuration_to_Distance (cz);
 
 	// compute B(Z) (eq. 8.25)
@@ -1245,6 +1246,105 @@ static void smacof_guttmanTransform (Configuration cx, Configuration cz, Distanc
 	}
 }
 
+/*
+	The smacof and INDSCAL iterations work on matrices of nPoints x nPoints, row by row.
+	Every row is computed by a single thread, so the results do not depend on the number of threads.
+*/
+#define MDS_MINIMUM_OPERATIONS_PER_THREAD  100000
+
+static integer MDS_getNumberOfThreads (integer numberOfRows, integer numberOfOperationsPerRow) {
+	if (Melder_debug == 62)
+		return 1;
+	return std::max (integer (1), std::min ({ numberOfRows * numberOfOperationsPerRow / MDS_MINIMUM_OPERATIONS_PER_THREAD,
+			integer (MelderThread_getNumberOfProcessors ()), numberOfRows }));
+}
+
+/*
+	Phase 1: the rows of B(Z) (eq. 8.25) and of B(Z)Z.
+	Phase 2: the rows of the Guttman transform Xu = (V+)(B(Z)Z) (eq. 8.29).
+*/
+Thing_define (smacof_guttman_Args, Thing) { public:
+	int phase;
+	integer firstRow, lastRow;
+	constMAT distZ, disp, weight, z, vplus;
+	MAT b, bz, x;
+};
+
+Thing_implement (smacof_guttman_Args, Thing, 0);
+
+static MelderThread_RETURN_TYPE smacof_guttman (smacof_guttman_Args me) {
+	const integer nPoints = my b.nrow, nDimensions = my z.ncol;
+	for (integer i = my firstRow; i <= my lastRow; i ++) {
+		if (my phase == 1) {
+			VEC bi = my b.row (i);
+			longdouble sum = 0.0;
+			for (integer j = 1; j <= nPoints; j ++) {
+				const double dzij = my distZ [i] [j];
+				if (i == j || dzij == 0.0) {
+					bi [j] = 0.0;
+					continue;
+				}
+				bi [j] = - my weight [i] [j] * my disp [i] [j] / dzij;
+				sum += bi [j];
+			}
+			bi [i] = - (double) sum;
+			VEC bzi = my bz.row (i);
+			for (integer j = 1; j <= nDimensions; j ++)
+				bzi [j] = 0.0;
+			for (integer l = 1; l <= nPoints; l ++) {
+				const double bil = bi [l];
+				if (bil == 0.0)
+					continue;
+				constVEC zl = my z.row (l);
+				for (integer j = 1; j <= nDimensions; j ++)
+					bzi [j] += bil * zl [j];
+			}
+		} else {
+			constVEC vplusi = my vplus.row (i);
+			VEC xi = my x.row (i);
+			for (integer j = 1; j <= nDimensions; j ++)
+				xi [j] = 0.0;
+			for (integer k = 1; k <= nPoints; k ++) {
+				const double vik = vplusi [k];
+				constVEC bzk = my bz.row (k);
+				for (integer j = 1; j <= nDimensions; j ++)
+					xi [j] += vik * bzk [j];
+			}
+		}
+	}
+	MelderThread_RETURN;
+}
+
+/*
+	Make cx the Guttman transform of cz, whose distances distZ are given;
+	b (nPoints x nPoints) and bz (nPoints x nDimensions) are scratch buffers that are reused over the iterations.
+	Multiplying B(Z) with Z before multiplying with V+ takes 2 nPoints^2 nDimensions operations instead of nPoints^3 nDimensions.
+*/
+static void smacof_guttmanTransform (Configuration cx, Configuration cz, Distance distZ, Distance disp, Weight weight, constMAT vplus, MAT b, MAT bz) {
+	const integer nPoints = cx -> numberOfRows;
+	const integer numberOfThreads = MDS_getNumberOfThreads (nPoints, 2 * nPoints * cx -> numberOfColumns);
+	std::vector <autosmacof_guttman_Args> args ((size_t) numberOfThreads);
+	for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+		autosmacof_guttman_Args arg = Thing_new (smacof_guttman_Args);
+		arg -> firstRow = 1 + (ithread - 1) * nPoints / numberOfThreads;
+		arg -> lastRow = ithread * nPoints / numberOfThreads;
+		arg -> distZ = distZ -> data.get();
+		arg -> disp = disp -> data.get();
+		arg -> weight = weight -> data.get();
+		arg -> z = cz -> data.get();
+		arg -> vplus = vplus;
+		arg -> b = b;
+		arg -> bz = bz;
+		arg -> x = cx -> data.get();
+		args [(size_t) ithread - 1] = arg.move();
+	}
+	for (int phase = 1; phase <= 2; phase ++) {   // phase 2 needs all the rows of B(Z)Z
+		for (integer ithread = 1; ithread <= numberOfThreads; ithread ++)
+			args [(size_t) ithread - 1] -> phase = phase;
+		MelderThread_run (smacof_guttman, args.data(), (int) numberOfThreads);
+	}
+}
+
 double Distance_Weight_stress (Distance fit, Distance conf, Weight weight, int stressMeasure) {
 	double eta_fit, eta_conf, rho, stress = undefined, denum, tmp;
 
@@ -1300,19 +1400,71 @@ double Distance_Weight_stress (Distance fit, Distance conf, Weight weight, int s
 	return stress;
 }
 
-void Distance_Weight_rawStressComponents (Distance fit, Distance conf, Weight weight, double *out_etafit, double *out_etaconf, double *out_rho)
-{
-	integer nPoints = conf -> numberOfRows;
-	longdouble etafit = 0.0, etaconf = 0.0, rho = 0.0;
-	for (integer i = 1; i <= nPoints - 1; i ++) {
-		constVEC wi = weight -> data.row (i);
-		constVEC fiti = fit -> data.row (i);
-		constVEC confi = conf -> data.row (i);
+/*
+	The sums over the upper triangle of the rows firstRow through lastRow, one row at a time.
+*/
+Thing_define (Distance_Weight_rawStress_Args, Thing) { public:
+	integer firstRow, lastRow;
+	constMAT fit, conf, weight;
+	VEC etafit, etaconf, rho;
+};
+
+Thing_implement (Distance_Weight_rawStress_Args, Thing, 0);
+
+static MelderThread_RETURN_TYPE Distance_Weight_rawStress (Distance_Weight_rawStress_Args me) {
+	const integer nPoints = my conf.nrow;
+	for (integer i = my firstRow; i <= my lastRow; i ++) {
+		constVEC wi = my weight.row (i);
+		constVEC fiti = my fit.row (i);
+		constVEC confi = my conf.row (i);
+		longdouble etafit = 0.0, etaconf = 0.0, rho = 0.0;
 		for (integer j = i + 1; j <= nPoints; j ++) {
 			etafit += wi [j] * fiti [j] * fiti [j];
 			etaconf += wi [j] * confi [j] * confi [j];
 			rho += wi [j] * fiti [j] * confi [j];
 		}
+		my etafit [i] = (double) etafit;
+		my etaconf [i] = (double) etaconf;
+		my rho [i] = (double) rho;
+	}
+	MelderThread_RETURN;
+}
+
+void Distance_Weight_rawStressComponents (Distance fit, Distance conf, Weight weight, double *out_etafit, double *out_etaconf, double *out_rho)
+{
+	integer nPoints = conf -> numberOfRows;
+	autoVEC etafitRows = VECzero (nPoints), etaconfRows = VECzero (nPoints), rhoRows = VECzero (nPoints);
+	/*
+		Row i has nPoints - i terms; the rows are summed in order afterwards,
+		so that the result does not depend on the number of threads.
+	*/
+	const integer numberOfThreads = MDS_getNumberOfThreads (nPoints, 3 * nPoints / 2);
+	std::vector <autoDistance_Weight_rawStress_Args> args ((size_t) numberOfThreads);
+	integer firstRow = 1;
+	for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+		autoDistance_Weight_rawStress_Args arg = Thing_new (Distance_Weight_rawStress_Args);
+		integer lastRow = nPoints - 1;
+		if (ithread < numberOfThreads) {
+			const double fractionDone = (double) ithread / numberOfThreads;   // of the triangle
+			lastRow = std::max (firstRow - 1, (integer) round (nPoints * (1.0 - sqrt (1.0 - fractionDone))));
+		}
+		arg -> firstRow = firstRow;
+		arg -> lastRow = lastRow;   // may be firstRow - 1
+		firstRow = lastRow + 1;
+		arg -> fit = fit -> data.get();
+		arg -> conf = conf -> data.get();
+		arg -> weight = weight -> data.get();
+		arg -> etafit = etafitRows.get();
+		arg -> etaconf = etaconfRows.get();
+		arg -> rho = rhoRows.get();
+		args [(size_t) ithread - 1] = arg.move();
+	}
+	MelderThread_run (Distance_Weight_rawStress, args.data(), (int) numberOfThreads);
+	longdouble etafit = 0.0, etaconf = 0.0, rho = 0.0;
+	for (integer i = 1; i <= nPoints - 1; i ++) {
+		etafit += etafitRows [i];
+		etaconf += etaconfRows [i];
+		rho += rhoRows [i];
 	}
 	if (out_etafit)
 		*out_etafit = (double) etafit;
@@ -1453,8 +1605,14 @@ autoConfiguration Dissimilarity_Configuration_Weight_Transformator_smacof (Dissi
 		*/
 
 		autoMAT vplus = MATpseudoInverse (v.get(), tol);
+
+		/*
+			At the start of every iteration conf and z are equal,
+			so the distances computed for the stress of one iteration are those of z in the next.
+		*/
+		autoDistance dist = Configuration_to_Distance (conf);
+		autoMAT b = MATraw (nPoints, nPoints), bz = MATraw (nPoints, nDimensions);
 		for (integer iter = 1; iter <= numberOfIterations; iter ++) {
-			autoDistance dist = Configuration_to_Distance (conf);
 
 			// transform & normalization
 
@@ -1462,13 +1620,16 @@ autoConfiguration Dissimilarity_Configuration_Weight_Transformator_smacof (Dissi
 
 			// Make conf the Guttman transform of z
 
-			smacof_guttmanTransform (conf, z.get(), fit.get(), weight, vplus.get());
+			if (Melder_debug == 62)
+				smacof_guttmanTransform_byQuadrupleSums (conf, z.get(), fit.get(), weight, vplus.get());
+			else
+				smacof_guttmanTransform (conf, z.get(), dist.get(), fit.get(), weight, vplus.get(), b.get(), bz.get());
 
 			// Compute stress
 
-			autoDistance cdist = Configuration_to_Distance (conf);
+			Configuration_into_Distance (conf, dist.get());
 
-			stress = Distance_Weight_stress (fit.get(), cdist.get(), weight, MDS_NORMALIZED_STRESS);
+			stress = Distance_Weight_stress (fit.get(), dist.get(), weight, MDS_NORMALIZED_STRESS);
 
 			// Check stop criterium
 
@@ -1944,7 +2105,7 @@ autoConfiguration Dissimilarity_Configuration_kruskal (Dissimilarity me, Configu
 	Problem of Negative Saliences and Nonsymmetry in INDSCAL, Journal of Classification 10, 115-124.
 */
 
-static void indscal_iteration_tenBerge (ScalarProductList zc, Configuration xc, Salience weights) {
+static void indscal_iteration_tenBerge_withCopies (ScalarProductList zc, Configuration xc, Salience weights) {
 	integer nPoints = xc -> numberOfRows, nDimensions = xc -> numberOfColumns;
 	integer nSources = zc->size;
 	double **x = xc -> data.at_deprecated, **w = weights -> data.at_deprecated, lambda;
@@ -2038,6 +2199,163 @@ static void indscal_iteration_tenBerge (ScalarProductList zc, Configuration xc,
 }
 
 
+
+/*
+	The same iteration without copying the scalar products:
+		sum_i w [i] [h] S [i] [h] = sum_i w [i] [h] S [i] - sum_{j != h} (sum_i w [i] [h] w [i] [j]) x [j] x [j]'
+		x [h]' S [i] [h] x [h] = x [h]' S [i] x [h] - sum_{j != h} w [i] [j] (x [h]' x [j])^2
+	Phase 1 computes rows of the weighted S matrix, phase 2 computes, for every source, the terms of x [h]' S [i] x [h] per row.
+*/
+Thing_define (indscal_tenBerge_Args, Thing) { public:
+	int phase;
+	integer firstRow, lastRow, h;
+	ScalarProductList zc;
+	constMAT x, w;
+	constVEC c;
+	MAT wsih, quadraticFormRows;
+};
+
+Thing_implement (indscal_tenBerge_Args, Thing, 0);
+
+static MelderThread_RETURN_TYPE indscal_tenBerge (indscal_tenBerge_Args me) {
+	const integer nPoints = my x.nrow, nDimensions = my x.ncol, nSources = my zc -> size, h = my h;
+	for (integer k = my firstRow; k <= my lastRow; k ++) {
+		if (my phase == 1) {
+			VEC wsihk = my wsih.row (k);
+			for (integer l = 1; l <= nPoints; l ++)
+				wsihk [l] = 0.0;
+			for (integer i = 1; i <= nSources; i ++) {
+				const double wih = my w [i] [h];
+				constVEC sik = my zc -> at [i] -> data.row (k);
+				for (integer l = 1; l <= nPoints; l ++)
+					wsihk [l] += wih * sik [l];
+			}
+			for (integer j = 1; j <= nDimensions; j ++) {
+				if (j == h)
+					continue;
+				const double cxkj = my c [j] * my x [k] [j];
+				for (integer l = 1; l <= nPoints; l ++)
+					wsihk [l] -= cxkj * my x [l] [j];
+			}
+		} else {
+			for (integer i = 1; i <= nSources; i ++) {
+				constVEC sik = my zc -> at [i] -> data.row (k);
+				longdouble sum = 0.0;
+				for (integer l = 1; l <= nPoints; l ++)
+					sum += sik [l] * my x [l] [h];
+				my quadraticFormRows [i] [k] = my x [k] [h] * (double) sum;
+			}
+		}
+	}
+	MelderThread_RETURN;
+}
+
+static void indscal_iteration_tenBerge (ScalarProductList zc, Configuration xc, Salience weights) {
+	if (Melder_debug == 62) {
+		indscal_iteration_tenBerge_withCopies (zc, xc, weights);
+		return;
+	}
+	const integer nPoints = xc -> numberOfRows, nDimensions = xc -> numberOfColumns;
+	const integer nSources = zc -> size;
+	MAT x = xc -> data.get(), w = weights -> data.get();
+	double lambda;
+
+	// tolerance = 1e-4 is nearly optimal for dominant eigenvector estimation.
+
+	const double tolerance = 1e-4;
+	autoMAT wsih = MATraw (nPoints, nPoints);
+	autoVEC solution = VECraw (nPoints);
+	autoVEC c = VECzero (nDimensions);
+	autoMAT quadraticFormRows = MATraw (nSources, nPoints);
+
+	const integer numberOfThreads = MDS_getNumberOfThreads (nPoints, (nSources + nDimensions) * nPoints);
+	std::vector <autoindscal_tenBerge_Args> args ((size_t) numberOfThreads);
+	for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+		autoindscal_tenBerge_Args arg = Thing_new (indscal_tenBerge_Args);
+		arg -> firstRow = 1 + (ithread - 1) * nPoints / numberOfThreads;
+		arg -> lastRow = ithread * nPoints / numberOfThreads;
+		arg -> zc = zc;
+		arg -> x = x;
+		arg -> w = w;
+		arg -> c = c.get();
+		arg -> wsih = wsih.get();
+		arg -> quadraticFormRows = quadraticFormRows.get();
+		args [(size_t) ithread - 1] = arg.move();
+	}
+
+	for (integer h = 1; h <= nDimensions; h ++) {
+		for (integer j = 1; j <= nDimensions; j ++) {
+			longdouble cj = 0.0;
+			if (j != h) {
+				for (integer i = 1; i <= nSources; i ++)
+					cj += w [i] [h] * w [i] [j];
+			}
+			c [j] = (double) cj;
+		}
+
+		// the weighted S matrix (eq. 8)
+
+		for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+			args [(size_t) ithread - 1] -> phase = 1;
+			args [(size_t) ithread - 1] -> h = h;
+		}
+		MelderThread_run (indscal_tenBerge, args.data(), (int) numberOfThreads);
+
+		// largest eigenvalue of m (nonsymmetric matrix!!) is optimal solution for this dimension
+
+		for (integer k = 1; k <= nPoints; k ++) {
+			solution [k] = x [k] [h];
+		}
+
+		NUMdominantEigenvector (wsih.get(), solution.get(), & lambda, tolerance);
+
+		// normalize the solution: centre and x'x = 1
+
+		longdouble mean = 0.0;
+		for (integer k = 1; k <= nPoints; k ++) {
+			mean += solution [k];
+		}
+		mean /= nPoints;
+
+		if (mean == 0.0) {
+			continue;
+		}
+
+		longdouble scale = 0.0;
+		for (integer k = 1; k <= nPoints; k ++) {
+			solution [k] -= mean;
+			scale += solution [k] * solution [k];
+		}
+
+		for (integer k = 1; k <= nPoints; k ++) {
+			x [k] [h] = solution [k] / sqrt ((double) scale);
+		}
+
+		// update weights. Make negative weights zero.
+
+		for (integer ithread = 1; ithread <= numberOfThreads; ithread ++)
+			args [(size_t) ithread - 1] -> phase = 2;
+		MelderThread_run (indscal_tenBerge, args.data(), (int) numberOfThreads);
+		for (integer i = 1; i <= nSources; i ++) {
+			longdouble wih = 0.0;
+			for (integer k = 1; k <= nPoints; k ++)
+				wih += quadraticFormRows [i] [k];
+			for (integer j = 1; j <= nDimensions; j ++) {
+				if (j == h)
+					continue;
+				longdouble xhxj = 0.0;
+				for (integer k = 1; k <= nPoints; k ++)
+					xhxj += x [k] [h] * x [k] [j];
+				wih -= w [i] [j] * xhxj * xhxj;
+			}
+			if (wih < 0.0) {
+				wih = 0.0;
+			}
+			w [i] [h] = (double) wih;
+		}
+	}
+}
+
 void ScalarProductList_Configuration_Salience_indscal (ScalarProductList sp, Configuration configuration, Salience weights, double tolerance, integer numberOfIterations, bool showProgress, autoConfiguration *out_conf, autoSalience *out_sal, double *out_varianceAccountedFor) {
 	try {
 		double tol = 1e-6, vafp = 0.0, varianceAccountedFor;
@@ -36,10 +36,18 @@
 #include "Eigen_and_SSCP.h"
 #include "Eigen_and_TableOfReal.h"
 #include "Matrix_extensions.h"
+#include "MelderThread.h"
 #include "NUM2.h"
+#include "NUMmachar.h"
 #include "PCA.h"
+#include "SVD.h"
 #include "TableOfReal_extensions.h"
 
+#include "enums_getText.h"
+#include "PCA_enums.h"
+#include "enums_getValue.h"
+#include "PCA_enums.h"
+
 #include "oo_DESTROY.h"
 #include "PCA_def.h"
 #include "oo_COPY.h"
@@ -148,35 +156,296 @@ autoEigen PCA_to_Eigen (PCA me) {
 	}
 }
 
-static autoPCA MAT_to_PCA (constMAT m, bool byColumns) {
+/*
+	The Covariance and RandomizedSvd methods never copy or centre the data matrix m.
+	The observations are the rows of m, or its columns if byColumns.
+	The products of the centred data A (numberOfObservations x dimension) are:
+		CROSS_PRODUCTS: A'A, into a dimension x dimension matrix;
+		RANGE: in A', with `in` having dimension columns, into a matrix with numberOfObservations columns;
+		COMPRESSION: in A, with `in` having numberOfObservations columns, into a matrix with dimension columns.
+*/
+enum class PCA_product { CROSS_PRODUCTS, RANGE, COMPRESSION };
+
+Thing_define (PCA_products_Args, Thing) {
+public:
+	PCA_product product;
+	constMAT m;
+	bool byColumns;
+	constVEC centroid;
+	constMAT in;
+	MAT out;
+	autoMAT partialSums;   // only if the threads share the elements of out
+	autoVEC difference;   // an observation minus the centroid
+	integer first, last;   // observations or variables
+};
+
+Thing_implement (PCA_products_Args, Thing, 0);
+
+static MelderThread_RETURN_TYPE PCA_products (PCA_products_Args me) {
+	constMAT m = my m;
+	constVEC centroid = my centroid;
+	constMAT in = my in;
+	MAT out = ( my partialSums.nrow > 0 ? my partialSums.get() : my out );
+	const integer dimension = centroid.size;
+	if (! my byColumns) {
+		VEC difference = my difference.get();
+		for (integer i = my first; i <= my last; i ++) {
+			for (integer k = 1; k <= dimension; k ++)
+				difference [k] = m [i] [k] - centroid [k];
+			if (my product == PCA_product::CROSS_PRODUCTS) {
+				for (integer k = 1; k <= dimension; k ++) {
+					const double dk = difference [k];
+					for (integer l = k; l <= dimension; l ++)
+						out [k] [l] += dk * difference [l];
+				}
+			} else if (my product == PCA_product::RANGE) {
+				for (integer j = 1; j <= in.nrow; j ++)
+					out [j] [i] = NUMinner (in.row (j), difference);
+			} else {
+				for (integer j = 1; j <= in.nrow; j ++) {
+					const double weight = in [j] [i];
+					for (integer k = 1; k <= dimension; k ++)
+						out [j] [k] += weight * difference [k];
+				}
+			}
+		}
+	} else if (my product == PCA_product::RANGE) {
+		/*
+			The rows of m are the variables; this thread does observations first .. last.
+		*/
+		for (integer j = 1; j <= in.nrow; j ++)
+			for (integer i = my first; i <= my last; i ++)
+				out [j] [i] = 0.0;
+		for (integer k = 1; k <= dimension; k ++) {
+			const double mean = centroid [k];
+			for (integer j = 1; j <= in.nrow; j ++) {
+				const double weight = in [j] [k];
+				for (integer i = my first; i <= my last; i ++)
+					out [j] [i] += weight * (m [k] [i] - mean);
+			}
+		}
+	} else {
+		/*
+			The rows of m are the variables; this thread does variables first .. last.
+		*/
+		for (integer k = my first; k <= my last; k ++) {
+			const double mean = centroid [k];
+			if (my product == PCA_product::CROSS_PRODUCTS) {
+				for (integer l = k; l <= dimension; l ++) {
+					const double meanl = centroid [l];
+					double sum = 0.0;
+					for (integer i = 1; i <= m.ncol; i ++)
+						sum += (m [k] [i] - mean) * (m [l] [i] - meanl);
+					out [k] [l] = sum;
+				}
+			} else {
+				for (integer j = 1; j <= in.nrow; j ++) {
+					double sum = 0.0;
+					for (integer i = 1; i <= m.ncol; i ++)
+						sum += in [j] [i] * (m [k] [i] - mean);
+					out [j] [k] = sum;
+				}
+			}
+		}
+	}
+	MelderThread_RETURN;
+}
+
+#define PCA_MINIMUM_PRODUCTS_PER_THREAD  100000
+
+static void PCA_products_run (PCA_product product, constMAT m, bool byColumns, constVEC centroid, constMAT in, MAT out) {
+	const integer numberOfObservations = ( byColumns ? m.ncol : m.nrow ), dimension = centroid.size;
+	/*
+		SSCP and COMPRESSION by rows update all the elements of out for every observation,
+		so the threads split the observations and keep their own sums.
+		Otherwise the threads write different elements of out:
+		RANGE splits the observations, and SSCP and COMPRESSION by columns split the variables.
+	*/
+	const bool threadsShareOut = ( product != PCA_product::RANGE && ! byColumns );
+	const bool splitVariables = ( product != PCA_product::RANGE && byColumns );
+	const integer size = ( splitVariables ? dimension : numberOfObservations );
+	const double numberOfProducts = ( product == PCA_product::CROSS_PRODUCTS ? 0.5 * dimension * (dimension + 1) : double (dimension) * in.nrow ) *
+		numberOfObservations;
+	const integer numberOfThreads = ( Melder_debug == 67 ? 1 :
+		std::max (integer (1), std::min ({ Melder_ifloor (numberOfProducts / PCA_MINIMUM_PRODUCTS_PER_THREAD), size,
+			integer (MelderThread_getNumberOfProcessors ()) })) );
+	std::vector <autoPCA_products_Args> args ((size_t) numberOfThreads);
+	integer first = 1;
+	for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+		autoPCA_products_Args arg = Thing_new (PCA_products_Args);
+		arg -> product = product;
+		arg -> m = m;
+		arg -> byColumns = byColumns;
+		arg -> centroid = centroid;
+		arg -> in = in;
+		arg -> out = out;
+		if (threadsShareOut)
+			arg -> partialSums = MATzero (out.nrow, out.ncol);
+		if (! byColumns)
+			arg -> difference = VECraw (dimension);
+		/*
+			Variable k of SSCP by columns has dimension - k + 1 products; give every thread about the same number.
+		*/
+		const integer last = ( ithread == numberOfThreads ? size :
+			product == PCA_product::CROSS_PRODUCTS && splitVariables ?
+				Melder_ifloor (size * (1.0 - sqrt (1.0 - double (ithread) / numberOfThreads))) :
+				ithread * size / numberOfThreads );
+		arg -> first = first;
+		arg -> last = last;   // may be first - 1
+		first = last + 1;
+		args [(size_t) ithread - 1] = arg.move();
+	}
+	MelderThread_run (PCA_products, args.data(), (int) numberOfThreads);
+	if (threadsShareOut) {
+		for (integer i = 1; i <= out.nrow; i ++)
+			for (integer j = 1; j <= out.ncol; j ++)
+				out [i] [j] = 0.0;
+		for (integer ithread = 1; ithread <= numberOfThreads; ithread ++)
+			MATadd_inplace (out, args [(size_t) ithread - 1] -> partialSums.get());
+	}
+	if (product == PCA_product::CROSS_PRODUCTS)
+		for (integer k = 2; k <= dimension; k ++)
+			for (integer l = 1; l < k; l ++)
+				out [k] [l] = out [l] [k];
+}
+
+/*
+	Modified Gram-Schmidt, twice, on the rows of y.
+	A row that depends on the rows before it becomes zero.
+*/
+static void MAT_orthonormalizeRows_inplace (MAT y) {
+	for (integer i = 1; i <= y.nrow; i ++) {
+		VEC yi = y.row (i);
+		const double originalNorm = NUMnorm (yi, 2.0);
+		for (integer pass = 1; pass <= 2; pass ++) {
+			for (integer k = 1; k < i; k ++) {
+				constVEC yk = y.row (k);
+				const double projection = NUMinner (yk, yi);
+				for (integer j = 1; j <= y.ncol; j ++)
+					yi [j] -= projection * yk [j];
+			}
+		}
+		const double norm = NUMnorm (yi, 2.0);
+		VECmultiply_inplace (yi, norm <= 1e-12 * originalNorm ? 0.0 : 1.0 / norm);
+	}
+}
+
+static void PCA_initFromSSCP (PCA me, constMAT m, bool byColumns) {
+	const integer dimension = my centroid.size;
+	autoMAT sscp = MATraw (dimension, dimension);
+	PCA_products_run (PCA_product::CROSS_PRODUCTS, m, byColumns, my centroid.get(), constMAT (), sscp.get());
+	Eigen_initFromSymmetricMatrix (me, sscp.get());
+	/*
+		The cross products are only precise up to a fraction eps of the largest eigenvalue;
+		smaller eigenvalues are those of a rank-deficient A'A.
+	*/
+	if (! NUMfpp)
+		NUMmachar ();
+	integer numberOfEigenvalues = 0;
+	while (numberOfEigenvalues < my numberOfEigenvalues &&
+			my eigenvalues [numberOfEigenvalues + 1] > dimension * NUMfpp -> eps * my eigenvalues [1])
+		numberOfEigenvalues ++;
+	Melder_require (numberOfEigenvalues > 0,
+		U"The covariance matrix should not be zero.");
+	my numberOfEigenvalues = numberOfEigenvalues;
+	my eigenvalues = VECcopy (my eigenvalues.part (1, numberOfEigenvalues));
+	my eigenvectors = MATpart (my eigenvectors.get(), 1, numberOfEigenvalues, 1, dimension);
+}
+
+/*
+	Halko, Martinsson & Tropp (2011), algorithm 4.4: the range of A is approximated by
+	the range of A times a Gaussian random matrix with a few more columns than the requested number of components,
+	sharpened by power iterations with A A', and A is compressed into that range before the SVD.
+*/
+#define PCA_RANDOMIZED_SVD_OVERSAMPLING  10
+#define PCA_RANDOMIZED_SVD_POWER_ITERATIONS  2
+
+static void PCA_initFromRandomizedSvd (PCA me, constMAT m, bool byColumns, integer numberOfComponents) {
+	const integer numberOfObservations = ( byColumns ? m.ncol : m.nrow ), dimension = my centroid.size;
+	const integer maximumNumberOfComponents = std::min (numberOfObservations, dimension);
+	if (numberOfComponents == 0 || numberOfComponents > maximumNumberOfComponents)
+		numberOfComponents = maximumNumberOfComponents;
+	const integer rangeDimension = std::min (numberOfComponents + PCA_RANDOMIZED_SVD_OVERSAMPLING, maximumNumberOfComponents);
+	autoMAT random = MATraw (rangeDimension, dimension);
+	for (integer j = 1; j <= rangeDimension; j ++)
+		for (integer k = 1; k <= dimension; k ++)
+			random [j] [k] = NUMrandomGauss (0.0, 1.0);
+	autoMAT range = MATraw (rangeDimension, numberOfObservations);   // the basis in the rows
+	autoMAT compression = MATraw (rangeDimension, dimension);
+	PCA_products_run (PCA_product::RANGE, m, byColumns, my centroid.get(), random.get(), range.get());
+	MAT_orthonormalizeRows_inplace (range.get());
+	for (integer iteration = 1; iteration <= PCA_RANDOMIZED_SVD_POWER_ITERATIONS; iteration ++) {
+		PCA_products_run (PCA_product::COMPRESSION, m, byColumns, my centroid.get(), range.get(), compression.get());
+		MAT_orthonormalizeRows_inplace (compression.get());
+		PCA_products_run (PCA_product::RANGE, m, byColumns, my centroid.get(), compression.get(), range.get());
+		MAT_orthonormalizeRows_inplace (range.get());
+	}
+	PCA_products_run (PCA_product::COMPRESSION, m, byColumns, my centroid.get(), range.get(), compression.get());
+	/*
+		The right singular vectors of the compression are those of A, and so are its singular values.
+	*/
+	autoMAT compression_transposed = MATtranspose (compression.get());
+	autoSVD svd = SVD_createFromGeneralMatrix (compression_transposed.get());
+	const integer numberOfZeroed = SVD_zeroSmallSingularValues (svd.get(), 0.0);
+	const integer numberOfEigenvalues = std::min (numberOfComponents, rangeDimension - numberOfZeroed);
+	Melder_require (numberOfEigenvalues > 0,
+		U"The centred data should not be zero.");
+	Eigen_init (me, numberOfEigenvalues, dimension);
+	for (integer i = 1; i <= numberOfEigenvalues; i ++) {
+		my eigenvalues [i] = svd -> d [i] * svd -> d [i];
+		for (integer k = 1; k <= dimension; k ++)
+			my eigenvectors [i] [k] = svd -> u [k] [i];
+	}
+}
+
+static autoPCA MAT_to_PCA (constMAT m, bool byColumns, kPCA_method method, integer numberOfComponents) {
 	try {
 		Melder_require (NUMdefined (m),
 			U"All matrix elements should be defined.");
 		Melder_require (NUMfrobeniusnorm (m) > 0.0,
 			U"Not all values in your table should be zero.");
-		autoMAT mcopy;
+		Melder_require (numberOfComponents >= 0,
+			U"The number of components should not be negative.");
 		if (byColumns) {
 			if (m.ncol < m.nrow)
 				Melder_warning (U"The number of columns in your table is less than the number of rows.");
-			mcopy = MATtranspose (m);
 		} else {
 			if (m.nrow < m.ncol)
 				Melder_warning (U"The number of rows in your table is less than the number of columns.");
-			mcopy = MATcopy (m);
 		}
-		
+		const integer numberOfObservations = ( byColumns ? m.ncol : m.nrow ), dimension = ( byColumns ? m.nrow : m.ncol );
 		autoPCA thee = Thing_new (PCA);
-		thy centroid = VECcolumnMeans (mcopy.get());
-		MATsubtract_inplace (mcopy.get(), thy centroid.get());
-		Eigen_initFromSquareRoot (thee.get(), mcopy.get());
-		thy labels = autostring32vector (mcopy.ncol);
-		PCA_setNumberOfObservations (thee.get(), mcopy.nrow);
+		if (method == kPCA_method::Svd) {
+			autoMAT mcopy = ( byColumns ? MATtranspose (m) : MATcopy (m) );
+			thy centroid = VECcolumnMeans (mcopy.get());
+			MATsubtract_inplace (mcopy.get(), thy centroid.get());
+			Eigen_initFromSquareRoot (thee.get(), mcopy.get());
+		} else {
+			if (byColumns) {
+				thy centroid = VECraw (dimension);
+				for (integer k = 1; k <= dimension; k ++)
+					thy centroid [k] = NUMmean (m.row (k));
+			} else {
+				thy centroid = VECcolumnMeans (m);
+			}
+			if (method == kPCA_method::Covariance)
+				PCA_initFromSSCP (thee.get(), m, byColumns);
+			else
+				PCA_initFromRandomizedSvd (thee.get(), m, byColumns, numberOfComponents);
+		}
+		if (numberOfComponents > 0 && numberOfComponents < thy numberOfEigenvalues) {
+			thy numberOfEigenvalues = numberOfComponents;
+			thy eigenvalues = VECcopy (thy eigenvalues.part (1, numberOfComponents));
+			thy eigenvectors = MATpart (thy eigenvectors.get(), 1, numberOfComponents, 1, dimension);
+		}
+		thy labels = autostring32vector (dimension);
+		PCA_setNumberOfObservations (thee.get(), numberOfObservations);
 		/*
 			The covariance matrix C = A'A / (N-1). However, we have calculated
 			the eigenstructure for A'A. This has no consequences for the
 			eigenvectors, but the eigenvalues have to be divided by (N-1).
 		*/
-		VECmultiply_inplace (thy eigenvalues.get(), 1.0 / (mcopy.nrow - 1));
+		VECmultiply_inplace (thy eigenvalues.get(), 1.0 / (numberOfObservations - 1));
 		
 		return thee;
 	} catch (MelderError) {
@@ -184,9 +453,9 @@ static autoPCA MAT_to_PCA (constMAT m, bool byColumns) {
 	}	
 }
 
-autoPCA TableOfReal_to_PCA_byRows (TableOfReal me) {
+autoPCA TableOfReal_to_PCA_byRows (TableOfReal me, kPCA_method method, integer numberOfComponents) {
 	try {
-		autoPCA thee = MAT_to_PCA (my data.get(), false);
+		autoPCA thee = MAT_to_PCA (my data.get(), false, method, numberOfComponents);
 		Melder_assert (thy labels.size == my numberOfColumns);
 		thy labels.all() <<= my columnLabels.all();
 		return thee;
@@ -195,18 +464,18 @@ autoPCA TableOfReal_to_PCA_byRows (TableOfReal me) {
 	}
 }
 
-autoPCA Matrix_to_PCA_byColumns (Matrix me) {
+autoPCA Matrix_to_PCA_byColumns (Matrix me, kPCA_method method, integer numberOfComponents) {
 	try {
-		autoPCA thee = MAT_to_PCA (my z.get(), true);
+		autoPCA thee = MAT_to_PCA (my z.get(), true, method, numberOfComponents);
 		return thee;
 	} catch (MelderError) {
 		Melder_throw (me, U": no PCA created from columns.");
 	}
 }
 
-autoPCA Matrix_to_PCA_byRows (Matrix me) {
+autoPCA Matrix_to_PCA_byRows (Matrix me, kPCA_method method, integer numberOfComponents) {
 	try {
-		autoPCA thee = MAT_to_PCA (my z.get(), false);
+		autoPCA thee = MAT_to_PCA (my z.get(), false, method, numberOfComponents);
 		return thee;
 	} catch (MelderError) {
 		Melder_throw (me, U": no PCA created from rows.");
@@ -30,6 +30,7 @@
 #include "TableOfReal.h"
 #include "Configuration.h"
 #include "Eigen.h"
+#include "PCA_enums.h"
 
 #include "PCA_def.h"
 
@@ -39,14 +40,22 @@ void PCA_setNumberOfObservations (PCA me, integer numberOfObservations);
 
 integer PCA_getNumberOfObservations (PCA me);
 
-autoPCA TableOfReal_to_PCA_byRows (TableOfReal me);
+autoPCA TableOfReal_to_PCA_byRows (TableOfReal me, kPCA_method method, integer numberOfComponents);
+/*
+	method Svd: SVD of a centred copy of the data (the most precise).
+	method Covariance: eigenstructure of the covariance matrix, whose sums of squares and cross products
+		are accumulated in threads without copying the data; for many more observations than variables.
+	method RandomizedSvd: only the first numberOfComponents components, from a randomized range finder
+		with power iterations, in threads without copying the data; for large tables of which only a few components are needed.
+	numberOfComponents = 0 keeps all the components.
+*/
 
 autoEigen PCA_to_Eigen (PCA me);
 
 /* Calculate PCA of M'M */
 
-autoPCA Matrix_to_PCA_byRows (Matrix me);
-autoPCA Matrix_to_PCA_byColumns (Matrix me);
+autoPCA Matrix_to_PCA_byRows (Matrix me, kPCA_method method, integer numberOfComponents);
+autoPCA Matrix_to_PCA_byColumns (Matrix me, kPCA_method method, integer numberOfComponents);
 /* Calculate PCA of M'M */
 
 void PCA_getEqualityOfEigenvalues (PCA me, integer from, integer to, int conservative, double *p_prob, double *p_chisq, double *p_df);
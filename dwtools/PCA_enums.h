@@ -0,0 +1,25 @@
+/* PCA_enums.h
+ *
+ * Copyright (C) 2026 Praat developers
+ *
+ * This code is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this work. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+enums_begin (kPCA_method, 1)
+	enums_add (kPCA_method, 1, Svd, U"SVD")
+	enums_add (kPCA_method, 2, Covariance, U"covariance")
+	enums_add (kPCA_method, 3, RandomizedSvd, U"randomized SVD")
+enums_end (kPCA_method, 3, Svd)
+
+/* End of file PCA_enums.h */
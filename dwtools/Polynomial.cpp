@@ -1214,6 +1214,116 @@ void Roots_Polynomial_polish (Roots me, Polynomial thee) {
 	}
 }
 
+static void Polynomial_evaluateWithDerivative_z_double (Polynomial me, dcomplex z, dcomplex *out_p, dcomplex *out_dp) {
+	double pr = my coefficients [my numberOfCoefficients], pi = 0.0, dpr = 0.0, dpi = 0.0;
+	for (integer i = my numberOfCoefficients - 1; i > 0; i --) {
+		double tr = dpr;
+		dpr = dpr * z.re - dpi * z.im + pr;
+		dpi = tr * z.im + dpi * z.re + pi;
+		tr = pr;
+		pr = pr * z.re - pi * z.im + my coefficients [i];
+		pi = tr * z.im + pi * z.re;
+	}
+	*out_p = { pr, pi };
+	*out_dp = { dpr, dpi };
+}
+
+bool Polynomial_into_Roots_aberth (Polynomial me, Roots roots, bool warmStart) {
+	const integer degree = my numberOfCoefficients - 1;
+	if (degree < 1 || my coefficients [degree + 1] == 0.0)
+		return false;
+	Melder_assert (roots -> min == 1);
+	dcomplex *z = & roots -> v [0];
+	if (! warmStart || roots -> max != degree) {
+		/*
+			Start from a circle with the geometric mean of the moduli of the roots as its radius,
+			rotated so that no starting value is real.
+		*/
+		double radius = pow (fabs (my coefficients [1] / my coefficients [degree + 1]), 1.0 / degree);
+		if (radius == 0.0 || ! isfinite (radius))
+			radius = 1.0;
+		for (integer k = 1; k <= degree; k ++) {
+			const double phi = 2.0 * NUMpi * (k - 1) / degree + 0.4;
+			z [k] = { radius * cos (phi), radius * sin (phi) };
+		}
+	}
+	roots -> max = degree;
+
+	/*
+		Aberth-Ehrlich iterations (Gauss-Seidel style): z [k] -= N / (1 - N * sum (1 / (z [k] - z [j]))),
+		where N = p (z [k]) / p' (z [k]) is the Newton correction.
+	*/
+	const integer maximumNumberOfIterations = 100;
+	const double relativeTolerance = 1e-12;
+	bool converged = false;
+	for (integer iteration = 1; iteration <= maximumNumberOfIterations && ! converged; iteration ++) {
+		converged = true;
+		for (integer k = 1; k <= degree; k ++) {
+			dcomplex p, dp;
+			Polynomial_evaluateWithDerivative_z_double (me, z [k], & p, & dp);
+			if (p.re == 0.0 && p.im == 0.0)
+				continue;   // exactly on a root
+			if (dp.re == 0.0 && dp.im == 0.0)
+				return false;
+			const dcomplex newton = dcomplex_div (p, dp);
+			dcomplex sum = { 0.0, 0.0 };
+			for (integer j = 1; j <= degree; j ++) {
+				if (j == k)
+					continue;
+				const dcomplex difference = dcomplex_sub (z [k], z [j]);
+				if (difference.re == 0.0 && difference.im == 0.0)
+					return false;
+				sum = dcomplex_add (sum, dcomplex_div ({ 1.0, 0.0 }, difference));
+			}
+			const dcomplex denominator = dcomplex_sub ({ 1.0, 0.0 }, dcomplex_mul (newton, sum));
+			if (denominator.re == 0.0 && denominator.im == 0.0)
+				return false;
+			const dcomplex correction = dcomplex_div (newton, denominator);
+			z [k] = dcomplex_sub (z [k], correction);
+			if (! isfinite (z [k].re) || ! isfinite (z [k].im))
+				return false;
+			if (dcomplex_abs (correction) > relativeTolerance * dcomplex_abs (z [k]))
+				converged = false;
+		}
+	}
+	if (! converged)
+		return false;
+
+	/*
+		Make the real roots exactly real and put the complex roots in adjacent conjugate pairs,
+		as Roots_Polynomial_polish expects.
+	*/
+	const double realTolerance = 1e-8, pairTolerance = 1e-6;
+	integer numberOfRootsDone = 0;
+	while (numberOfRootsDone < degree) {
+		const integer k = numberOfRootsDone + 1;
+		const double modulus = dcomplex_abs (z [k]);
+		if (fabs (z [k].im) <= realTolerance * modulus) {
+			z [k].im = 0.0;
+			numberOfRootsDone ++;
+			continue;
+		}
+		integer partner = 0;
+		double minimumDistance = pairTolerance * modulus;
+		for (integer j = k + 1; j <= degree; j ++) {
+			const double distance = dcomplex_abs (dcomplex_sub (z [j], dcomplex_conjugate (z [k])));
+			if (distance <= minimumDistance) {
+				partner = j;
+				minimumDistance = distance;
+			}
+		}
+		if (partner == 0)
+			return false;
+		std::swap (z [k + 1], z [partner]);
+		const double re = 0.5 * (z [k].re + z [k + 1].re), im = 0.5 * fabs (z [k].im - z [k + 1].im);
+		z [k] = { re, im };
+		z [k + 1] = { re, - im };
+		numberOfRootsDone += 2;
+	}
+	Roots_Polynomial_polish (roots, me);
+	return true;
+}
+
 autoPolynomial Roots_to_Polynomial (Roots me, bool rootsAreReal) {
 	try {
 		(void) me;
@@ -213,6 +213,19 @@ double Polynomial_findOneSimpleRealRoot_ridders (Polynomial me, double xmin, dou
 
 void Roots_Polynomial_polish (Roots me, Polynomial thee);
 
+bool Polynomial_into_Roots_aberth (Polynomial me, Roots roots, bool warmStart);
+/*
+	For finding the roots of many low-degree polynomials one after the other, as for the frames of an LPC:
+	Aberth-Ehrlich iterations, starting from the roots already in `roots` if warmStart is true
+	and `roots` holds as many roots as the degree of `me`, otherwise from a circle around the origin.
+	Conjugate roots are paired and the roots are polished, as in Polynomial_to_Roots.
+	Preconditions: `roots` has room for at least degree roots; NUMmachar () has been called.
+	Postcondition: roots -> max is the degree of `me`.
+	Allocates nothing and does not throw, so that it can run in several threads at once
+	(Polynomial_to_Roots cannot, because the LAPACK routines use static variables).
+	Returns false if the iterations do not converge or the roots cannot be paired.
+*/
+
 autoPolynomial Roots_to_Polynomial (Roots me, bool rootsAreReal);
 
 autoPolynomial TableOfReal_to_Polynomial (TableOfReal me, integer degree, integer xcol, integer ycol, integer scol);
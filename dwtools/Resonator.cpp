@@ -47,6 +47,20 @@ double structFilter :: v_getOutput (double input) {
 	return output;
 }
 
+void structFilter :: v_filterBlock (VEC samples, double a1, double b1, double c1, integer numberOfSteps) {
+	const double da = (a - a1) / numberOfSteps, db = (b - b1) / numberOfSteps, dc = (c - c1) / numberOfSteps;
+	double y1 = p1, y2 = p2;
+	for (integer i = 1; i <= samples.size; i ++) {
+		const double ai = a1 + (i - 1) * da, bi = b1 + (i - 1) * db, ci = c1 + (i - 1) * dc;
+		const double output = ai * samples [i] + bi * y1 + ci * y2;
+		y2 = y1;
+		y1 = output;
+		samples [i] = output;
+	}
+	p1 = y1;
+	p2 = y2;
+}
+
 Thing_implement (Resonator, Filter, 0);
 
 void structResonator :: v_setFB (double f, double bw) {
@@ -87,6 +101,20 @@ double structAntiResonator :: v_getOutput (double input) {
 	return output;
 }
 
+void structAntiResonator :: v_filterBlock (VEC samples, double a1, double b1, double c1, integer numberOfSteps) {
+	const double da = (a - a1) / numberOfSteps, db = (b - b1) / numberOfSteps, dc = (c - c1) / numberOfSteps;
+	double x1 = p1, x2 = p2;
+	for (integer i = 1; i <= samples.size; i ++) {
+		const double ai = a1 + (i - 1) * da, bi = b1 + (i - 1) * db, ci = c1 + (i - 1) * dc;
+		const double input = samples [i];
+		samples [i] = ai * (input - bi * x1 - ci * x2);
+		x2 = x1;
+		x1 = input;
+	}
+	p1 = x1;
+	p2 = x2;
+}
+
 Thing_implement (ConstantGainResonator, Filter, 0);
 
 void structConstantGainResonator :: v_resetMemory () {
@@ -109,6 +137,20 @@ double structConstantGainResonator :: v_getOutput (double input) {
 	return output;
 }
 
+/* d = a - 1, so it is interpolated along with a */
+void structConstantGainResonator :: v_filterBlock (VEC samples, double a1, double b1, double c1, integer numberOfSteps) {
+	const double da = (a - a1) / numberOfSteps, db = (b - b1) / numberOfSteps, dc = (c - c1) / numberOfSteps;
+	for (integer i = 1; i <= samples.size; i ++) {
+		const double ai = a1 + (i - 1) * da, bi = b1 + (i - 1) * db, ci = c1 + (i - 1) * dc;
+		const double input = samples [i];
+		samples [i] = ai * (input + (ai - 1.0) * p4) + bi * p1 + ci * p2;
+		p2 = p1;
+		p1 = samples [i];
+		p4 = p3;
+		p3 = input;
+	}
+}
+
 autoConstantGainResonator ConstantGainResonator_create (double dT) {
 	try {
 		autoConstantGainResonator me = Thing_new (ConstantGainResonator);
@@ -143,4 +185,9 @@ void Filter_resetMemory (Filter me) {
 	my v_resetMemory ();
 }
 
+void Filter_filterBlock_inplace (Filter me, VEC samples, double a1, double b1, double c1, integer numberOfSteps) {
+	Melder_assert (numberOfSteps >= 1);
+	my v_filterBlock (samples, a1, b1, c1, numberOfSteps);
+}
+
 /* End of file Resonator.cpp */
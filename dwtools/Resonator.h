@@ -33,6 +33,7 @@ Thing_define (Filter, Daata) {
 	virtual double v_getOutput (double input);
 	virtual void v_setFB (double f, double b);
 	virtual void v_resetMemory ();
+	virtual void v_filterBlock (VEC samples, double a1, double b1, double c1, integer numberOfSteps);
 };
 
 Thing_define (Resonator, Filter) {
@@ -47,6 +48,8 @@ Thing_define (AntiResonator, Resonator) {
 		override;
 	void v_setFB (double f, double b)
 		override;
+	void v_filterBlock (VEC samples, double a1, double b1, double c1, integer numberOfSteps)
+		override;
 };
 
 Thing_define (ConstantGainResonator, Filter) {
@@ -59,6 +62,8 @@ Thing_define (ConstantGainResonator, Filter) {
 		override;
 	void v_resetMemory ()
 		override;
+	void v_filterBlock (VEC samples, double a1, double b1, double c1, integer numberOfSteps)
+		override;
 };
 
 #define Resonator_NORMALISATION_H0 0
@@ -82,5 +87,14 @@ double Filter_getOutput (Filter me, double input);
 
 void Filter_resetMemory (Filter me);
 
+/*
+	Filter the samples in place while the coefficients change linearly
+	from (a1, b1, c1) at samples [1] to the current coefficients of the filter at samples [numberOfSteps + 1]
+	(which is usually the first sample of the next block).
+	The same as Filter_getOutput for every sample with the interpolated coefficients,
+	but with one virtual call per block instead of one per sample.
+*/
+void Filter_filterBlock_inplace (Filter me, VEC samples, double a1, double b1, double c1, integer numberOfSteps);
+
 #endif /* _Resonator_h_ */
 
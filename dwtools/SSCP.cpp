@@ -1757,7 +1757,7 @@ void SSCP_unExpand (SSCP me) {
 
 void SSCP_expandLowerCholeskyInverse (SSCP me) {
 	if (NUMisEmpty (my lowerCholeskyInverse.get()))
-		my lowerCholeskyInverse = MATraw (my numberOfColumns, my numberOfColumns);
+		my lowerCholeskyInverse = MATraw (my numberOfRows == 1 ? 1 : my numberOfColumns, my numberOfColumns);   // one row if diagonal, as NUMmahalanobisDistance expects
 	if (my numberOfRows == 1) {   // diagonal
 		my lnd = 0.0;
 		for (integer j = 1; j <= my numberOfColumns; j ++) {
@@ -43,7 +43,7 @@ autoSound BandFilterSpectrogram_as_Sound (BandFilterSpectrogram me, int to_dB);
 	where erf(x) = 1 - erfc(x) and n is the windowLength in samples.
 	To compare with the rectangular window we need to divide this by the window width (n -1) x 1^2.
 */
-static void _Spectrogram_windowCorrection (Spectrogram me, integer numberOfSamples_window) {
+double BandFilterSpectrogram_gaussianWindowFactor (integer numberOfSamples_window) {
 	double windowFactor = 1.0;
 	if (numberOfSamples_window > 1) {
 		double e12 = exp (-12);
@@ -54,6 +54,11 @@ static void _Spectrogram_windowCorrection (Spectrogram me, integer numberOfSampl
 		double p1 = 4 * NUMsqrtpi * NUMsqrt3 * e12 * (1 - NUMerfcc (arg1)) * (numberOfSamples_window + 1);
 		windowFactor =  (p2 - p1 + 24 * (numberOfSamples_window - 1) * e12 * e12) / denum;
 	}
+	return windowFactor;
+}
+
+static void _Spectrogram_windowCorrection (Spectrogram me, integer numberOfSamples_window) {
+	double windowFactor = BandFilterSpectrogram_gaussianWindowFactor (numberOfSamples_window);
 	for (integer i = 1; i <= my ny; i ++) {
 		for (integer j = 1; j <= my nx; j ++) {
 			my z [i] [j] /= windowFactor;
@@ -190,32 +195,43 @@ static void Sound_into_MelSpectrogram_frame (Sound me, MelSpectrogram thee, inte
 	}
 }
 
-autoMelSpectrogram Sound_to_MelSpectrogram (Sound me, double analysisWidth, double dt, double f1_mel, double fmax_mel, double df_mel) {
-	try {
-		double samplingFrequency = 1.0 / my dx, nyquist = 0.5 * samplingFrequency;
-		double windowDuration = 2.0 * analysisWidth;   // Gaussian window
-		double fmin_mel = 0.0;
-		double fbottom = NUMhertzToMel2 (100.0), fceiling = NUMhertzToMel2 (nyquist);
+integer Sound_getMelFilterParameters (Sound me, double *inout_f1_mel, double *inout_fmax_mel, double *inout_df_mel) {
+	double samplingFrequency = 1.0 / my dx, nyquist = 0.5 * samplingFrequency;
+	double fbottom = NUMhertzToMel2 (100.0), fceiling = NUMhertzToMel2 (nyquist);
+	double f1_mel = *inout_f1_mel, fmax_mel = *inout_fmax_mel, df_mel = *inout_df_mel;
 
-		// Check defaults.
+	// Check defaults.
 
-		if (fmax_mel <= 0.0 || fmax_mel > fceiling) {
-			fmax_mel = fceiling;
-		}
-		if (fmax_mel <= f1_mel) {
-			f1_mel = fbottom; fmax_mel = fceiling;
-		}
-		if (f1_mel <= 0.0) {
-			f1_mel = fbottom;
-		}
-		if (df_mel <= 0.0) {
-			df_mel = 100.0;
-		}
+	if (fmax_mel <= 0.0 || fmax_mel > fceiling) {
+		fmax_mel = fceiling;
+	}
+	if (fmax_mel <= f1_mel) {
+		f1_mel = fbottom; fmax_mel = fceiling;
+	}
+	if (f1_mel <= 0.0) {
+		f1_mel = fbottom;
+	}
+	if (df_mel <= 0.0) {
+		df_mel = 100.0;
+	}
+
+	// Determine the number of filters.
 
-		// Determine the number of filters.
+	integer numberOfFilters = Melder_iround ((fmax_mel - f1_mel) / df_mel);
+	fmax_mel = f1_mel + numberOfFilters * df_mel;
 
-		integer numberOfFilters = Melder_iround ((fmax_mel - f1_mel) / df_mel);
-		fmax_mel = f1_mel + numberOfFilters * df_mel;
+	*inout_f1_mel = f1_mel;
+	*inout_fmax_mel = fmax_mel;
+	*inout_df_mel = df_mel;
+	return numberOfFilters;
+}
+
+autoMelSpectrogram Sound_to_MelSpectrogram (Sound me, double analysisWidth, double dt, double f1_mel, double fmax_mel, double df_mel) {
+	try {
+		double samplingFrequency = 1.0 / my dx;
+		double windowDuration = 2.0 * analysisWidth;   // Gaussian window
+		double fmin_mel = 0.0;
+		integer numberOfFilters = Sound_getMelFilterParameters (me, & f1_mel, & fmax_mel, & df_mel);
 
 		integer numberOfFrames;
 		double t1;
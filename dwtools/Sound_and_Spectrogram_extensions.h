@@ -40,6 +40,18 @@ autoBarkSpectrogram Sound_to_BarkSpectrogram (Sound me, double analysisWidth, do
 autoMelSpectrogram Sound_to_MelSpectrogram (Sound me, double analysisWidth, double dt,
 	double f1_mel, double fmax_mel, double df_mel);
 
+integer Sound_getMelFilterParameters (Sound me, double *inout_f1_mel, double *inout_fmax_mel, double *inout_df_mel);
+/*
+	Replaces the filter parameters of Sound_to_MelSpectrogram by their defaults where needed
+	and returns the number of filters.
+*/
+
+double BandFilterSpectrogram_gaussianWindowFactor (integer numberOfSamples_window);
+/*
+	The power under the Gaussian window of the filter bank analyses relative to a rectangular window of the same length;
+	the filter outputs are divided by this factor.
+*/
+
 autoSpectrogram Sound_to_Spectrogram_pitchDependent (Sound me, double analysisWidth,
 	double dt, double f1_hz, double fmax_hz, double df_hz, double relative_bw,
 	double minimumPitch, double maximumPitch);
@@ -23,9 +23,203 @@
 
 #include "Sound_to_MFCC.h"
 #include "Sound_and_Spectrogram_extensions.h"
+#include "Sound_extensions.h"
+#include "NUM2.h"
+#include "MelderThread.h"
+
+/*
+	The fused analysis: the frames are windowed in batches, each batch is Fourier-transformed with a single call,
+	and the power spectrum of every frame goes through the triangular filters, the dB conversion and the cosine transform
+	straight into the MFCC, without a Spectrum per frame and without a MelSpectrogram in between.
+	Only the nonzero weights of each filter are stored.
+	The arithmetic is that of Sound_to_MelSpectrogram followed by MelSpectrogram_to_MFCC, step by step,
+	so that both give the same coefficients (Debug option 71 takes the route via the MelSpectrogram).
+	Consecutive batches are divided over threads; every thread has its own frame matrix, spectra and FFT workspace.
+*/
+#define Sound_to_MFCC_FRAMES_PER_BATCH  32
+#define Sound_to_MFCC_BATCHES_PER_THREAD  4
+
+Thing_define (Sound_into_MFCC_Args, Thing) { public:
+	Sound sound;
+	MFCC mfcc;
+	integer firstFrame, lastFrame, framesPerBatch;
+	integer nsamp_window, nsampFFT;
+	double windowDuration, frameDx, powerScale, windowFactor;
+	constVEC window;
+	NUMfft_Table fftTable;
+	constINTVEC filterFirstBin, filterLastBin, filterOffset;
+	constVEC filterWeights;
+	constMAT cosinesTable;
+	autoMAT frames;
+	autoVEC power, filterOutput, fftWorkspace;
+};
+
+Thing_implement (Sound_into_MFCC_Args, Thing, 0);
+
+static MelderThread_RETURN_TYPE Sound_into_MFCC (Sound_into_MFCC_Args me) {
+	Sound sound = my sound;
+	MFCC thee = my mfcc;
+	const integer nsampFFT = my nsampFFT, numberOfFrequencies = nsampFFT / 2 + 1;
+	const integer numberOfFilters = my filterOutput.size;
+	const double *s = & sound -> z [1] [0];
+	VEC power = my power.get(), x = my filterOutput.get();
+	for (integer firstFrame = my firstFrame; firstFrame <= my lastFrame; firstFrame += my framesPerBatch) {
+		const integer lastFrame = std::min (firstFrame + my framesPerBatch - 1, my lastFrame);
+		MAT batch = my frames.horizontalBand (1, lastFrame - firstFrame + 1);
+		for (integer iframe = firstFrame; iframe <= lastFrame; iframe ++) {
+			/*
+				The first channel from the sample nearest to the start of the window on, as Sound_into_Sound does.
+			*/
+			double t = Sampled_indexToX (thee, iframe);
+			integer index = Sampled_xToNearestIndex (sound, t - my windowDuration / 2.0);
+			VEC frame = batch [iframe - firstFrame + 1];
+			for (integer i = 1; i <= my nsamp_window; i ++) {
+				integer j = index - 1 + i;
+				frame [i] = ( j < 1 || j > sound -> nx ? 0.0 : s [j] * my window [i] );
+			}
+			for (integer i = my nsamp_window + 1; i <= nsampFFT; i ++)
+				frame [i] = 0.0;
+		}
+
+		NUMfft_forward_batch (my fftTable, batch, my fftWorkspace.get());   // complex spectra
+
+		for (integer iframe = firstFrame; iframe <= lastFrame; iframe ++) {
+			constVEC frame = batch [iframe - firstFrame + 1];
+			/*
+				The power spectrum as in Sound_to_Spectrum_power; the bins at 0 Hz and at the Nyquist frequency count once.
+			*/
+			double re = frame [1] * my frameDx;
+			power [1] = my powerScale * (re * re) * 0.5;
+			for (integer i = 2; i < numberOfFrequencies; i ++) {
+				re = frame [i + i - 2] * my frameDx;
+				double im = frame [i + i - 1] * my frameDx;
+				power [i] = my powerScale * (re * re + im * im);
+			}
+			re = frame [nsampFFT] * my frameDx;
+			power [numberOfFrequencies] = my powerScale * (re * re) * 0.5;
+			/*
+				The filter bank in dB.
+			*/
+			for (integer ifilter = 1; ifilter <= numberOfFilters; ifilter ++) {
+				const double *weight = my filterWeights.at + my filterOffset [ifilter];
+				double p = 0.0;
+				for (integer i = my filterFirstBin [ifilter]; i <= my filterLastBin [ifilter]; i ++)
+					p += weight [i] * power [i];
+				p /= my windowFactor;
+				x [ifilter] = ( p > 0.0 ? BandFilterSpectrogram_DBFAC * log10 (p / BandFilterSpectrogram_DBREF) : -300.0 );
+			}
+			/*
+				The cosine transform, as far as the coefficients go.
+			*/
+			CC_Frame ccframe = & thy frame [iframe];
+			ccframe -> c0 = NUMinner (x, my cosinesTable.row (1));
+			for (integer i = 1; i <= ccframe -> numberOfCoefficients; i ++)
+				ccframe -> c [i] = NUMinner (x, my cosinesTable.row (i + 1));
+		}
+	}
+	MelderThread_RETURN;
+}
+
+static autoMFCC Sound_to_MFCC_fused (Sound me, integer numberOfCoefficients, double analysisWidth, double dt, double f1_mel, double fmax_mel, double df_mel) {
+	double samplingFrequency = 1.0 / my dx;
+	double windowDuration = 2.0 * analysisWidth;   // Gaussian window
+	double fmin_mel = 0.0;
+	integer numberOfFilters = Sound_getMelFilterParameters (me, & f1_mel, & fmax_mel, & df_mel);
+	Melder_require (numberOfFilters > 1,
+		U"There should be at least two filters.");
+	if (numberOfCoefficients <= 0 || numberOfCoefficients > numberOfFilters - 1)
+		numberOfCoefficients = numberOfFilters - 1;
+
+	integer numberOfFrames;
+	double t1;
+	Sampled_shortTermAnalysis (me, windowDuration, dt, & numberOfFrames, & t1);
+	autoSound window = Sound_createGaussian (windowDuration, samplingFrequency);
+	const integer nsamp_window = window -> nx;
+	integer nsampFFT = 2;
+	while (nsampFFT < nsamp_window)
+		nsampFFT *= 2;
+	const integer numberOfFrequencies = nsampFFT / 2 + 1;
+	const double frameDx = window -> dx, binWidth = 1.0 / (frameDx * nsampFFT);
+	const double powerScale = 2.0 * binWidth / (window -> xmax - window -> xmin);
+	/*
+		The bins within each triangular filter, and their weights.
+	*/
+	autoINTVEC filterFirstBin = INTVECraw (numberOfFilters), filterLastBin = INTVECraw (numberOfFilters);
+	autoINTVEC filterOffset = INTVECraw (numberOfFilters);
+	std::vector <double> weights;
+	for (integer ifilter = 1; ifilter <= numberOfFilters; ifilter ++) {
+		double fc_mel = f1_mel + (ifilter - 1) * df_mel;
+		double fc_hz = NUMmelToHertz2 (fc_mel);
+		double fl_hz = NUMmelToHertz2 (fc_mel - df_mel);
+		double fh_hz = NUMmelToHertz2 (fc_mel + df_mel);
+		double rifrom = 1.0 + Melder_roundUp (fl_hz / binWidth), rito = 1.0 + Melder_roundDown (fh_hz / binWidth);
+		integer ifrom = ( isundef (rifrom) || rifrom < 1.0 ? 1 : (integer) rifrom );   // below 0 mel the lower edge is undefined
+		integer ito = ( rito > (double) numberOfFrequencies ? numberOfFrequencies : (integer) rito );
+		filterFirstBin [ifilter] = ifrom;
+		filterLastBin [ifilter] = ito;
+		filterOffset [ifilter] = (integer) weights.size () + 1 - ifrom;   // bin i has weight number offset + i
+		for (integer i = ifrom; i <= ito; i ++)
+			weights.push_back (NUMtriangularfilter_amplitude (fl_hz, fc_hz, fh_hz, (i - 1) * binWidth));
+	}
+	autoVEC filterWeights = VECraw (std::max ((integer) weights.size (), integer (1)));
+	for (integer i = 1; i <= (integer) weights.size (); i ++)
+		filterWeights [i] = weights [(size_t) i - 1];
+	autoMAT cosinesTable = MATcosinesTable (numberOfFilters);
+
+	autoMFCC thee = MFCC_create (my xmin, my xmax, numberOfFrames, dt, t1, numberOfFilters - 1, fmin_mel, fmax_mel);
+	for (integer iframe = 1; iframe <= numberOfFrames; iframe ++)
+		CC_Frame_init (& thy frame [iframe], numberOfCoefficients);
+
+	NUMfft_Table fftTable = NUMfft_getSharedTable (nsampFFT);
+	const integer framesPerBatch = Sound_to_MFCC_FRAMES_PER_BATCH;
+	const integer framesPerThread = framesPerBatch * Sound_to_MFCC_BATCHES_PER_THREAD;
+	const integer numberOfThreads = std::min ((numberOfFrames - 1) / framesPerThread + 1, integer (MelderThread_getNumberOfProcessors ()));
+	std::vector <autoSound_into_MFCC_Args> args ((size_t) numberOfThreads);
+	for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+		autoSound_into_MFCC_Args arg = Thing_new (Sound_into_MFCC_Args);
+		arg -> sound = me;
+		arg -> mfcc = thee.get();
+		arg -> framesPerBatch = framesPerBatch;
+		arg -> nsamp_window = nsamp_window;
+		arg -> nsampFFT = nsampFFT;
+		arg -> windowDuration = windowDuration;
+		arg -> frameDx = frameDx;
+		arg -> powerScale = powerScale;
+		arg -> windowFactor = BandFilterSpectrogram_gaussianWindowFactor (nsamp_window);
+		arg -> window = window -> z.row (1);
+		arg -> fftTable = fftTable;
+		arg -> filterFirstBin = filterFirstBin.get();
+		arg -> filterLastBin = filterLastBin.get();
+		arg -> filterOffset = filterOffset.get();
+		arg -> filterWeights = filterWeights.get();
+		arg -> cosinesTable = cosinesTable.get();
+		arg -> frames = MATzero (framesPerBatch, nsampFFT);
+		arg -> power = VECzero (numberOfFrequencies);
+		arg -> filterOutput = VECzero (numberOfFilters);
+		arg -> fftWorkspace = VECraw (NUMfft_getWorkspaceSize (nsampFFT));
+		args [(size_t) ithread - 1] = arg.move();
+	}
+	autoMelderProgress progress (U"MFCC analysis");
+	for (integer firstFrame = 1; firstFrame <= numberOfFrames; firstFrame += numberOfThreads * framesPerThread) {
+		Melder_progress ((double) firstFrame / (numberOfFrames + 1.0), U"Frame ", firstFrame, U" out of ", numberOfFrames, U".");
+		integer numberOfThreadsNeeded = 0;
+		for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+			const integer threadFirstFrame = firstFrame + (ithread - 1) * framesPerThread;
+			if (threadFirstFrame > numberOfFrames)
+				break;
+			args [(size_t) ithread - 1] -> firstFrame = threadFirstFrame;
+			args [(size_t) ithread - 1] -> lastFrame = std::min (threadFirstFrame + framesPerThread - 1, numberOfFrames);
+			numberOfThreadsNeeded = ithread;
+		}
+		MelderThread_run (Sound_into_MFCC, args.data(), (int) numberOfThreadsNeeded);
+	}
+	return thee;
+}
 
 autoMFCC Sound_to_MFCC (Sound me, integer numberOfCoefficients, double analysisWidth, double dt, double f1_mel, double fmax_mel, double df_mel) {
 	try {
+		if (Melder_debug != 71)
+			return Sound_to_MFCC_fused (me, numberOfCoefficients, analysisWidth, dt, f1_mel, fmax_mel, df_mel);
 		autoMelSpectrogram mf = Sound_to_MelSpectrogram (me, analysisWidth, dt, f1_mel, fmax_mel, df_mel);
 		autoMFCC mfcc = MelSpectrogram_to_MFCC (mf.get(), numberOfCoefficients);
 		return mfcc;
@@ -77,9 +77,10 @@ autoDurationTier TextGrid_to_DurationTier (TextGrid me, integer tierNumber,
 	try {
 		autoDurationTier him = DurationTier_create (my xmin, my xmax);
 		IntervalTier tier = TextGrid_checkSpecifiedTierIsIntervalTier (me, tierNumber);
+		MelderStringMatcher matcher (which, criterion, true);
 		for (integer i = 1; i <= tier ->intervals.size; i ++) {
 			TextInterval segment = tier -> intervals.at [i];
-			if (Melder_stringMatchesCriterion (segment -> text.get(), which, criterion, true)) {
+			if (matcher. matches (segment -> text.get())) {
 				double xmin = segment -> xmin, xmax = segment -> xmax;
 				RealTier_addPoint (him.get(), xmin, 1.0);
 				RealTier_addPoint (him.get(), xmin + leftTransitionDuration, timeScalefactor);
@@ -805,9 +805,10 @@ double TextGrid_getTotalDurationOfIntervalsWhere (TextGrid me, integer tierNumbe
 	try {
 		longdouble totalDuration = 0.0;
 		IntervalTier tier = TextGrid_checkSpecifiedTierIsIntervalTier (me, tierNumber);
+		MelderStringMatcher matcher (which, criterion, true);
 		for (integer iinterval = 1; iinterval <= tier -> intervals.size; iinterval ++) {
 			TextInterval interval = tier -> intervals.at [iinterval];
-			if (Melder_stringMatchesCriterion (interval -> text.get(), which, criterion, true)) {
+			if (matcher. matches (interval -> text.get())) {
 				totalDuration += interval -> xmax - interval -> xmin;
 			}
 		}
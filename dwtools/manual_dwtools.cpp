@@ -2684,7 +2684,7 @@ NORMAL (U"An object of type PCA represents the principal components analysis "
 ENTRY (U"Commands")
 NORMAL (U"Creation:")
 LIST_ITEM (U"\\bu @@Principal component analysis@ tutorial")
-LIST_ITEM (U"\\bu @@TableOfReal: To PCA@")
+LIST_ITEM (U"\\bu @@TableOfReal: To PCA...@")
 ENTRY (U"Inside a PCA")
 NORMAL (U"With @Inspect you will see that this type contains the same "
 	"attributes as an @Eigen with the following extras:")
@@ -3154,7 +3154,7 @@ NORMAL (U"Traditionally, principal component analysis is performed on the "
 	"variables differ much, or if the units of measurement of the "
 	"variables differ. You can standardize the data in the TableOfReal by choosing @@TableOfReal: Standardize columns|Standardize columns@.")
 NORMAL (U"To perform the analysis, we select the TabelOfReal data matrix in the list of objects and choose "
-	"@@TableOfReal: To PCA|To PCA@. This will result in a new PCA object in the "
+	"@@TableOfReal: To PCA...|To PCA...@. This will result in a new PCA object in the "
 	"list of objects.")
 NORMAL (U"We can now make a @@Scree plot|scree@ plot of the eigenvalues, @@Eigen: Draw "
 	"eigenvalues...|Draw eigenvalues...@ "
@@ -5046,9 +5046,23 @@ NORMAL (U"The a priori probabilities in the Discriminant will be calculated from
 FORMULA (U"%aprioriProbability__%i_ = %n__%i_ / \\Si__%k=1..%numberOfGroups_ %n__%k_")
 MAN_END
 
-MAN_BEGIN (U"TableOfReal: To PCA", U"djmw", 20160223)
+MAN_BEGIN (U"TableOfReal: To PCA...", U"djmw", 20181018)
 INTRO (U"A command that creates a @PCA object from every selected "
 	"@TableOfReal object, where the TableOfReal object is interpreted as row-oriented, i.e. %%numberOfRows% data vectors, each data vector has %%numberofColumns% elements.")
+ENTRY (U"Settings")
+TAG (U"##Method")
+DEFINITION (U"determines how the components are calculated.")
+LIST_ITEM1 (U"\\bu %%SVD%: from the singular value decomposition of a centred copy of the table. This is the most precise method.")
+LIST_ITEM1 (U"\\bu %%covariance%: from the eigenvalue decomposition of the covariance matrix, "
+	"whose sums of squares and cross products are accumulated in parallel without copying the table. "
+	"This is much faster and needs much less memory when there are many more rows than columns.")
+LIST_ITEM1 (U"\\bu %%randomized SVD%: only the first %%numberOfComponents% components, from a randomized range finder with two power iterations, "
+	"calculated in parallel without copying the table. "
+	"This is the method for large tables of which only a few components are needed.")
+TAG (U"##Number of components (0 = all)")
+DEFINITION (U"the number of components that the PCA keeps.")
+ENTRY (U"Matrix")
+NORMAL (U"##Matrix: To PCA (by rows)...# and ##Matrix: To PCA (by columns)...# have the same settings.")
 NORMAL (U"In @@Principal component analysis|the tutorial on PCA@ you will find more info on principal component analysis.")
 MAN_END
 
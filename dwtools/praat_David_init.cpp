@@ -122,6 +122,7 @@
 #include "CCs_to_DTW.h"
 #include "Discriminant_PatternList_Categories.h"
 #include "DTW_and_TextGrid.h"
+#include "DTWBatch.h"
 #include "Permutation_and_Index.h"
 #include "Pitch_extensions.h"
 #include "Sound_and_Spectrogram_extensions.h"
@@ -463,6 +464,20 @@ DO
 	CONVERT_COUPLE_END (my name.get(), U"_", your name.get());
 }
 
+FORM (NEW1_CCs_to_Table_dtw, U"CCs: To Table (DTW)", nullptr) {
+	LABEL (U"The first selected CC is the query, the others are the references")
+	REAL (cepstralWeight, U"Cepstral weight", U"1.0")
+	REAL (logEnergyWeight, U"Log energy weight", U"0.0")
+	REAL (sakoeChibaBand, U"Sakoe-Chiba band (s)", U"0.1")
+	INTEGER (numberOfBestMatches, U"Number of best matches (0 = all)", U"10")
+	OK
+DO
+	FIND_LIST (CC)
+		autoTable result = CCs_to_Table_dtw (& list, cepstralWeight, logEnergyWeight, sakoeChibaBand, numberOfBestMatches);
+		praat_new (result.move(), list.at [1] -> name.get(), U"_dtw");
+	END
+}
+
 DIRECT (NEW_CC_to_Matrix) {
 	CONVERT_EACH (CC)
 		autoMatrix result = CC_to_Matrix (me);
@@ -2158,6 +2173,32 @@ DIRECT (NEW_EditCostsTable_to_TableOfReal) {
 	CONVERT_EACH_END (my name.get());
 }
 
+FORM (NEW_Table_to_Table_editDistances, U"Table: To Table (edit distances)", nullptr) {
+	SENTENCE (targetColumnLabel, U"Target column", U"target")
+	SENTENCE (sourceColumnLabel, U"Source column", U"source")
+	BOOLEAN (symbolsAreSeparatedBySpaces, U"Symbols are separated by spaces", true)
+	REAL (maximumDistance, U"Maximum distance (0 = none)", U"0.0")
+	OK
+DO
+	CONVERT_EACH (Table)
+		autoTable result = Table_EditCostsTable_to_Table_editDistances (me, targetColumnLabel, sourceColumnLabel,
+			symbolsAreSeparatedBySpaces, maximumDistance, nullptr);
+	CONVERT_EACH_END (my name.get(), U"_distances")
+}
+
+FORM (NEW1_Table_EditCostsTable_to_Table_editDistances, U"Table & EditCostsTable: To Table (edit distances)", nullptr) {
+	SENTENCE (targetColumnLabel, U"Target column", U"target")
+	SENTENCE (sourceColumnLabel, U"Source column", U"source")
+	BOOLEAN (symbolsAreSeparatedBySpaces, U"Symbols are separated by spaces", true)
+	REAL (maximumDistance, U"Maximum distance (0 = none)", U"0.0")
+	OK
+DO
+	CONVERT_TWO (Table, EditCostsTable)
+		autoTable result = Table_EditCostsTable_to_Table_editDistances (me, targetColumnLabel, sourceColumnLabel,
+			symbolsAreSeparatedBySpaces, maximumDistance, you);
+	CONVERT_TWO_END (my name.get(), U"_distances")
+}
+
 FORM (NEW_EditCostsTable_createEmpty, U"Create empty EditCostsTable", U"Create empty EditCostsTable...") {
 	SENTENCE (name, U"Name", U"editCosts")
 	INTEGER (numberOfTargetSymbols, U"Number of target symbols", U"0")
@@ -3526,13 +3567,33 @@ DIRECT (NEW_Matrix_transpose) {
 
 DIRECT (NEW_Matrix_to_PCA_byColumns) {
 	CONVERT_EACH (Matrix)
-		autoPCA result = Matrix_to_PCA_byColumns (me);
+		autoPCA result = Matrix_to_PCA_byColumns (me, kPCA_method::Svd, 0);
 	CONVERT_EACH_END (my name.get(), U"_columns");
 }
 
 DIRECT (NEW_Matrix_to_PCA_byRows) {
 	CONVERT_EACH (Matrix)
-		autoPCA result = Matrix_to_PCA_byRows (me);
+		autoPCA result = Matrix_to_PCA_byRows (me, kPCA_method::Svd, 0);
+	CONVERT_EACH_END (my name.get(), U"_rows")
+}
+
+FORM (NEW_Matrix_to_PCA_byColumns_method, U"Matrix: To PCA (by columns)", U"TableOfReal: To PCA...") {
+	OPTIONMENU_ENUM (kPCA_method, method, U"Method", kPCA_method::DEFAULT)
+	INTEGER (numberOfComponents, U"Number of components (0 = all)", U"0")
+	OK
+DO
+	CONVERT_EACH (Matrix)
+		autoPCA result = Matrix_to_PCA_byColumns (me, method, numberOfComponents);
+	CONVERT_EACH_END (my name.get(), U"_columns");
+}
+
+FORM (NEW_Matrix_to_PCA_byRows_method, U"Matrix: To PCA (by rows)", U"TableOfReal: To PCA...") {
+	OPTIONMENU_ENUM (kPCA_method, method, U"Method", kPCA_method::DEFAULT)
+	INTEGER (numberOfComponents, U"Number of components (0 = all)", U"0")
+	OK
+DO
+	CONVERT_EACH (Matrix)
+		autoPCA result = Matrix_to_PCA_byRows (me, method, numberOfComponents);
 	CONVERT_EACH_END (my name.get(), U"_rows")
 }
 
@@ -4481,6 +4542,20 @@ DO
 	CONVERT_COUPLE_END (my name.get(), U"_", your name.get())
 }
 
+FORM (NEW1_Pitches_to_Table_dtw, U"Pitches: To Table (DTW)", nullptr) {
+	LABEL (U"The first selected Pitch is the query, the others are the references")
+	REAL (vuvCosts, U"Voiced-unvoiced costs", U"24.0")
+	REAL (weight, U"Time costs weight", U"10.0")
+	REAL (sakoeChibaBand, U"Sakoe-Chiba band (s)", U"0.1")
+	INTEGER (numberOfBestMatches, U"Number of best matches (0 = all)", U"10")
+	OK
+DO
+	FIND_LIST (Pitch)
+		autoTable result = Pitches_to_Table_dtw (& list, vuvCosts, weight, sakoeChibaBand, numberOfBestMatches);
+		praat_new (result.move(), list.at [1] -> name.get(), U"_dtw");
+	END
+}
+
 FORM (NEW_PitchTier_to_Pitch, U"PitchTier: To Pitch", U"PitchTier: To Pitch...") {
 	POSITIVE (stepSize, U"Step size", U"0.02")
 	POSITIVE (pitchFloor, U"Pitch floor (Hz)", U"60.0")
@@ -5248,6 +5323,20 @@ DO
    CONVERT_COUPLE_END (my name.get(), U"_", your name.get())
 }
 
+FORM (NEW1_Sounds_to_Table_dtw, U"Sounds: To Table (DTW)", nullptr) {
+	LABEL (U"The first selected Sound is the query, the others are the references")
+	POSITIVE (windowLength, U"Window length (s)", U"0.015")
+	POSITIVE (timeStep, U"Time step (s)", U"0.005")
+	REAL (sakoeChibaBand, U"Sakoe-Chiba band (s)", U"0.1")
+	INTEGER (numberOfBestMatches, U"Number of best matches (0 = all)", U"10")
+	OK
+DO
+	FIND_LIST (Sound)
+		autoTable result = Sounds_to_Table_dtw (& list, windowLength, timeStep, sakoeChibaBand, numberOfBestMatches);
+		praat_new (result.move(), list.at [1] -> name.get(), U"_dtw");
+	END
+}
+
 FORM (NEW_Sound_to_TextGrid_detectSilences, U"Sound: To TextGrid (silences)", U"Sound: To TextGrid (silences)...") {
 	LABEL (U"Parameters for the intensity analysis")
 	POSITIVE (minimumPitch, U"Minimum pitch (Hz)", U"100")
@@ -7073,7 +7162,17 @@ DIRECT (NEW_TableOfReal_to_Discriminant) {
 
 DIRECT (NEW_TableOfReal_to_PCA_byRows) {
 	CONVERT_EACH (TableOfReal)
-		autoPCA result = TableOfReal_to_PCA_byRows (me);
+		autoPCA result = TableOfReal_to_PCA_byRows (me, kPCA_method::Svd, 0);
+	CONVERT_EACH_END (my name.get())
+}
+
+FORM (NEW_TableOfReal_to_PCA_byRows_method, U"TableOfReal: To PCA", U"TableOfReal: To PCA...") {
+	OPTIONMENU_ENUM (kPCA_method, method, U"Method", kPCA_method::DEFAULT)
+	INTEGER (numberOfComponents, U"Number of components (0 = all)", U"0")
+	OK
+DO
+	CONVERT_EACH (TableOfReal)
+		autoPCA result = TableOfReal_to_PCA_byRows (me, method, numberOfComponents);
 	CONVERT_EACH_END (my name.get())
 }
 
@@ -7393,6 +7492,7 @@ void praat_CC_init (ClassInfo klas) {
 	praat_addAction1 (klas, 1, U"Get value...", nullptr, praat_HIDDEN + praat_DEPTH_1, REAL_CC_getValue);
 	praat_addAction1 (klas, 0, U"To Matrix", nullptr, 0, NEW_CC_to_Matrix);
 	praat_addAction1 (klas, 2, U"To DTW...", nullptr, 0, NEW1_CCs_to_DTW);
+	praat_addAction1 (klas, 0, U"To Table (DTW)...", nullptr, 0, NEW1_CCs_to_Table_dtw);
 }
 
 static void praat_Eigen_Matrix_project (ClassInfo klase, ClassInfo klasm); // deprecated 2014
@@ -8092,8 +8192,10 @@ void praat_uvafon_David_init () {
 	praat_addAction1 (classMatrix, 0, U"Get standard deviation...", U"Get mean...", 1, REAL_Matrix_getStandardDeviation);
 	praat_addAction1 (classMatrix, 0, U"Transpose", U"Synthesize", 0, NEW_Matrix_transpose);
 	praat_addAction1 (classMatrix, 0, U"Solve equation...", U"Analyse", 0, NEW_Matrix_solveEquation);
-	praat_addAction1 (classMatrix, 0, U"To PCA (by rows)", U"Solve equation...", 0, NEW_Matrix_to_PCA_byRows);
-	praat_addAction1 (classMatrix, 0, U"To PCA (by columns)", U"To PCA (by rows)", 0, NEW_Matrix_to_PCA_byColumns);
+	praat_addAction1 (classMatrix, 0, U"To PCA (by rows)...", U"Solve equation...", 0, NEW_Matrix_to_PCA_byRows_method);
+	praat_addAction1 (classMatrix, 0, U"To PCA (by columns)...", U"To PCA (by rows)...", 0, NEW_Matrix_to_PCA_byColumns_method);
+	praat_addAction1 (classMatrix, 0, U"To PCA (by rows)", U"To PCA (by columns)...", praat_HIDDEN, NEW_Matrix_to_PCA_byRows);
+	praat_addAction1 (classMatrix, 0, U"To PCA (by columns)", U"To PCA (by rows)", praat_HIDDEN, NEW_Matrix_to_PCA_byColumns);
 	praat_addAction1 (classMatrix, 0, U"To PatternList...", U"To VocalTract", 1, NEW_Matrix_to_PatternList);
 	praat_addAction1 (classMatrix, 0, U"To Pattern...", U"*To PatternList...", praat_DEPRECATED_2016, NEW_Matrix_to_PatternList);
 	praat_addAction1 (classMatrix, 0, U"To ActivationList", U"To PatternList...", 1, NEW_Matrix_to_ActivationList);
@@ -8219,6 +8321,7 @@ void praat_uvafon_David_init () {
 	praat_addAction1 (classPermutation, 0, U"Multiply", nullptr, 0, NEW1_Permutations_multiply);
 
 	praat_addAction1 (classPitch, 2, U"To DTW...", U"To PointProcess", praat_HIDDEN, NEW1_Pitches_to_DTW);
+	praat_addAction1 (classPitch, 0, U"To Table (DTW)...", U"To DTW...", praat_HIDDEN, NEW1_Pitches_to_Table_dtw);
 
 	praat_addAction1 (classPitchTier, 0, U"To Pitch...", U"To Sound (sine)...", 1, NEW_PitchTier_to_Pitch);
 	praat_addAction1 (classPitchTier, 0, U"Modify interval...", U"Add point...", 1, MODIFY_PitchTier_modifyInterval);
@@ -8305,6 +8408,7 @@ void praat_uvafon_David_init () {
 	praat_addAction1 (classSound, 0, U"To Polygon...", U"Down to Matrix", praat_DEPTH_1 | praat_HIDDEN, NEW_Sound_to_Polygon);
     praat_addAction1 (classSound, 2, U"To Polygon (enclosed)...", U"Cross-correlate...", praat_DEPTH_1 | praat_HIDDEN, NEW1_Sounds_to_Polygon_enclosed);
     praat_addAction1 (classSound, 2, U"To DTW...", U"Cross-correlate...", praat_DEPTH_1, NEW1_Sounds_to_DTW);
+	praat_addAction1 (classSound, 0, U"To Table (DTW)...", U"To DTW...", praat_DEPTH_1, NEW1_Sounds_to_Table_dtw);
 
 	praat_addAction1 (classSound, 1, U"Filter (gammatone)...", U"Filter (de-emphasis)...", 1, NEW_Sound_filterByGammaToneFilter4);
 	praat_addAction1 (classSound, 0, U"Remove noise...", U"Filter (formula)...", 1, NEW_Sound_removeNoise);
@@ -8428,12 +8532,15 @@ void praat_uvafon_David_init () {
 	praat_addAction1 (classTable, 0, U"To KlattTable", nullptr, praat_HIDDEN, NEW_Table_to_KlattTable);
 	praat_addAction1 (classTable, 1, U"Get median absolute deviation...", U"Get standard deviation...", 1, REAL_Table_getMedianAbsoluteDeviation);
 	praat_addAction1 (classTable, 0, U"To StringsIndex (column)...", nullptr, praat_HIDDEN, NEW_Table_to_StringsIndex_column);
+	praat_addAction1 (classTable, 0, U"To Table (edit distances)...", nullptr, 0, NEW_Table_to_Table_editDistances);
+	praat_addAction2 (classTable, 1, classEditCostsTable, 1, U"To Table (edit distances)...", nullptr, 0, NEW1_Table_EditCostsTable_to_Table_editDistances);
 
 	praat_addAction1 (classTableOfReal, 1, U"Report multivariate normality...", U"Get column stdev (label)...", praat_DEPTH_1 | praat_HIDDEN, INFO_TableOfReal_reportMultivariateNormality);
 	praat_addAction1 (classTableOfReal, 0, U"Append columns", U"Append", 1, NEW1_TableOfReal_appendColumns);
 	praat_addAction1 (classTableOfReal, 0, U"Multivariate statistics -", nullptr, 0, 0);
 	praat_addAction1 (classTableOfReal, 0, U"To Discriminant", nullptr, 1, NEW_TableOfReal_to_Discriminant);
-	praat_addAction1 (classTableOfReal, 0, U"To PCA", nullptr, 1, NEW_TableOfReal_to_PCA_byRows);
+	praat_addAction1 (classTableOfReal, 0, U"To PCA...", nullptr, 1, NEW_TableOfReal_to_PCA_byRows_method);
+	praat_addAction1 (classTableOfReal, 0, U"To PCA", nullptr, praat_DEPTH_1 | praat_HIDDEN, NEW_TableOfReal_to_PCA_byRows);
 	praat_addAction1 (classTableOfReal, 0, U"To SSCP...", nullptr, 1, NEW_TableOfReal_to_SSCP);
 	praat_addAction1 (classTableOfReal, 0, U"To SSCP (row weights)...", nullptr, 1, NEW_TableOfReal_to_SSCP_rowWeights);
 	praat_addAction1 (classTableOfReal, 0, U"To Covariance", nullptr, 1, NEW_TableOfReal_to_Covariance);
@@ -208,7 +208,7 @@ FORM (REAL_GaussianMixture_TableOfReal_getLikelihoodValue, U"GaussianMixture & T
 	OK
 DO
 	NUMBER_TWO (GaussianMixture, TableOfReal)
-		conststring32 criterionText = GaussianMixture_criterionText (criterion);
+		conststring32 criterionText = GaussianMixture_criterionText (criterion - 1);
 		double lnpdn = GaussianMixture_TableOfReal_getLikelihoodValue (me, you, criterion - 1);
 		double result = lnpdn / you -> numberOfRows;
 	NUMBER_TWO_END (U" (= ", criterionText, U", n = ", you -> numberOfRows, U")")
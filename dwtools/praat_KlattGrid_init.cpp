@@ -783,17 +783,45 @@ DO
 		KlattGrid_formantSelection_vocalTract (me, filtersStructure, fromOralFormant, toOralFormant, fromNasalFormant, toNasalFormant, fromNasalAntiFormant, toNasalAntiFormant);
 		KlattGrid_formantSelection_coupling (me, fromTrachealFormant, toTrachealFormant, fromTrachealAntiFormant, toTrachealAntiFormant, fromDeltaFormant, toDeltaFormant, fromDeltaBandwidth, toDeltaBandwidth);
 		KlattGrid_formantSelection_frication (me, fromFricationFormant, toFricationFormant, useFricationBypass);
-		autoSound result = KlattGrid_to_Sound (me);
+		autoSound result = KlattGrid_to_Sound (me, nullptr);
 	CONVERT_EACH_END (my name.get())
 }
 
 DIRECT (NEW_KlattGrid_to_Sound) {
 	CONVERT_EACH (KlattGrid)
 		KlattGrid_setDefaultPlayOptions (me);
-		autoSound result = KlattGrid_to_Sound (me);
+		autoSound result = KlattGrid_to_Sound (me, nullptr);
 	CONVERT_EACH_END (my name.get())
 }
 
+static autoSynthesisBatch KlattGrids_createDefaultSynthesisBatch (OrderedOf<structKlattGrid>* klattGrids) {
+	for (integer igrid = 1; igrid <= klattGrids->size; igrid ++)
+		KlattGrid_setDefaultPlayOptions (klattGrids->at [igrid]);
+	return KlattGrids_createSynthesisBatch (klattGrids);
+}
+
+DIRECT (NEW2_KlattGrids_to_Sound_batch) {
+	FIND_LIST (KlattGrid)
+		autoSynthesisBatch batch = KlattGrids_createDefaultSynthesisBatch (& list);
+		autoSound sound;
+		autoTextGrid textGrid;
+		SynthesisBatch_to_Sound_TextGrid (batch.get(), & sound, & textGrid);
+		praat_new (sound.move(), U"batch");
+		praat_new (textGrid.move(), U"batch");
+	END
+}
+
+FORM (SAVE_KlattGrids_saveAsWavFiles_batch, U"KlattGrids: Save as WAV files (batch)", U"KlattGrid: To Sound") {
+	TEXTFIELD (folder, U"Folder:", U"")
+	OK
+DO
+	FIND_LIST (KlattGrid)
+		autoSynthesisBatch batch = KlattGrids_createDefaultSynthesisBatch (& list);
+		SynthesisBatch_saveAsWavFiles (batch.get(), folder);
+		SynthesisBatch_infoThroughput (batch.get());
+	END_NO_NEW_DATA
+}
+
 FORM (PLAY_KlattGrid_playSpecial, U"KlattGrid: Play special", U"KlattGrid: Play special...") {
 	REAL (fromTime, U"left Time range (s)", U"0")
 	REAL (toTime, U"right Time range (s)", U"0")
@@ -981,6 +1009,8 @@ void praat_KlattGrid_init () {
 	praat_addAction1 (classKlattGrid, 0, U"To Sound", nullptr, 0, NEW_KlattGrid_to_Sound);
 	praat_addAction1 (classKlattGrid, 0, U"To Sound (special)...", nullptr, 0, NEW_KlattGrid_to_Sound_special);
 	praat_addAction1 (classKlattGrid, 0, U"To Sound (phonation)...", nullptr, 0, NEW_KlattGrid_to_Sound_phonation);
+	praat_addAction1 (classKlattGrid, 0, U"To Sound (batch)", nullptr, 0, NEW2_KlattGrids_to_Sound_batch);
+	praat_addAction1 (classKlattGrid, 0, U"Save as WAV files (batch)...", nullptr, 0, SAVE_KlattGrids_saveAsWavFiles_batch);
 
 	praat_addAction1 (classKlattGrid, 0, U"Draw -", nullptr, 0, nullptr);
 	praat_addAction1 (classKlattGrid, 0, U"Draw synthesizer...", nullptr, 1, GRAPHICS_KlattGrid_draw);
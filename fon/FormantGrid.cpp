@@ -156,36 +156,70 @@ void FormantGrid_removeBandwidthPointsBetween (FormantGrid me, integer iformant,
 	AnyTier_removePointsBetween (my bandwidths.at [iformant]->asAnyTier(), tmin, tmax);
 }
 
+/*
+	The LP coefficients of one formant at time t: D(z) = 1 + p z^-1 + q z^-2.
+	Returns 0 if the formant or the bandwidth is undefined, 1 for a single pole, 2 for a double pole.
+*/
+static int FormantGrid_getPoleCoefficients (RealTier formantTier, RealTier bandwidthTier, double t, double dt, double *out_p, double *out_q) {
+	const double formant = RealTier_getValueAtTime (formantTier, t);
+	const double bandwidth = RealTier_getValueAtTime (bandwidthTier, t);
+	if (isundef (formant) || isundef (bandwidth))
+		return 0;
+	const double cosomdt = cos (2 * NUMpi * formant * dt);
+	const double r = exp (- NUMpi * bandwidth * dt);
+	/* Formants at 0 Hz or the Nyquist are single poles, others are double poles. */
+	if (fabs (cosomdt) > 0.999999) {   /* Allow for round-off errors. */
+		/* single pole: D(z) = 1 - r z^-1 */
+		*out_p = - r;
+		*out_q = 0.0;
+		return 1;
+	}
+	/* double pole: D(z) = 1 + p z^-1 + q z^-2 */
+	*out_p = - 2 * r * cosomdt;
+	*out_q = r * r;
+	return 2;
+}
+
+/*
+	The tiers are sampled only every FormantGrid_FILTER_BLOCK_SIZE samples, and within a block the coefficients
+	of a double pole are interpolated linearly; blocks with a single pole or an undefined value at one of their ends,
+	and all blocks if Debug option 63 is set, are filtered with coefficients computed at every sample.
+*/
+#define FormantGrid_FILTER_BLOCK_SIZE  32
+
 void Sound_FormantGrid_filter_inplace (Sound me, FormantGrid formantGrid) {
-	double dt = my dx;
+	const double dt = my dx;
+	const integer blockSize = ( Melder_debug == 63 ? 1 : FormantGrid_FILTER_BLOCK_SIZE );
 	if (formantGrid -> formants.size > 0 && formantGrid -> bandwidths.size > 0) {
 		for (integer iformant = 1; iformant <= formantGrid -> formants.size; iformant ++) {
 			RealTier formantTier = formantGrid -> formants.at [iformant];
 			RealTier bandwidthTier = formantGrid -> bandwidths.at [iformant];
-			for (integer isamp = 1; isamp <= my nx; isamp ++) {
-				double t = my x1 + (isamp - 1) * my dx;
-				/*
-				 * Compute LP coefficients.
-				 */
-				double formant, bandwidth;
-				formant = RealTier_getValueAtTime (formantTier, t);
-				bandwidth = RealTier_getValueAtTime (bandwidthTier, t);
-				if (isdefined (formant) && isdefined (bandwidth)) {
-					double cosomdt = cos (2 * NUMpi * formant * dt);
-					double r = exp (- NUMpi * bandwidth * dt);
-					/* Formants at 0 Hz or the Nyquist are single poles, others are double poles. */
-					if (fabs (cosomdt) > 0.999999) {   /* Allow for round-off errors. */
-						/* single pole: D(z) = 1 - r z^-1 */
-						for (integer channel = 1; channel <= my ny; channel ++) {
-							if (isamp > 1) my z [channel] [isamp] += r * my z [channel] [isamp - 1];
+			double pNext = 0.0, qNext = 0.0;
+			int poleKindNext = FormantGrid_getPoleCoefficients (formantTier, bandwidthTier, my x1, dt, & pNext, & qNext);
+			for (integer firstSample = 1; firstSample <= my nx; firstSample += blockSize) {
+				const integer nextBlockStart = firstSample + blockSize;
+				const integer lastSample = std::min (nextBlockStart - 1, my nx);
+				const double pFirst = pNext, qFirst = qNext;
+				const int poleKindFirst = poleKindNext;
+				poleKindNext = FormantGrid_getPoleCoefficients (formantTier, bandwidthTier, my x1 + (nextBlockStart - 1) * dt, dt, & pNext, & qNext);
+				if (poleKindFirst == 2 && poleKindNext == 2) {
+					const double dp = (pNext - pFirst) / blockSize, dq = (qNext - qFirst) / blockSize;
+					for (integer channel = 1; channel <= my ny; channel ++) {
+						VEC z = my z.row (channel);
+						for (integer isamp = firstSample; isamp <= lastSample; isamp ++) {
+							const double p = pFirst + (isamp - firstSample) * dp, q = qFirst + (isamp - firstSample) * dq;
+							if (isamp > 1) z [isamp] -= p * z [isamp - 1];
+							if (isamp > 2) z [isamp] -= q * z [isamp - 2];
 						}
-					} else {
-						/* double pole: D(z) = 1 + p z^-1 + q z^-2 */
-						double p = - 2 * r * cosomdt;
-						double q = r * r;
+					}
+				} else {
+					for (integer isamp = firstSample; isamp <= lastSample; isamp ++) {
+						double p = pFirst, q = qFirst;
+						const int poleKind = ( isamp == firstSample ? poleKindFirst :
+								FormantGrid_getPoleCoefficients (formantTier, bandwidthTier, my x1 + (isamp - 1) * dt, dt, & p, & q) );
 						for (integer channel = 1; channel <= my ny; channel ++) {
-							if (isamp > 1) my z [channel] [isamp] -= p * my z [channel] [isamp - 1];
-							if (isamp > 2) my z [channel] [isamp] -= q * my z [channel] [isamp - 2];
+							if (poleKind >= 1 && isamp > 1) my z [channel] [isamp] -= p * my z [channel] [isamp - 1];
+							if (poleKind == 2 && isamp > 2) my z [channel] [isamp] -= q * my z [channel] [isamp - 2];
 						}
 					}
 				}
@@ -516,13 +516,69 @@ bool LongSound_haveWindow (LongSound me, double tmin, double tmax) {
 	return true;
 }
 
+SoundEnvelope LongSound_haveEnvelope (LongSound me) {
+	/*
+		The progress window handles events, which can ask for the window that is being drawn to be drawn again;
+		that drawing then does without an envelope.
+	*/
+	static bool isBuildingEnvelope;
+	if (my envelope || my envelopeCancelled || isBuildingEnvelope)
+		return my envelope.get();
+	try {
+		isBuildingEnvelope = true;
+		/*
+			The envelope is needed only for windows that exceed the buffer, i.e. for many samples per pixel,
+			so that its blocks can be large, which keeps the envelope of a file of many hours small.
+		*/
+		constexpr integer blockSize = SoundEnvelope_BRANCHING * SoundEnvelope_BRANCHING * SoundEnvelope_BRANCHING;
+		autoSoundEnvelope envelope = SoundEnvelope_create (my numberOfChannels, my nx, blockSize);
+		/*
+			Read the file in chunks that consist of whole level-1 blocks.
+		*/
+		constexpr integer chunkSize = 1024 * blockSize;
+		autoMAT chunk;
+		autoMelderProgress progress (U"Computing the envelope of the sound file...");
+		for (integer firstSample = 1; firstSample <= my nx; firstSample += chunkSize) {
+			try {
+				Melder_progress ((double) (firstSample - 1) / my nx,
+					U"Computing the envelope of the sound file: ", firstSample - 1, U" of ", my nx, U" samples.");
+			} catch (MelderError) {
+				Melder_clearError ();
+				my envelopeCancelled = true;
+				isBuildingEnvelope = false;
+				return nullptr;
+			}
+			const integer numberOfSamples = std::min (chunkSize, my nx - firstSample + 1);
+			if (chunk.ncol != numberOfSamples)
+				chunk = MATraw (my numberOfChannels, numberOfSamples);
+			LongSound_readAudioToFloat (me, chunk.get(), firstSample);
+			for (integer channel = 1; channel <= my numberOfChannels; channel ++)
+				SoundEnvelope_setSamples (envelope.get(), channel, firstSample, chunk.row (channel));
+		}
+		SoundEnvelope_finish (envelope.get());
+		my envelope = envelope.move();
+		isBuildingEnvelope = false;
+		return my envelope.get();
+	} catch (MelderError) {
+		isBuildingEnvelope = false;
+		Melder_throw (me, U": envelope not computed.");
+	}
+}
+
 void LongSound_getWindowExtrema (LongSound me, double tmin, double tmax, int channel, double *minimum, double *maximum) {
 	integer imin, imax;
 	(void) Sampled_getWindowSamples (me, tmin, tmax, & imin, & imax);
 	*minimum = 1.0;
 	*maximum = -1.0;
 	try {
-		LongSound_haveWindow (me, tmin, tmax);
+		if (! LongSound_haveWindow (me, tmin, tmax)) {
+			if (Melder_debug == 65 || imin > imax)
+				return;
+			SoundEnvelope envelope = LongSound_haveEnvelope (me);
+			if (envelope)
+				SoundEnvelope_getExtrema (envelope, channel, imin, imax, constVEC (), minimum, maximum);
+			return;
+		}
 	} catch (MelderError) {
 		Melder_clearError ();
 		return;
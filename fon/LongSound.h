@@ -18,7 +18,7 @@
  * along with this work. If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include "Sound.h"
+#include "SoundEnvelope.h"
 #include "Collection.h"
 
 #define COMPRESSED_MODE_READ_FLOAT 0
@@ -44,6 +44,8 @@ Thing_define (LongSound, Sampled) {
 	integer compressedSamplesLeft;
 	double *compressedFloats [2];
 	int16 *compressedShorts;
+	autoSoundEnvelope envelope;   // of the whole file, built when first needed; the file does not change while it is open
+	bool envelopeCancelled;   // the user cancelled the building of the envelope, which is therefore not tried again
 
 	void v_destroy () noexcept
 		override;
@@ -67,6 +69,16 @@ bool LongSound_haveWindow (LongSound me, double tmin, double tmax);
  */
 
 void LongSound_getWindowExtrema (LongSound me, double tmin, double tmax, int channel, double *minimum, double *maximum);
+/*
+ * If the window exceeds the buffer, the extrema come from the envelope,
+ * widened to whole level-1 blocks (Debug option 65: minimum 1 and maximum -1, as if there were no samples).
+ */
+
+SoundEnvelope LongSound_haveEnvelope (LongSound me);
+/*
+ * Reads the whole file into my envelope, if it is not there yet, with a progress window.
+ * Returns null if the user cancels, now or before, or if the envelope is being built already.
+ */
 
 void LongSound_playPart (LongSound me, double tmin, double tmax,
 	Sound_PlayCallback callback, Thing boss);
@@ -24,6 +24,8 @@
 #include "Pitch_to_PointProcess.h"
 #include "PointProcess_and_Sound.h"
 #include "Sound_and_LPC.h"
+#include "MelderThread.h"
+#include <map>
 
 #define MAX_T  0.02000000001   /* Maximum interval between two voice pulses (otherwise voiceless). */
 
@@ -195,50 +197,132 @@ void Manipulation_play (Manipulation me, int method) {
 	}
 }
 
+/*
+	Overlap-add synthesis goes in two steps.
+	First the copies of windowed stretches of the source into the target are listed, in an OverlapAdd,
+	with the random choices and the tier interpolations in the original order, and with the target samples already clipped;
+	then the copies are carried out, with the raised-cosine windows taken from tables (one per window length)
+	instead of a cosine per sample, and without a bounds check per sample.
+	Several Manipulations are synthesized in threads, one OverlapAdd per Manipulation
+	(Debug option 72 computes the window per sample, one Manipulation at a time).
+*/
+#define OverlapAdd_RISE  1
+#define OverlapAdd_FALL  2
+#define OverlapAdd_FLAT  3
+
+struct OverlapAdd_Copy {
+	int shape;   // OverlapAdd_RISE, OverlapAdd_FALL or OverlapAdd_FLAT
+	integer imin, imax;   // the source samples under the window
+	integer ifirst, ilast;   // the source samples that land inside the target
+	integer distance;   // from a source sample to its target sample
+	const double *window;   // window [1..imax-imin+1] = 1 -/+ cos, from OverlapAdd_Windows
+};
+
+Thing_define (OverlapAdd, Thing) { public:
+	Sound source;
+	autoSound target;
+	std::vector <OverlapAdd_Copy> copies;
+};
+
+Thing_implement (OverlapAdd, Thing, 0);
+
+static autoOverlapAdd OverlapAdd_create (Sound source, autoSound target) {
+	autoOverlapAdd me = Thing_new (OverlapAdd);
+	my source = source;
+	my target = target.move();
+	return me;
+}
+
+Thing_define (OverlapAdd_Windows, Thing) { public:
+	std::map <integer, autoVEC> rises, falls;   // by window length
+};
+
+Thing_implement (OverlapAdd_Windows, Thing, 0);
+
+/*
+	Points the copies of an OverlapAdd to their windows, computing the tables that are not there yet
+	(in the main thread, so that the threads only read them).
+*/
+static void OverlapAdd_Windows_attach (OverlapAdd_Windows me, OverlapAdd overlapAdd) {
+	for (OverlapAdd_Copy& copy : overlapAdd -> copies) {
+		if (copy.shape == OverlapAdd_FLAT)
+			continue;
+		const integer n = copy.imax - copy.imin + 1;
+		std::map <integer, autoVEC>& tables = ( copy.shape == OverlapAdd_RISE ? my rises : my falls );
+		auto found = tables.find (n);
+		if (found == tables.end ()) {
+			autoVEC window = VECraw (n);
+			const double dphase = NUMpi / n;
+			for (integer k = 1; k <= n; k ++)
+				window [k] = ( copy.shape == OverlapAdd_RISE ? 1.0 - cos (dphase * (k - 1 + 0.5)) : 1.0 + cos (dphase * (k - 1 + 0.5)) );
+			found = tables.emplace (n, window.move()).first;
+		}
+		copy.window = found -> second.at;
+	}
+}
+
+static void OverlapAdd_run (OverlapAdd me, bool windowPerSample) {
+	const double *source = & my source -> z [1] [0];
+	double *target = & my target -> z [1] [0];
+	for (const OverlapAdd_Copy& copy : my copies) {
+		const integer distance = copy.distance;
+		if (copy.shape == OverlapAdd_FLAT) {
+			NUMvector_copyElements (source + copy.imin, target + copy.imin + distance, 0, copy.imax - copy.imin);
+		} else if (windowPerSample) {
+			const double dphase = NUMpi / (copy.imax - copy.imin + 1);
+			const double sign = ( copy.shape == OverlapAdd_RISE ? -1.0 : 1.0 );
+			for (integer i = copy.ifirst; i <= copy.ilast; i ++)
+				target [i + distance] += source [i] * 0.5 * (1.0 + sign * cos (dphase * (i - copy.imin + 0.5)));
+		} else {
+			const double *window = copy.window - copy.imin + 1;   // window [i] belongs to source sample i
+			for (integer i = copy.ifirst; i <= copy.ilast; i ++)
+				target [i + distance] += source [i] * 0.5 * window [i];
+		}
+	}
+}
+
 static integer PointProcess_getFirstVoicedPoint (PointProcess me, double maxT) {
 	for (integer i = 1; i < my nt; i ++) if (my t [i + 1] - my t [i] <= maxT) return i;
 	return 0;
 }
 
-static void copyRise (Sound me, double tmin, double tmax, Sound thee, double tmaxTarget) {
+static void copyWindowed (integer imin, integer imax, OverlapAdd thee, integer distance, int shape) {
+	integer ifirst = imin, ilast = imax;
+	if (ifirst + distance < 1) ifirst = 1 - distance;
+	if (ilast + distance > thy target -> nx) ilast = thy target -> nx - distance;
+	if (ilast < ifirst) return;
+	thy copies. push_back ({ shape, imin, imax, ifirst, ilast, distance, nullptr });
+}
+
+static void copyRise (Sound me, double tmin, double tmax, OverlapAdd thee, double tmaxTarget) {
 	integer imin = Sampled_xToHighIndex (me, tmin);
 	if (imin < 1) imin = 1;
 	integer imax = Sampled_xToHighIndex (me, tmax) - 1;   // not xToLowIndex: ensure separation of subsequent calls
 	if (imax > my nx) imax = my nx;
 	if (imax < imin) return;
-	integer imaxTarget = Sampled_xToHighIndex (thee, tmaxTarget) - 1;
+	integer imaxTarget = Sampled_xToHighIndex (thy target.get(), tmaxTarget) - 1;
 	integer distance = imaxTarget - imax;
-	double dphase = NUMpi / (imax - imin + 1);
-	for (integer i = imin; i <= imax; i ++) {
-		integer iTarget = i + distance;
-		if (iTarget >= 1 && iTarget <= thy nx)
-			thy z [1] [iTarget] += my z [1] [i] * 0.5 * (1.0 - cos (dphase * (i - imin + 0.5)));
-	}
+	copyWindowed (imin, imax, thee, distance, OverlapAdd_RISE);
 }
 
-static void copyFall (Sound me, double tmin, double tmax, Sound thee, double tminTarget) {
+static void copyFall (Sound me, double tmin, double tmax, OverlapAdd thee, double tminTarget) {
 	integer imin = Sampled_xToHighIndex (me, tmin);
 	if (imin < 1) imin = 1;
 	integer imax = Sampled_xToHighIndex (me, tmax) - 1;   // not xToLowIndex: ensure separation of subsequent calls
 	if (imax > my nx) imax = my nx;
 	if (imax < imin) return;
-	integer iminTarget = Sampled_xToHighIndex (thee, tminTarget);
+	integer iminTarget = Sampled_xToHighIndex (thy target.get(), tminTarget);
 	integer distance = iminTarget - imin;
-	double dphase = NUMpi / (imax - imin + 1);
-	for (integer i = imin; i <= imax; i ++) {
-		integer iTarget = i + distance;
-		if (iTarget >= 1 && iTarget <= thy nx)
-			thy z [1] [iTarget] += my z [1] [i] * 0.5 * (1.0 + cos (dphase * (i - imin + 0.5)));
-	}
+	copyWindowed (imin, imax, thee, distance, OverlapAdd_FALL);
 }
 
-static void copyBell (Sound me, double tmid, double leftWidth, double rightWidth, Sound thee, double tmidTarget) {
+static void copyBell (Sound me, double tmid, double leftWidth, double rightWidth, OverlapAdd thee, double tmidTarget) {
 	copyRise (me, tmid - leftWidth, tmid, thee, tmidTarget);
 	copyFall (me, tmid, tmid + rightWidth, thee, tmidTarget);
 }
 
 static void copyBell2 (Sound me, PointProcess source, integer isource, double leftWidth, double rightWidth,
-	Sound thee, double tmidTarget, double maxT)
+	OverlapAdd thee, double tmidTarget, double maxT)
 {
 	/*
 	 * Replace 'leftWidth' and 'rightWidth' by the lengths of the intervals in the source (instead of target),
@@ -256,186 +340,122 @@ static void copyBell2 (Sound me, PointProcess source, integer isource, double le
 	copyBell (me, tmid, leftWidth, rightWidth, thee, tmidTarget);
 }
 
-static void copyFlat (Sound me, double tmin, double tmax, Sound thee, double tminTarget) {
+static void copyFlat (Sound me, double tmin, double tmax, OverlapAdd thee, double tminTarget) {
 	integer imin = Sampled_xToHighIndex (me, tmin);
 	if (imin < 1) imin = 1;
 	integer imax = Sampled_xToHighIndex (me, tmax) - 1;   // not xToLowIndex: ensure separation of subsequent calls
 	if (imax > my nx) imax = my nx;
 	if (imax < imin) return;
-	integer iminTarget = Sampled_xToHighIndex (thee, tminTarget);
+	integer iminTarget = Sampled_xToHighIndex (thy target.get(), tminTarget);
 	if (iminTarget < 1) iminTarget = 1;
 	trace (tmin, U" ", tmax, U" ", tminTarget, U" ", imin, U" ", imax, U" ", iminTarget);
-	Melder_assert (iminTarget + imax - imin <= thy nx);
-	NUMvector_copyElements (& my z [1] [0] + imin, & thy z [1] [0] + iminTarget, 0, imax - imin);
+	Melder_assert (iminTarget + imax - imin <= thy target -> nx);
+	thy copies. push_back ({ OverlapAdd_FLAT, imin, imax, imin, imax, iminTarget - imin, nullptr });
 }
 
-autoSound Sound_Point_Point_to_Sound (Sound me, PointProcess source, PointProcess target, double maxT) {
-	try {
-		autoSound thee = Sound_create (1, my xmin, my xmax, my nx, my dx, my x1);
-		if (source -> nt < 2 || target -> nt < 2) {   // almost completely voiceless?
-			NUMvector_copyElements (& my z [1] [0], & thy z [1] [0], 1, my nx);
-			return thee;
-		}
-		for (integer i = 1; i <= target -> nt; i ++) {
-			double tmid = target -> t [i];
-			double tleft = i > 1 ? target -> t [i - 1] : my xmin;
-			double tright = i < target -> nt ? target -> t [i + 1] : my xmax;
-			double leftWidth = tmid - tleft, rightWidth = tright - tmid;
-			int leftVoiced = i > 1 && leftWidth <= maxT;
-			int rightVoiced = i < target -> nt && rightWidth <= maxT;
-			integer isource = PointProcess_getNearestIndex (source, tmid);
-			if (! leftVoiced) leftWidth = rightWidth;   // symmetric bell
-			if (! rightVoiced) rightWidth = leftWidth;   // symmetric bell
-			if (leftVoiced || rightVoiced) {
-				copyBell2 (me, source, isource, leftWidth, rightWidth, thee.get(), tmid, maxT);
-				if (! leftVoiced) {
-					double startOfFlat = ( i == 1 ? tleft : (tleft + tmid) / 2.0 );
-					double endOfFlat = tmid - leftWidth;
-					copyFlat (me, startOfFlat, endOfFlat, thee.get(), startOfFlat);
-					copyFall (me, endOfFlat, tmid, thee.get(), endOfFlat);
-				} else if (! rightVoiced) {
-					double startOfFlat = tmid + rightWidth;
-					double endOfFlat = ( i == target -> nt ? tright : (tmid + tright) / 2.0 );
-					copyRise (me, tmid, startOfFlat, thee.get(), startOfFlat);
-					copyFlat (me, startOfFlat, endOfFlat, thee.get(), startOfFlat);
-				}
-			} else {
+static autoOverlapAdd Sound_Point_Point_to_OverlapAdd (Sound me, PointProcess source, PointProcess target, double maxT) {
+	autoOverlapAdd thee = OverlapAdd_create (me, Sound_create (1, my xmin, my xmax, my nx, my dx, my x1));
+	if (source -> nt < 2 || target -> nt < 2) {   // almost completely voiceless?
+		thy copies. push_back ({ OverlapAdd_FLAT, 1, my nx, 1, my nx, 0, nullptr });
+		return thee;
+	}
+	for (integer i = 1; i <= target -> nt; i ++) {
+		double tmid = target -> t [i];
+		double tleft = i > 1 ? target -> t [i - 1] : my xmin;
+		double tright = i < target -> nt ? target -> t [i + 1] : my xmax;
+		double leftWidth = tmid - tleft, rightWidth = tright - tmid;
+		int leftVoiced = i > 1 && leftWidth <= maxT;
+		int rightVoiced = i < target -> nt && rightWidth <= maxT;
+		integer isource = PointProcess_getNearestIndex (source, tmid);
+		if (! leftVoiced) leftWidth = rightWidth;   // symmetric bell
+		if (! rightVoiced) rightWidth = leftWidth;   // symmetric bell
+		if (leftVoiced || rightVoiced) {
+			copyBell2 (me, source, isource, leftWidth, rightWidth, thee.get(), tmid, maxT);
+			if (! leftVoiced) {
 				double startOfFlat = ( i == 1 ? tleft : (tleft + tmid) / 2.0 );
+				double endOfFlat = tmid - leftWidth;
+				copyFlat (me, startOfFlat, endOfFlat, thee.get(), startOfFlat);
+				copyFall (me, endOfFlat, tmid, thee.get(), endOfFlat);
+			} else if (! rightVoiced) {
+				double startOfFlat = tmid + rightWidth;
 				double endOfFlat = ( i == target -> nt ? tright : (tmid + tright) / 2.0 );
+				copyRise (me, tmid, startOfFlat, thee.get(), startOfFlat);
 				copyFlat (me, startOfFlat, endOfFlat, thee.get(), startOfFlat);
 			}
+		} else {
+			double startOfFlat = ( i == 1 ? tleft : (tleft + tmid) / 2.0 );
+			double endOfFlat = ( i == target -> nt ? tright : (tmid + tright) / 2.0 );
+			copyFlat (me, startOfFlat, endOfFlat, thee.get(), startOfFlat);
 		}
-		return thee;
+	}
+	return thee;
+}
+
+static autoSound OverlapAdd_to_Sound (OverlapAdd me) {
+	autoOverlapAdd_Windows windows = Thing_new (OverlapAdd_Windows);
+	if (Melder_debug != 72)
+		OverlapAdd_Windows_attach (windows.get(), me);
+	OverlapAdd_run (me, Melder_debug == 72);
+	return my target.move();
+}
+
+autoSound Sound_Point_Point_to_Sound (Sound me, PointProcess source, PointProcess target, double maxT) {
+	try {
+		autoOverlapAdd overlapAdd = Sound_Point_Point_to_OverlapAdd (me, source, target, maxT);
+		return OverlapAdd_to_Sound (overlapAdd.get());
 	} catch (MelderError) {
 		Melder_throw (me, U": not manipulated.");
 	}
 }
 
-autoSound Sound_Point_Pitch_Duration_to_Sound (Sound me, PointProcess pulses,
+static autoOverlapAdd Sound_Point_Pitch_Duration_to_OverlapAdd (Sound me, PointProcess pulses,
 	PitchTier pitch, DurationTier duration, double maxT)
 {
-	try {
-		integer ipointleft, ipointright;
-		double deltat = 0, handledTime = my xmin;
-		double startOfSourceNoise, endOfSourceNoise, startOfTargetNoise, endOfTargetNoise;
-		double durationOfSourceNoise, durationOfTargetNoise;
-		double startOfSourceVoice, endOfSourceVoice, startOfTargetVoice, endOfTargetVoice;
-		double durationOfSourceVoice, durationOfTargetVoice;
-		double startingPeriod, finishingPeriod, ttarget, voicelessPeriod;
-		if (duration -> points.size == 0)
-			Melder_throw (U"No duration points.");
-
-		/*
-		 * Create a Sound long enough to hold the longest possible duration-manipulated sound.
-		 */
-		autoSound thee = Sound_create (1, my xmin, my xmin + 3 * (my xmax - my xmin), 3 * my nx, my dx, my x1);
+	integer ipointleft, ipointright;
+	double deltat = 0, handledTime = my xmin;
+	double startOfSourceNoise, endOfSourceNoise, startOfTargetNoise, endOfTargetNoise;
+	double durationOfSourceNoise, durationOfTargetNoise;
+	double startOfSourceVoice, endOfSourceVoice, startOfTargetVoice, endOfTargetVoice;
+	double durationOfSourceVoice, durationOfTargetVoice;
+	double startingPeriod, finishingPeriod, ttarget, voicelessPeriod;
+	if (duration -> points.size == 0)
+		Melder_throw (U"No duration points.");
 
+	/*
+	 * Create a Sound long enough to hold the longest possible duration-manipulated sound.
+	 */
+	autoOverlapAdd thee = OverlapAdd_create (me, Sound_create (1, my xmin, my xmin + 3 * (my xmax - my xmin), 3 * my nx, my dx, my x1));
+	/*
+	 * Below, I'll abbreviate the voiced interval as "voice" and the voiceless interval as "noise".
+	 */
+	if (pitch && pitch -> points.size) for (ipointleft = 1; ipointleft <= pulses -> nt; ipointleft = ipointright + 1) {
 		/*
-		 * Below, I'll abbreviate the voiced interval as "voice" and the voiceless interval as "noise".
+		 * Find the beginning of the voice.
 		 */
-		if (pitch && pitch -> points.size) for (ipointleft = 1; ipointleft <= pulses -> nt; ipointleft = ipointright + 1) {
-			/*
-			 * Find the beginning of the voice.
-			 */
-			startOfSourceVoice = pulses -> t [ipointleft];   // the first pulse of the voice
-			startingPeriod = 1.0 / RealTier_getValueAtTime (pitch, startOfSourceVoice);
-			startOfSourceVoice -= 0.5 * startingPeriod;   // the first pulse is in the middle of a period
-
-			/*
-			 * Measure one noise.
-			 */
-			startOfSourceNoise = handledTime;
-			endOfSourceNoise = startOfSourceVoice;
-			durationOfSourceNoise = endOfSourceNoise - startOfSourceNoise;
-			startOfTargetNoise = startOfSourceNoise + deltat;
-			endOfTargetNoise = startOfTargetNoise + RealTier_getArea (duration, startOfSourceNoise, endOfSourceNoise);
-			durationOfTargetNoise = endOfTargetNoise - startOfTargetNoise;
-
-			/*
-			 * Copy the noise.
-			 */
-			voicelessPeriod = NUMrandomUniform (0.008, 0.012);
-			ttarget = startOfTargetNoise + 0.5 * voicelessPeriod;
-			while (ttarget < endOfTargetNoise) {
-				double tsource;
-				double tleft = startOfSourceNoise, tright = endOfSourceNoise;
-				int i;
-				for (i = 1; i <= 15; i ++) {
-					double tsourcemid = 0.5 * (tleft + tright);
-					double ttargetmid = startOfTargetNoise + RealTier_getArea (duration,
-						startOfSourceNoise, tsourcemid);
-					if (ttargetmid < ttarget) tleft = tsourcemid; else tright = tsourcemid;
-				}
-				tsource = 0.5 * (tleft + tright);
-				copyBell (me, tsource, voicelessPeriod, voicelessPeriod, thee.get(), ttarget);
-				voicelessPeriod = NUMrandomUniform (0.008, 0.012);
-				ttarget += voicelessPeriod;
-			}
-			deltat += durationOfTargetNoise - durationOfSourceNoise;
-
-			/*
-			 * Find the end of the voice.
-			 */
-			for (ipointright = ipointleft + 1; ipointright <= pulses -> nt; ipointright ++)
-				if (pulses -> t [ipointright] - pulses -> t [ipointright - 1] > maxT)
-					break;
-			ipointright --;
-			endOfSourceVoice = pulses -> t [ipointright];   // the last pulse of the voice
-			finishingPeriod = 1.0 / RealTier_getValueAtTime (pitch, endOfSourceVoice);
-			endOfSourceVoice += 0.5 * finishingPeriod;   // the last pulse is in the middle of a period
-			/*
-			 * Measure one voice.
-			 */
-			durationOfSourceVoice = endOfSourceVoice - startOfSourceVoice;
-
-			/*
-			 * This will be copied to an interval with a different location and duration.
-			 */
-			startOfTargetVoice = startOfSourceVoice + deltat;
-			endOfTargetVoice = startOfTargetVoice +
-				RealTier_getArea (duration, startOfSourceVoice, endOfSourceVoice);
-			durationOfTargetVoice = endOfTargetVoice - startOfTargetVoice;
-
-			/*
-			 * Copy the voiced part.
-			 */
-			ttarget = startOfTargetVoice + 0.5 * startingPeriod;
-			while (ttarget < endOfTargetVoice) {
-				double tsource, period;
-				integer isourcepulse;
-				double tleft = startOfSourceVoice, tright = endOfSourceVoice;
-				int i;
-				for (i = 1; i <= 15; i ++) {
-					double tsourcemid = 0.5 * (tleft + tright);
-					double ttargetmid = startOfTargetVoice + RealTier_getArea (duration,
-						startOfSourceVoice, tsourcemid);
-					if (ttargetmid < ttarget) tleft = tsourcemid; else tright = tsourcemid;
-				}
-				tsource = 0.5 * (tleft + tright);
-				period = 1.0 / RealTier_getValueAtTime (pitch, tsource);
-				isourcepulse = PointProcess_getNearestIndex (pulses, tsource);
-				copyBell2 (me, pulses, isourcepulse, period, period, thee.get(), ttarget, maxT);
-				ttarget += period;
-			}
-			deltat += durationOfTargetVoice - durationOfSourceVoice;
-			handledTime = endOfSourceVoice;
-		}
+		startOfSourceVoice = pulses -> t [ipointleft];   // the first pulse of the voice
+		startingPeriod = 1.0 / RealTier_getValueAtTime (pitch, startOfSourceVoice);
+		startOfSourceVoice -= 0.5 * startingPeriod;   // the first pulse is in the middle of a period
 
 		/*
-		 * Copy the remaining unvoiced part, if we are at the end.
+		 * Measure one noise.
 		 */
 		startOfSourceNoise = handledTime;
-		endOfSourceNoise = my xmax;
+		endOfSourceNoise = startOfSourceVoice;
 		durationOfSourceNoise = endOfSourceNoise - startOfSourceNoise;
 		startOfTargetNoise = startOfSourceNoise + deltat;
 		endOfTargetNoise = startOfTargetNoise + RealTier_getArea (duration, startOfSourceNoise, endOfSourceNoise);
 		durationOfTargetNoise = endOfTargetNoise - startOfTargetNoise;
+
+		/*
+		 * Copy the noise.
+		 */
 		voicelessPeriod = NUMrandomUniform (0.008, 0.012);
 		ttarget = startOfTargetNoise + 0.5 * voicelessPeriod;
 		while (ttarget < endOfTargetNoise) {
 			double tsource;
 			double tleft = startOfSourceNoise, tright = endOfSourceNoise;
-			for (int i = 1; i <= 15; i ++) {
+			int i;
+			for (i = 1; i <= 15; i ++) {
 				double tsourcemid = 0.5 * (tleft + tright);
 				double ttargetmid = startOfTargetNoise + RealTier_getArea (duration,
 					startOfSourceNoise, tsourcemid);
@@ -446,43 +466,185 @@ autoSound Sound_Point_Pitch_Duration_to_Sound (Sound me, PointProcess pulses,
 			voicelessPeriod = NUMrandomUniform (0.008, 0.012);
 			ttarget += voicelessPeriod;
 		}
+		deltat += durationOfTargetNoise - durationOfSourceNoise;
 
 		/*
-		 * Find the number of trailing zeroes and hack the sound's time domain.
+		 * Find the end of the voice.
 		 */
-		thy xmax = thy xmin + RealTier_getArea (duration, my xmin, my xmax);
-		if (fabs (thy xmax - my xmax) < 1e-12) thy xmax = my xmax;   // common situation
-		thy nx = Sampled_xToLowIndex (thee.get(), thy xmax);
-		if (thy nx > 3 * my nx) thy nx = 3 * my nx;
+		for (ipointright = ipointleft + 1; ipointright <= pulses -> nt; ipointright ++)
+			if (pulses -> t [ipointright] - pulses -> t [ipointright - 1] > maxT)
+				break;
+		ipointright --;
+		endOfSourceVoice = pulses -> t [ipointright];   // the last pulse of the voice
+		finishingPeriod = 1.0 / RealTier_getValueAtTime (pitch, endOfSourceVoice);
+		endOfSourceVoice += 0.5 * finishingPeriod;   // the last pulse is in the middle of a period
+		/*
+		 * Measure one voice.
+		 */
+		durationOfSourceVoice = endOfSourceVoice - startOfSourceVoice;
 
-		return thee;
+		/*
+		 * This will be copied to an interval with a different location and duration.
+		 */
+		startOfTargetVoice = startOfSourceVoice + deltat;
+		endOfTargetVoice = startOfTargetVoice +
+			RealTier_getArea (duration, startOfSourceVoice, endOfSourceVoice);
+		durationOfTargetVoice = endOfTargetVoice - startOfTargetVoice;
+
+		/*
+		 * Copy the voiced part.
+		 */
+		ttarget = startOfTargetVoice + 0.5 * startingPeriod;
+		while (ttarget < endOfTargetVoice) {
+			double tsource, period;
+			integer isourcepulse;
+			double tleft = startOfSourceVoice, tright = endOfSourceVoice;
+			int i;
+			for (i = 1; i <= 15; i ++) {
+				double tsourcemid = 0.5 * (tleft + tright);
+				double ttargetmid = startOfTargetVoice + RealTier_getArea (duration,
+					startOfSourceVoice, tsourcemid);
+				if (ttargetmid < ttarget) tleft = tsourcemid; else tright = tsourcemid;
+			}
+			tsource = 0.5 * (tleft + tright);
+			period = 1.0 / RealTier_getValueAtTime (pitch, tsource);
+			isourcepulse = PointProcess_getNearestIndex (pulses, tsource);
+			copyBell2 (me, pulses, isourcepulse, period, period, thee.get(), ttarget, maxT);
+			ttarget += period;
+		}
+		deltat += durationOfTargetVoice - durationOfSourceVoice;
+		handledTime = endOfSourceVoice;
+	}
+
+	/*
+	 * Copy the remaining unvoiced part, if we are at the end.
+	 */
+	startOfSourceNoise = handledTime;
+	endOfSourceNoise = my xmax;
+	durationOfSourceNoise = endOfSourceNoise - startOfSourceNoise;
+	startOfTargetNoise = startOfSourceNoise + deltat;
+	endOfTargetNoise = startOfTargetNoise + RealTier_getArea (duration, startOfSourceNoise, endOfSourceNoise);
+	durationOfTargetNoise = endOfTargetNoise - startOfTargetNoise;
+	voicelessPeriod = NUMrandomUniform (0.008, 0.012);
+	ttarget = startOfTargetNoise + 0.5 * voicelessPeriod;
+	while (ttarget < endOfTargetNoise) {
+		double tsource;
+		double tleft = startOfSourceNoise, tright = endOfSourceNoise;
+		for (int i = 1; i <= 15; i ++) {
+			double tsourcemid = 0.5 * (tleft + tright);
+			double ttargetmid = startOfTargetNoise + RealTier_getArea (duration,
+				startOfSourceNoise, tsourcemid);
+			if (ttargetmid < ttarget) tleft = tsourcemid; else tright = tsourcemid;
+		}
+		tsource = 0.5 * (tleft + tright);
+		copyBell (me, tsource, voicelessPeriod, voicelessPeriod, thee.get(), ttarget);
+		voicelessPeriod = NUMrandomUniform (0.008, 0.012);
+		ttarget += voicelessPeriod;
+	}
+
+	/*
+	 * Find the number of trailing zeroes and hack the sound's time domain.
+	 */
+	Sound target = thy target.get();
+	target -> xmax = target -> xmin + RealTier_getArea (duration, my xmin, my xmax);
+	if (fabs (target -> xmax - my xmax) < 1e-12) target -> xmax = my xmax;   // common situation
+	target -> nx = Sampled_xToLowIndex (target, target -> xmax);
+	if (target -> nx > 3 * my nx) target -> nx = 3 * my nx;
+
+	return thee;
+}
+
+autoSound Sound_Point_Pitch_Duration_to_Sound (Sound me, PointProcess pulses,
+	PitchTier pitch, DurationTier duration, double maxT)
+{
+	try {
+		autoOverlapAdd overlapAdd = Sound_Point_Pitch_Duration_to_OverlapAdd (me, pulses, pitch, duration, maxT);
+		return OverlapAdd_to_Sound (overlapAdd.get());
 	} catch (MelderError) {
 		Melder_throw (me, U": not manipulated.");
 	}
 }
 
-static autoSound synthesize_overlapAdd_nodur (Manipulation me) {
+static autoOverlapAdd Manipulation_to_OverlapAdd (Manipulation me) {
+	if (! my duration || my duration -> points.size == 0) {
+		try {
+			if (! my sound)  Melder_throw (U"Missing original sound.");
+			if (! my pulses) Melder_throw (U"Missing pulses analysis.");
+			if (! my pitch)  Melder_throw (U"Missing pitch manipulation.");
+			autoPointProcess targetPulses = PitchTier_Point_to_PointProcess (my pitch.get(), my pulses.get(), MAX_T);
+			return Sound_Point_Point_to_OverlapAdd (my sound.get(), my pulses.get(), targetPulses.get(), MAX_T);
+		} catch (MelderError) {
+			Melder_throw (me, U": overlap-add synthesis (without duration) not performed.");
+		}
+	}
 	try {
 		if (! my sound)  Melder_throw (U"Missing original sound.");
 		if (! my pulses) Melder_throw (U"Missing pulses analysis.");
 		if (! my pitch)  Melder_throw (U"Missing pitch manipulation.");
-		autoPointProcess targetPulses = PitchTier_Point_to_PointProcess (my pitch.get(), my pulses.get(), MAX_T);
-		return Sound_Point_Point_to_Sound (my sound.get(), my pulses.get(), targetPulses.get(), MAX_T);
+		return Sound_Point_Pitch_Duration_to_OverlapAdd (my sound.get(), my pulses.get(), my pitch.get(), my duration.get(), MAX_T);
 	} catch (MelderError) {
-		Melder_throw (me, U": overlap-add synthesis (without duration) not performed.");
+		Melder_throw (me, U": overlap-add synthesis not performed.");
 	}
 }
 
-static autoSound synthesize_overlapAdd (Manipulation me) {
-	if (! my duration || my duration -> points.size == 0) return synthesize_overlapAdd_nodur (me);
+static autoSound synthesize_overlapAdd_nodur (Manipulation me) {
 	try {
 		if (! my sound)  Melder_throw (U"Missing original sound.");
 		if (! my pulses) Melder_throw (U"Missing pulses analysis.");
 		if (! my pitch)  Melder_throw (U"Missing pitch manipulation.");
-		return Sound_Point_Pitch_Duration_to_Sound (my sound.get(), my pulses.get(), my pitch.get(), my duration.get(), MAX_T);
+		autoPointProcess targetPulses = PitchTier_Point_to_PointProcess (my pitch.get(), my pulses.get(), MAX_T);
+		return Sound_Point_Point_to_Sound (my sound.get(), my pulses.get(), targetPulses.get(), MAX_T);
 	} catch (MelderError) {
-		Melder_throw (me, U": overlap-add synthesis not performed.");
+		Melder_throw (me, U": overlap-add synthesis (without duration) not performed.");
+	}
+}
+
+static autoSound synthesize_overlapAdd (Manipulation me) {
+	autoOverlapAdd overlapAdd = Manipulation_to_OverlapAdd (me);
+	return OverlapAdd_to_Sound (overlapAdd.get());
+}
+
+Thing_define (OverlapAdd_Args, Thing) { public:
+	std::vector <autoOverlapAdd> *overlapAdds;
+	integer first, step;
+};
+
+Thing_implement (OverlapAdd_Args, Thing, 0);
+
+static MelderThread_RETURN_TYPE OverlapAdd_runAll (OverlapAdd_Args me) {
+	for (integer i = my first; i <= (integer) my overlapAdds -> size (); i += my step)
+		OverlapAdd_run ((* my overlapAdds) [(size_t) i - 1].get(), false);
+	MelderThread_RETURN;
+}
+
+std::vector <autoSound> Manipulations_to_Sounds_overlapAdd (OrderedOf<structManipulation>* me) {
+	const integer numberOfManipulations = my size;
+	std::vector <autoOverlapAdd> overlapAdds ((size_t) numberOfManipulations);
+	autoOverlapAdd_Windows windows = Thing_new (OverlapAdd_Windows);
+	for (integer i = 1; i <= numberOfManipulations; i ++) {
+		overlapAdds [(size_t) i - 1] = Manipulation_to_OverlapAdd (my at [i]);
+		if (Melder_debug != 72)
+			OverlapAdd_Windows_attach (windows.get(), overlapAdds [(size_t) i - 1].get());
+	}
+	if (Melder_debug == 72) {
+		for (integer i = 1; i <= numberOfManipulations; i ++)
+			OverlapAdd_run (overlapAdds [(size_t) i - 1].get(), true);
+	} else {
+		const integer numberOfThreads = std::max (integer (1), std::min (numberOfManipulations, integer (MelderThread_getNumberOfProcessors ())));
+		std::vector <autoOverlapAdd_Args> args ((size_t) numberOfThreads);
+		for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+			autoOverlapAdd_Args arg = Thing_new (OverlapAdd_Args);
+			arg -> overlapAdds = & overlapAdds;
+			arg -> first = ithread;
+			arg -> step = numberOfThreads;
+			args [(size_t) ithread - 1] = arg.move();
+		}
+		MelderThread_run (OverlapAdd_runAll, args.data(), (int) numberOfThreads);
 	}
+	std::vector <autoSound> sounds ((size_t) numberOfManipulations);
+	for (integer i = 1; i <= numberOfManipulations; i ++)
+		sounds [(size_t) i - 1] = overlapAdds [(size_t) i - 1] -> target.move();
+	return sounds;
 }
 
 static autoSound synthesize_pulses (Manipulation me) {
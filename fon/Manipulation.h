@@ -69,6 +69,11 @@ autoSound Sound_Point_Point_to_Sound (Sound me, PointProcess source, PointProces
 /*void Sound_Formant_Intensity_filter (Sound me, FormantTier formant, IntensityTier intensity);*/
 
 autoSound Manipulation_to_Sound (Manipulation me, int method);
+std::vector <autoSound> Manipulations_to_Sounds_overlapAdd (OrderedOf<structManipulation>* me);
+/*
+	The overlap-add resyntheses of all the Manipulations, in threads:
+	the same Sounds as Manipulation_to_Sound (..., Manipulation_OVERLAPADD) for one Manipulation after the other.
+*/
 void Manipulation_playPart (Manipulation me, double tmin, double tmax, int method);
 void Manipulation_play (Manipulation me, int method);
 void Manipulation_writeToTextFileWithoutSound (Manipulation me, MelderFile file);
@@ -639,6 +639,80 @@ int Praat_tests (kPraatTests itest, conststring32 arg1, conststring32 arg2, cons
 		case kPraatTests::FILEINMEMORYMANAGER_IO: {
 			test_FileInMemoryManager_io ();
 		} break;
+		case kPraatTests::TIME_FFT: {
+			integer size = Melder_atoi (arg2);
+			autoVEC x = VECrandomGauss (size, 0.0, 1.0);
+			autoNUMfft_Table table;
+			NUMfft_Table_init (& table, size);
+			double z = 0.0;
+			for (int64 i = 1; i <= n; i ++) {
+				NUMfft_forward (& table, x.get());
+				NUMfft_backward (& table, x.get());
+				VECmultiply_inplace (x.get(), 1.0 / size);
+				z += x [1];
+			}
+			t = Melder_stopwatch () / size;   // forward plus backward, per sample
+			MelderInfo_writeLine (z);
+		} break;
+		case kPraatTests::CHECK_RANDOM_PHILOX: {
+			/*
+				The known-answer tests of Random123 (kat_vectors, philox4x32_10).
+			*/
+			struct { uint64 seed, stream, counter, word0, word1; } known [] = {
+				{ 0, 0, 0, UINT64_C (0xe169c58d6627e8d5), UINT64_C (0x9b00dbd8bc57ac4c) },
+				{ UINT64_C (0xffffffffffffffff), UINT64_C (0xffffffffffffffff), UINT64_C (0xffffffffffffffff),
+						UINT64_C (0x41c83b0e408f276d), UINT64_C (0x6d5451fda20bc7c6) },
+				{ UINT64_C (0x299f31d0a4093822), UINT64_C (0x0370734413198a2e), UINT64_C (0x85a308d3243f6a88),
+						UINT64_C (0x94fdccebd16cfe09), UINT64_C (0x24126ea15001e420) }
+			};
+			for (int iknown = 0; iknown < 3; iknown ++) {
+				uint64 words [2];
+				NUMrandomPhilox_words (known [iknown]. seed, known [iknown]. stream, known [iknown]. counter, 1, words);
+				Melder_require (words [0] == known [iknown]. word0 && words [1] == known [iknown]. word1,
+					U"Philox known-answer test ", iknown + 1, U" failed.");
+			}
+			/*
+				Blocks (of any size, starting anywhere) must give the same words as single counters,
+				and filling must give the same numbers as drawing them one by one.
+			*/
+			const integer size = Melder_atoi (arg2);
+			autoVEC fractions = VECraw (size), gausses = VECraw (size);
+			for (int64 iteration = 1; iteration <= n; iteration ++) {
+				const uint64 seed = NUMrandom_drawSeed (), stream = NUMrandom_drawSeed () >> (iteration % 64);
+				const uint64 firstCounter = NUMrandom_drawSeed () >> (iteration % 64);
+				const integer numberOfCounters = NUMrandomInteger (1, 50);
+				uint64 block [100], single [2];
+				NUMrandomPhilox_words (seed, stream, firstCounter, numberOfCounters, block);
+				for (integer icounter = 0; icounter < numberOfCounters; icounter ++) {
+					NUMrandomPhilox_words (seed, stream, firstCounter + (uint64) icounter, 1, single);
+					Melder_require (block [2 * icounter] == single [0] && block [2 * icounter + 1] == single [1],
+						U"Philox block differs from single counter.");
+				}
+				NUMrandomStream (seed, stream). fillFractions (fractions.get());
+				NUMrandomStream (seed, stream). fillGauss (gausses.get(), 0.0, 1.0);
+				NUMrandomStream fractionStream (seed, stream), gaussStream (seed, stream);
+				for (integer i = 1; i <= size; i ++) {
+					Melder_require (fractionStream. fraction () == fractions [i],
+						U"Filled fraction ", i, U" differs from drawn fraction.");
+					Melder_require (gaussStream. gauss (0.0, 1.0) == gausses [i],
+						U"Filled Gaussian number ", i, U" differs from drawn Gaussian number.");
+				}
+			}
+			t = Melder_stopwatch ();
+			MelderInfo_writeLine (U"OK");
+		} break;
+		case kPraatTests::TIME_RANDOM_GAUSS_FILL: {
+			const integer size = Melder_atoi (arg2);
+			autoVEC x = VECraw (size);
+			NUMrandomStream stream (NUMrandom_drawSeed (), 0);
+			double z = 0.0;
+			for (int64 iteration = 1; iteration <= n; iteration ++) {
+				stream. fillGauss (x.get(), 0.0, 1.0);
+				z += x [1];
+			}
+			t = Melder_stopwatch () / size;   // per number
+			MelderInfo_writeLine (z);
+		} break;
 	}
 	MelderInfo_writeLine (Melder_single (n / t * 1e-9), U" Gflops");
 	MelderInfo_close ();
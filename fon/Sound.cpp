@@ -23,6 +23,7 @@
  */
 
 #include "Sound.h"
+#include "SoundEnvelope.h"
 #include "Sound_extensions.h"
 #include "NUM2.h"
 
@@ -770,11 +771,34 @@ void Sound_draw (Sound me, Graphics g,
 	*/
 	integer ixmin, ixmax;
 	Matrix_getWindowSamplesX (me, tmin, tmax, & ixmin, & ixmax);
+	Graphics_setInner (g);
+	/*
+		A curve with several samples per column is drawn from a min/max envelope,
+		which is also where the automatic vertical range comes from.
+	*/
+	const bool methodIsCurve = ! str32str (method, U"bars") && ! str32str (method, U"Bars") &&
+		! str32str (method, U"poles") && ! str32str (method, U"Poles") &&
+		! str32str (method, U"speckles") && ! str32str (method, U"Speckles");
+	autoSoundEnvelope envelope;
+	if (methodIsCurve && ixmax > ixmin && SoundEnvelope_shouldDraw (g, ixmax - ixmin + 1))
+		envelope = SoundEnvelope_createFromSound (me, ixmin, ixmax);
 	/*
 		Automatic vertical range.
 	*/
 	if (minimum == maximum) {
-		Matrix_getWindowExtrema (me, ixmin, ixmax, 1, my ny, & minimum, & maximum);
+		if (envelope) {
+			for (integer channel = 1; channel <= my ny; channel ++) {
+				double channelMinimum, channelMaximum;
+				SoundEnvelope_getExtrema (envelope.get(), channel, 1, ixmax - ixmin + 1, my z.row (channel).part (ixmin, ixmax),
+					& channelMinimum, & channelMaximum);
+				if (channel == 1 || channelMinimum < minimum)
+					minimum = channelMinimum;
+				if (channel == 1 || channelMaximum > maximum)
+					maximum = channelMaximum;
+			}
+		} else {
+			Matrix_getWindowExtrema (me, ixmin, ixmax, 1, my ny, & minimum, & maximum);
+		}
 		if (minimum == maximum) {
 			minimum -= 1.0;
 			maximum += 1.0;
@@ -783,7 +807,6 @@ void Sound_draw (Sound me, Graphics g,
 	/*
 		Set coordinates for drawing.
 	*/
-	Graphics_setInner (g);
 	for (integer channel = 1; channel <= my ny; channel ++) {
 		Graphics_setWindow (g, timesAreReversed ? tmax : tmin, timesAreReversed ? tmin : tmax,
 			minimum - (my ny - channel) * (maximum - minimum),
@@ -813,8 +836,12 @@ void Sound_draw (Sound me, Graphics g,
 			/*
 			 * The default: draw as a curve.
 			 */
-			Graphics_function (g, & my z [channel] [0], ixmin, ixmax,
-					Matrix_columnToX (me, ixmin), Matrix_columnToX (me, ixmax));
+			if (envelope)
+				SoundEnvelope_drawChannel (envelope.get(), g, channel, 1, ixmax - ixmin + 1, my z.row (channel).part (ixmin, ixmax),
+						Matrix_columnToX (me, ixmin), Matrix_columnToX (me, ixmax));
+			else
+				Graphics_function (g, & my z [channel] [0], ixmin, ixmax,
+						Matrix_columnToX (me, ixmin), Matrix_columnToX (me, ixmax));
 		}
 	}
 	Graphics_setWindow (g, timesAreReversed ? tmax : tmin, timesAreReversed ? tmin : tmax, minimum, maximum);
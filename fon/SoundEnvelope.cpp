@@ -0,0 +1,187 @@
+/* SoundEnvelope.cpp
+ *
+ * Copyright (C) 2026 Praat developers
+ *
+ * This code is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this work. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SoundEnvelope.h"
+
+Thing_implement (SoundEnvelope, Thing, 0);
+
+/*
+	Drawing with an envelope pays off from this many samples per column on.
+*/
+#define SoundEnvelope_MINIMUM_SAMPLES_PER_COLUMN  4
+
+autoSoundEnvelope SoundEnvelope_create (integer numberOfChannels, integer numberOfSamples, integer blockSize) {
+	try {
+		Melder_assert (numberOfChannels >= 1 && numberOfSamples >= 1 && blockSize >= 2);
+		autoSoundEnvelope me = Thing_new (SoundEnvelope);
+		my numberOfChannels = numberOfChannels;
+		my numberOfSamples = numberOfSamples;
+		my blockSize = blockSize;
+		integer numberOfBlocks = (numberOfSamples - 1) / blockSize + 1;
+		for (;;) {
+			my minima. push_back (MATraw (numberOfChannels, numberOfBlocks));
+			my maxima. push_back (MATraw (numberOfChannels, numberOfBlocks));
+			my numberOfLevels += 1;
+			if (numberOfBlocks == 1)
+				break;
+			numberOfBlocks = (numberOfBlocks - 1) / SoundEnvelope_BRANCHING + 1;
+		}
+		return me;
+	} catch (MelderError) {
+		Melder_throw (U"SoundEnvelope not created.");
+	}
+}
+
+void SoundEnvelope_setSamples (SoundEnvelope me, integer channel, integer firstSample, constVEC samples) {
+	Melder_assert (channel >= 1 && channel <= my numberOfChannels);
+	Melder_assert ((firstSample - 1) % my blockSize == 0);
+	Melder_assert (firstSample - 1 + samples.size <= my numberOfSamples);
+	MAT minima = my minima [0].get(), maxima = my maxima [0].get();
+	integer block = (firstSample - 1) / my blockSize;
+	for (integer first = 1; first <= samples.size; first += my blockSize) {
+		const integer last = std::min (first + my blockSize - 1, samples.size);
+		double minimum = samples [first], maximum = minimum;
+		for (integer i = first + 1; i <= last; i ++) {
+			const double value = samples [i];
+			if (value < minimum)
+				minimum = value;
+			if (value > maximum)
+				maximum = value;
+		}
+		block += 1;
+		minima [channel] [block] = minimum;
+		maxima [channel] [block] = maximum;
+	}
+}
+
+void SoundEnvelope_finish (SoundEnvelope me) {
+	for (integer level = 2; level <= my numberOfLevels; level ++) {
+		constMAT minimaBelow = my minima [level - 2].get(), maximaBelow = my maxima [level - 2].get();
+		MAT minima = my minima [level - 1].get(), maxima = my maxima [level - 1].get();
+		for (integer channel = 1; channel <= my numberOfChannels; channel ++) {
+			for (integer block = 1; block <= minima.ncol; block ++) {
+				const integer first = (block - 1) * SoundEnvelope_BRANCHING + 1;
+				const integer last = std::min (first + SoundEnvelope_BRANCHING - 1, minimaBelow.ncol);
+				double minimum = minimaBelow [channel] [first], maximum = maximaBelow [channel] [first];
+				for (integer i = first + 1; i <= last; i ++) {
+					if (minimaBelow [channel] [i] < minimum)
+						minimum = minimaBelow [channel] [i];
+					if (maximaBelow [channel] [i] > maximum)
+						maximum = maximaBelow [channel] [i];
+				}
+				minima [channel] [block] = minimum;
+				maxima [channel] [block] = maximum;
+			}
+		}
+	}
+}
+
+autoSoundEnvelope SoundEnvelope_createFromSound (Sound sound, integer firstSample, integer lastSample) {
+	Melder_assert (firstSample >= 1 && lastSample <= sound -> nx);
+	autoSoundEnvelope me = SoundEnvelope_create (sound -> ny, lastSample - firstSample + 1, SoundEnvelope_BRANCHING);
+	for (integer channel = 1; channel <= sound -> ny; channel ++)
+		SoundEnvelope_setSamples (me.get(), channel, 1, sound -> z.row (channel).part (firstSample, lastSample));
+	SoundEnvelope_finish (me.get());
+	return me;
+}
+
+void SoundEnvelope_getExtrema (SoundEnvelope me, integer channel, integer firstSample, integer lastSample, constVEC samples,
+	double *out_minimum, double *out_maximum)
+{
+	Melder_assert (firstSample >= 1 && lastSample <= my numberOfSamples && firstSample <= lastSample);
+	Melder_assert (samples.size == 0 || samples.size == my numberOfSamples);
+	double minimum = undefined, maximum = undefined;
+	integer i = firstSample;
+	while (i <= lastSample) {
+		/*
+			Take the largest block that starts at sample i and ends within the stretch.
+		*/
+		integer level = 0, blockSize = 1;
+		for (;;) {
+			const integer nextBlockSize = ( level == 0 ? my blockSize : blockSize * SoundEnvelope_BRANCHING );
+			if (level == my numberOfLevels || (i - 1) % nextBlockSize != 0 || i - 1 + nextBlockSize > lastSample)
+				break;
+			level += 1;
+			blockSize = nextBlockSize;
+		}
+		double blockMinimum, blockMaximum;
+		if (level == 0 && samples.size > 0) {
+			blockMinimum = blockMaximum = samples [i];
+			i += 1;
+		} else {
+			if (level == 0) {
+				level = 1;   // widen to the level-1 block that contains sample i
+				blockSize = my blockSize;
+			}
+			const integer block = (i - 1) / blockSize + 1;
+			blockMinimum = my minima [level - 1] [channel] [block];
+			blockMaximum = my maxima [level - 1] [channel] [block];
+			i = block * blockSize + 1;
+		}
+		if (isundef (minimum) || blockMinimum < minimum)
+			minimum = blockMinimum;
+		if (isundef (maximum) || blockMaximum > maximum)
+			maximum = blockMaximum;
+	}
+	if (out_minimum)
+		*out_minimum = minimum;
+	if (out_maximum)
+		*out_maximum = maximum;
+}
+
+integer SoundEnvelope_getNumberOfColumns (Graphics g) {
+	double x1WC, x2WC, y1WC, y2WC;
+	Graphics_inqWindow (g, & x1WC, & x2WC, & y1WC, & y2WC);
+	return Melder_iceiling (fabs (Graphics_dxWCtoMM (g, x2WC - x1WC)) * 1200.0 / 25.4);
+}
+
+bool SoundEnvelope_shouldDraw (Graphics g, integer numberOfSamples) {
+	return Melder_debug != 65 &&
+		numberOfSamples >= SoundEnvelope_MINIMUM_SAMPLES_PER_COLUMN * SoundEnvelope_getNumberOfColumns (g);
+}
+
+void SoundEnvelope_drawChannel (SoundEnvelope me, Graphics g, integer channel, integer firstSample, integer lastSample,
+	constVEC samples, double x1WC, double x2WC)
+{
+	const integer numberOfSamples = lastSample - firstSample + 1;
+	const integer numberOfColumns = std::min (SoundEnvelope_getNumberOfColumns (g), numberOfSamples / 2);
+	if (numberOfColumns < 1)
+		return;
+	/*
+		Two points per column, so that Graphics_function draws a vertical line between them.
+		The extremum nearest to the previous point comes first, which keeps the lines between the columns short.
+	*/
+	autoVEC y = VECraw (2 * numberOfColumns);
+	double previous = 0.0;
+	for (integer column = 1; column <= numberOfColumns; column ++) {
+		const integer first = firstSample + (column - 1) * numberOfSamples / numberOfColumns;
+		const integer last = firstSample + column * numberOfSamples / numberOfColumns - 1;
+		double minimum, maximum;
+		SoundEnvelope_getExtrema (me, channel, first, last, samples, & minimum, & maximum);
+		if (column == 1 || fabs (minimum - previous) <= fabs (maximum - previous)) {
+			y [2 * column - 1] = minimum;
+			y [2 * column] = previous = maximum;
+		} else {
+			y [2 * column - 1] = maximum;
+			y [2 * column] = previous = minimum;
+		}
+	}
+	Graphics_function (g, & y [0], 1, 2 * numberOfColumns, x1WC, x2WC);
+}
+
+/* End of file SoundEnvelope.cpp */
@@ -0,0 +1,95 @@
+#ifndef _SoundEnvelope_h_
+#define _SoundEnvelope_h_
+/* SoundEnvelope.h
+ *
+ * Copyright (C) 2026 Praat developers
+ *
+ * This code is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this work. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Sound.h"
+
+/*
+	A min/max pyramid over the samples of a sound, for drawing and scanning long sounds.
+
+	Level 1 has the minimum and maximum of every block of `blockSize` samples,
+	level 2 of every block of SoundEnvelope_BRANCHING level-1 blocks, and so on,
+	up to the first level that has a single block. The last block of a level can be shorter than the others.
+	The extrema of any stretch of samples are thereby available in time proportional to the number of levels.
+*/
+#define SoundEnvelope_BRANCHING  8
+
+Thing_define (SoundEnvelope, Thing) {
+	integer numberOfChannels, numberOfSamples;
+	integer blockSize;   // of level 1
+	integer numberOfLevels;
+	std::vector <autoMAT> minima, maxima;   // [level - 1] [channel] [block]
+};
+
+/*
+	Allocates the levels. Fill level 1 with SoundEnvelope_setSamples, then call SoundEnvelope_finish.
+*/
+autoSoundEnvelope SoundEnvelope_create (integer numberOfChannels, integer numberOfSamples, integer blockSize);
+
+/*
+	Puts samples `firstSample` .. `firstSample + samples.size - 1` of `channel` into level 1.
+	`firstSample - 1` has to be a multiple of my blockSize,
+	and so has `samples.size`, except for the last samples of the sound.
+*/
+void SoundEnvelope_setSamples (SoundEnvelope me, integer channel, integer firstSample, constVEC samples);
+
+/*
+	Computes the levels above level 1.
+*/
+void SoundEnvelope_finish (SoundEnvelope me);
+
+/*
+	The envelope of samples `firstSample` .. `lastSample` of a Sound, in blocks of SoundEnvelope_BRANCHING samples;
+	sample 1 of the envelope is sample `firstSample` of the Sound.
+*/
+autoSoundEnvelope SoundEnvelope_createFromSound (Sound sound, integer firstSample, integer lastSample);
+
+/*
+	The extrema of samples `firstSample` .. `lastSample` of `channel`.
+	If `samples` (the samples of the channel) is given, the extrema are exact;
+	if `samples` is empty, the stretch is widened to whole level-1 blocks.
+*/
+void SoundEnvelope_getExtrema (SoundEnvelope me, integer channel, integer firstSample, integer lastSample, constVEC samples,
+	double *out_minimum, double *out_maximum);
+
+/*
+	The number of device pixels across the current viewport of `g`
+	at the finest resolution that any Graphics can have (1200 dpi),
+	so that the envelope looks the same as all the samples on every device the drawing can be copied to.
+*/
+integer SoundEnvelope_getNumberOfColumns (Graphics g);
+
+/*
+	Whether drawing `numberOfSamples` samples across the current viewport of `g`
+	had better be done with an envelope, i.e. whether there are several samples per column.
+	Debug option 65 always draws all the samples.
+*/
+bool SoundEnvelope_shouldDraw (Graphics g, integer numberOfSamples);
+
+/*
+	Draws samples `firstSample` .. `lastSample` of `channel`, as Graphics_function would draw them
+	from `x1WC` (the time of `firstSample`) to `x2WC` (the time of `lastSample`),
+	but with only a minimum and a maximum for every column,
+	so that a picture of a long sound takes little time to draw and little memory to record.
+*/
+void SoundEnvelope_drawChannel (SoundEnvelope me, Graphics g, integer channel, integer firstSample, integer lastSample,
+	constVEC samples, double x1WC, double x2WC);
+
+/* End of file SoundEnvelope.h */
+#endif
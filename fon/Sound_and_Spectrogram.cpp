@@ -34,12 +34,94 @@
 
 #include "Sound_and_Spectrogram.h"
 #include "NUM2.h"
+#include "MelderThread.h"
 
 #include "enums_getText.h"
 #include "Sound_and_Spectrogram_enums.h"
 #include "enums_getValue.h"
 #include "Sound_and_Spectrogram_enums.h"
 
+/*
+	The frames are windowed in batches, and each batch is Fourier-transformed with a single call.
+	Consecutive batches are divided over threads; every thread has its own frame matrix, power spectrum and FFT workspace.
+*/
+#define Sound_to_Spectrogram_FRAMES_PER_BATCH  32
+#define Sound_to_Spectrogram_BATCHES_PER_THREAD  4
+
+Thing_define (Sound_into_Spectrogram_Args, Thing) { public:
+	Sound sound;
+	Spectrogram spectrogram;
+	integer firstFrame, lastFrame, framesPerBatch;
+	integer nsamp_window, halfnsamp_window, nsampFFT, binWidth_samples;
+	double oneByBinWidth, *window;
+	NUMfft_Table fftTable;
+	autoMAT frames;
+	autoVEC spec, fftWorkspace;
+};
+
+Thing_implement (Sound_into_Spectrogram_Args, Thing, 0);
+
+static MelderThread_RETURN_TYPE Sound_into_Spectrogram (Sound_into_Spectrogram_Args me) {
+	Sound sound = my sound;
+	Spectrogram thee = my spectrogram;
+	const integer ny = sound -> ny, nsampFFT = my nsampFFT, half_nsampFFT = nsampFFT / 2;
+	for (integer firstFrame = my firstFrame; firstFrame <= my lastFrame; firstFrame += my framesPerBatch) {
+		const integer lastFrame = std::min (firstFrame + my framesPerBatch - 1, my lastFrame);
+		MAT batch = my frames.horizontalBand (1, (lastFrame - firstFrame + 1) * ny);
+		for (integer iframe = firstFrame; iframe <= lastFrame; iframe ++) {
+			double t = Sampled_indexToX (thee, iframe);
+			integer leftSample = Sampled_xToLowIndex (sound, t), rightSample = leftSample + 1;
+			integer startSample = rightSample - my halfnsamp_window;
+			integer endSample = leftSample + my halfnsamp_window;
+			Melder_assert (startSample >= 1);
+			Melder_assert (endSample <= sound -> nx);
+			for (integer channel = 1; channel <= ny; channel ++) {
+				VEC frame = batch [(iframe - firstFrame) * ny + channel];
+				for (integer j = 1, i = startSample; j <= my nsamp_window; j ++) {
+					frame [j] = sound -> z [channel] [i ++] * my window [j];
+				}
+				for (integer j = my nsamp_window + 1; j <= nsampFFT; j ++) frame [j] = 0.0;
+			}
+		}
+
+		/*
+			Compute the Fast Fourier Transforms of all the frames in the batch.
+		*/
+		NUMfft_forward_batch (my fftTable, batch, my fftWorkspace.get());   // complex spectra
+
+		VEC spec = my spec.get();
+		for (integer iframe = firstFrame; iframe <= lastFrame; iframe ++) {
+			for (integer i = 1; i <= half_nsampFFT; i ++) {
+				spec [i] = 0.0;
+			}
+			for (integer channel = 1; channel <= ny; channel ++) {
+				VEC frame = batch [(iframe - firstFrame) * ny + channel];
+				/*
+					Put the power spectrum in frame [1..half_nsampFFT + 1].
+				*/
+				spec [1] += frame [1] * frame [1];   // DC component
+				for (integer i = 2; i <= half_nsampFFT; i ++)
+					spec [i] += frame [i + i - 2] * frame [i + i - 2] + frame [i + i - 1] * frame [i + i - 1];
+				spec [half_nsampFFT + 1] += frame [nsampFFT] * frame [nsampFFT];   // Nyquist frequency. Correct??
+			}
+			if (ny > 1 ) for (integer i = 1; i <= half_nsampFFT; i ++) {
+				spec [i] /= ny;
+			}
+
+			/*
+				Bin into frame [1..nBands].
+			*/
+			for (integer iband = 1; iband <= thy ny; iband ++) {
+				integer leftsample = (iband - 1) * my binWidth_samples + 1, rightsample = leftsample + my binWidth_samples;
+				long double power = 0.0;
+				for (integer i = leftsample; i < rightsample; i ++) power += spec [i];
+				thy z [iband] [iframe] = (double) power * my oneByBinWidth;
+			}
+		}
+	}
+	MelderThread_RETURN;
+}
+
 autoSpectrogram Sound_to_Spectrogram (Sound me, double effectiveAnalysisWidth, double fmax,
 	double minimumTimeStep1, double minimumFreqStep1, kSound_to_Spectrogram_windowShape windowType,
 	double maximumTimeOversampling, double maximumFreqOversampling)
@@ -80,7 +162,6 @@ autoSpectrogram Sound_to_Spectrogram (Sound me, double effectiveAnalysisWidth, d
 		integer nsampFFT = 1;
 		while (nsampFFT < nsamp_window || nsampFFT < 2 * numberOfFreqs * (nyquist / fmax))
 			nsampFFT *= 2;
-		integer half_nsampFFT = nsampFFT / 2;
 
 		/*
 			Compute the frequency sampling of the spectrogram.
@@ -95,8 +176,6 @@ autoSpectrogram Sound_to_Spectrogram (Sound me, double effectiveAnalysisWidth, d
 		autoSpectrogram thee = Spectrogram_create (my xmin, my xmax, numberOfTimes, timeStep, t1,
 				0.0, fmax, numberOfFreqs, freqStep, 0.5 * (freqStep - binWidth_hertz));
 
-		autoVEC frame = VECzero (nsampFFT);
-		autoNUMvector <double> spec (1, nsampFFT);
 		autoNUMvector <double> window (1, nsamp_window);
 		autoNUMfft_Table fftTable;
 		NUMfft_Table_init (& fftTable, nsampFFT);
@@ -132,51 +211,44 @@ autoSpectrogram Sound_to_Spectrogram (Sound me, double effectiveAnalysisWidth, d
 		}
 		double oneByBinWidth = 1.0 / windowssq / binWidth_samples;
 
-		for (integer iframe = 1; iframe <= numberOfTimes; iframe ++) {
-			double t = Sampled_indexToX (thee.get(), iframe);
-			integer leftSample = Sampled_xToLowIndex (me, t), rightSample = leftSample + 1;
-			integer startSample = rightSample - halfnsamp_window;
-			integer endSample = leftSample + halfnsamp_window;
-			Melder_assert (startSample >= 1);
-			Melder_assert (endSample <= my nx);
-			for (integer i = 1; i <= half_nsampFFT; i ++) {
-				spec [i] = 0.0;
-			}
-			for (integer channel = 1; channel <= my ny; channel ++) {
-				for (integer j = 1, i = startSample; j <= nsamp_window; j ++) {
-					frame [j] = my z [channel] [i ++] * window [j];
-				}
-				for (integer j = nsamp_window + 1; j <= nsampFFT; j ++) frame [j] = 0.0f;
-
-				Melder_progress (iframe / (numberOfTimes + 1.0),
-					U"Sound to Spectrogram: analysis of frame ", iframe, U" out of ", numberOfTimes);
-
-				/*
-					Compute the Fast Fourier Transform of the frame.
-				*/
-				NUMfft_forward (& fftTable, frame.get());   // complex spectrum
-
-				/*
-					Put the power spectrum in frame [1..half_nsampFFT + 1].
-				*/
-				spec [1] += frame [1] * frame [1];   // DC component
-				for (integer i = 2; i <= half_nsampFFT; i ++)
-					spec [i] += frame [i + i - 2] * frame [i + i - 2] + frame [i + i - 1] * frame [i + i - 1];
-				spec [half_nsampFFT + 1] += frame [nsampFFT] * frame [nsampFFT];   // Nyquist frequency. Correct??
-			}
-			if (my ny > 1 ) for (integer i = 1; i <= half_nsampFFT; i ++) {
-				spec [i] /= my ny;
-			}
-
-			/*
-				Bin into frame [1..nBands].
-			*/
-			for (integer iband = 1; iband <= numberOfFreqs; iband ++) {
-				integer leftsample = (iband - 1) * binWidth_samples + 1, rightsample = leftsample + binWidth_samples;
-				long double power = 0.0;
-				for (integer i = leftsample; i < rightsample; i ++) power += spec [i];
-				thy z [iband] [iframe] = (double) power * oneByBinWidth;
+		/*
+			Debug option 53 switches batching off, and with it the threads.
+		*/
+		const integer framesPerBatch = ( Melder_debug == 53 ? 1 : Sound_to_Spectrogram_FRAMES_PER_BATCH );
+		const integer framesPerThread = framesPerBatch * ( Melder_debug == 53 ? 1 : Sound_to_Spectrogram_BATCHES_PER_THREAD );
+		const integer numberOfThreads = ( Melder_debug == 53 ? 1 :
+				std::min ((numberOfTimes - 1) / framesPerThread + 1, integer (MelderThread_getNumberOfProcessors ())) );
+		std::vector <autoSound_into_Spectrogram_Args> args ((size_t) numberOfThreads);
+		for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+			autoSound_into_Spectrogram_Args arg = Thing_new (Sound_into_Spectrogram_Args);
+			arg -> sound = me;
+			arg -> spectrogram = thee.get();
+			arg -> framesPerBatch = framesPerBatch;
+			arg -> nsamp_window = nsamp_window;
+			arg -> halfnsamp_window = halfnsamp_window;
+			arg -> nsampFFT = nsampFFT;
+			arg -> binWidth_samples = binWidth_samples;
+			arg -> oneByBinWidth = oneByBinWidth;
+			arg -> window = window.peek();
+			arg -> fftTable = & fftTable;
+			arg -> frames = MATzero (framesPerBatch * my ny, nsampFFT);
+			arg -> spec = VECzero (nsampFFT);
+			arg -> fftWorkspace = VECraw (NUMfft_getWorkspaceSize (nsampFFT));
+			args [(size_t) ithread - 1] = arg.move();
+		}
+		for (integer firstFrame = 1; firstFrame <= numberOfTimes; firstFrame += numberOfThreads * framesPerThread) {
+			Melder_progress (firstFrame / (numberOfTimes + 1.0),
+				U"Sound to Spectrogram: analysis of frame ", firstFrame, U" out of ", numberOfTimes);
+			integer numberOfThreadsNeeded = 0;
+			for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+				const integer threadFirstFrame = firstFrame + (ithread - 1) * framesPerThread;
+				if (threadFirstFrame > numberOfTimes)
+					break;
+				args [(size_t) ithread - 1] -> firstFrame = threadFirstFrame;
+				args [(size_t) ithread - 1] -> lastFrame = std::min (threadFirstFrame + framesPerThread - 1, numberOfTimes);
+				numberOfThreadsNeeded = ithread;
 			}
+			MelderThread_run (Sound_into_Spectrogram, args.data(), (int) numberOfThreadsNeeded);
 		}
 		return thee;
 	} catch (MelderError) {
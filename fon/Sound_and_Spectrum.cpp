@@ -33,6 +33,7 @@
 
 #include "Sound_and_Spectrum.h"
 #include "NUM2.h"
+#include "MelderThread.h"
 
 autoSpectrum Sound_to_Spectrum (Sound me, bool fast) {
 	try {
@@ -186,46 +187,188 @@ autoSound Sound_filter_formula (Sound me, conststring32 formula, Interpreter int
 	}
 }
 
-autoSound Sound_filter_passHannBand (Sound me, double fmin, double fmax, double smooth) {
-	try {
-		autoSound thee = Data_copy (me);
-		if (my ny == 1) {
-			autoSpectrum spec = Sound_to_Spectrum (me, true);
-			Spectrum_passHannBand (spec.get(), fmin, fmax, smooth);
-			autoSound him = Spectrum_to_Sound (spec.get());
-			NUMvector_copyElements (& his z [1] [0], & thy z [1] [0], 1, thy nx);
-		} else {
-			for (integer ichan = 1; ichan <= my ny; ichan ++) {
-				autoSound channel = Sound_extractChannel (me, ichan);
-				autoSpectrum spec = Sound_to_Spectrum (channel.get(), true);
-				Spectrum_passHannBand (spec.get(), fmin, fmax, smooth);
-				autoSound him = Spectrum_to_Sound (spec.get());
-				NUMvector_copyElements (& his z [1] [0], & thy z [ichan] [0], 1, thy nx);
+void Spectrum_filterHannBands (Spectrum me, integer numberOfBands, const SpectrumHannBand bands []) {
+	for (integer iband = 0; iband < numberOfBands; iband ++) {
+		if (bands [iband]. pass)
+			Spectrum_passHannBand (me, bands [iband]. fmin, bands [iband]. fmax, bands [iband]. smooth);
+		else
+			Spectrum_stopHannBand (me, bands [iband]. fmin, bands [iband]. fmax, bands [iband]. smooth);
+	}
+}
+
+/*
+	The impulse response of a Hann edge with smoothing s decays as 1 / (s t)^2 (or faster),
+	so we truncate the kernel at |t| = kernelHalfDurationTimesSmoothing / s,
+	where the truncation error is far below the precision of any recording.
+	Edges without smoothing (brick walls) have impulse responses that decay as 1 / t,
+	and are always done with a transform of the whole signal.
+*/
+static const double kernelHalfDurationTimesSmoothing = 40.0;
+
+static double SpectrumHannBands_getSmallestSmoothing (integer numberOfBands, const SpectrumHannBand bands [], double nyquistFrequency) {
+	double smallestSmoothing = undefined;
+	for (integer iband = 0; iband < numberOfBands; iband ++) {
+		const double fmax = bands [iband]. fmax == 0.0 ? nyquistFrequency : bands [iband]. fmax;
+		const bool hasLowerEdge = bands [iband]. fmin > 0.0, hasUpperEdge = fmax < nyquistFrequency;
+		if (! hasLowerEdge && ! hasUpperEdge)
+			continue;
+		if (bands [iband]. smooth <= 0.0)
+			return 0.0;
+		if (isundef (smallestSmoothing) || bands [iband]. smooth < smallestSmoothing)
+			smallestSmoothing = bands [iband]. smooth;
+	}
+	return smallestSmoothing;
+}
+
+Thing_define (Sound_filterWithKernel_Args, Thing) { public:
+	Sound sound;
+	integer firstChannel, channelStep, lastChannel;
+	NUMfft_Table fftTable;
+	constVEC kernelSpectrum;
+	integer kernelHalfLength;
+	autoVEC segment, overlap, fftWorkspace;
+};
+
+Thing_implement (Sound_filterWithKernel_Args, Thing, 0);
+
+/*
+	Overlap-save convolution, in place, with the zero-phase kernel h [-K..K] whose spectrum (divided by N) is given.
+	Each segment of N samples yields N - 2K output samples; the 2K input samples that the next segment shares
+	with this one are saved before the output overwrites them.
+*/
+static MelderThread_RETURN_TYPE Sound_filterWithKernel (Sound_filterWithKernel_Args me) {
+	const integer numberOfSamples = my sound -> nx, n = my fftTable -> n, halfLength = my kernelHalfLength;
+	const integer hop = n - 2 * halfLength;
+	double *segment = & my segment [0], *overlap = & my overlap [0];
+	const double *kernelSpectrum = & my kernelSpectrum [0];
+	for (integer ichan = my firstChannel; ichan <= my lastChannel; ichan += my channelStep) {
+		double *x = & my sound -> z [ichan] [0];
+		for (integer i = 1; i <= 2 * halfLength; i ++)
+			overlap [i] = ( i - halfLength >= 1 && i - halfLength <= numberOfSamples ? x [i - halfLength] : 0.0 );   // the samples before x [1] are zero
+		for (integer start = 1; start <= numberOfSamples; start += hop) {
+			/*
+				segment [i] = x [start - halfLength + i - 1], the first 2K of which have been saved in `overlap`.
+			*/
+			for (integer i = 1; i <= 2 * halfLength; i ++)
+				segment [i] = overlap [i];
+			for (integer i = 2 * halfLength + 1; i <= n; i ++) {
+				const integer isamp = start - halfLength + i - 1;
+				segment [i] = ( isamp <= numberOfSamples ? x [isamp] : 0.0 );
+			}
+			for (integer i = 1; i <= 2 * halfLength; i ++)
+				overlap [i] = segment [hop + i];
+			NUMfft_forward (my fftTable, my segment.get(), my fftWorkspace.get());
+			segment [1] *= kernelSpectrum [1];
+			for (integer i = 2; i < n; i += 2) {
+				const double re = segment [i], im = segment [i + 1];
+				segment [i] = re * kernelSpectrum [i] - im * kernelSpectrum [i + 1];
+				segment [i + 1] = re * kernelSpectrum [i + 1] + im * kernelSpectrum [i];
 			}
+			segment [n] *= kernelSpectrum [n];
+			NUMfft_backward (my fftTable, my segment.get(), my fftWorkspace.get());
+			const integer numberOfOutputSamples = std::min (hop, numberOfSamples - start + 1);
+			for (integer i = 1; i <= numberOfOutputSamples; i ++)
+				x [start + i - 1] = segment [halfLength + i];
 		}
+	}
+	MelderThread_RETURN;
+}
+
+void Sound_filterChannelsWithHannBands_inplace (Sound me, integer fromChannel, integer toChannel,
+	integer numberOfBands, const SpectrumHannBand bands [], bool useKernel)
+{
+	const integer numberOfChannels = toChannel - fromChannel + 1;
+	if (numberOfChannels < 1)
+		return;
+	const double nyquistFrequency = 0.5 / my dx;
+	const double smallestSmoothing = SpectrumHannBands_getSmallestSmoothing (numberOfBands, bands, nyquistFrequency);
+	integer numberOfSamplesForWholeTransform = 2;
+	while (numberOfSamplesForWholeTransform < my nx)
+		numberOfSamplesForWholeTransform *= 2;
+	/*
+		The kernel is designed on a grid of `designSize` frequencies (a power of two),
+		and used in segments of 4 * designSize samples.
+	*/
+	integer designSize = 256;
+	if (smallestSmoothing > 0.0) {
+		const double kernelDuration = 2.0 * kernelHalfDurationTimesSmoothing / smallestSmoothing;
+		while (designSize < kernelDuration / my dx && designSize <= numberOfSamplesForWholeTransform)
+			designSize *= 2;
+	}
+	if (! useKernel || ! (smallestSmoothing > 0.0) || 4 * designSize > numberOfSamplesForWholeTransform || Melder_debug == 57) {
+		for (integer ichan = fromChannel; ichan <= toChannel; ichan ++) {
+			autoSound channel = Sound_extractChannel (me, ichan);
+			autoSpectrum spec = Sound_to_Spectrum (channel.get(), true);
+			Spectrum_filterHannBands (spec.get(), numberOfBands, bands);
+			autoSound him = Spectrum_to_Sound (spec.get());
+			NUMvector_copyElements (& his z [1] [0], & my z [ichan] [0], 1, my nx);
+		}
+		return;
+	}
+
+	/*
+		Design: the response on the design grid, transformed back, is the kernel h [-K..K], with K = designSize / 2 - 1.
+	*/
+	autoSpectrum design = Spectrum_create (nyquistFrequency, designSize / 2 + 1);
+	design -> dx = 1.0 / (my dx * designSize);   // as in Sound_to_Spectrum
+	for (integer i = 1; i <= design -> nx; i ++) {
+		design -> z [1] [i] = 1.0;
+		design -> z [2] [i] = 0.0;
+	}
+	Spectrum_filterHannBands (design.get(), numberOfBands, bands);
+	autoVEC kernel = VECzero (designSize);
+	kernel [1] = design -> z [1] [1];
+	for (integer i = 2; i < design -> nx; i ++)
+		kernel [i + i - 2] = design -> z [1] [i];   // the imaginary parts stay zero
+	kernel [designSize] = design -> z [1] [design -> nx];
+	autoNUMfft_Table designTable;
+	NUMfft_Table_init (& designTable, designSize);
+	NUMfft_backward (& designTable, kernel.get());
+	const integer halfLength = designSize / 2 - 1;
+	const integer segmentSize = 4 * designSize;
+	autoVEC kernelSpectrum = VECzero (segmentSize);
+	kernelSpectrum [1] = kernel [1] / designSize / segmentSize;   // h [0], and the normalization of the two backward transforms
+	for (integer k = 1; k <= halfLength; k ++)
+		kernelSpectrum [1 + k] = kernelSpectrum [segmentSize + 1 - k] = kernel [1 + k] / designSize / segmentSize;
+	autoNUMfft_Table fftTable;
+	NUMfft_Table_init (& fftTable, segmentSize);
+	NUMfft_forward (& fftTable, kernelSpectrum.get());
+
+	const integer numberOfThreads = std::min (numberOfChannels, integer (MelderThread_getNumberOfProcessors ()));
+	std::vector <autoSound_filterWithKernel_Args> args ((size_t) numberOfThreads);
+	for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+		autoSound_filterWithKernel_Args arg = Thing_new (Sound_filterWithKernel_Args);
+		arg -> sound = me;
+		arg -> firstChannel = fromChannel + ithread - 1;
+		arg -> channelStep = numberOfThreads;
+		arg -> lastChannel = toChannel;
+		arg -> fftTable = & fftTable;
+		arg -> kernelSpectrum = kernelSpectrum.get();
+		arg -> kernelHalfLength = halfLength;
+		arg -> segment = VECraw (segmentSize);
+		arg -> overlap = VECraw (2 * halfLength);
+		arg -> fftWorkspace = VECraw (NUMfft_getWorkspaceSize (segmentSize));
+		args [(size_t) ithread - 1] = arg.move();
+	}
+	MelderThread_run (Sound_filterWithKernel, args.data(), (int) numberOfThreads);
+}
+
+autoSound Sound_filter_passHannBand (Sound me, double fmin, double fmax, double smooth, bool useKernel) {
+	try {
+		autoSound thee = Data_copy (me);
+		const SpectrumHannBand band { true, fmin, fmax, smooth };
+		Sound_filterChannelsWithHannBands_inplace (thee.get(), 1, thy ny, 1, & band, useKernel);
 		return thee;
 	} catch (MelderError) {
 		Melder_throw (me, U": not filtered (pass Hann band).");
 	}
 }
 
-autoSound Sound_filter_stopHannBand (Sound me, double fmin, double fmax, double smooth) {
+autoSound Sound_filter_stopHannBand (Sound me, double fmin, double fmax, double smooth, bool useKernel) {
 	try {
 		autoSound thee = Data_copy (me);
-		if (my ny == 1) {
-			autoSpectrum spec = Sound_to_Spectrum (me, true);
-			Spectrum_stopHannBand (spec.get(), fmin, fmax, smooth);
-			autoSound him = Spectrum_to_Sound (spec.get());
-			NUMvector_copyElements (& his z [1] [0], & thy z [1] [0], 1, thy nx);
-		} else {
-			for (integer ichan = 1; ichan <= my ny; ichan ++) {
-				autoSound channel = Sound_extractChannel (me, ichan);
-				autoSpectrum spec = Sound_to_Spectrum (channel.get(), true);
-				Spectrum_stopHannBand (spec.get(), fmin, fmax, smooth);
-				autoSound him = Spectrum_to_Sound (spec.get());
-				NUMvector_copyElements (& his z [1] [0], & thy z [ichan] [0], 1, thy nx);
-			}
-		}
+		const SpectrumHannBand band { false, fmin, fmax, smooth };
+		Sound_filterChannelsWithHannBands_inplace (thee.get(), 1, thy ny, 1, & band, useKernel);
 		return thee;
 	} catch (MelderError) {
 		Melder_throw (me, U": not filtered (stop Hann band).");
@@ -27,8 +27,31 @@ autoSound Spectrum_to_Sound (Spectrum me);
 
 autoSpectrum Spectrum_lpcSmoothing (Spectrum me, int numberOfPeaks, double preemphasisFrequency);
 
-autoSound Sound_filter_passHannBand (Sound me, double fmin, double fmax, double smooth);
-autoSound Sound_filter_stopHannBand (Sound me, double fmin, double fmax, double smooth);
+/*
+	A filter that multiplies the spectrum with a product of Hann bands,
+	each as in Spectrum_passHannBand or Spectrum_stopHannBand.
+*/
+struct SpectrumHannBand {
+	bool pass;   // pass band (true) or stop band (false)
+	double fmin, fmax, smooth;
+};
+void Spectrum_filterHannBands (Spectrum me, integer numberOfBands, const SpectrumHannBand bands []);
+
+void Sound_filterChannelsWithHannBands_inplace (Sound me, integer fromChannel, integer toChannel,
+	integer numberOfBands, const SpectrumHannBand bands [], bool useKernel);
+/*
+	Filters channels fromChannel through toChannel, each on its own.
+	Without `useKernel`, each channel is transformed as a whole,
+	exactly as Sound_to_Spectrum + Spectrum_filterHannBands + Spectrum_to_Sound would.
+	With `useKernel`, if all band edges are smooth and the sound is long compared to the edges,
+	this is approximated by overlap-save convolution with a zero-phase FIR kernel that has the Hann-band response,
+	in blocks and with the channels divided over threads, so that no transform of the whole signal is needed;
+	the result differs from the exact one by the truncation of the kernel, and near the edges of the sound,
+	where the whole transform wraps around. Otherwise (or with Debug option 57) each channel is transformed as a whole.
+*/
+
+autoSound Sound_filter_passHannBand (Sound me, double fmin, double fmax, double smooth, bool useKernel);
+autoSound Sound_filter_stopHannBand (Sound me, double fmin, double fmax, double smooth, bool useKernel);
 autoSound Sound_filter_formula (Sound me, conststring32 formula, Interpreter interpreter);
 
 /* End of file Sound_and_Spectrum.h */
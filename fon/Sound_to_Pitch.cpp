@@ -41,13 +41,14 @@
 #define FCC_NORMAL  2
 #define FCC_ACCURATE  3
 
-static void Sound_into_PitchFrame (Sound me, Pitch_Frame pitchFrame, double t,
-	double minimumPitch, int maxnCandidates, int method, double voicingThreshold, double octaveCost,
-	NUMfft_Table fftTable, double dt_window, integer nsamp_window, integer halfnsamp_window,
-	integer maximumLag, integer nsampFFT, integer nsamp_period, integer halfnsamp_period,
-	integer brent_ixmax, integer brent_depth, double globalPeak,
-	const MAT& frame, double *ac, double *window, double *windowR,
-	double *r, integer *imax, double *localMean)
+/*
+	The analysis of a frame goes in three steps:
+	windowing (with the computation of the local mean and the local peak), correlation, and the search for candidates.
+	The autocorrelation step is performed for a whole batch of frames at once (see Sound_into_Pitch below).
+*/
+static double Sound_into_PitchFrame_window (Sound me, Pitch_Frame pitchFrame, double t, int method,
+	integer nsamp_window, integer halfnsamp_window, integer nsampFFT, integer nsamp_period, integer halfnsamp_period,
+	double globalPeak, MAT frame, double *window, double *localMean)
 {
 	integer leftSample = Sampled_xToLowIndex (me, t), rightSample = leftSample + 1;
 	integer startSample, endSample;
@@ -99,69 +100,60 @@ static void Sound_into_PitchFrame (Sound me, Pitch_Frame pitchFrame, double t,
 	}
 	pitchFrame -> intensity =
 		localPeak > globalPeak ? 1.0 : localPeak / globalPeak;
+	return localPeak;
+}
 
-	/*
-	 * Compute the correlation into the array 'r'.
-	 */
-	if (method >= FCC_NORMAL) {
-		double startTime = t - 0.5 * (1.0 / minimumPitch + dt_window);
-		integer localSpan = maximumLag + nsamp_window, localMaximumLag, offset;
-		if ((startSample = Sampled_xToLowIndex (me, startTime)) < 1) startSample = 1;
-		if (localSpan > my nx + 1 - startSample) localSpan = my nx + 1 - startSample;
-		localMaximumLag = localSpan - nsamp_window;
-		offset = startSample - 1;
-		longdouble sumx2 = 0.0;   // sum of squares
-		for (integer channel = 1; channel <= my ny; channel ++) {
-			double *amp = & my z [channel] [0] + offset;
-			for (integer i = 1; i <= nsamp_window; i ++) {
-				double x = amp [i] - localMean [channel];
-				sumx2 += x * x;
-			}
-		}
-		longdouble sumy2 = sumx2;   // at zero lag, these are still equal
-		r [0] = 1.0;
-		for (integer i = 1; i <= localMaximumLag; i ++) {
-			longdouble product = 0.0;
-			for (integer channel = 1; channel <= my ny; channel ++) {
-				double *amp = & my z [channel] [0] + offset;
-				double y0 = amp [i] - localMean [channel];
-				double yZ = amp [i + nsamp_window] - localMean [channel];
-				sumy2 += yZ * yZ - y0 * y0;
-				for (integer j = 1; j <= nsamp_window; j ++) {
-					double x = amp [j] - localMean [channel];
-					double y = amp [i + j] - localMean [channel];
-					product += x * y;
-				}
-			}
-			r [- i] = r [i] = (double) product / sqrt ((double) sumx2 * (double) sumy2);
-		}
-	} else {
-
-		/*
-		 * The FFT of the autocorrelation is the power spectrum.
-		 */
-		for (integer i = 1; i <= nsampFFT; i ++) {
-			ac [i] = 0.0;
+static void Sound_into_PitchFrame_crossCorrelate (Sound me, double t, double minimumPitch,
+	double dt_window, integer nsamp_window, integer maximumLag, double *r, double *localMean)
+{
+	integer startSample;
+	double startTime = t - 0.5 * (1.0 / minimumPitch + dt_window);
+	integer localSpan = maximumLag + nsamp_window, localMaximumLag, offset;
+	if ((startSample = Sampled_xToLowIndex (me, startTime)) < 1) startSample = 1;
+	if (localSpan > my nx + 1 - startSample) localSpan = my nx + 1 - startSample;
+	localMaximumLag = localSpan - nsamp_window;
+	offset = startSample - 1;
+	longdouble sumx2 = 0.0;   // sum of squares
+	for (integer channel = 1; channel <= my ny; channel ++) {
+		double *amp = & my z [channel] [0] + offset;
+		for (integer i = 1; i <= nsamp_window; i ++) {
+			double x = amp [i] - localMean [channel];
+			sumx2 += x * x;
 		}
+	}
+	longdouble sumy2 = sumx2;   // at zero lag, these are still equal
+	r [0] = 1.0;
+	for (integer i = 1; i <= localMaximumLag; i ++) {
+		longdouble product = 0.0;
 		for (integer channel = 1; channel <= my ny; channel ++) {
-			NUMfft_forward (fftTable, VEC (& frame [channel] [0], fftTable->n));   // complex spectrum
-			ac [1] += frame [channel] [1] * frame [channel] [1];   // DC component
-			for (integer i = 2; i < nsampFFT; i += 2) {
-				ac [i] += frame [channel] [i] * frame [channel] [i] + frame [channel] [i+1] * frame [channel] [i+1];   // power spectrum
+			double *amp = & my z [channel] [0] + offset;
+			double y0 = amp [i] - localMean [channel];
+			double yZ = amp [i + nsamp_window] - localMean [channel];
+			sumy2 += yZ * yZ - y0 * y0;
+			for (integer j = 1; j <= nsamp_window; j ++) {
+				double x = amp [j] - localMean [channel];
+				double y = amp [i + j] - localMean [channel];
+				product += x * y;
 			}
-			ac [nsampFFT] += frame [channel] [nsampFFT] * frame [channel] [nsampFFT];   // Nyquist frequency
 		}
-		NUMfft_backward (fftTable, VEC (ac, fftTable->n));   /* Autocorrelation. */
-
-		/*
-		 * Normalize the autocorrelation to the value with zero lag,
-		 * and divide it by the normalized autocorrelation of the window.
-		 */
-		r [0] = 1.0;
-		for (integer i = 1; i <= brent_ixmax; i ++)
-			r [- i] = r [i] = ac [i + 1] / (ac [1] * windowR [i + 1]);
+		r [- i] = r [i] = (double) product / sqrt ((double) sumx2 * (double) sumy2);
 	}
+}
 
+static void Sound_into_PitchFrame_autocorrelationFromPowerSpectrum (constVEC ac, integer brent_ixmax, double *windowR, double *r) {
+	/*
+	 * Normalize the autocorrelation to the value with zero lag,
+	 * and divide it by the normalized autocorrelation of the window.
+	 */
+	r [0] = 1.0;
+	for (integer i = 1; i <= brent_ixmax; i ++)
+		r [- i] = r [i] = ac [i + 1] / (ac [1] * windowR [i + 1]);
+}
+
+static void Sound_into_PitchFrame_findCandidates (Sound me, Pitch_Frame pitchFrame, double localPeak,
+	double minimumPitch, int maxnCandidates, int method, double voicingThreshold, double octaveCost,
+	integer maximumLag, integer brent_ixmax, integer brent_depth, double *r, integer *imax)
+{
 	/*
 	 * Register the first candidate, which is always present: voicelessness.
 	 */
@@ -254,6 +246,7 @@ Thing_define (Sound_into_Pitch_Args, Thing) { public:
 	double voicingThreshold, octaveCost, dt_window;
 	integer nsamp_window, halfnsamp_window, maximumLag, nsampFFT, nsamp_period, halfnsamp_period, brent_ixmax, brent_depth;
 	double globalPeak, *window, *windowR;
+	autoVEC fftWorkspace;   // allocated in the main thread, for the autocorrelation methods
 	bool isMainThread;
 	volatile int *cancelled;
 };
@@ -300,30 +293,37 @@ bool mutex_inited;
 
 static MelderThread_RETURN_TYPE Sound_into_Pitch (Sound_into_Pitch_Args me)
 {
+	/*
+		In the autocorrelation methods, the windowed frames are Fourier-transformed in batches,
+		and so are their power spectra (Debug option 53 switches batching off).
+	*/
+	const integer maximumNumberOfFramesPerBatch = ( my method >= FCC_NORMAL || Melder_debug == 53 ? 1 : 16 );
+	const integer ny = my sound -> ny;
 	autoNUMfft_Table fftTable;
-	autoMAT frame;
-	autoNUMvector <double> ac, r, localMean;
+	autoMAT frames, acs;
+	autoNUMvector <double> r, localMean, localPeaks;
 	autoNUMvector <integer> imax;
 	{// scope
 		MelderThread_LOCK (mutex);
 		if (my method >= FCC_NORMAL) {   // cross-correlation
-			frame = MATzero (my sound -> ny, my nsamp_window);
+			frames = MATzero (ny, my nsamp_window);
 		} else {   // autocorrelation
 			NUMfft_Table_init (& fftTable, my nsampFFT);
-			frame = MATzero (my sound -> ny, my nsampFFT);
-			ac.reset (1, my nsampFFT);
+			frames = MATzero (maximumNumberOfFramesPerBatch * ny, my nsampFFT);
+			acs = MATzero (maximumNumberOfFramesPerBatch, my nsampFFT);
 		}
 		r.reset (- my nsamp_window, my nsamp_window);
 		imax.reset (1, my maxnCandidates);
-		localMean.reset (1, my sound -> ny);
+		localMean.reset (1, ny);
+		localPeaks.reset (1, maximumNumberOfFramesPerBatch);
 		MelderThread_UNLOCK (mutex);
 	}
-	for (integer iframe = my firstFrame; iframe <= my lastFrame; iframe ++) {
-		Pitch_Frame pitchFrame = & my pitch -> frame [iframe];
-		const double t = Sampled_indexToX (my pitch, iframe);
+	for (integer firstFrame = my firstFrame; firstFrame <= my lastFrame; firstFrame += maximumNumberOfFramesPerBatch) {
+		const integer lastFrame = std::min (firstFrame + maximumNumberOfFramesPerBatch - 1, my lastFrame);
+		const integer numberOfFramesInBatch = lastFrame - firstFrame + 1;
 		if (my isMainThread) {
 			try {
-				Melder_progress (0.1 + 0.8 * (iframe - my firstFrame) / (my lastFrame - my firstFrame),
+				Melder_progress (0.1 + 0.8 * (firstFrame - my firstFrame) / (my lastFrame - my firstFrame),
 					U"Sound to Pitch: analysing ", my lastFrame, U" frames");
 			} catch (MelderError) {
 				*my cancelled = 1;
@@ -332,13 +332,52 @@ static MelderThread_RETURN_TYPE Sound_into_Pitch (Sound_into_Pitch_Args me)
 		} else if (*my cancelled) {
 			MelderThread_RETURN;
 		}
-		Sound_into_PitchFrame (my sound, pitchFrame, t,
-			my minimumPitch, my maxnCandidates, my method, my voicingThreshold, my octaveCost,
-			& fftTable, my dt_window, my nsamp_window, my halfnsamp_window,
-			my maximumLag, my nsampFFT, my nsamp_period, my halfnsamp_period,
-			my brent_ixmax, my brent_depth, my globalPeak,
-			frame.get(), ac.peek(), my window, my windowR,
-			r.peek(), imax.peek(), localMean.peek());
+		if (my method >= FCC_NORMAL) {
+			Pitch_Frame pitchFrame = & my pitch -> frame [firstFrame];
+			const double t = Sampled_indexToX (my pitch, firstFrame);
+			const double localPeak = Sound_into_PitchFrame_window (my sound, pitchFrame, t, my method,
+				my nsamp_window, my halfnsamp_window, my nsampFFT, my nsamp_period, my halfnsamp_period,
+				my globalPeak, frames.get(), my window, localMean.peek());
+			Sound_into_PitchFrame_crossCorrelate (my sound, t, my minimumPitch,
+				my dt_window, my nsamp_window, my maximumLag, r.peek(), localMean.peek());
+			Sound_into_PitchFrame_findCandidates (my sound, pitchFrame, localPeak,
+				my minimumPitch, my maxnCandidates, my method, my voicingThreshold, my octaveCost,
+				my maximumLag, my brent_ixmax, my brent_depth, r.peek(), imax.peek());
+			continue;
+		}
+		for (integer iframe = firstFrame; iframe <= lastFrame; iframe ++) {
+			const integer ibatch = iframe - firstFrame + 1;
+			localPeaks [ibatch] = Sound_into_PitchFrame_window (my sound, & my pitch -> frame [iframe],
+				Sampled_indexToX (my pitch, iframe), my method,
+				my nsamp_window, my halfnsamp_window, my nsampFFT, my nsamp_period, my halfnsamp_period,
+				my globalPeak, frames.horizontalBand ((ibatch - 1) * ny + 1, ibatch * ny), my window, localMean.peek());
+		}
+		/*
+		 * The FFT of the autocorrelation is the power spectrum.
+		 */
+		NUMfft_forward_batch (& fftTable, frames.horizontalBand (1, numberOfFramesInBatch * ny), my fftWorkspace.get());   // complex spectra
+		for (integer ibatch = 1; ibatch <= numberOfFramesInBatch; ibatch ++) {
+			VEC ac = acs [ibatch];
+			for (integer i = 1; i <= my nsampFFT; i ++) {
+				ac [i] = 0.0;
+			}
+			for (integer channel = 1; channel <= ny; channel ++) {
+				VEC frame = frames [(ibatch - 1) * ny + channel];
+				ac [1] += frame [1] * frame [1];   // DC component
+				for (integer i = 2; i < my nsampFFT; i += 2) {
+					ac [i] += frame [i] * frame [i] + frame [i+1] * frame [i+1];   // power spectrum
+				}
+				ac [my nsampFFT] += frame [my nsampFFT] * frame [my nsampFFT];   // Nyquist frequency
+			}
+		}
+		NUMfft_backward_batch (& fftTable, acs.horizontalBand (1, numberOfFramesInBatch), my fftWorkspace.get());   // autocorrelations
+		for (integer iframe = firstFrame; iframe <= lastFrame; iframe ++) {
+			const integer ibatch = iframe - firstFrame + 1;
+			Sound_into_PitchFrame_autocorrelationFromPowerSpectrum (acs [ibatch], my brent_ixmax, my windowR, r.peek());
+			Sound_into_PitchFrame_findCandidates (my sound, & my pitch -> frame [iframe], localPeaks [ibatch],
+				my minimumPitch, my maxnCandidates, my method, my voicingThreshold, my octaveCost,
+				my maximumLag, my brent_ixmax, my brent_depth, r.peek(), imax.peek());
+		}
 	}
 	MelderThread_RETURN;
 }
@@ -548,6 +587,8 @@ autoPitch Sound_to_Pitch_any (Sound me,
 				nsampFFT, nsamp_period, halfnsamp_period, brent_ixmax, brent_depth,
 				globalPeak, window.peek(), windowR.at,
 				ithread == numberOfThreads, & cancelled);
+			if (method < FCC_NORMAL)
+				args [ithread - 1] -> fftWorkspace = VECraw (NUMfft_getWorkspaceSize (nsampFFT));
 			firstFrame = lastFrame + 1;
 			lastFrame += numberOfFramesPerThread;
 		}
@@ -0,0 +1,212 @@
+/* SynthesisBatch.cpp
+ *
+ * Copyright (C) 2026 Praat developers
+ *
+ * This code is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this work. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SynthesisBatch.h"
+#include "MelderThread.h"
+
+Thing_implement (SynthesisBatchItem, Thing, 0);
+
+Thing_implement (SynthesisBatch, Thing, 0);
+
+autoSynthesisBatchItem structSynthesisBatch :: v_prepare (integer /* item */) {
+	Melder_throw (U"Nothing to synthesize.");
+}
+
+bool structSynthesisBatch :: v_synthesize (SynthesisBatchItem /* item */, NUMrandomStream * /* randomStream */) {
+	return false;
+}
+
+conststring32 structSynthesisBatch :: v_getItemName (integer item) {
+	return Melder_integer (item);
+}
+
+/*
+	The items are synthesized in parts of at most this many items per thread,
+	after each of which the main thread can show the progress and save the Sounds.
+*/
+#define SynthesisBatch_ITEMS_PER_THREAD_PER_PART  4
+
+Thing_define (SynthesisBatch_Args, Thing) {
+	public:
+		SynthesisBatch batch;
+		uint64 seed;
+		integer firstItem, lastItem;
+		std::vector <autoSynthesisBatchItem> *items;
+		integer failedItem;
+};
+
+Thing_implement (SynthesisBatch_Args, Thing, 0);
+
+static MelderThread_RETURN_TYPE SynthesisBatch_synthesize (SynthesisBatch_Args me) {
+	for (integer item = my firstItem; item <= my lastItem; item ++) {
+		NUMrandomStream randomStream (my seed, (uint64) item);
+		if (! my batch -> v_synthesize ((*my items) [(size_t) item - 1].get(), & randomStream)) {
+			my failedItem = item;   // the main thread reports it
+			break;
+		}
+	}
+	MelderThread_RETURN;
+}
+
+static int SynthesisBatch_getMaximumNumberOfThreads () {
+	return ( Melder_debug == 64 ? 1 : MelderThread_getNumberOfProcessors () );
+}
+
+/*
+	Prepares items firstItem .. lastItem into items [firstItem - 1] .. items [lastItem - 1] in the main thread,
+	then fills their Sounds in the threads.
+*/
+static void SynthesisBatch_synthesizePart (SynthesisBatch me, uint64 seed, integer firstItem, integer lastItem,
+	std::vector <autoSynthesisBatchItem>& items)
+{
+	for (integer item = firstItem; item <= lastItem; item ++) {
+		try {
+			items [(size_t) item - 1] = my v_prepare (item);
+		} catch (MelderError) {
+			Melder_throw (U"Item ", item, U" (", my v_getItemName (item), U") not synthesized.");
+		}
+	}
+	const integer numberOfItems = lastItem - firstItem + 1;
+	const integer numberOfThreads = std::min (numberOfItems, integer (SynthesisBatch_getMaximumNumberOfThreads ()));
+	std::vector <autoSynthesisBatch_Args> args ((size_t) numberOfThreads);
+	for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+		autoSynthesisBatch_Args arg = Thing_new (SynthesisBatch_Args);
+		arg -> batch = me;
+		arg -> seed = seed;
+		arg -> firstItem = firstItem + (ithread - 1) * numberOfItems / numberOfThreads;
+		arg -> lastItem = firstItem + ithread * numberOfItems / numberOfThreads - 1;
+		arg -> items = & items;
+		arg -> failedItem = 0;
+		args [(size_t) ithread - 1] = arg.move();
+	}
+	MelderThread_run (SynthesisBatch_synthesize, args.data(), (int) numberOfThreads);
+	my numberOfThreads = std::max (my numberOfThreads, int (numberOfThreads));
+	for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+		const integer failedItem = args [(size_t) ithread - 1] -> failedItem;
+		if (failedItem != 0)
+			Melder_throw (U"Item ", failedItem, U" (", my v_getItemName (failedItem), U") not synthesized.");
+	}
+	for (integer item = firstItem; item <= lastItem; item ++) {
+		Sound sound = items [(size_t) item - 1] -> sound.get();
+		my totalDuration += sound -> xmax - sound -> xmin;
+	}
+}
+
+static void SynthesisBatch_reset (SynthesisBatch me) {
+	my numberOfThreads = 0;
+	my synthesisTime = 0.0;
+	my totalDuration = 0.0;
+}
+
+static integer SynthesisBatch_getItemsPerPart () {
+	return SynthesisBatch_ITEMS_PER_THREAD_PER_PART * SynthesisBatch_getMaximumNumberOfThreads ();
+}
+
+void SynthesisBatch_to_Sound_TextGrid (SynthesisBatch me, autoSound *out_sound, autoTextGrid *out_textGrid) {
+	try {
+		Melder_require (my numberOfItems > 0,
+			U"There should be at least one item to synthesize.");
+		SynthesisBatch_reset (me);
+		const uint64 seed = NUMrandom_drawSeed ();
+		const double startingTime = Melder_clock ();
+		std::vector <autoSound> sounds ((size_t) my numberOfItems);
+		std::vector <autoSynthesisBatchItem> items ((size_t) my numberOfItems);
+		const integer itemsPerPart = SynthesisBatch_getItemsPerPart ();
+		autoMelderProgress progress (U"Synthesizing...");
+		for (integer firstItem = 1; firstItem <= my numberOfItems; firstItem += itemsPerPart) {
+			const integer lastItem = std::min (firstItem + itemsPerPart - 1, my numberOfItems);
+			SynthesisBatch_synthesizePart (me, seed, firstItem, lastItem, items);
+			for (integer item = firstItem; item <= lastItem; item ++) {
+				sounds [(size_t) item - 1] = items [(size_t) item - 1] -> sound.move();
+				items [(size_t) item - 1]. reset ();
+			}
+			Melder_progress ((double) lastItem / my numberOfItems,
+				U"Synthesized ", lastItem, U" of ", my numberOfItems, U" items.");
+		}
+		my synthesisTime = Melder_clock () - startingTime;
+
+		const integer numberOfChannels = sounds [0] -> ny;
+		const double dx = sounds [0] -> dx;
+		integer nx = 0;
+		for (integer item = 1; item <= my numberOfItems; item ++) {
+			Sound sound = sounds [(size_t) item - 1].get();
+			Melder_require (sound -> ny == numberOfChannels,
+				U"To concatenate the sounds, their numbers of channels should be equal. Item ", item, U" differs from item 1.");
+			Melder_require (sound -> dx == dx,
+				U"To concatenate the sounds, their sampling frequencies should be equal. Item ", item, U" differs from item 1.");
+			nx += sound -> nx;
+		}
+		autoSound thee = Sound_create (numberOfChannels, 0.0, nx * dx, nx, dx, 0.5 * dx);
+		autoTextGrid him = TextGrid_create (0.0, nx * dx, U"items", U"");
+		nx = 0;
+		for (integer item = 1; item <= my numberOfItems; item ++) {
+			Sound sound = sounds [(size_t) item - 1].get();
+			for (integer channel = 1; channel <= numberOfChannels; channel ++)
+				thy z.row (channel).part (nx + 1, nx + sound -> nx) <<= sound -> z.row (channel);
+			if (item > 1)
+				TextGrid_insertBoundary (him.get(), 1, nx * dx);
+			TextGrid_setIntervalText (him.get(), 1, item, my v_getItemName (item));
+			nx += sound -> nx;
+		}
+		*out_sound = thee.move();
+		*out_textGrid = him.move();
+	} catch (MelderError) {
+		Melder_throw (me, U": not synthesized.");
+	}
+}
+
+void SynthesisBatch_saveAsWavFiles (SynthesisBatch me, conststring32 folderPath) {
+	try {
+		Melder_require (my numberOfItems > 0,
+			U"There should be at least one item to synthesize.");
+		SynthesisBatch_reset (me);
+		const uint64 seed = NUMrandom_drawSeed ();
+		const double startingTime = Melder_clock ();
+		std::vector <autoSynthesisBatchItem> items ((size_t) my numberOfItems);
+		const integer itemsPerPart = SynthesisBatch_getItemsPerPart ();
+		autoMelderProgress progress (U"Synthesizing...");
+		for (integer firstItem = 1; firstItem <= my numberOfItems; firstItem += itemsPerPart) {
+			const integer lastItem = std::min (firstItem + itemsPerPart - 1, my numberOfItems);
+			SynthesisBatch_synthesizePart (me, seed, firstItem, lastItem, items);
+			for (integer item = firstItem; item <= lastItem; item ++) {
+				structMelderFile file { };
+				Melder_relativePathToFile (Melder_cat (folderPath, U"/", my v_getItemName (item), U".wav"), & file);
+				Sound_saveAsAudioFile (items [(size_t) item - 1] -> sound.get(), & file, Melder_WAV, 16);
+				items [(size_t) item - 1]. reset ();
+			}
+			Melder_progress ((double) lastItem / my numberOfItems,
+				U"Synthesized and saved ", lastItem, U" of ", my numberOfItems, U" items.");
+		}
+		my synthesisTime = Melder_clock () - startingTime;
+	} catch (MelderError) {
+		Melder_throw (me, U": not saved.");
+	}
+}
+
+void SynthesisBatch_infoThroughput (SynthesisBatch me) {
+	MelderInfo_open ();
+	MelderInfo_writeLine (my numberOfItems, U" items (", Melder_fixed (my totalDuration, 3),
+		U" seconds of sound) in ", Melder_fixed (my synthesisTime, 3), U" seconds with ", my numberOfThreads,
+		( my numberOfThreads == 1 ? U" thread" : U" threads" ));
+	if (my synthesisTime > 0.0)
+		MelderInfo_writeLine (U"Throughput: ", Melder_fixed (my numberOfItems / my synthesisTime, 1), U" items per second, ",
+			Melder_fixed (my totalDuration / my synthesisTime, 2), U" times real time");
+	MelderInfo_close ();
+}
+
+/* End of file SynthesisBatch.cpp */
@@ -0,0 +1,77 @@
+#ifndef _SynthesisBatch_h_
+#define _SynthesisBatch_h_
+/* SynthesisBatch.h
+ *
+ * Copyright (C) 2026 Praat developers
+ *
+ * This code is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this work. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Sound.h"
+#include "TextGrid.h"
+
+/*
+	The Sound of an item and whatever its synthesis needs, created in the main thread.
+*/
+Thing_define (SynthesisBatchItem, Thing) {
+	autoSound sound;
+};
+
+/*
+	A batch of syntheses, such as the steps of a stimulus continuum, done in threads.
+
+	Item `item` (1 .. numberOfItems) is prepared by v_prepare (item), in the main thread,
+	which creates its Sound (zero) and everything else that its synthesis needs, and may throw.
+	The samples are then filled by v_synthesize (item, randomStream), which is called from several threads at once.
+	It should therefore allocate nothing, throw nothing, change nothing that other items can see,
+	draw no graphics, show no progress, and take its random numbers from `randomStream` only;
+	it returns false if the item could not be synthesized.
+	The random stream is stream `item` of a seed that is drawn from the main stream when the batch starts,
+	so that the Sounds do not depend on the number of threads
+	(Debug option 64 synthesizes the items one by one, in the main thread).
+*/
+Thing_define (SynthesisBatch, Thing) {
+	integer numberOfItems;
+
+	/*
+		The throughput of the latest synthesis.
+	*/
+	int numberOfThreads;
+	double synthesisTime, totalDuration;
+
+	virtual autoSynthesisBatchItem v_prepare (integer item);
+	virtual bool v_synthesize (SynthesisBatchItem item, NUMrandomStream *randomStream);
+	virtual conststring32 v_getItemName (integer item);
+};
+
+/*
+	All the Sounds one after the other (they have to have the same sampling frequency),
+	with a TextGrid whose single tier labels each Sound with its item name, as in "Concatenate recoverably".
+*/
+void SynthesisBatch_to_Sound_TextGrid (SynthesisBatch me, autoSound *out_sound, autoTextGrid *out_textGrid);
+
+/*
+	Every Sound to the WAV file "<folderPath>/<item name>.wav".
+	A Sound is written and freed as soon as its part of the batch has been synthesized,
+	so that the memory does not grow with the number of items.
+*/
+void SynthesisBatch_saveAsWavFiles (SynthesisBatch me, conststring32 folderPath);
+
+/*
+	Writes the throughput of the latest synthesis to the Info window.
+*/
+void SynthesisBatch_infoThroughput (SynthesisBatch me);
+
+/* End of file SynthesisBatch.h */
+#endif
@@ -441,9 +441,10 @@ integer TextGrid_countIntervalsWhere (TextGrid me, integer tierNumber, kMelder_s
 	try {
 		integer count = 0;
 		IntervalTier tier = TextGrid_checkSpecifiedTierIsIntervalTier (me, tierNumber);
+		MelderStringMatcher matcher (which, criterion, true);
 		for (integer iinterval = 1; iinterval <= tier -> intervals.size; iinterval ++) {
 			TextInterval interval = tier -> intervals.at [iinterval];
-			if (Melder_stringMatchesCriterion (interval -> text.get(), which, criterion, true)) {
+			if (matcher. matches (interval -> text.get())) {
 				count ++;
 			}
 		}
@@ -457,9 +458,10 @@ integer TextGrid_countPointsWhere (TextGrid me, integer tierNumber, kMelder_stri
 	try {
 		integer count = 0;
 		TextTier tier = TextGrid_checkSpecifiedTierIsPointTier (me, tierNumber);
+		MelderStringMatcher matcher (which, criterion, true);
 		for (integer ipoint = 1; ipoint <= tier -> points.size; ipoint ++) {
 			TextPoint point = tier -> points.at [ipoint];
-			if (Melder_stringMatchesCriterion (point -> mark.get(), which, criterion, true)) {
+			if (matcher. matches (point -> mark.get())) {
 				count ++;
 			}
 		}
@@ -666,9 +668,10 @@ autoPointProcess TextGrid_getStartingPoints (TextGrid me, integer tierNumber, kM
 	try {
 		IntervalTier tier = TextGrid_checkSpecifiedTierIsIntervalTier (me, tierNumber);
 		autoPointProcess thee = PointProcess_create (my xmin, my xmax, 10);
+		MelderStringMatcher matcher (which, criterion, true);
 		for (integer iinterval = 1; iinterval <= tier -> intervals.size; iinterval ++) {
 			TextInterval interval = tier -> intervals.at [iinterval];
-			if (Melder_stringMatchesCriterion (interval -> text.get(), which, criterion, true)) {
+			if (matcher. matches (interval -> text.get())) {
 				PointProcess_addPoint (thee.get(), interval -> xmin);
 			}
 		}
@@ -682,9 +685,10 @@ autoPointProcess TextGrid_getEndPoints (TextGrid me, integer tierNumber, kMelder
 	try {
 		IntervalTier tier = TextGrid_checkSpecifiedTierIsIntervalTier (me, tierNumber);
 		autoPointProcess thee = PointProcess_create (my xmin, my xmax, 10);
+		MelderStringMatcher matcher (which, criterion, true);
 		for (integer iinterval = 1; iinterval <= tier -> intervals.size; iinterval ++) {
 			TextInterval interval = tier -> intervals.at [iinterval];
-			if (Melder_stringMatchesCriterion (interval -> text.get(), which, criterion, true)) {
+			if (matcher. matches (interval -> text.get())) {
 				PointProcess_addPoint (thee.get(), interval -> xmax);
 			}
 		}
@@ -698,9 +702,10 @@ autoPointProcess TextGrid_getCentrePoints (TextGrid me, integer tierNumber, kMel
 	try {
 		IntervalTier tier = TextGrid_checkSpecifiedTierIsIntervalTier (me, tierNumber);
 		autoPointProcess thee = PointProcess_create (my xmin, my xmax, 10);
+		MelderStringMatcher matcher (which, criterion, true);
 		for (integer iinterval = 1; iinterval <= tier -> intervals.size; iinterval ++) {
 			TextInterval interval = tier -> intervals.at [iinterval];
-			if (Melder_stringMatchesCriterion (interval -> text.get(), which, criterion, true)) {
+			if (matcher. matches (interval -> text.get())) {
 				PointProcess_addPoint (thee.get(), 0.5 * (interval -> xmin + interval -> xmax));
 			}
 		}
@@ -714,9 +719,10 @@ autoPointProcess TextGrid_getPoints (TextGrid me, integer tierNumber, kMelder_st
 	try {
 		TextTier tier = TextGrid_checkSpecifiedTierIsPointTier (me, tierNumber);
 		autoPointProcess thee = PointProcess_create (my xmin, my xmax, 10);
+		MelderStringMatcher matcher (which, criterion, true);
 		for (integer ipoint = 1; ipoint <= tier -> points.size; ipoint ++) {
 			TextPoint point = tier -> points.at [ipoint];
-			if (Melder_stringMatchesCriterion (point -> mark.get(), which, criterion, true)) {
+			if (matcher. matches (point -> mark.get())) {
 				PointProcess_addPoint (thee.get(), point -> number);
 			}
 		}
@@ -733,11 +739,12 @@ autoPointProcess TextGrid_getPoints_preceded (TextGrid me, integer tierNumber,
 	try {
 		TextTier tier = TextGrid_checkSpecifiedTierIsPointTier (me, tierNumber);
 		autoPointProcess thee = PointProcess_create (my xmin, my xmax, 10);
+		MelderStringMatcher matcher (which, criterion, true), matcher_precededBy (precededBy, criterion_precededBy, true);
 		for (integer ipoint = 1; ipoint <= tier -> points.size; ipoint ++) {
 			TextPoint point = tier -> points.at [ipoint];
-			if (Melder_stringMatchesCriterion (point -> mark.get(), which, criterion, true)) {
+			if (matcher. matches (point -> mark.get())) {
 				TextPoint preceding = ( ipoint <= 1 ? nullptr : tier -> points.at [ipoint - 1] );
-				if (Melder_stringMatchesCriterion (preceding -> mark.get(), precededBy, criterion_precededBy, true)) {
+				if (matcher_precededBy. matches (preceding -> mark.get())) {
 					PointProcess_addPoint (thee.get(), point -> number);
 				}
 			}
@@ -755,11 +762,12 @@ autoPointProcess TextGrid_getPoints_followed (TextGrid me, integer tierNumber,
 	try {
 		TextTier tier = TextGrid_checkSpecifiedTierIsPointTier (me, tierNumber);
 		autoPointProcess thee = PointProcess_create (my xmin, my xmax, 10);
+		MelderStringMatcher matcher (which, criterion, true), matcher_followedBy (followedBy, criterion_followedBy, true);
 		for (integer ipoint = 1; ipoint <= tier -> points.size; ipoint ++) {
 			TextPoint point = tier -> points.at [ipoint];
-			if (Melder_stringMatchesCriterion (point -> mark.get(), which, criterion, true)) {
+			if (matcher. matches (point -> mark.get())) {
 				TextPoint following = ( ipoint >= tier -> points.size ? nullptr : tier -> points.at [ipoint + 1] );
-				if (Melder_stringMatchesCriterion (following -> mark.get(), followedBy, criterion_followedBy, true)) {
+				if (matcher_followedBy. matches (following -> mark.get())) {
 					PointProcess_addPoint (thee.get(), point -> number);
 				}
 			}
@@ -1201,8 +1209,9 @@ void TextTier_removePoint (TextTier me, integer ipoint) {
 }
 
 void TextTier_removePoints (TextTier me, kMelder_string which, conststring32 criterion) {
+	MelderStringMatcher matcher (which, criterion, true);
 	for (integer i = my points.size; i > 0; i --)
-		if (Melder_stringMatchesCriterion (my points.at [i] -> mark.get(), which, criterion, true))
+		if (matcher. matches (my points.at [i] -> mark.get()))
 			my points. removeItem (i);
 }
 
@@ -1693,6 +1702,7 @@ autoTable TextGrid_downto_Table (TextGrid me, bool includeLineNumbers, int timeD
 
 autoTable TextGrid_tabulateOccurrences (TextGrid me, constVEC searchTiers, kMelder_string which, conststring32 criterion, bool caseSensitive) {
 	const int timeDecimals = 6;
+	MelderStringMatcher matcher (which, criterion, caseSensitive);
 	integer numberOfRows = 0;
 	for (integer itier = 1; itier <= searchTiers.size; itier ++) {
 		integer tierNumber = Melder_iround (searchTiers [itier]);
@@ -1702,7 +1712,7 @@ autoTable TextGrid_tabulateOccurrences (TextGrid me, constVEC searchTiers, kMeld
 			IntervalTier tier = static_cast <IntervalTier> (anyTier);
 			for (integer iinterval = 1; iinterval <= tier -> intervals.size; iinterval ++) {
 				TextInterval interval = tier -> intervals.at [iinterval];
-				if (Melder_stringMatchesCriterion (interval -> text.get(), which, criterion, caseSensitive)) {
+				if (matcher. matches (interval -> text.get())) {
 					numberOfRows ++;
 				}
 			}
@@ -1710,7 +1720,7 @@ autoTable TextGrid_tabulateOccurrences (TextGrid me, constVEC searchTiers, kMeld
 			TextTier tier = static_cast <TextTier> (anyTier);
 			for (integer ipoint = 1; ipoint <= tier -> points.size; ipoint ++) {
 				TextPoint point = tier -> points.at [ipoint];
-				if (Melder_stringMatchesCriterion (point -> mark.get(), which, criterion, caseSensitive)) {
+				if (matcher. matches (point -> mark.get())) {
 					numberOfRows ++;
 				}
 			}
@@ -1725,7 +1735,7 @@ autoTable TextGrid_tabulateOccurrences (TextGrid me, constVEC searchTiers, kMeld
 			IntervalTier tier = static_cast <IntervalTier> (anyTier);
 			for (integer iinterval = 1; iinterval <= tier -> intervals.size; iinterval ++) {
 				TextInterval interval = tier -> intervals.at [iinterval];
-				if (Melder_stringMatchesCriterion (interval -> text.get(), which, criterion, caseSensitive)) {
+				if (matcher. matches (interval -> text.get())) {
 					++ rowNumber;
 					Melder_assert (rowNumber <= numberOfRows);
 					double time = 0.5 * (interval -> xmin + interval -> xmax);
@@ -1738,7 +1748,7 @@ autoTable TextGrid_tabulateOccurrences (TextGrid me, constVEC searchTiers, kMeld
 			TextTier tier = static_cast <TextTier> (anyTier);
 			for (integer ipoint = 1; ipoint <= tier -> points.size; ipoint ++) {
 				TextPoint point = tier -> points.at [ipoint];
-				if (Melder_stringMatchesCriterion (point -> mark.get(), which, criterion, caseSensitive)) {
+				if (matcher. matches (point -> mark.get())) {
 					++ rowNumber;
 					Melder_assert (rowNumber <= numberOfRows);
 					double time = point -> number;
@@ -1338,12 +1338,13 @@ static void do_drawIntervalTier (TextGridEditor me, IntervalTier tier, integer i
 	 * Highlight interval: yellow (selected) or green (matching label).
 	 */
 	
+	MelderStringMatcher greenMatcher (my p_greenMethod, my p_greenString, true);
 	for (iinterval = 1; iinterval <= ninterval; iinterval ++) {
 		TextInterval interval = tier -> intervals.at [iinterval];
 		double tmin = interval -> xmin, tmax = interval -> xmax;
 		if (tmax > my startWindow && tmin < my endWindow) {   // interval visible?
 			int intervalIsSelected = iinterval == selectedInterval;
-			int labelMatches = Melder_stringMatchesCriterion (interval -> text.get(), my p_greenMethod, my p_greenString, true);
+			int labelMatches = greenMatcher. matches (interval -> text.get());
 			if (tmin < my startWindow)
 				tmin = my startWindow;
 			if (tmax > my endWindow)
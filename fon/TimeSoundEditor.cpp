@@ -463,9 +463,11 @@ void TimeSoundEditor_drawSound (TimeSoundEditor me, double globalMinimum, double
 	integer numberOfChannels = ( sound ? sound -> ny : longSound -> numberOfChannels );
 	bool cursorVisible = my startSelection == my endSelection && my startSelection >= my startWindow && my startSelection <= my endWindow;
 	Graphics_setColour (my graphics.get(), Graphics_BLACK);
-	bool fits;
+	bool fits, haveEnvelope = false;
 	try {
 		fits = sound ? true : LongSound_haveWindow (longSound, my startWindow, my endWindow);
+		if (! fits && Melder_debug != 65)
+			haveEnvelope = !! LongSound_haveEnvelope (longSound);   // a window that exceeds the buffer is drawn from the envelope
 	} catch (MelderError) {
 		bool outOfMemory = !! str32str (Melder_getError (), U"memory");
 		if (Melder_debug == 9) Melder_flushError (); else Melder_clearError ();
@@ -474,7 +476,7 @@ void TimeSoundEditor_drawSound (TimeSoundEditor me, double globalMinimum, double
 		Graphics_text (my graphics.get(), 0.5, 0.5, outOfMemory ? U"(out of memory)" : U"(cannot read sound file)");
 		return;
 	}
-	if (! fits) {
+	if (! fits && ! haveEnvelope) {   // Debug option 65, or the user cancelled the envelope
 		Graphics_setWindow (my graphics.get(), 0.0, 1.0, 0.0, 1.0);
 		Graphics_setTextAlignment (my graphics.get(), Graphics_CENTRE, Graphics_HALF);
 		Graphics_text (my graphics.get(), 0.5, 0.5, U"(window too large; zoom in to see the data)");
@@ -632,11 +634,15 @@ void TimeSoundEditor_drawSound (TimeSoundEditor me, double globalMinimum, double
 			Graphics_setColour (my graphics.get(), Graphics_BLACK);
 			Graphics_function (my graphics.get(), & sound -> z [ichan] [0], first, last,
 				Sampled_indexToX (sound, first), Sampled_indexToX (sound, last));
-		} else {
+		} else if (fits) {
 			Graphics_setWindow (my graphics.get(), my startWindow, my endWindow, minimum * 32768, maximum * 32768);
 			Graphics_function16 (my graphics.get(),
 				longSound -> buffer - longSound -> imin * numberOfChannels + (ichan - 1), numberOfChannels - 1, first, last,
 				Sampled_indexToX (longSound, first), Sampled_indexToX (longSound, last));
+		} else {
+			Graphics_setWindow (my graphics.get(), my startWindow, my endWindow, minimum, maximum);
+			SoundEnvelope_drawChannel (longSound -> envelope.get(), my graphics.get(), ichan, first, last, constVEC (),
+				Sampled_indexToX (longSound, first), Sampled_indexToX (longSound, last));
 		}
 		Graphics_resetViewport (my graphics.get(), vp);
 	}
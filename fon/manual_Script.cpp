@@ -862,6 +862,11 @@ TAG (U"##randomGauss (%\\mu, %\\si)")
 DEFINITION (U"Gaussian random real number with mean %\\mu and standard deviation %\\si")
 TAG (U"##randomPoisson (%mean)")
 DEFINITION (U"Poisson random real number")
+TAG (U"##random_initializeWithSeedUnsafelyButPredictably (%seed)")
+DEFINITION (U"makes all subsequent random numbers (also those in simulations such as @@OTGrammar: To output Distributions...@) "
+	"reproducible, for instance for testing; the seed is an integer")
+TAG (U"##random_initializeSafelyAndUnpredictably ()")
+DEFINITION (U"undoes the effect of $random_initializeWithSeedUnsafelyButPredictably")
 TAG (U"##lnGamma (%x)")
 DEFINITION (U"logarithm of the \\Ga function")
 TAG (U"##gaussP (%z)")
@@ -298,6 +298,8 @@ LIST_ITEM1 (U"\\bu @@Sound: To LPC (marple)...")
 NORMAL (U"Filtering (see @Filtering tutorial):")
 LIST_ITEM (U"\\bu @@Sound: Filter (pass Hann band)...")
 LIST_ITEM (U"\\bu @@Sound: Filter (stop Hann band)...")
+LIST_ITEM (U"\\bu @@Sound: Filter (pass Hann band, FIR)...")
+LIST_ITEM (U"\\bu @@Sound: Filter (stop Hann band, FIR)...")
 LIST_ITEM (U"\\bu @@Sound: Filter (formula)...")
 LIST_ITEM (U"\\bu @@Sound: Filter (one formant)...")
 LIST_ITEM (U"\\bu @@Sound: Filter (pre-emphasis)...")
@@ -650,6 +652,18 @@ LIST_ITEM (U"2. @@Spectrum: Filter (pass Hann band)...")
 LIST_ITEM (U"3. @@Spectrum: To Sound")
 NORMAL (U"For a comparative discussion of various filtering methods, see the @Filtering tutorial.")
 NORMAL (U"For a complementary filter, see @@Sound: Filter (stop Hann band)...@.")
+NORMAL (U"For long sounds, @@Sound: Filter (pass Hann band, FIR)...@ is faster.")
+MAN_END
+
+MAN_BEGIN (U"Sound: Filter (pass Hann band, FIR)...", U"ppgb", 20261018)
+INTRO (U"A command to convert every selected @Sound object into a filtered sound, "
+	"approximately as @@Sound: Filter (pass Hann band)...@ does.")
+NORMAL (U"The filtering is done in the time domain, by convolution with a finite impulse response "
+	"that has the Hann-band response and is cut off at 40 / %smoothing seconds on either side; "
+	"the channels are filtered in parallel. For long sounds, this is much faster than a transform of the whole sound.")
+NORMAL (U"The result differs slightly from that of @@Sound: Filter (pass Hann band)...@, "
+	"especially near the start and end of the sound, where the transform of the whole sound wraps around. "
+	"For short sounds, the result is the same.")
 MAN_END
 
 MAN_BEGIN (U"Sound: Filter (stop Hann band)...", U"ppgb", 20041123)
@@ -660,6 +674,14 @@ LIST_ITEM (U"2. @@Spectrum: Filter (stop Hann band)...")
 LIST_ITEM (U"3. @@Spectrum: To Sound")
 NORMAL (U"For a comparative discussion of various filtering methods, see the @Filtering tutorial.")
 NORMAL (U"For a complementary filter, see @@Sound: Filter (pass Hann band)...@.")
+NORMAL (U"For long sounds, @@Sound: Filter (stop Hann band, FIR)...@ is faster.")
+MAN_END
+
+MAN_BEGIN (U"Sound: Filter (stop Hann band, FIR)...", U"ppgb", 20261018)
+INTRO (U"A command to convert every selected @Sound object into a filtered sound, "
+	"approximately as @@Sound: Filter (stop Hann band)...@ does.")
+NORMAL (U"The filtering is done in the time domain, as in @@Sound: Filter (pass Hann band, FIR)...@, "
+	"with the same differences from the transform of the whole sound.")
 MAN_END
 
 MAN_BEGIN (U"Sound: Formula...", U"ppgb", 20021206)
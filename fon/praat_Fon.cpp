@@ -1306,9 +1306,11 @@ DIRECT (NEW_Manipulation_getResynthesis_lpc) {
 }
 
 DIRECT (NEW_Manipulation_getResynthesis_overlapAdd) {
-	CONVERT_EACH (Manipulation)
-		autoSound result = Manipulation_to_Sound (me, Manipulation_OVERLAPADD);
-	CONVERT_EACH_END (my name.get())
+	FIND_LIST (Manipulation)
+		std::vector <autoSound> results = Manipulations_to_Sounds_overlapAdd (& list);
+		for (integer i = 1; i <= list.size; i ++)
+			praat_new (results [(size_t) i - 1].move(), list.at [i] -> name.get());
+	END
 }
 
 DIRECT (HELP_Manipulation_help) {
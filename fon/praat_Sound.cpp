@@ -782,7 +782,18 @@ FORM (NEW_Sound_filter_passHannBand, U"Sound: Filter (pass Hann band)", U"Sound:
 	OK
 DO
 	CONVERT_EACH (Sound)
-		autoSound result = Sound_filter_passHannBand (me, fromFrequency, toFrequency, smoothing);
+		autoSound result = Sound_filter_passHannBand (me, fromFrequency, toFrequency, smoothing, false);
+	CONVERT_EACH_END (my name.get(), U"_band")
+}
+
+FORM (NEW_Sound_filter_passHannBand_fir, U"Sound: Filter (pass Hann band, FIR)", U"Sound: Filter (pass Hann band, FIR)...") {
+	REAL (fromFrequency, U"From frequency (Hz)", U"500.0")
+	REAL (toFrequency, U"To frequency (Hz)", U"1000.0")
+	POSITIVE (smoothing, U"Smoothing (Hz)", U"100.0")
+	OK
+DO
+	CONVERT_EACH (Sound)
+		autoSound result = Sound_filter_passHannBand (me, fromFrequency, toFrequency, smoothing, true);
 	CONVERT_EACH_END (my name.get(), U"_band")
 }
 
@@ -802,7 +813,18 @@ FORM (NEW_Sound_filter_stopHannBand, U"Sound: Filter (stop Hann band)", U"Sound:
 	OK
 DO
 	CONVERT_EACH (Sound)
-		autoSound result = Sound_filter_stopHannBand (me, fromFrequency, toFrequency, smoothing);
+		autoSound result = Sound_filter_stopHannBand (me, fromFrequency, toFrequency, smoothing, false);
+	CONVERT_EACH_END (my name.get(), U"_band")
+}
+
+FORM (NEW_Sound_filter_stopHannBand_fir, U"Sound: Filter (stop Hann band, FIR)", U"Sound: Filter (stop Hann band, FIR)...") {
+	REAL (fromFrequency, U"From frequency (Hz)", U"500.0")
+	REAL (toFrequency, U"To frequency (Hz)", U"1000.0")
+	POSITIVE (smoothing, U"Smoothing (Hz)", U"100.0")
+	OK
+DO
+	CONVERT_EACH (Sound)
+		autoSound result = Sound_filter_stopHannBand (me, fromFrequency, toFrequency, smoothing, true);
 	CONVERT_EACH_END (my name.get(), U"_band")
 }
 
@@ -2382,6 +2404,8 @@ void praat_Sound_init () {
 		praat_addAction1 (classSound, 0, U"-- frequency-domain filter --", nullptr, 1, nullptr);
 		praat_addAction1 (classSound, 0, U"Filter (pass Hann band)...", nullptr, 1, NEW_Sound_filter_passHannBand);
 		praat_addAction1 (classSound, 0, U"Filter (stop Hann band)...", nullptr, 1, NEW_Sound_filter_stopHannBand);
+		praat_addAction1 (classSound, 0, U"Filter (pass Hann band, FIR)...", nullptr, 1, NEW_Sound_filter_passHannBand_fir);
+		praat_addAction1 (classSound, 0, U"Filter (stop Hann band, FIR)...", nullptr, 1, NEW_Sound_filter_stopHannBand_fir);
 		praat_addAction1 (classSound, 0, U"Filter (formula)...", nullptr, 1, NEW_Sound_filter_formula);
 		praat_addAction1 (classSound, 0, U"-- time-domain filter --", nullptr, 1, nullptr);
 		praat_addAction1 (classSound, 0, U"Filter (one formant)...", nullptr, 1, NEW_Sound_filter_oneFormant);
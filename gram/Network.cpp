@@ -28,6 +28,7 @@
  */
 
 #include "Network.h"
+#include "MelderThread.h"
 
 #include "oo_DESTROY.h"
 #include "Network_def.h"
@@ -163,7 +164,29 @@ void Network_setClamping (Network me, integer nodeNumber, bool clamped) {
 	}
 }
 
-void Network_spreadActivities (Network me, integer numberOfSteps) {
+static double Network_clipActivity (Network me, double excitation) {
+	switch (my activityClippingRule) {
+		case kNetwork_activityClippingRule::SIGMOID:
+			return my minimumActivity +
+				(my maximumActivity - my minimumActivity) * NUMsigmoid (excitation - 0.5 * (my minimumActivity + my maximumActivity));
+		case kNetwork_activityClippingRule::LINEAR:
+			if (excitation < my minimumActivity)
+				return my minimumActivity;
+			else if (excitation > my maximumActivity)
+				return my maximumActivity;
+			else
+				return excitation;
+		case kNetwork_activityClippingRule::TOP_SIGMOID:
+			if (excitation <= my minimumActivity)
+				return my minimumActivity;
+			else
+				return my minimumActivity +
+					(my maximumActivity - my minimumActivity) * (2.0 * NUMsigmoid (2.0 * (excitation - my minimumActivity) / (my maximumActivity - my minimumActivity)) - 1.0);
+	}
+	return excitation;   // unreachable
+}
+
+static void Network_spreadActivities_connectionByConnection (Network me, integer numberOfSteps) {
 	for (integer istep = 1; istep <= numberOfSteps; istep ++) {
 		for (integer inode = 1; inode <= my numberOfNodes; inode ++) {
 			NetworkNode node = & my nodes [inode];
@@ -182,33 +205,161 @@ void Network_spreadActivities (Network me, integer numberOfSteps) {
 		}
 		for (integer inode = 1; inode <= my numberOfNodes; inode ++) {
 			NetworkNode node = & my nodes [inode];
-			if (! node -> clamped) {
-				switch (my activityClippingRule) {
-					case kNetwork_activityClippingRule::SIGMOID:
-						node -> activity = my minimumActivity +
-							(my maximumActivity - my minimumActivity) * NUMsigmoid (node -> excitation - 0.5 * (my minimumActivity + my maximumActivity));
-					break;
-					case kNetwork_activityClippingRule::LINEAR:
-						if (node -> excitation < my minimumActivity) {
-							node -> activity = my minimumActivity;
-						} else if (node -> excitation > my maximumActivity) {
-							node -> activity = my maximumActivity;
-						} else {
-							node -> activity = node -> excitation;
-						}
-					break;
-					case kNetwork_activityClippingRule::TOP_SIGMOID:
-						if (node -> excitation <= my minimumActivity) {
-							node -> activity = my minimumActivity;
-						} else {
-							node -> activity = my minimumActivity +
-								(my maximumActivity - my minimumActivity) * (2.0 * NUMsigmoid (2.0 * (node -> excitation - my minimumActivity) / (my maximumActivity - my minimumActivity)) - 1.0);
-							trace (U"excitation ", node -> excitation, U", activity ", node -> activity);
-						}
-					break;
-				}
-			}
+			if (! node -> clamped)
+				node -> activity = Network_clipActivity (me, node -> excitation);
+		}
+	}
+}
+
+static void Network_updateIncidence (Network me) {
+	if (my incidenceStart.size == my numberOfNodes + 1 && my incidentConnections.size == 2 * my numberOfConnections)
+		return;   // up to date
+	autoINTVEC incidenceStart = INTVECzero (my numberOfNodes + 1);
+	for (integer iconn = 1; iconn <= my numberOfConnections; iconn ++) {
+		const NetworkConnection connection = & my connections [iconn];
+		Melder_require (connection -> nodeFrom >= 1 && connection -> nodeFrom <= my numberOfNodes &&
+				connection -> nodeTo >= 1 && connection -> nodeTo <= my numberOfNodes,
+			me, U": connection ", iconn, U" refers to a node that does not exist.");
+		incidenceStart [connection -> nodeFrom] += 1;
+		incidenceStart [connection -> nodeTo] += 1;
+	}
+	/*
+		Turn the counts into starting positions.
+	*/
+	integer position = 1;
+	for (integer inode = 1; inode <= my numberOfNodes + 1; inode ++) {
+		const integer count = incidenceStart [inode];
+		incidenceStart [inode] = position;
+		position += count;
+	}
+	autoINTVEC incidentConnections = INTVECraw (2 * my numberOfConnections);
+	autoINTVEC incidentNodes = INTVECraw (2 * my numberOfConnections);
+	autoINTVEC fill = INTVECcopy (incidenceStart.get());
+	for (integer iconn = 1; iconn <= my numberOfConnections; iconn ++) {
+		const NetworkConnection connection = & my connections [iconn];
+		integer k = fill [connection -> nodeFrom] ++;
+		incidentConnections [k] = iconn;
+		incidentNodes [k] = connection -> nodeTo;
+		k = fill [connection -> nodeTo] ++;
+		incidentConnections [k] = iconn;
+		incidentNodes [k] = connection -> nodeFrom;
+	}
+	my incidenceStart = incidenceStart.move();
+	my incidentConnections = incidentConnections.move();
+	my incidentNodes = incidentNodes.move();
+}
+
+/*
+	Below this number of connections, threads cost more than they save.
+*/
+#define Network_MINIMUM_CONNECTIONS_PER_THREAD  20000
+
+static integer Network_getNumberOfThreads (Network me) {
+	if (Melder_debug == 58)
+		return 1;
+	return std::max (integer (1), std::min (my numberOfConnections / Network_MINIMUM_CONNECTIONS_PER_THREAD,
+			integer (MelderThread_getNumberOfProcessors ())));
+}
+
+/*
+	One step of activity spreading for the nodes firstNode through lastNode.
+	The excitation of a node changes only through its own connections, and in the order of their connection numbers,
+	just as in Network_spreadActivities_connectionByConnection (the shunting term makes this order matter);
+	the activities of the other nodes are those of the previous step, so they are read from `activities`
+	while the new activities are written into `newActivities`.
+	Thus every node can be done independently, and the results are identical to those of spreading connection by connection.
+*/
+Thing_define (Network_spread_Args, Thing) { public:
+	Network network;
+	integer firstNode, lastNode;
+	constBOOLVEC clamped;
+	VEC excitations;
+	constVEC activities;
+	VEC newActivities;
+};
+
+Thing_implement (Network_spread_Args, Thing, 0);
+
+static MelderThread_RETURN_TYPE Network_spread (Network_spread_Args me) {
+	Network network = my network;
+	const double spreadingRate = network -> spreadingRate, activityLeak = network -> activityLeak, excitatoryShunting = network -> shunting;
+	const integer *incidenceStart = & network -> incidenceStart [0];
+	const integer *incidentConnections = & network -> incidentConnections [0], *incidentNodes = & network -> incidentNodes [0];
+	const structNetworkConnection *connections = & network -> connections [0];
+	const bool *clamped = & my clamped [0];
+	const double *activities = & my activities [0];
+	double *excitations = & my excitations [0], *newActivities = & my newActivities [0];
+	for (integer inode = my firstNode; inode <= my lastNode; inode ++) {
+		if (clamped [inode]) {
+			newActivities [inode] = activities [inode];
+			continue;
+		}
+		double excitation = excitations [inode];
+		excitation -= spreadingRate * activityLeak * excitation;
+		for (integer k = incidenceStart [inode]; k < incidenceStart [inode + 1]; k ++) {
+			const double weight = connections [incidentConnections [k]]. weight;
+			const double shunting = weight >= 0.0 ? excitatoryShunting : 0.0;   // only for excitatory connections
+			excitation += spreadingRate * activities [incidentNodes [k]] * (weight - shunting * excitation);
+		}
+		excitations [inode] = excitation;
+		newActivities [inode] = Network_clipActivity (network, excitation);
+	}
+	MelderThread_RETURN;
+}
+
+void Network_spreadActivities (Network me, integer numberOfSteps) {
+	if (Melder_debug == 58) {
+		Network_spreadActivities_connectionByConnection (me, numberOfSteps);
+		return;
+	}
+	if (numberOfSteps < 1 || my numberOfNodes < 1)
+		return;
+	Network_updateIncidence (me);
+	/*
+		The node state as a structure of arrays, with two buffers for the activities.
+	*/
+	autoBOOLVEC clamped = BOOLVECraw (my numberOfNodes);
+	autoVEC excitations = VECraw (my numberOfNodes);
+	autoVEC activities = VECraw (my numberOfNodes), newActivities = VECraw (my numberOfNodes);
+	for (integer inode = 1; inode <= my numberOfNodes; inode ++) {
+		clamped [inode] = my nodes [inode]. clamped;
+		excitations [inode] = my nodes [inode]. excitation;
+		activities [inode] = my nodes [inode]. activity;
+	}
+	/*
+		Give every thread about the same number of connections.
+	*/
+	const integer numberOfThreads = std::min (Network_getNumberOfThreads (me), my numberOfNodes);
+	std::vector <autoNetwork_spread_Args> args ((size_t) numberOfThreads);
+	integer firstNode = 1;
+	for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+		autoNetwork_spread_Args arg = Thing_new (Network_spread_Args);
+		arg -> network = me;
+		arg -> clamped = clamped.get();
+		arg -> excitations = excitations.get();
+		integer lastNode = my numberOfNodes;
+		if (ithread < numberOfThreads) {
+			const integer nextThreadStart = 1 + ithread * 2 * my numberOfConnections / numberOfThreads;   // in the incidence lists
+			lastNode = firstNode - 1;
+			while (lastNode < my numberOfNodes && my incidenceStart [lastNode + 1] < nextThreadStart)
+				lastNode ++;
+		}
+		arg -> firstNode = firstNode;
+		arg -> lastNode = lastNode;   // may be firstNode - 1
+		firstNode = lastNode + 1;
+		args [(size_t) ithread - 1] = arg.move();
+	}
+	for (integer istep = 1; istep <= numberOfSteps; istep ++) {
+		for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+			args [(size_t) ithread - 1] -> activities = activities.get();
+			args [(size_t) ithread - 1] -> newActivities = newActivities.get();
 		}
+		MelderThread_run (Network_spread, args.data(), (int) numberOfThreads);
+		std::swap (activities, newActivities);
+	}
+	for (integer inode = 1; inode <= my numberOfNodes; inode ++) {
+		my nodes [inode]. excitation = excitations [inode];
+		my nodes [inode]. activity = activities [inode];
 	}
 }
 
@@ -238,16 +389,43 @@ void Network_normalizeActivities (Network me, integer nodeMin, integer nodeMax)
 	}	
 }
 
+Thing_define (Network_updateWeights_Args, Thing) { public:
+	Network network;
+	integer firstConnection, lastConnection;
+};
+
+Thing_implement (Network_updateWeights_Args, Thing, 0);
+
+static MelderThread_RETURN_TYPE Network_updateWeights_part (Network_updateWeights_Args me) {
+	Network network = my network;
+	for (integer iconn = my firstConnection; iconn <= my lastConnection; iconn ++) {
+		NetworkConnection connection = & network -> connections [iconn];
+		NetworkNode nodeFrom = & network -> nodes [connection -> nodeFrom];
+		NetworkNode nodeTo = & network -> nodes [connection -> nodeTo];
+		connection -> weight += connection -> plasticity * network -> learningRate *
+			(nodeFrom -> activity * nodeTo -> activity - (network -> instar * nodeTo -> activity + network -> outstar * nodeFrom -> activity + network -> weightLeak) * connection -> weight);
+		if (connection -> weight < network -> minimumWeight) connection -> weight = network -> minimumWeight;
+		else if (connection -> weight > network -> maximumWeight) connection -> weight = network -> maximumWeight;
+	}
+	MelderThread_RETURN;
+}
+
 void Network_updateWeights (Network me) {
-	for (integer iconn = 1; iconn <= my numberOfConnections; iconn ++) {
-		NetworkConnection connection = & my connections [iconn];
-		NetworkNode nodeFrom = & my nodes [connection -> nodeFrom];
-		NetworkNode nodeTo = & my nodes [connection -> nodeTo];
-		connection -> weight += connection -> plasticity * my learningRate *
-			(nodeFrom -> activity * nodeTo -> activity - (my instar * nodeTo -> activity + my outstar * nodeFrom -> activity + my weightLeak) * connection -> weight);
-		if (connection -> weight < my minimumWeight) connection -> weight = my minimumWeight;
-		else if (connection -> weight > my maximumWeight) connection -> weight = my maximumWeight;
+	if (my numberOfConnections < 1)
+		return;
+	/*
+		Every connection is updated independently of the others.
+	*/
+	const integer numberOfThreads = Network_getNumberOfThreads (me);
+	std::vector <autoNetwork_updateWeights_Args> args ((size_t) numberOfThreads);
+	for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+		autoNetwork_updateWeights_Args arg = Thing_new (Network_updateWeights_Args);
+		arg -> network = me;
+		arg -> firstConnection = 1 + (ithread - 1) * my numberOfConnections / numberOfThreads;
+		arg -> lastConnection = ithread * my numberOfConnections / numberOfThreads;
+		args [(size_t) ithread - 1] = arg.move();
 	}
+	MelderThread_run (Network_updateWeights_part, args.data(), (int) numberOfThreads);
 }
 
 void Network_normalizeWeights (Network me, integer nodeMin, integer nodeMax, integer nodeFromMin, integer nodeFromMax, double newSum) {
@@ -101,6 +101,14 @@ oo_DEFINE_CLASS (Network, Daata)
 	oo_STRUCT_VECTOR (NetworkConnection, connections, numberOfConnections)
 
 	#if oo_DECLARING
+		/*
+			The connections of each node, in compressed-sparse-row form, for Network_spreadActivities:
+			the connections of node `inode` are incidentConnections [incidenceStart [inode] .. incidenceStart [inode + 1] - 1],
+			in the order of their connection numbers, and the nodes at their other ends are in incidentNodes.
+			Neither copied nor written; built when needed, and rebuilt when nodes or connections have been added.
+		*/
+		autoINTVEC incidenceStart, incidentConnections, incidentNodes;
+
 		void v_info ()
 			override;
 	#endif
@@ -73,6 +73,7 @@
  */
 
 #include "OTGrammar.h"
+#include "MelderThread.h"
 
 #include "oo_DESTROY.h"
 #include "OTGrammar_def.h"
@@ -1048,7 +1049,269 @@ autoStrings OTGrammar_inputToOutputs (OTGrammar me, conststring32 input, integer
 	}
 }
 
-autoDistributions OTGrammar_to_Distribution (OTGrammar me, integer trialsPerInput, double noise) {
+/*
+	Monte-Carlo simulation of evaluations, in parallel.
+	Every thread has its own copy of the disharmonies, so that the grammar itself does not change.
+	The trials are divided over a fixed number of parts, each with its own counter-based random stream
+	(stream number = part number, with one seed drawn from the main stream),
+	so that for a given seed the results do not depend on the number of threads.
+*/
+
+#define OTGrammar_NUMBER_OF_PARTS  16
+#define OTGrammar_MINIMUM_EVALUATIONS_PER_THREAD  2000
+
+Thing_define (OTGrammar_simulate_Args, Thing) { public:
+	OTGrammar grammar;
+	double noise;
+	uint64 seed;
+	integer firstPart, lastPart;
+	/*
+		The work: either a number of trials for every tableau,
+		or a number of inputs drawn from a pair distribution.
+	*/
+	integer trialsPerInput;
+	constINTVEC tableauOffsets;
+	integer numberOfInputs;
+	constVEC cumulativeWeights;
+	constINTVEC pairTableaus, pairOffsets;
+	constBOOLVEC candidateIsCorrect;
+	/*
+		The results.
+	*/
+	autoINTVEC numberOfWins;   // for every output of every tableau
+	integer numberOfCorrect;
+	/*
+		The buffers for one evaluation.
+	*/
+	NUMrandomStream random { 0, 0 };
+	autoVEC disharmonies, weights, harmonies;
+	autoINTVEC survivors, survivorMarks, group;
+	autoBOOLVEC used;
+
+	void newDisharmonies () {
+		for (integer icons = 1; icons <= grammar -> numberOfConstraints; icons ++)
+			disharmonies [icons] = grammar -> constraints [icons]. ranking + random. gauss (0, noise);
+	}
+	integer getWinner (integer itab);
+};
+Thing_implement (OTGrammar_simulate_Args, Thing, 0);
+
+/*
+	The same winner as OTGrammar_getWinner () would choose, but without sorting the constraints:
+	in strict ranking, the constraints are visited from the highest to the lowest disharmony
+	only until a single candidate survives.
+*/
+integer structOTGrammar_simulate_Args :: getWinner (integer itab) {
+	const OTGrammarTableau tableau = & grammar -> tableaus [itab];
+	const integer numberOfConstraints = grammar -> numberOfConstraints;
+	integer numberOfSurvivors = tableau -> numberOfCandidates;
+	for (integer icand = 1; icand <= numberOfSurvivors; icand ++)
+		survivors [icand] = icand;
+	const kOTGrammar_decisionStrategy decisionStrategy = grammar -> decisionStrategy;
+	if (decisionStrategy == kOTGrammar_decisionStrategy::OPTIMALITY_THEORY) {
+		for (integer icons = 1; icons <= numberOfConstraints; icons ++)
+			used [icons] = false;
+		integer numberOfUsedConstraints = 0;
+		while (numberOfSurvivors > 1 && numberOfUsedConstraints < numberOfConstraints) {
+			/*
+				Find the highest-ranked constraint that is still unused,
+				together with the constraints tied to it (they count as one).
+			*/
+			integer highest = 0;
+			for (integer icons = 1; icons <= numberOfConstraints; icons ++)
+				if (! used [icons] && (highest == 0 || disharmonies [icons] > disharmonies [highest]))
+					highest = icons;
+			integer groupSize = 0;
+			for (integer icons = highest; icons <= numberOfConstraints; icons ++) {
+				if (! used [icons] && disharmonies [icons] == disharmonies [highest]) {
+					used [icons] = true;
+					group [++ groupSize] = icons;
+				}
+			}
+			numberOfUsedConstraints += groupSize;
+			/*
+				Keep only the candidates with the fewest marks.
+			*/
+			integer fewestMarks = INTEGER_MAX;
+			for (integer isurvivor = 1; isurvivor <= numberOfSurvivors; isurvivor ++) {
+				const INTVEC marks = tableau -> candidates [survivors [isurvivor]]. marks.get();
+				integer numberOfMarks = 0;
+				for (integer igroup = 1; igroup <= groupSize; igroup ++)
+					numberOfMarks += marks [group [igroup]];
+				survivorMarks [isurvivor] = numberOfMarks;
+				if (numberOfMarks < fewestMarks)
+					fewestMarks = numberOfMarks;
+			}
+			integer numberOfBest = 0;
+			for (integer isurvivor = 1; isurvivor <= numberOfSurvivors; isurvivor ++)
+				if (survivorMarks [isurvivor] == fewestMarks)
+					survivors [++ numberOfBest] = survivors [isurvivor];
+			numberOfSurvivors = numberOfBest;
+		}
+	} else {
+		for (integer icons = 1; icons <= numberOfConstraints; icons ++) {
+			const double disharmony = disharmonies [icons];
+			weights [icons] =
+				decisionStrategy == kOTGrammar_decisionStrategy::EXPONENTIAL_HG ||
+				decisionStrategy == kOTGrammar_decisionStrategy::EXPONENTIAL_MAXIMUM_ENTROPY ? exp (disharmony) :
+				decisionStrategy == kOTGrammar_decisionStrategy::LINEAR_OT ? ( disharmony > 0.0 ? disharmony : 0.0 ) :
+				decisionStrategy == kOTGrammar_decisionStrategy::POSITIVE_HG ? ( disharmony > 1.0 ? disharmony : 1.0 ) :
+				disharmony;
+		}
+		if (decisionStrategy == kOTGrammar_decisionStrategy::MAXIMUM_ENTROPY ||
+			decisionStrategy == kOTGrammar_decisionStrategy::EXPONENTIAL_MAXIMUM_ENTROPY)
+		{
+			/*
+				As in _OTGrammar_fillInHarmonies () and _OTGrammar_fillInProbabilities ().
+			*/
+			double maximumHarmony = undefined;
+			for (integer icand = 1; icand <= tableau -> numberOfCandidates; icand ++) {
+				const INTVEC marks = tableau -> candidates [icand]. marks.get();
+				longdouble disharmony = 0.0;
+				for (integer icons = 1; icons <= numberOfConstraints; icons ++)
+					disharmony += weights [icons] * marks [icons];
+				harmonies [icand] = - (double) disharmony;
+				if (icand == 1 || harmonies [icand] > maximumHarmony)
+					maximumHarmony = harmonies [icand];
+			}
+			double sumOfProbabilities = 0.0;
+			for (integer icand = 1; icand <= tableau -> numberOfCandidates; icand ++) {
+				harmonies [icand] = exp (harmonies [icand] - maximumHarmony);   // now unnormalized probabilities
+				sumOfProbabilities += harmonies [icand];
+			}
+			const double cutOff = random. fraction ();
+			double cumulativeProbability = 0.0;
+			for (integer icand = 1; icand <= tableau -> numberOfCandidates; icand ++) {
+				cumulativeProbability += harmonies [icand] / sumOfProbabilities;
+				if (cumulativeProbability > cutOff)
+					return icand;
+			}
+			return 1;
+		}
+		/*
+			Harmonic grammars: keep only the candidates with the lowest disharmony,
+			computed in the same way as in OTGrammar_compareCandidates ().
+		*/
+		double lowestDisharmony = undefined;
+		for (integer icand = 1; icand <= tableau -> numberOfCandidates; icand ++) {
+			const INTVEC marks = tableau -> candidates [icand]. marks.get();
+			double disharmony = 0.0;
+			for (integer icons = 1; icons <= numberOfConstraints; icons ++)
+				disharmony += weights [icons] * marks [icons];
+			harmonies [icand] = disharmony;
+			if (icand == 1 || disharmony < lowestDisharmony)
+				lowestDisharmony = disharmony;
+		}
+		numberOfSurvivors = 0;
+		for (integer icand = 1; icand <= tableau -> numberOfCandidates; icand ++)
+			if (harmonies [icand] == lowestDisharmony)
+				survivors [++ numberOfSurvivors] = icand;
+	}
+	/*
+		Give all candidates that are equally good an equal chance to become the winner.
+	*/
+	if (numberOfSurvivors == 1 || Melder_debug == 41)
+		return survivors [1];   // keep first
+	if (Melder_debug == 42)
+		return survivors [numberOfSurvivors];   // take last
+	const integer isurvivor = 1 + (integer) (numberOfSurvivors * random. fraction ());
+	return survivors [isurvivor <= numberOfSurvivors ? isurvivor : numberOfSurvivors];
+}
+
+static MelderThread_RETURN_TYPE OTGrammar_simulate (OTGrammar_simulate_Args me) {
+	const OTGrammar grammar = my grammar;
+	for (integer ipart = my firstPart; ipart <= my lastPart; ipart ++) {
+		my random = NUMrandomStream (my seed, (uint64) ipart);
+		if (my trialsPerInput > 0) {
+			const integer firstTrial = (ipart - 1) * my trialsPerInput / OTGrammar_NUMBER_OF_PARTS + 1;
+			const integer lastTrial = ipart * my trialsPerInput / OTGrammar_NUMBER_OF_PARTS;
+			for (integer itab = 1; itab <= grammar -> numberOfTableaus; itab ++) {
+				for (integer itrial = firstTrial; itrial <= lastTrial; itrial ++) {
+					my newDisharmonies ();
+					my numberOfWins [my tableauOffsets [itab] + my getWinner (itab)] += 1;
+				}
+			}
+		} else {
+			const integer firstInput = (ipart - 1) * my numberOfInputs / OTGrammar_NUMBER_OF_PARTS + 1;
+			const integer lastInput = ipart * my numberOfInputs / OTGrammar_NUMBER_OF_PARTS;
+			const integer numberOfPairs = my cumulativeWeights.size;
+			const double totalWeight = my cumulativeWeights [numberOfPairs];
+			for (integer iinput = firstInput; iinput <= lastInput; iinput ++) {
+				/*
+					Draw a pair, as in PairDistribution_peekPair ().
+				*/
+				const double cutOff = totalWeight * my random. fraction ();
+				const integer ipair = std::min (numberOfPairs, 1 + integer (std::lower_bound (
+					& my cumulativeWeights [1], & my cumulativeWeights [1] + numberOfPairs, cutOff) - & my cumulativeWeights [1])
+				);
+				my newDisharmonies ();
+				const integer iwinner = my getWinner (my pairTableaus [ipair]);
+				if (my candidateIsCorrect [my pairOffsets [ipair] + iwinner])
+					my numberOfCorrect += 1;
+			}
+		}
+	}
+	MelderThread_RETURN;
+}
+
+static std::vector <autoOTGrammar_simulate_Args> OTGrammar_simulate_createArgs (OTGrammar me,
+	double noise, integer numberOfEvaluations)
+{
+	integer maximumNumberOfCandidates = 0, totalNumberOfOutputs = 0;
+	for (integer itab = 1; itab <= my numberOfTableaus; itab ++) {
+		maximumNumberOfCandidates = std::max (maximumNumberOfCandidates, my tableaus [itab]. numberOfCandidates);
+		totalNumberOfOutputs += my tableaus [itab]. numberOfCandidates;
+	}
+	const integer numberOfThreads = std::max (integer (1), std::min (numberOfEvaluations / OTGrammar_MINIMUM_EVALUATIONS_PER_THREAD,
+			std::min (integer (MelderThread_getNumberOfProcessors ()), integer (OTGrammar_NUMBER_OF_PARTS))));
+	const uint64 seed = NUMrandom_drawSeed ();
+	std::vector <autoOTGrammar_simulate_Args> args ((size_t) numberOfThreads);
+	for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+		autoOTGrammar_simulate_Args arg = Thing_new (OTGrammar_simulate_Args);
+		arg -> grammar = me;
+		arg -> noise = noise;
+		arg -> seed = seed;
+		arg -> firstPart = (ithread - 1) * OTGrammar_NUMBER_OF_PARTS / numberOfThreads + 1;
+		arg -> lastPart = ithread * OTGrammar_NUMBER_OF_PARTS / numberOfThreads;
+		arg -> numberOfWins = INTVECzero (totalNumberOfOutputs);
+		arg -> disharmonies = VECzero (my numberOfConstraints);
+		arg -> weights = VECzero (my numberOfConstraints);
+		arg -> harmonies = VECzero (maximumNumberOfCandidates);
+		arg -> survivors = INTVECzero (maximumNumberOfCandidates);
+		arg -> survivorMarks = INTVECzero (maximumNumberOfCandidates);
+		arg -> group = INTVECzero (my numberOfConstraints);
+		arg -> used = BOOLVECzero (my numberOfConstraints);
+		args [(size_t) ithread - 1] = arg.move();
+	}
+	return args;
+}
+
+/*
+	The number of times every candidate of every tableau wins, in trialsPerInput evaluations per tableau.
+*/
+static autoINTVEC OTGrammar_simulateWinners (OTGrammar me, integer trialsPerInput, double noise) {
+	autoINTVEC tableauOffsets = INTVECzero (my numberOfTableaus);
+	integer totalNumberOfOutputs = 0;
+	for (integer itab = 1; itab <= my numberOfTableaus; itab ++) {
+		tableauOffsets [itab] = totalNumberOfOutputs;
+		totalNumberOfOutputs += my tableaus [itab]. numberOfCandidates;
+	}
+	autoINTVEC numberOfWins = INTVECzero (totalNumberOfOutputs);
+	if (trialsPerInput <= 0)
+		return numberOfWins;
+	std::vector <autoOTGrammar_simulate_Args> args = OTGrammar_simulate_createArgs (me, noise, trialsPerInput * my numberOfTableaus);
+	for (size_t ithread = 0; ithread < args.size(); ithread ++) {
+		args [ithread] -> trialsPerInput = trialsPerInput;
+		args [ithread] -> tableauOffsets = tableauOffsets.get();
+	}
+	MelderThread_run (OTGrammar_simulate, args.data(), (int) args.size());
+	for (size_t ithread = 0; ithread < args.size(); ithread ++)
+		for (integer iout = 1; iout <= totalNumberOfOutputs; iout ++)
+			numberOfWins [iout] += args [ithread] -> numberOfWins [iout];
+	return numberOfWins;
+}
+
+static autoDistributions OTGrammar_to_Distribution_serial (OTGrammar me, integer trialsPerInput, double noise) {
 	try {
 		integer totalNumberOfOutputs = 0, nout = 0;
 		/*
@@ -1092,7 +1355,7 @@ autoDistributions OTGrammar_to_Distribution (OTGrammar me, integer trialsPerInpu
 	}
 }
 
-autoPairDistribution OTGrammar_to_PairDistribution (OTGrammar me, integer trialsPerInput, double noise) {
+static autoPairDistribution OTGrammar_to_PairDistribution_serial (OTGrammar me, integer trialsPerInput, double noise) {
 	try {
 		integer nout = 0;
 		/*
@@ -1131,6 +1394,46 @@ autoPairDistribution OTGrammar_to_PairDistribution (OTGrammar me, integer trials
 	}
 }
 
+autoDistributions OTGrammar_to_Distribution (OTGrammar me, integer trialsPerInput, double noise) {
+	if (Melder_debug == 59)
+		return OTGrammar_to_Distribution_serial (me, trialsPerInput, noise);
+	try {
+		autoINTVEC numberOfWins = OTGrammar_simulateWinners (me, trialsPerInput, noise);
+		autoDistributions thee = Distributions_create (numberOfWins.size, 1);
+		integer nout = 0;
+		for (integer itab = 1; itab <= my numberOfTableaus; itab ++) {
+			OTGrammarTableau tableau = & my tableaus [itab];
+			for (integer icand = 1; icand <= tableau -> numberOfCandidates; icand ++) {
+				thy rowLabels [nout + icand] = Melder_dup (Melder_cat (tableau -> input.get(), U" \\-> ", tableau -> candidates [icand]. output.get()));
+				thy data [nout + icand] [1] = numberOfWins [nout + icand];
+			}
+			nout += tableau -> numberOfCandidates;
+		}
+		return thee;
+	} catch (MelderError) {
+		Melder_throw (me, U": output distribution not computed.");
+	}
+}
+
+autoPairDistribution OTGrammar_to_PairDistribution (OTGrammar me, integer trialsPerInput, double noise) {
+	if (Melder_debug == 59)
+		return OTGrammar_to_PairDistribution_serial (me, trialsPerInput, noise);
+	try {
+		autoINTVEC numberOfWins = OTGrammar_simulateWinners (me, trialsPerInput, noise);
+		autoPairDistribution thee = PairDistribution_create ();
+		integer nout = 0;
+		for (integer itab = 1; itab <= my numberOfTableaus; itab ++) {
+			OTGrammarTableau tableau = & my tableaus [itab];
+			for (integer icand = 1; icand <= tableau -> numberOfCandidates; icand ++)
+				PairDistribution_add (thee.get(), tableau -> input.get(), tableau -> candidates [icand]. output.get(), numberOfWins [nout + icand]);
+			nout += tableau -> numberOfCandidates;
+		}
+		return thee;
+	} catch (MelderError) {
+		Melder_throw (me, U": output distribution not computed.");
+	}
+}
+
 static bool honoursFixedRankings (OTGrammar me) {
 	for (integer i = 1; i <= my numberOfFixedRankings; i ++) {
 		integer higher = my fixedRankings [i]. higher, lower = my fixedRankings [i]. lower;
@@ -2290,7 +2593,7 @@ void OTGrammar_Distributions_learnFromPartialOutputs (OTGrammar me, Distribution
 	}
 }
 
-double OTGrammar_PairDistribution_getFractionCorrect (OTGrammar me, PairDistribution thee,
+static double OTGrammar_PairDistribution_getFractionCorrect_serial (OTGrammar me, PairDistribution thee,
 	double evaluationNoise, integer numberOfInputs)
 {
 	try {
@@ -2310,6 +2613,64 @@ double OTGrammar_PairDistribution_getFractionCorrect (OTGrammar me, PairDistribu
 	}
 }
 
+double OTGrammar_PairDistribution_getFractionCorrect (OTGrammar me, PairDistribution thee,
+	double evaluationNoise, integer numberOfInputs)
+{
+	if (Melder_debug == 59)
+		return OTGrammar_PairDistribution_getFractionCorrect_serial (me, thee, evaluationNoise, numberOfInputs);
+	try {
+		/*
+			Look up the tableau of every pair that can be drawn, and which of its candidates are correct.
+		*/
+		integer numberOfPairs = 0, numberOfCandidates = 0;
+		for (integer ipair = 1; ipair <= thy pairs.size; ipair ++) {
+			PairProbability prob = thy pairs.at [ipair];
+			if (prob -> weight > 0.0) {
+				Melder_require (prob -> string1 && prob -> string2,
+					U"No string in probability pair ", ipair, U".");
+				numberOfPairs += 1;
+				numberOfCandidates += my tableaus [OTGrammar_getTableau (me, prob -> string1.get())]. numberOfCandidates;
+			}
+		}
+		Melder_require (numberOfPairs > 0,
+			U"No candidates.");
+		autoVEC cumulativeWeights = VECraw (numberOfPairs);
+		autoINTVEC pairTableaus = INTVECraw (numberOfPairs), pairOffsets = INTVECraw (numberOfPairs);
+		autoBOOLVEC candidateIsCorrect = BOOLVECzero (numberOfCandidates);
+		double sumOfWeights = 0.0;
+		integer ipair = 0, offset = 0;
+		for (integer jpair = 1; jpair <= thy pairs.size; jpair ++) {
+			PairProbability prob = thy pairs.at [jpair];
+			if (prob -> weight <= 0.0)
+				continue;
+			ipair += 1;
+			sumOfWeights += prob -> weight;
+			cumulativeWeights [ipair] = sumOfWeights;
+			const integer itab = OTGrammar_getTableau (me, prob -> string1.get());
+			pairTableaus [ipair] = itab;
+			pairOffsets [ipair] = offset;
+			for (integer icand = 1; icand <= my tableaus [itab]. numberOfCandidates; icand ++)
+				candidateIsCorrect [offset + icand] = str32equ (my tableaus [itab]. candidates [icand]. output.get(), prob -> string2.get());
+			offset += my tableaus [itab]. numberOfCandidates;
+		}
+		std::vector <autoOTGrammar_simulate_Args> args = OTGrammar_simulate_createArgs (me, evaluationNoise, numberOfInputs);
+		for (size_t ithread = 0; ithread < args.size(); ithread ++) {
+			args [ithread] -> numberOfInputs = numberOfInputs;
+			args [ithread] -> cumulativeWeights = cumulativeWeights.get();
+			args [ithread] -> pairTableaus = pairTableaus.get();
+			args [ithread] -> pairOffsets = pairOffsets.get();
+			args [ithread] -> candidateIsCorrect = candidateIsCorrect.get();
+		}
+		MelderThread_run (OTGrammar_simulate, args.data(), (int) args.size());
+		integer numberOfCorrect = 0;
+		for (size_t ithread = 0; ithread < args.size(); ithread ++)
+			numberOfCorrect += args [ithread] -> numberOfCorrect;
+		return (double) numberOfCorrect / numberOfInputs;
+	} catch (MelderError) {
+		Melder_throw (me, U" & ", thee, U": fraction correct not computed.");
+	}
+}
+
 integer OTGrammar_PairDistribution_getMinimumNumberCorrect (OTGrammar me, PairDistribution thee,
 	double evaluationNoise, integer numberOfReplications)
 {
@@ -261,7 +261,7 @@ int OTMulti_candidateMatches (OTMulti me, integer icand, conststring32 form1, co
 	return (form1 [0] == U'\0' || str32str (string, form1)) && (form2 [0] == U'\0' || str32str (string, form2));
 }
 
-static void _OTMulti_fillInHarmonies (OTMulti me, conststring32 form1, conststring32 form2) {
+static void _OTMulti_fillInHarmonies_bySearching (OTMulti me, conststring32 form1, conststring32 form2) {
 	if (my decisionStrategy == kOTGrammar_decisionStrategy::OPTIMALITY_THEORY) return;
 	for (integer icand = 1; icand <= my numberOfCandidates; icand ++) if (OTMulti_candidateMatches (me, icand, form1, form2)) {
 		OTCandidate candidate = & my candidates [icand];
@@ -291,13 +291,13 @@ static void _OTMulti_fillInHarmonies (OTMulti me, conststring32 form1, conststri
 				disharmony += constraintDisharmony * marks [icons];
 			}
 		} else {
-			Melder_fatal (U"_OTMulti_fillInHarmonies: unimplemented decision strategy.");
+			Melder_fatal (U"_OTMulti_fillInHarmonies_bySearching: unimplemented decision strategy.");
 		}
 		candidate -> harmony = - disharmony;
 	}
 }
 
-static void _OTMulti_fillInProbabilities (OTMulti me, conststring32 form1, conststring32 form2) {
+static void _OTMulti_fillInProbabilities_bySearching (OTMulti me, conststring32 form1, conststring32 form2) {
 	double maximumHarmony = -1e308;
 	for (integer icand = 1; icand <= my numberOfCandidates; icand ++) if (OTMulti_candidateMatches (me, icand, form1, form2)) {
 		OTCandidate candidate = & my candidates [icand];
@@ -324,14 +324,18 @@ static void _OTMulti_fillInProbabilities (OTMulti me, conststring32 form1, const
 
 class MelderError_OTMulti_NoMatchingCandidate: public MelderError {};
 
-integer OTMulti_getWinner (OTMulti me, conststring32 form1, conststring32 form2) {
+/*
+	The evaluation as it was before the candidate index and the violation matrix (Debug option 61):
+	every evaluation searches all candidate strings for the forms and computes the disharmonies from the marks.
+*/
+static integer OTMulti_getWinner_bySearching (OTMulti me, conststring32 form1, conststring32 form2) {
 	try {
 		integer icand_best = 0;
 		if (my decisionStrategy == kOTGrammar_decisionStrategy::MAXIMUM_ENTROPY ||
 			my decisionStrategy == kOTGrammar_decisionStrategy::EXPONENTIAL_MAXIMUM_ENTROPY)
 		{
-			_OTMulti_fillInHarmonies (me, form1, form2);
-			_OTMulti_fillInProbabilities (me, form1, form2);
+			_OTMulti_fillInHarmonies_bySearching (me, form1, form2);
+			_OTMulti_fillInProbabilities_bySearching (me, form1, form2);
 			double cutOff = NUMrandomUniform (0.0, 1.0);
 			double sumOfProbabilities = 0.0;
 			for (integer icand = 1; icand <= my numberOfCandidates; icand ++) if (OTMulti_candidateMatches (me, icand, form1, form2)) {
@@ -378,6 +382,204 @@ integer OTMulti_getWinner (OTMulti me, conststring32 form1, conststring32 form2)
 	}
 }
 
+static const std::u32string& OTMulti_matchingCandidatesKey (OTMulti me, conststring32 form1, conststring32 form2) {
+	my matchingCandidatesKey. assign (form1);
+	my matchingCandidatesKey. push_back (U'\0');
+	my matchingCandidatesKey. append (form2);
+	return my matchingCandidatesKey;
+}
+
+/*
+	The candidates whose string contains both form1 and form2 (an empty form matches every candidate).
+	Learning asks for the same pairs of forms again and again, so every answer is kept.
+	A pair of forms is looked for only among the candidates that match the first form,
+	which learning asks for by itself anyway.
+*/
+static constINTVEC OTMulti_getMatchingCandidates (OTMulti me, conststring32 form1, conststring32 form2) {
+	const auto found = my matchingCandidates. find (OTMulti_matchingCandidatesKey (me, form1, form2));
+	if (found != my matchingCandidates. end ())
+		return found -> second.get();
+	autoINTVEC candidates;
+	if (form1 [0] != U'\0' && form2 [0] != U'\0') {
+		const constINTVEC candidatesOfForm1 = OTMulti_getMatchingCandidates (me, form1, U"");
+		integer numberOfMatchingCandidates = 0;
+		for (integer i = 1; i <= candidatesOfForm1.size; i ++)
+			if (str32str (my candidates [candidatesOfForm1 [i]]. string.get(), form2))
+				numberOfMatchingCandidates ++;
+		candidates = INTVECraw (numberOfMatchingCandidates);
+		integer imatch = 0;
+		for (integer i = 1; i <= candidatesOfForm1.size; i ++)
+			if (str32str (my candidates [candidatesOfForm1 [i]]. string.get(), form2))
+				candidates [++ imatch] = candidatesOfForm1 [i];
+	} else {
+		integer numberOfMatchingCandidates = 0;
+		for (integer icand = 1; icand <= my numberOfCandidates; icand ++)
+			if (OTMulti_candidateMatches (me, icand, form1, form2))
+				numberOfMatchingCandidates ++;
+		candidates = INTVECraw (numberOfMatchingCandidates);
+		integer imatch = 0;
+		for (integer icand = 1; icand <= my numberOfCandidates; icand ++)
+			if (OTMulti_candidateMatches (me, icand, form1, form2))
+				candidates [++ imatch] = icand;
+	}
+	const constINTVEC result = candidates.get();   // stays valid when moved into the map
+	my matchingCandidates [OTMulti_matchingCandidatesKey (me, form1, form2)] = candidates.move();
+	return result;
+}
+
+/*
+	Computes the disharmonies of the given candidates (not for Optimality Theory), into candidateDisharmonies,
+	as the inner products of their rows of violations with the weights that the decision strategy gives to the constraints.
+	The sums are taken in constraint order, so that the disharmonies are identical to those of OTMulti_compareCandidates.
+*/
+static void OTMulti_computeDisharmonies (OTMulti me, constINTVEC candidates) {
+	if (my violations.nrow != my numberOfCandidates || my violations.ncol != my numberOfConstraints) {
+		my violations = MATraw (my numberOfCandidates, my numberOfConstraints);
+		for (integer icand = 1; icand <= my numberOfCandidates; icand ++)
+			for (integer icons = 1; icons <= my numberOfConstraints; icons ++)
+				my violations [icand] [icons] = my candidates [icand]. marks [icons];
+		my constraintWeights = VECraw (my numberOfConstraints);
+		my candidateDisharmonies = VECraw (my numberOfCandidates);
+	}
+	for (integer icons = 1; icons <= my numberOfConstraints; icons ++) {
+		const double disharmony = my constraints [icons]. disharmony;
+		double weight = undefined;
+		if (my decisionStrategy == kOTGrammar_decisionStrategy::HARMONIC_GRAMMAR ||
+			my decisionStrategy == kOTGrammar_decisionStrategy::MAXIMUM_ENTROPY)
+		{
+			weight = disharmony;
+		} else if (my decisionStrategy == kOTGrammar_decisionStrategy::EXPONENTIAL_HG ||
+			my decisionStrategy == kOTGrammar_decisionStrategy::EXPONENTIAL_MAXIMUM_ENTROPY)
+		{
+			weight = exp (disharmony);
+		} else if (my decisionStrategy == kOTGrammar_decisionStrategy::LINEAR_OT) {
+			weight = ( disharmony > 0.0 ? disharmony : 0.0 );   // adds zero where the constraint used to be skipped
+		} else if (my decisionStrategy == kOTGrammar_decisionStrategy::POSITIVE_HG) {
+			weight = ( disharmony > 1.0 ? disharmony : 1.0 );
+		} else {
+			Melder_fatal (U"OTMulti_computeDisharmonies: unimplemented decision strategy.");
+		}
+		my constraintWeights [icons] = weight;
+	}
+	const constVEC weights = my constraintWeights.get();
+	for (integer i = 1; i <= candidates.size; i ++) {
+		const integer icand = candidates [i];
+		const constVEC candidateViolations = my violations.row (icand);
+		double disharmony = 0.0;
+		for (integer icons = 1; icons <= my numberOfConstraints; icons ++)
+			disharmony += weights [icons] * candidateViolations [icons];
+		my candidateDisharmonies [icand] = disharmony;
+	}
+}
+
+static void _OTMulti_fillInHarmonies (OTMulti me, constINTVEC candidates) {
+	if (my decisionStrategy == kOTGrammar_decisionStrategy::OPTIMALITY_THEORY) return;
+	OTMulti_computeDisharmonies (me, candidates);
+	for (integer i = 1; i <= candidates.size; i ++)
+		my candidates [candidates [i]]. harmony = - my candidateDisharmonies [candidates [i]];
+}
+
+static void _OTMulti_fillInProbabilities (OTMulti me, constINTVEC candidates) {
+	double maximumHarmony = -1e308;
+	for (integer i = 1; i <= candidates.size; i ++) {
+		OTCandidate candidate = & my candidates [candidates [i]];
+		if (candidate -> harmony > maximumHarmony) {
+			maximumHarmony = candidate -> harmony;
+		}
+	}
+	for (integer i = 1; i <= candidates.size; i ++) {
+		OTCandidate candidate = & my candidates [candidates [i]];
+		candidate -> probability = exp (candidate -> harmony - maximumHarmony);
+		Melder_assert (candidate -> probability >= 0.0 && candidate -> probability <= 1.0);
+	}
+	double sumOfProbabilities = 0.0;
+	for (integer i = 1; i <= candidates.size; i ++) {
+		OTCandidate candidate = & my candidates [candidates [i]];
+		sumOfProbabilities += candidate -> probability;
+	}
+	Melder_assert (sumOfProbabilities > 0.0);   // Because at least one of them is 1.0.
+	for (integer i = 1; i <= candidates.size; i ++) {
+		OTCandidate candidate = & my candidates [candidates [i]];
+		candidate -> probability /= sumOfProbabilities;
+	}
+}
+
+integer OTMulti_getWinner (OTMulti me, conststring32 form1, conststring32 form2) {
+	if (Melder_debug == 61)
+		return OTMulti_getWinner_bySearching (me, form1, form2);
+	try {
+		const constINTVEC candidates = OTMulti_getMatchingCandidates (me, form1, form2);
+		if (candidates.size == 0) {
+			Melder_appendError (U"The forms ", form1, U" and ", form2, U" do not match any candidate.");
+			throw MelderError_OTMulti_NoMatchingCandidate ();
+		}
+		integer icand_best = 0;
+		if (my decisionStrategy == kOTGrammar_decisionStrategy::MAXIMUM_ENTROPY ||
+			my decisionStrategy == kOTGrammar_decisionStrategy::EXPONENTIAL_MAXIMUM_ENTROPY)
+		{
+			_OTMulti_fillInHarmonies (me, candidates);
+			_OTMulti_fillInProbabilities (me, candidates);
+			double cutOff = NUMrandomUniform (0.0, 1.0);
+			double sumOfProbabilities = 0.0;
+			for (integer i = 1; i <= candidates.size; i ++) {
+				const integer icand = candidates [i];
+				sumOfProbabilities += my candidates [icand]. probability;
+				if (sumOfProbabilities > cutOff) {
+					icand_best = icand;
+					break;
+				}
+			}
+		} else {
+			/*
+				Harmonic grammars compare the disharmonies, which are computed once for every candidate
+				instead of once for every comparison.
+			*/
+			const bool comparesDisharmonies = ( my decisionStrategy != kOTGrammar_decisionStrategy::OPTIMALITY_THEORY );
+			if (comparesDisharmonies)
+				OTMulti_computeDisharmonies (me, candidates);
+			integer numberOfBestCandidates = 0;
+			for (integer i = 1; i <= candidates.size; i ++) {
+				const integer icand = candidates [i];
+				if (icand_best == 0) {
+					icand_best = icand;
+					numberOfBestCandidates = 1;
+				} else {
+					int comparison;
+					if (comparesDisharmonies) {
+						const double disharmony = my candidateDisharmonies [icand], bestDisharmony = my candidateDisharmonies [icand_best];
+						comparison = ( disharmony < bestDisharmony ? -1 : disharmony > bestDisharmony ? +1 : 0 );
+					} else {
+						comparison = OTMulti_compareCandidates (me, icand, icand_best);
+					}
+					if (comparison == -1) {
+						icand_best = icand;   // the current candidate is the unique best candidate found so far
+						numberOfBestCandidates = 1;
+					} else if (comparison == 0) {
+						numberOfBestCandidates += 1;   // the current candidate is equally good as the best found before
+						/*
+						 * Give all candidates that are equally good an equal chance to become the winner.
+						 */
+						if (Melder_debug == 41) {
+							icand_best = icand_best;   // keep first
+						} else if (Melder_debug == 42) {
+							icand_best = icand;   // take last
+						} else if (NUMrandomUniform (0.0, numberOfBestCandidates) < 1.0) {   // default: take random
+							icand_best = icand;
+						}
+					}
+				}
+			}
+		}
+		if (icand_best == 0) {
+			Melder_appendError (U"The forms ", form1, U" and ", form2, U" do not match any candidate.");
+			throw MelderError_OTMulti_NoMatchingCandidate ();   // BUG: NYI
+		}
+		return icand_best;
+	} catch (MelderError) {
+		Melder_throw (me, U": winner not determined.");
+	}
+}
+
 static void OTMulti_modifyRankings (OTMulti me, integer iwinner, integer iloser,
 	kOTGrammar_rerankingStrategy updateRule,
 	double plasticity, double relativePlasticityNoise)
@@ -23,6 +23,9 @@
 #include "Distributions.h"
 #include "OTGrammar.h"
 
+#include <string>
+#include <unordered_map>
+
 #include "OTMulti_def.h"
 
 integer OTMulti_getConstraintIndexFromName (OTMulti me, conststring32 name);
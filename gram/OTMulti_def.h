@@ -78,6 +78,17 @@ oo_DEFINE_CLASS (OTMulti, Daata)
 	#endif
 
 	#if oo_DECLARING
+		/*
+			For OTMulti_getWinner: the candidates that match each pair of partial forms asked for so far
+			(the key is form1, a null character, and form2), and the marks of all candidates
+			as one contiguous numberOfCandidates x numberOfConstraints matrix of violations.
+			Neither copied nor written; built when needed; the violations are rebuilt when a constraint has been removed.
+		*/
+		std::unordered_map <std::u32string, autoINTVEC> matchingCandidates;
+		std::u32string matchingCandidatesKey;   // reused for every look-up
+		autoMAT violations;
+		autoVEC constraintWeights, candidateDisharmonies;
+
 		void v_info ()
 			override;
 	#endif
@@ -1,6 +1,6 @@
 /* melder_readtext.cpp
  *
- * Copyright (C) 2008,2010-2012,2014-2017 Paul Boersma
+ * Copyright (C) 2008,2010-2012,2014-2017,2026 Paul Boersma
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -19,7 +19,109 @@
 #include "melder.h"
 #include "../kar/UnicodeData.h"
 
+/********** Streaming **********/
+
+#define MelderReadText_CHUNK_SIZE  65536
+
+static void refillChunk (MelderReadText me) {
+	/*
+		Keep the bytes that have not been read yet, and append new bytes from the file, except null bytes.
+	*/
+	const integer numberOfBytesLeft = my chunkEnd - my readPointer8;
+	memmove (& my string8 [0], my readPointer8, (size_t) numberOfBytesLeft);
+	char *to = & my string8 [numberOfBytesLeft];
+	if (! my endOfFileReached) {
+		const size_t numberOfBytesRequested = (size_t) (MelderReadText_CHUNK_SIZE - numberOfBytesLeft);
+		const size_t numberOfBytesRead = fread (to, 1, numberOfBytesRequested, my file);
+		if (ferror (my file))
+			Melder_throw (U"Error reading text file (line ", my lineNumber, U").");
+		my endOfFileReached = ( numberOfBytesRead < numberOfBytesRequested );
+		const char *from = to, *end = to + numberOfBytesRead;
+		for (; from < end; from ++) {
+			if (*from == '\0')
+				my numberOfNullBytes += 1;
+			else
+				* to ++ = *from;
+		}
+	}
+	*to = '\0';
+	my readPointer8 = & my string8 [0];
+	my chunkEnd = to;
+}
+
+static bool haveBytes (MelderReadText me, integer numberOfBytes) {
+	while (my chunkEnd - my readPointer8 < numberOfBytes && ! my endOfFileReached)
+		refillChunk (me);
+	return my chunkEnd - my readPointer8 >= numberOfBytes;
+}
+
+/*
+	The number of bytes in the UTF-8 sequence at `p` (whose first byte is not ASCII),
+	or 0 if the sequence is not valid by the criteria of Melder_str8IsValidUtf8.
+*/
+static integer getUtf8SequenceLength (const char8 *p) {
+	const char8 kar1 = p [0];
+	const integer length = ( kar1 <= 0xC1 ? 0 : kar1 <= 0xDF ? 2 : kar1 <= 0xEF ? 3 : kar1 <= 0xF4 ? 4 : 0 );
+	for (integer i = 1; i < length; i ++)
+		if ((p [i] & 0xC0) != 0x80)
+			return 0;   // this includes the closing null byte of the chunk
+	return length;
+}
+
+static char32 getStreamedChar (MelderReadText me) {
+	if (my readPointer8 == my chunkEnd && ! haveBytes (me, 1))
+		return U'\0';
+	const char8 kar1 = (char8) * my readPointer8 ++;
+	if (kar1 <= 0x7F && kar1 != 13) {
+		if (kar1 == '\n')
+			my lineNumber += 1;
+		return (char32) kar1;
+	}
+	if (kar1 == 13) {
+		if (haveBytes (me, 1) && * my readPointer8 == '\n')
+			my readPointer8 ++;   // a Windows line break
+		my lineNumber += 1;
+		return U'\n';
+	}
+	my readPointer8 --;   // back to the start of the non-ASCII character
+	if (my input8Encoding == kMelder_textInputEncoding::UTF8) {
+		(void) haveBytes (me, 4);
+		const char8 *p = (const char8 *) my readPointer8;
+		const integer length = getUtf8SequenceLength (p);
+		if (length > 0) {
+			my readPointer8 += length;
+			my hasDecodedNonAscii = true;
+			if (length == 2)
+				return ((kar1 & 0x00'001F) << 6) | (p [1] & 0x00'003F);
+			if (length == 3)
+				return ((kar1 & 0x00'000F) << 12) | ((p [1] & 0x00'003F) << 6) | (p [2] & 0x00'003F);
+			return ((kar1 & 0x00'0007) << 18) | ((p [1] & 0x00'003F) << 12) | ((p [2] & 0x00'003F) << 6) | (p [3] & 0x00'003F);
+		}
+		if (my fallbackEncoding == kMelder_textInputEncoding::UTF8)
+			Melder_throw (U"Text is not valid UTF-8 (line ", my lineNumber, U"); please try a different text input encoding.");
+		if (my hasDecodedNonAscii) {
+			my mustBeReadAsAWhole = true;
+			Melder_throw (U"Text is not valid UTF-8 (line ", my lineNumber, U"), but earlier lines were.");
+		}
+		/*
+			Everything so far was ASCII, which reads the same in the fallback encoding;
+			the whole text will therefore be decoded exactly as if it had been checked for UTF-8 validity beforehand.
+		*/
+		my input8Encoding = my fallbackEncoding;
+	}
+	my readPointer8 ++;
+	if (my input8Encoding == kMelder_textInputEncoding::MACROMAN)
+		return Melder_decodeMacRoman [kar1];
+	if (my input8Encoding == kMelder_textInputEncoding::WINDOWS_LATIN1)
+		return Melder_decodeWindowsLatin1 [kar1];
+	return (char32) kar1;   // ISO Latin-1, or unknown encoding
+}
+
+/********** Reading **********/
+
 char32 MelderReadText_getChar (MelderReadText me) {
+	if (my file)
+		return getStreamedChar (me);
 	if (my string32) {
 		if (* my readPointer32 == U'\0') return U'\0';
 		return * my readPointer32 ++;
@@ -56,6 +158,16 @@ char32 MelderReadText_getChar (MelderReadText me) {
 }
 
 mutablestring32 MelderReadText_readLine (MelderReadText me) {
+	if (my file) {
+		char32 kar = getStreamedChar (me);
+		if (kar == U'\0')   // tried to read past end of file
+			return nullptr;
+		static autoMelderString line;
+		MelderString_empty (& line);
+		for (; kar != U'\n' && kar != U'\0'; kar = getStreamedChar (me))
+			MelderString_appendCharacter (& line, kar);
+		return line.string;
+	}
 	if (my string32) {
 		Melder_assert (my readPointer32);
 		Melder_assert (! my readPointer8);
@@ -98,6 +210,7 @@ mutablestring32 MelderReadText_readLine (MelderReadText me) {
 }
 
 int64 MelderReadText_getNumberOfLines (MelderReadText me) {
+	Melder_assert (! my file);   // only for texts read as a whole
 	int64 n = 0;
 	if (my string32) {
 		char32 *p = & my string32 [0];
@@ -120,6 +233,8 @@ int64 MelderReadText_getNumberOfLines (MelderReadText me) {
 }
 
 conststring32 MelderReadText_getLineNumber (MelderReadText me) {
+	if (my file)
+		return Melder_integer (my lineNumber);
 	int64 result = 1;
 	if (my string32) {
 		char32 *p = & my string32 [0];
@@ -170,4 +285,37 @@ autoMelderReadText MelderReadText_createFromFile (MelderFile file) {
 	return me;
 }
 
+autoMelderReadText MelderReadText_openFromFile (MelderFile file) {
+	if (Melder_debug == 54)
+		return MelderReadText_createFromFile (file);
+	autoMelderReadText me = std::make_unique <structMelderReadText> ();
+	my file. reset (Melder_fopen (file, "rb"));
+	char8 firstBytes [3];
+	const size_t numberOfFirstBytes = fread (firstBytes, 1, 3, my file);
+	if (numberOfFirstBytes >= 2 &&
+		((firstBytes [0] == 0xFE && firstBytes [1] == 0xFF) || (firstBytes [0] == 0xFF && firstBytes [1] == 0xFE)))
+	{
+		my file. reset (nullptr);
+		return MelderReadText_createFromFile (file);   // UTF-16
+	}
+	const bool hasUtf8ByteOrderMark = ( numberOfFirstBytes == 3 &&
+			firstBytes [0] == 0xEF && firstBytes [1] == 0xBB && firstBytes [2] == 0xBF );
+	if (! hasUtf8ByteOrderMark)
+		rewind (my file);
+	my string8 = autostring8 (MelderReadText_CHUNK_SIZE);
+	my readPointer8 = my chunkEnd = & my string8 [0];
+	my input8Encoding = Melder_getInputEncoding ();
+	if (my input8Encoding == kMelder_textInputEncoding::UTF8_THEN_ISO_LATIN1) {
+		my input8Encoding = kMelder_textInputEncoding::UTF8;
+		my fallbackEncoding = kMelder_textInputEncoding::ISO_LATIN1;
+	} else if (my input8Encoding == kMelder_textInputEncoding::UTF8_THEN_WINDOWS_LATIN1) {
+		my input8Encoding = kMelder_textInputEncoding::UTF8;
+		my fallbackEncoding = kMelder_textInputEncoding::WINDOWS_LATIN1;
+	} else if (my input8Encoding == kMelder_textInputEncoding::UTF8_THEN_MACROMAN) {
+		my input8Encoding = kMelder_textInputEncoding::UTF8;
+		my fallbackEncoding = kMelder_textInputEncoding::MACROMAN;
+	}
+	return me;
+}
+
 /* End of file melder_readtext.cpp */
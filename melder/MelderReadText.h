@@ -2,7 +2,7 @@
 #define _melder_readtext_h_
 /* melder_readtext.h
  *
- * Copyright (C) 1992-2018 Paul Boersma
+ * Copyright (C) 1992-2018,2026 Paul Boersma
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -24,6 +24,18 @@ struct structMelderReadText {
 	autostring8 string8;
 	char *readPointer8;
 	kMelder_textInputEncoding input8Encoding;
+	/*
+		A text opened with MelderReadText_openFromFile is not read as a whole:
+		`string8` holds only a chunk of the file, without null bytes and with `chunkEnd` pointing to its closing null byte,
+		and `readPointer8` runs through the chunk, which is refilled from `file` when needed.
+	*/
+	autofile file;
+	char *chunkEnd = nullptr;
+	bool endOfFileReached = false;
+	int64 lineNumber = 1, numberOfNullBytes = 0;
+	kMelder_textInputEncoding fallbackEncoding = kMelder_textInputEncoding::UTF8;   // if the text turns out not to be valid UTF-8 (UTF8 = none)
+	bool hasDecodedNonAscii = false;
+	bool mustBeReadAsAWhole = false;   // invalid UTF-8 after valid non-ASCII UTF-8: start again with MelderReadText_createFromFile
 	structMelderReadText () : readPointer32 (nullptr), readPointer8 (nullptr) {
 		/*
 			Check that C++ default initialization has worked.
@@ -71,6 +83,16 @@ struct autoMelderReadText {
 #endif
 
 autoMelderReadText MelderReadText_createFromFile (MelderFile file);
+autoMelderReadText MelderReadText_openFromFile (MelderFile file);
+/*
+	Like MelderReadText_createFromFile, but decodes an 8-bit file while it is being read,
+	without ever holding the whole file in memory.
+	Null bytes are skipped and counted in `numberOfNullBytes`.
+	If the file turns out not to be valid UTF-8 after valid non-ASCII UTF-8 characters have been read,
+	MelderReadText_getChar throws, with `mustBeReadAsAWhole` set;
+	the caller can then start again with MelderReadText_createFromFile.
+	UTF-16 files, and all files if Debug option 54 is set, are read as a whole.
+*/
 char32 MelderReadText_getChar (MelderReadText text);
 mutablestring32 MelderReadText_readLine (MelderReadText text);
 int64 MelderReadText_getNumberOfLines (MelderReadText me);
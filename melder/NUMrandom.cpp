@@ -148,41 +148,66 @@ void NUMrandom_State :: init_by_array64 (uint64 init_key [], unsigned int key_le
 }
 
 static bool theInited = false;
-void NUMrandom_init () {
-	for (int threadNumber = 0; threadNumber <= 16; threadNumber ++) {
-		const int numberOfKeys = 6;
-		uint64 keys [numberOfKeys];
-		keys [0] = (uint64) llround (1e6 * Melder_clock ());   // unique between boots of the same computer
-		keys [1] = UINT64_C (7320321686725470078) + (uint64) threadNumber;   // unique between threads in the same process
-		switch (threadNumber) {
-			case  0: keys [2] = UINT64_C  (4492812493098689432); keys [3] = UINT64_C  (8902321878452586268); break;
-			case  1: keys [2] = UINT64_C  (1875086582568685862); keys [3] = UINT64_C (12243257483652989599); break;
-			case  2: keys [2] = UINT64_C  (9040925727554857487); keys [3] = UINT64_C  (8037578605604605534); break;
-			case  3: keys [2] = UINT64_C (11168476768576857685); keys [3] = UINT64_C  (7862359785763816517); break;
-			case  4: keys [2] = UINT64_C  (3878901748368466876); keys [3] = UINT64_C  (3563078257726526076); break;
-			case  5: keys [2] = UINT64_C  (2185735817578415800); keys [3] = UINT64_C   (198502654671560756); break;
-			case  6: keys [2] = UINT64_C (12248047509814562486); keys [3] = UINT64_C  (9836250167165762757); break;
-			case  7: keys [2] = UINT64_C    (28362088588870143); keys [3] = UINT64_C  (8756376201767075602); break;
-			case  8: keys [2] = UINT64_C  (5758130586486546775); keys [3] = UINT64_C  (4213784157469743413); break;
-			case  9: keys [2] = UINT64_C  (8508416536565170756); keys [3] = UINT64_C  (2856175717654375656); break;
-			case 10: keys [2] = UINT64_C  (2802356275260644756); keys [3] = UINT64_C  (2309872134087235167); break;
-			case 11: keys [2] = UINT64_C   (230875784065064545); keys [3] = UINT64_C  (1209802371478023476); break;
-			case 12: keys [2] = UINT64_C  (6520185868568714577); keys [3] = UINT64_C  (2173615001556504015); break;
-			case 13: keys [2] = UINT64_C  (9082605608605765650); keys [3] = UINT64_C  (1204167447560475647); break;
-			case 14: keys [2] = UINT64_C  (1238716515545475765); keys [3] = UINT64_C  (8435674023875847388); break;
-			case 15: keys [2] = UINT64_C  (6127715675014756456); keys [3] = UINT64_C  (2435788450287508457); break;
-			case 16: keys [2] = UINT64_C  (1081237546238975884); keys [3] = UINT64_C  (2939783238574293882); break;
-			default: Melder_fatal (U"Thread number too high.");
-		}
-		keys [4] = (uint64) (int64) getpid ();   // unique between processes that run simultaneously on the same computer
-		#ifndef _WIN32
-		//keys [5] = (uint64) (int64) gethostid ();   // unique between computers; but can be SLOW because it could have to access the internet
-		#endif
-		states [threadNumber]. init_by_array64 (keys, numberOfKeys);
+
+static void initState (int threadNumber, uint64 seed, uint64 processIdentifier) {
+	const int numberOfKeys = 6;
+	uint64 keys [numberOfKeys];
+	keys [0] = seed;
+	keys [1] = UINT64_C (7320321686725470078) + (uint64) threadNumber;   // unique between threads in the same process
+	switch (threadNumber) {
+		case  0: keys [2] = UINT64_C  (4492812493098689432); keys [3] = UINT64_C  (8902321878452586268); break;
+		case  1: keys [2] = UINT64_C  (1875086582568685862); keys [3] = UINT64_C (12243257483652989599); break;
+		case  2: keys [2] = UINT64_C  (9040925727554857487); keys [3] = UINT64_C  (8037578605604605534); break;
+		case  3: keys [2] = UINT64_C (11168476768576857685); keys [3] = UINT64_C  (7862359785763816517); break;
+		case  4: keys [2] = UINT64_C  (3878901748368466876); keys [3] = UINT64_C  (3563078257726526076); break;
+		case  5: keys [2] = UINT64_C  (2185735817578415800); keys [3] = UINT64_C   (198502654671560756); break;
+		case  6: keys [2] = UINT64_C (12248047509814562486); keys [3] = UINT64_C  (9836250167165762757); break;
+		case  7: keys [2] = UINT64_C    (28362088588870143); keys [3] = UINT64_C  (8756376201767075602); break;
+		case  8: keys [2] = UINT64_C  (5758130586486546775); keys [3] = UINT64_C  (4213784157469743413); break;
+		case  9: keys [2] = UINT64_C  (8508416536565170756); keys [3] = UINT64_C  (2856175717654375656); break;
+		case 10: keys [2] = UINT64_C  (2802356275260644756); keys [3] = UINT64_C  (2309872134087235167); break;
+		case 11: keys [2] = UINT64_C   (230875784065064545); keys [3] = UINT64_C  (1209802371478023476); break;
+		case 12: keys [2] = UINT64_C  (6520185868568714577); keys [3] = UINT64_C  (2173615001556504015); break;
+		case 13: keys [2] = UINT64_C  (9082605608605765650); keys [3] = UINT64_C  (1204167447560475647); break;
+		case 14: keys [2] = UINT64_C  (1238716515545475765); keys [3] = UINT64_C  (8435674023875847388); break;
+		case 15: keys [2] = UINT64_C  (6127715675014756456); keys [3] = UINT64_C  (2435788450287508457); break;
+		case 16: keys [2] = UINT64_C  (1081237546238975884); keys [3] = UINT64_C  (2939783238574293882); break;
+		default: Melder_fatal (U"Thread number too high.");
 	}
+	keys [4] = processIdentifier;
+	keys [5] = 0;
+	#ifndef _WIN32
+	//keys [5] = (uint64) (int64) gethostid ();   // unique between computers; but can be SLOW because it could have to access the internet
+	#endif
+	states [threadNumber]. init_by_array64 (keys, numberOfKeys);
+	states [threadNumber]. secondAvailable = false;
+}
+
+void NUMrandom_init () {
+	for (int threadNumber = 0; threadNumber <= 16; threadNumber ++)
+		initState (threadNumber,
+			(uint64) llround (1e6 * Melder_clock ()),   // unique between boots of the same computer
+			(uint64) (int64) getpid ()   // unique between processes that run simultaneously on the same computer
+		);
 	theInited = true;
 }
 
+void NUMrandom_initializeSafelyAndUnpredictably () {
+	NUMrandom_init ();
+}
+
+void NUMrandom_initializeWithSeedUnsafelyButPredictably (uint64 seed) {
+	for (int threadNumber = 0; threadNumber <= 16; threadNumber ++)
+		initState (threadNumber, seed, 0);
+	theInited = true;
+}
+
+uint64 NUMrandom_drawSeed () {
+	const uint64 high = (uint64) (NUMrandomFraction () * 9007199254740992.0);   // 53 random bits
+	const uint64 low = (uint64) (NUMrandomFraction () * 9007199254740992.0);
+	return (high << 11) ^ low;
+}
+
 /* Throughout the years, several versions for "zero or magic" have been proposed. Choose the fastest. */
 
 #define ZERO_OR_MAGIC_VERSION  3
@@ -422,4 +447,189 @@ uint32 NUMhashString (conststring32 string) {
 	return hash;
 }
 
+/********** Counter-based streams: Philox-4x32-10 **********/
+
+#if defined (__GNUC__) && defined (__x86_64__)
+	#define NUMrandom_USE_AVX2  1
+	#include <immintrin.h>
+#else
+	#define NUMrandom_USE_AVX2  0
+#endif
+
+#define PHILOX_M0  UINT32_C (0xD2511F53)
+#define PHILOX_M1  UINT32_C (0xCD9E8D57)
+#define PHILOX_W0  UINT32_C (0x9E3779B9)
+#define PHILOX_W1  UINT32_C (0xBB67AE85)
+
+static inline void philox (uint64 seed, uint64 stream, uint64 counter, uint64 *words) {
+	uint32 c0 = (uint32) counter, c1 = (uint32) (counter >> 32), c2 = (uint32) stream, c3 = (uint32) (stream >> 32);
+	uint32 k0 = (uint32) seed, k1 = (uint32) (seed >> 32);
+	for (int round = 1; round <= 10; round ++) {
+		const uint64 product0 = (uint64) PHILOX_M0 * c0, product1 = (uint64) PHILOX_M1 * c2;
+		const uint32 newC0 = (uint32) (product1 >> 32) ^ c1 ^ k0;
+		const uint32 newC2 = (uint32) (product0 >> 32) ^ c3 ^ k1;
+		c1 = (uint32) product1;
+		c3 = (uint32) product0;
+		c0 = newC0;
+		c2 = newC2;
+		k0 += PHILOX_W0;
+		k1 += PHILOX_W1;
+	}
+	words [0] = (uint64) c1 << 32 | c0;
+	words [1] = (uint64) c3 << 32 | c2;
+}
+
+#if NUMrandom_USE_AVX2
+/*
+	Four counters at a time, one in each 64-bit lane, whose lower halves hold the 32-bit words.
+*/
+__attribute__ ((target ("avx2")))
+static void philox_avx2 (uint64 seed, uint64 stream, uint64 firstCounter, integer numberOfQuads, uint64 *words) {
+	const __m256i lowerHalves = _mm256_set1_epi64x (INT64_C (0xFFFFFFFF));
+	const __m256i m0 = _mm256_set1_epi64x (PHILOX_M0), m1 = _mm256_set1_epi64x (PHILOX_M1);
+	const __m256i streamLow = _mm256_set1_epi64x ((int64) (uint32) stream), streamHigh = _mm256_set1_epi64x ((int64) (stream >> 32));
+	for (integer iquad = 0; iquad < numberOfQuads; iquad ++) {
+		const uint64 counter = firstCounter + 4 * (uint64) iquad;
+		__m256i c0 = _mm256_set_epi64x ((int64) (uint32) (counter + 3), (int64) (uint32) (counter + 2),
+				(int64) (uint32) (counter + 1), (int64) (uint32) counter);
+		__m256i c1 = _mm256_set_epi64x ((int64) ((counter + 3) >> 32), (int64) ((counter + 2) >> 32),
+				(int64) ((counter + 1) >> 32), (int64) (counter >> 32));
+		__m256i c2 = streamLow, c3 = streamHigh;
+		uint32 k0 = (uint32) seed, k1 = (uint32) (seed >> 32);
+		for (int round = 1; round <= 10; round ++) {
+			const __m256i product0 = _mm256_mul_epu32 (m0, c0), product1 = _mm256_mul_epu32 (m1, c2);
+			const __m256i newC0 = _mm256_xor_si256 (_mm256_xor_si256 (_mm256_srli_epi64 (product1, 32), c1),
+					_mm256_set1_epi64x ((int64) k0));
+			const __m256i newC2 = _mm256_xor_si256 (_mm256_xor_si256 (_mm256_srli_epi64 (product0, 32), c3),
+					_mm256_set1_epi64x ((int64) k1));
+			c1 = _mm256_and_si256 (product1, lowerHalves);
+			c3 = _mm256_and_si256 (product0, lowerHalves);
+			c0 = newC0;
+			c2 = newC2;
+			k0 += PHILOX_W0;
+			k1 += PHILOX_W1;
+		}
+		const __m256i word0 = _mm256_or_si256 (_mm256_slli_epi64 (c1, 32), c0);
+		const __m256i word1 = _mm256_or_si256 (_mm256_slli_epi64 (c3, 32), c2);
+		const __m256i evenCounters = _mm256_unpacklo_epi64 (word0, word1);   // counters 0 and 2
+		const __m256i oddCounters = _mm256_unpackhi_epi64 (word0, word1);   // counters 1 and 3
+		_mm256_storeu_si256 ((__m256i *) & words [8 * iquad], _mm256_permute2x128_si256 (evenCounters, oddCounters, 0x20));
+		_mm256_storeu_si256 ((__m256i *) & words [8 * iquad + 4], _mm256_permute2x128_si256 (evenCounters, oddCounters, 0x31));
+	}
+	_mm256_zeroupper ();   // otherwise the non-AVX code that follows (log, sincos) runs several times slower
+}
+
+static bool hasAVX2 () {
+	static const bool result = __builtin_cpu_supports ("avx2");
+	return result;
+}
+#endif
+
+void NUMrandomPhilox_words (uint64 seed, uint64 stream, uint64 firstCounter, integer numberOfCounters, uint64 *words) {
+	integer icounter = 0;
+	#if NUMrandom_USE_AVX2
+		if (Melder_debug != 60 && hasAVX2 ()) {
+			const integer numberOfQuads = numberOfCounters / 4;
+			philox_avx2 (seed, stream, firstCounter, numberOfQuads, words);
+			icounter = 4 * numberOfQuads;
+		}
+	#endif
+	for (; icounter < numberOfCounters; icounter ++)
+		philox (seed, stream, firstCounter + (uint64) icounter, & words [2 * icounter]);
+}
+
+static inline double wordToFraction (uint64 word) {
+	return (word >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/*
+	The polar method, as in NUMrandomGauss: two independent Gaussian numbers from the two fractions of a counter,
+	or none if the point falls outside the unit circle (in 21 percent of the cases).
+*/
+static inline bool wordsToGausses (uint64 word0, uint64 word1, double *gauss0, double *gauss1) {
+	const double x = 2.0 * wordToFraction (word0) - 1.0;   // inside the square [-1; 1) x [-1; 1)
+	const double y = 2.0 * wordToFraction (word1) - 1.0;
+	const double s = x * x + y * y;
+	if (s >= 1.0)
+		return false;   // outside the unit circle
+	if (s == 0.0) {
+		*gauss0 = *gauss1 = 0.0;
+	} else {
+		const double factor = sqrt (-2.0 * log (s) / s);
+		*gauss0 = x * factor;
+		*gauss1 = y * factor;
+	}
+	return true;
+}
+
+double NUMrandomStream :: fraction () {
+	if (numberOfBufferedFractions == 0) {
+		uint64 words [2];
+		philox (seed, stream, counter ++, words);
+		bufferedFractions [0] = wordToFraction (words [1]);
+		bufferedFractions [1] = wordToFraction (words [0]);   // the first to be returned
+		numberOfBufferedFractions = 2;
+	}
+	return bufferedFractions [-- numberOfBufferedFractions];
+}
+
+double NUMrandomStream :: gauss (double mean, double standardDeviation) {
+	if (numberOfBufferedGausses == 1) {
+		numberOfBufferedGausses = 0;
+		return mean + standardDeviation * bufferedGauss;
+	}
+	uint64 words [2];
+	double result;
+	do
+		philox (seed, stream, counter ++, words);
+	while (! wordsToGausses (words [0], words [1], & result, & bufferedGauss));
+	numberOfBufferedGausses = 1;
+	return mean + standardDeviation * result;
+}
+
+#define NUMrandomStream_BLOCK_SIZE  256   /* counters */
+
+void NUMrandomStream :: fillFractions (VEC const& target) {
+	uint64 words [2 * NUMrandomStream_BLOCK_SIZE];
+	for (integer offset = 0; offset < target.size; offset += 2 * NUMrandomStream_BLOCK_SIZE) {
+		const integer numberOfValues = std::min (target.size - offset, integer (2 * NUMrandomStream_BLOCK_SIZE));
+		const integer numberOfCounters = (numberOfValues + 1) / 2;
+		NUMrandomPhilox_words (seed, stream, counter, numberOfCounters, words);
+		counter += (uint64) numberOfCounters;
+		double *to = & target [offset + 1];
+		for (integer i = 0; i < numberOfValues; i ++)
+			to [i] = wordToFraction (words [i]);
+	}
+}
+
+void NUMrandomStream :: fillUniform (VEC const& target, double lowest, double highest) {
+	fillFractions (target);
+	const double range = highest - lowest;
+	for (integer i = 1; i <= target.size; i ++)
+		target [i] = lowest + range * target [i];
+}
+
+void NUMrandomStream :: fillGauss (VEC const& target, double mean, double standardDeviation) {
+	uint64 words [2 * NUMrandomStream_BLOCK_SIZE];
+	integer numberOfValues = 0;
+	while (numberOfValues < target.size) {
+		/*
+			Compute somewhat more counters than the missing pairs need on average,
+			but use only as many as it takes, so that the stream goes on exactly where it would have one by one.
+		*/
+		const integer numberOfMissingPairs = (target.size - numberOfValues + 1) / 2;
+		const integer numberOfCounters = std::min (numberOfMissingPairs + numberOfMissingPairs / 4 + 4, integer (NUMrandomStream_BLOCK_SIZE));
+		NUMrandomPhilox_words (seed, stream, counter, numberOfCounters, words);
+		for (integer icounter = 0; icounter < numberOfCounters && numberOfValues < target.size; icounter ++) {
+			counter ++;
+			double gauss0, gauss1;
+			if (! wordsToGausses (words [2 * icounter], words [2 * icounter + 1], & gauss0, & gauss1))
+				continue;
+			target [++ numberOfValues] = mean + standardDeviation * gauss0;
+			if (numberOfValues < target.size)
+				target [++ numberOfValues] = mean + standardDeviation * gauss1;
+		}
+	}
+}
+
 /* End of file NUMrandom.cpp */
@@ -22,6 +22,13 @@
 
 void NUMrandom_init ();
 
+/*
+	For reproducible simulations, e.g. in test scripts.
+	Seeding applies to all 17 streams: the main stream and the 16 streams for threads.
+*/
+void NUMrandom_initializeWithSeedUnsafelyButPredictably (uint64 seed);
+void NUMrandom_initializeSafelyAndUnpredictably ();
+
 double NUMrandomFraction ();
 double NUMrandomFraction_mt (int threadNumber);
 
@@ -39,5 +46,43 @@ double NUMrandomPoisson (double mean);
 
 uint32 NUMhashString (conststring32 string);
 
+/*
+	Counter-based random numbers (Philox-4x32-10; Salmon, Moraes, Dror & Shaw 2011).
+	The numbers of a stream are a pure function of the seed, the stream number and the position in the stream,
+	so that every part of a parallel computation can use its own stream (e.g. stream 1 for part 1),
+	and the results do not depend on the number of threads or on the order in which the parts are done.
+	Every position (counter) yields two fractions, or (polar method) two Gaussian numbers or, in 21 percent of the cases, none.
+	The fill functions start at the next unused counter and compute the counters in blocks,
+	with AVX2 if the processor has it (bit-identical to the scalar code, which Debug option 60 enforces).
+*/
+struct NUMrandomStream {
+	uint64 seed, stream, counter;
+	int numberOfBufferedFractions, numberOfBufferedGausses;
+	double bufferedFractions [2], bufferedGauss;
+
+	NUMrandomStream (uint64 theSeed, uint64 theStream) :
+		seed (theSeed), stream (theStream), counter (0), numberOfBufferedFractions (0), numberOfBufferedGausses (0) { }
+	double fraction ();
+	double uniform (double lowest, double highest) {
+		return lowest + (highest - lowest) * fraction ();
+	}
+	double gauss (double mean, double standardDeviation);
+	void fillFractions (VEC const& target);
+	void fillUniform (VEC const& target, double lowest, double highest);
+	void fillGauss (VEC const& target, double mean, double standardDeviation);
+};
+
+/*
+	A seed drawn from the main stream, for the NUMrandomStreams of a simulation whose results should
+	depend on the main stream (and therefore on random_initializeWithSeedUnsafelyButPredictably).
+*/
+uint64 NUMrandom_drawSeed ();
+
+/*
+	The raw output: counters firstCounter .. firstCounter + numberOfCounters - 1 of a stream,
+	two 64-bit words per counter.
+*/
+void NUMrandomPhilox_words (uint64 seed, uint64 stream, uint64 firstCounter, integer numberOfCounters, uint64 *words);
+
 /* End of file NUMrandom.h */
 #endif
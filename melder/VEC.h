@@ -171,17 +171,24 @@ inline autoVEC VECmultiply (constVEC const& x, constVEC const& y) {
 	return result;
 }
 
+/*
+	Block-filled from a counter-based stream whose seed is drawn from the main random stream.
+*/
+inline void VECrandomGauss_inplace (VEC const& x, double mu, double sigma) {
+	NUMrandomStream (NUMrandom_drawSeed (), 0). fillGauss (x, mu, sigma);
+}
 inline autoVEC VECrandomGauss (integer size, double mu, double sigma) {
 	autoVEC result = VECraw (size);
-	for (integer i = 1; i <= size; i ++)
-		result [i] = NUMrandomGauss (mu, sigma);
+	VECrandomGauss_inplace (result.get(), mu, sigma);
 	return result;
 }
 
+inline void VECrandomUniform_inplace (VEC const& x, double lowest, double highest) {
+	NUMrandomStream (NUMrandom_drawSeed (), 0). fillUniform (x, lowest, highest);
+}
 inline autoVEC VECrandomUniform (integer size, double lowest, double highest) {
 	autoVEC result = VECraw (size);
-	for (integer i = 1; i <= size; i ++)
-		result [i] = NUMrandomUniform (lowest, highest);
+	VECrandomUniform_inplace (result.get(), lowest, highest);
 	return result;
 }
 
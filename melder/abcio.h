@@ -169,6 +169,15 @@ double bingetr64 (FILE *f);   void binputr64 (double x, FILE *f);
 	This is the native format of a `double` on Silicon Graphics Iris and PowerMac.
 */
 
+void bingetr32_array (double *x, integer n, FILE *f);
+void bingetr64_array (double *x, integer n, FILE *f);   void binputr64_array (const double *x, integer n, FILE *f);
+/*
+	Read or write n consecutive real numbers x [0..n-1] in the same format as bingetr32, bingetr64 and binputr64,
+	with the same results (when writing: the same bytes), but with a single fread or fwrite for a whole block of numbers,
+	followed or preceded by a byte swap in memory.
+	Use these for contiguous vectors and matrix rows; on machines with unknown byte order, they fall back to the element-wise routines.
+*/
+
 double bingetr80 (FILE *f);   void binputr80 (double x, FILE *f);
 /*
 	Read or write a real number from or to 10 bytes in the stream `f`,
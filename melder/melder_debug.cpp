@@ -82,6 +82,28 @@ the behaviour of Praat will temporarily change in the following ways:
 50: compute sum, mean, stdev with first-element offset (80 bits)
 51: compute sum, mean, stdev with two cycles, as in R (80 bits)
 (other numbers than 48-51: compute sum, mean, stdev with simple pairwise algorithm, base case 64 [80 bits])
+52: FFT: use the FFTPACK kernels instead of the vectorised engine for powers of two
+53: short-term analyses (To Spectrogram, To Pitch (ac)): transform the frames one by one instead of in batches
+54: text files (Read from file): read the whole file into memory before decoding it, instead of streaming it
+55: LPC analysis (To LPC): one frame at a time, through a Sound object per frame, without threads
+56: LPC to Formant: roots of every frame from the companion matrix (LAPACK), without threads; LPC to LineSpectralFrequencies: without threads
+57: Hann-band filters (Sound, EEG): transform each channel as a whole instead of overlap-save convolution
+58: Network: spread activities connection by connection, and update weights, without threads
+59: OTGrammar: output distributions and fraction correct with one evaluation at a time on the grammar itself, without threads
+60: NUMrandomStream: compute the counters one by one instead of four at a time with AVX2
+61: OTMulti: search all candidate strings at every evaluation and compute the disharmonies from the marks (no candidate index, no violation matrix)
+62: MDS: distances, smacof Guttman transform (by quadruple sums), stress and INDSCAL (with copies of the scalar products) without threads and with the general Minkowski formula
+63: KlattGrid and FormantGrid filtering: compute the filter coefficients from the tiers at every sample instead of interpolating them within blocks; parallel formants without threads
+64: SynthesisBatch (KlattGrids, Artwords & Speakers): synthesize the items one by one in the main thread
+65: Sound_draw and the LongSound window: draw all the samples instead of a min/max envelope
+66: EditDistanceTable: compare the symbol strings in every cell; edit distance batches in a single thread without cutoff
+67: PCA: covariance and randomized SVD in a single thread
+68: NUMmahalanobisDistances (Discriminant and GaussianMixture classification): one row and group at a time in a single thread
+69: GaussianMixture & TableOfReal: EM and likelihood with the whole matrix of probabilities instead of streamed sufficient statistics
+70: DTWBatch: all the distances in a single thread, without LB_Keogh pruning or early abandoning
+71: Sound_to_MFCC: via a MelSpectrogram instead of the fused analysis
+72: Manipulation overlap-add synthesis: the window computed per sample, one Manipulation at a time
+73: binary files: read and write arrays of real numbers element by element instead of in blocks
 181: read and write native-endian real64
 900: use DG Meta Serif Science instead of Palatino
 1264: Mac: Sound_record_fixedTime uses microphone "FW Solo (1264)"
@@ -61,23 +61,53 @@ inline static char32 * str32str_word_optionallyCaseSensitive (conststring32 stri
 	return nullptr;   // can never occur
 }
 
-bool Melder_stringMatchesCriterion (conststring32 value, kMelder_string which, conststring32 criterion, bool caseSensitive) {
+static bool isLiteralRegularExpression (conststring32 criterion) {
+	if (criterion [0] == U'\0')
+		return false;   // leave the empty expression to the compiler
+	for (const char32 *p = & criterion [0]; *p != U'\0'; p ++)
+		if (! Melder_isAlphanumeric (*p) && *p != U' ' && *p != U'_')
+			return false;
+	return true;
+}
+
+MelderStringMatcher :: MelderStringMatcher (kMelder_string which, conststring32 criterion, bool caseSensitive) :
+	_which (which), _criterion (criterion ? criterion : U""),   // regard null strings as empty strings, as is usual in Praat
+	_criterionLength (0), _caseSensitive (caseSensitive), _compiledRegexp (nullptr)
+{
+	if (_which == kMelder_string::MATCH_REGEXP) {
+		if (isLiteralRegularExpression (_criterion)) {
+			_which = kMelder_string::CONTAINS;
+			_caseSensitive = true;   // as in the compiled expression below
+		} else
+			_compiledRegexp = CompileRE_throwable (_criterion, ! REDFLT_CASE_INSENSITIVE);
+	}
+	_criterionLength = str32len (_criterion);
+}
+
+MelderStringMatcher :: ~MelderStringMatcher () {
+	free (_compiledRegexp);
+}
+
+bool MelderStringMatcher :: matches (conststring32 value) {
 	if (! value) {
 		value = U"";   // regard null strings as empty strings, as is usual in Praat
 	}
-	if (! criterion) {
-		criterion = U"";   // regard null strings as empty strings, as is usual in Praat
-	}
+	const kMelder_string which = _which;
+	const conststring32 criterion = _criterion;
+	const bool caseSensitive = _caseSensitive;
 	switch (which)
 	{
 		case kMelder_string::UNDEFINED:
 		{
-			Melder_fatal (U"Melder_stringMatchesCriterion: unknown criterion.");
+			Melder_fatal (U"MelderStringMatcher: unknown criterion.");
 		}
 		case kMelder_string::EQUAL_TO:
 		case kMelder_string::NOT_EQUAL_TO:
 		{
-			bool doesMatch = str32equ_optionallyCaseSensitive (value, criterion, caseSensitive);
+			bool doesMatch = ( caseSensitive ?
+				value [0] == criterion [0] && str32equ (value, criterion) :
+				str32equ_caseInsensitive (value, criterion)
+			);
 			return which == kMelder_string::EQUAL_TO ? doesMatch : ! doesMatch;
 		}
 		case kMelder_string::CONTAINS:
@@ -89,15 +119,15 @@ bool Melder_stringMatchesCriterion (conststring32 value, kMelder_string which, c
 		case kMelder_string::STARTS_WITH:
 		case kMelder_string::DOES_NOT_START_WITH:
 		{
-			bool doesMatch = str32nequ_optionallyCaseSensitive (value, criterion, str32len (criterion), caseSensitive);
+			bool doesMatch = str32nequ_optionallyCaseSensitive (value, criterion, _criterionLength, caseSensitive);
 			return which == kMelder_string::STARTS_WITH ? doesMatch : ! doesMatch;
 		}
 		case kMelder_string::ENDS_WITH:
 		case kMelder_string::DOES_NOT_END_WITH:
 		{
-			integer criterionLength = str32len (criterion), valueLength = str32len (value);
-			bool doesMatch = criterionLength <= valueLength &&
-				str32equ_optionallyCaseSensitive (value + valueLength - criterionLength, criterion, caseSensitive);
+			integer valueLength = str32len (value);
+			bool doesMatch = _criterionLength <= valueLength &&
+				str32equ_optionallyCaseSensitive (value + valueLength - _criterionLength, criterion, caseSensitive);
 			return which == kMelder_string::ENDS_WITH ? doesMatch : ! doesMatch;
 		}
 		case kMelder_string::CONTAINS_WORD:
@@ -138,15 +168,16 @@ bool Melder_stringMatchesCriterion (conststring32 value, kMelder_string which, c
 		}
 		case kMelder_string::MATCH_REGEXP:
 		{
-			char32 *place = nullptr;
-			regexp *compiled_regexp = CompileRE_throwable (criterion, ! REDFLT_CASE_INSENSITIVE);
-			if (ExecRE (compiled_regexp, nullptr, value, nullptr, 0, U'\0', U'\0', nullptr, nullptr))
-				place = compiled_regexp -> startp [0];
-			free (compiled_regexp);
-			return !! place;
+			return ExecRE (_compiledRegexp, nullptr, value, nullptr, 0, U'\0', U'\0', nullptr, nullptr) &&
+					_compiledRegexp -> startp [0];
 		}
 	}
-	//return false;   // should not occur
+	Melder_fatal (U"MelderStringMatcher: unknown criterion.");
+	return false;
+}
+
+bool Melder_stringMatchesCriterion (conststring32 value, kMelder_string which, conststring32 criterion, bool caseSensitive) {
+	return MelderStringMatcher (which, criterion, caseSensitive). matches (value);
 }
 
 /* End of file melder_search.cpp */
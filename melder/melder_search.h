@@ -23,5 +23,28 @@
 bool Melder_numberMatchesCriterion (double value, kMelder_number which, double criterion);
 bool Melder_stringMatchesCriterion (conststring32 value, kMelder_string which, conststring32 criterion, bool caseSensitive);
 
+/*
+	A string criterion prepared once, for matching many values,
+	as in "Count intervals where..." or "Extract rows where...".
+	A regular expression is compiled in the constructor (which throws if it is invalid)
+	instead of once for every value; a regular expression without special characters
+	is searched for as a literal string.
+	Not thread-safe: the regular-expression executor keeps its state in static variables.
+*/
+struct regexp;
+struct MelderStringMatcher {
+	MelderStringMatcher (kMelder_string which, conststring32 criterion, bool caseSensitive);
+	~MelderStringMatcher ();
+	MelderStringMatcher (const MelderStringMatcher&) = delete;   // disable copy constructor
+	MelderStringMatcher& operator= (const MelderStringMatcher&) = delete;   // disable copy assignment
+	bool matches (conststring32 value);
+private:
+	kMelder_string _which;
+	conststring32 _criterion;   // not owned; has to outlive the matcher
+	integer _criterionLength;
+	bool _caseSensitive;
+	regexp *_compiledRegexp;
+};
+
 /* End of file melder_search.h */
 #endif
@@ -20,6 +20,42 @@
 
 /*** Typed I/O functions for vectors and matrices. ***/
 
+/*
+	Contiguous runs of numbers (vectors and matrix rows) are read and written in one go
+	if abcio has a bulk routine for the storage type; the other storage types go element by element.
+*/
+#define ELEMENTWISE_BINARY_READ(T,storage)  \
+	static void bingetArray_##storage (T *x, integer n, FILE *f) { \
+		for (integer i = 0; i < n; i ++) \
+			x [i] = binget##storage (f); \
+	}
+#define ELEMENTWISE_BINARY_WRITE(T,storage)  \
+	static void binputArray_##storage (const T *x, integer n, FILE *f) { \
+		for (integer i = 0; i < n; i ++) \
+			binput##storage (x [i], f); \
+	}
+#define ELEMENTWISE_BINARY(T,storage)  \
+	ELEMENTWISE_BINARY_READ (T, storage) \
+	ELEMENTWISE_BINARY_WRITE (T, storage)
+
+ELEMENTWISE_BINARY (signed char, i8)
+ELEMENTWISE_BINARY (int, i16)
+ELEMENTWISE_BINARY (long, i32)
+ELEMENTWISE_BINARY (integer, integer32BE)
+ELEMENTWISE_BINARY (integer, integer16BE)
+ELEMENTWISE_BINARY (unsigned char, u8)
+ELEMENTWISE_BINARY (unsigned int, u16)
+ELEMENTWISE_BINARY (unsigned long, u32)
+ELEMENTWISE_BINARY_WRITE (double, r32)
+ELEMENTWISE_BINARY (dcomplex, c64)
+ELEMENTWISE_BINARY (dcomplex, c128)
+static void bingetArray_r32 (double *x, integer n, FILE *f) { bingetr32_array (x, n, f); }
+static void bingetArray_r64 (double *x, integer n, FILE *f) { bingetr64_array (x, n, f); }
+static void binputArray_r64 (const double *x, integer n, FILE *f) { binputr64_array (x, n, f); }
+#undef ELEMENTWISE_BINARY
+#undef ELEMENTWISE_BINARY_WRITE
+#undef ELEMENTWISE_BINARY_READ
+
 #define FUNCTION(T,storage)  \
 	void NUMvector_writeText_##storage (const T *v, integer lo, integer hi, MelderFile file, conststring32 name) { \
 		texputintro (file, name, U" []: ", hi >= lo ? nullptr : U"(empty)", 0,0,0); \
@@ -36,13 +72,13 @@
 		if (feof (file -> filePointer) || ferror (file -> filePointer)) Melder_throw (U"Write error."); \
 	} \
 	void NUMvector_writeBinary_##storage (const T *v, integer lo, integer hi, FILE *f) { \
-		for (integer i = lo; i <= hi; i ++) \
-			binput##storage (v [i], f); \
+		if (hi >= lo) \
+			binputArray_##storage (& v [lo], hi - lo + 1, f); \
 		if (feof (f) || ferror (f)) Melder_throw (U"Write error."); \
 	} \
 	void vector_writeBinary_##storage (const constvector<T>& vec, FILE *f) { \
-		for (integer i = 1; i <= vec.size; i ++) \
-			binput##storage (vec [i], f); \
+		if (vec.size >= 1) \
+			binputArray_##storage (& vec [1], vec.size, f); \
 		if (feof (f) || ferror (f)) Melder_throw (U"Write error."); \
 	} \
 	T * NUMvector_readText_##storage (integer lo, integer hi, MelderReadText text, const char *name) { \
@@ -77,9 +113,8 @@
 		T *result = nullptr; \
 		try { \
 			result = NUMvector <T> (lo, hi); \
-			for (integer i = lo; i <= hi; i ++) { \
-				result [i] = binget##storage (f); \
-			} \
+			if (hi >= lo) \
+				bingetArray_##storage (& result [lo], hi - lo + 1, f); \
 			return result; \
 		} catch (MelderError) { \
 			NUMvector_free (result, lo); \
@@ -88,9 +123,8 @@
 	} \
 	autovector<T> vector_readBinary_##storage (integer size, FILE *f) { \
 		autovector<T> result = vectorzero<T> (size); \
-		for (integer i = 1; i <= size; i ++) { \
-			result [i] = binget##storage (f); \
-		} \
+		if (size >= 1) \
+			bingetArray_##storage (& result [1], size, f); \
 		return result; \
 	} \
 	void NUMmatrix_writeText_##storage (T **m, integer row1, integer row2, integer col1, integer col2, MelderFile file, conststring32 name) { \
@@ -120,19 +154,16 @@
 		if (feof (file -> filePointer) || ferror (file -> filePointer)) Melder_throw (U"Write error."); \
 	} \
 	void NUMmatrix_writeBinary_##storage (T **m, integer row1, integer row2, integer col1, integer col2, FILE *f) { \
-		if (row2 >= row1) { \
-			for (integer irow = row1; irow <= row2; irow ++) { \
-				for (integer icol = col1; icol <= col2; icol ++) \
-					binput##storage (m [irow] [icol], f); \
-			} \
+		if (row2 >= row1 && col2 >= col1) { \
+			for (integer irow = row1; irow <= row2; irow ++) \
+				binputArray_##storage (& m [irow] [col1], col2 - col1 + 1, f); \
 		} \
 		if (feof (f) || ferror (f)) Melder_throw (U"Write error."); \
 	} \
 	void matrix_writeBinary_##storage (const constmatrix<T>& mat, FILE *f) { \
-		for (integer irow = 1; irow <= mat.nrow; irow ++) { \
-			for (integer icol = 1; icol <= mat.ncol; icol ++) \
-				binput##storage (mat [irow] [icol], f); \
-		} \
+		if (mat.ncol >= 1) \
+			for (integer irow = 1; irow <= mat.nrow; irow ++) \
+				binputArray_##storage (& mat [irow] [1], mat.ncol, f); \
 		if (feof (f) || ferror (f)) Melder_throw (U"Write error."); \
 	} \
 	T ** NUMmatrix_readText_##storage (integer row1, integer row2, integer col1, integer col2, MelderReadText text, const char *name) { \
@@ -167,8 +198,9 @@
 		T **result = nullptr; \
 		try { \
 			result = NUMmatrix <T> (row1, row2, col1, col2); \
-			for (integer irow = row1; irow <= row2; irow ++) for (integer icol = col1; icol <= col2; icol ++) \
-				result [irow] [icol] = binget##storage (f); \
+			if (row2 >= row1 && col2 >= col1) \
+				for (integer irow = row1; irow <= row2; irow ++) \
+					bingetArray_##storage (& result [irow] [col1], col2 - col1 + 1, f); \
 			return result; \
 		} catch (MelderError) { \
 			NUMmatrix_free (result, row1, col1); \
@@ -177,8 +209,8 @@
 	} \
 	automatrix<T> matrix_readBinary_##storage (integer nrow, integer ncol, FILE *f) { \
 		automatrix<T> result = matrixzero<T> (nrow, ncol); \
-		for (integer irow = 1; irow <= nrow; irow ++) for (integer icol = 1; icol <= ncol; icol ++) \
-			result [irow] [icol] = binget##storage (f); \
+		if (nrow >= 1 && ncol >= 1) \
+			bingetArray_##storage (& result [1] [1], nrow * ncol, f);   /* the rows are contiguous */ \
 		return result; \
 	}
 
@@ -382,8 +382,9 @@ autoTableOfReal TableOfReal_extractRowsWhereColumn (TableOfReal me, integer colu
 autoTableOfReal TableOfReal_extractRowsWhereLabel (TableOfReal me, kMelder_string which, conststring32 criterion) {
 	try {
 		integer n = 0;
+		MelderStringMatcher matcher (which, criterion, true);
 		for (integer irow = 1; irow <= my numberOfRows; irow ++) {
-			if (Melder_stringMatchesCriterion (my rowLabels [irow].get(), which, criterion, true)) {
+			if (matcher. matches (my rowLabels [irow].get())) {
 				n ++;
 			}
 		}
@@ -393,7 +394,7 @@ autoTableOfReal TableOfReal_extractRowsWhereLabel (TableOfReal me, kMelder_strin
 		copyColumnLabels (me, thee.get());
 		n = 0;
 		for (integer irow = 1; irow <= my numberOfRows; irow ++)
-			if (Melder_stringMatchesCriterion (my rowLabels [irow].get(), which, criterion, true))
+			if (matcher. matches (my rowLabels [irow].get()))
 				copyRow (me, irow, thee.get(), ++ n);
 		return thee;
 	} catch (MelderError) {
@@ -428,8 +429,9 @@ autoTableOfReal TableOfReal_extractColumnsWhereRow (TableOfReal me, integer row,
 autoTableOfReal TableOfReal_extractColumnsWhereLabel (TableOfReal me, kMelder_string which, conststring32 criterion) {
 	try {
 		integer n = 0;
+		MelderStringMatcher matcher (which, criterion, true);
 		for (integer icol = 1; icol <= my numberOfColumns; icol ++) {
-			if (Melder_stringMatchesCriterion (my columnLabels [icol].get(), which, criterion, true)) {
+			if (matcher. matches (my columnLabels [icol].get())) {
 				n ++;
 			}
 		}
@@ -439,7 +441,7 @@ autoTableOfReal TableOfReal_extractColumnsWhereLabel (TableOfReal me, kMelder_st
 		copyRowLabels (me, thee.get());
 		n = 0;
 		for (integer icol = 1; icol <= my numberOfColumns; icol ++) {
-			if (Melder_stringMatchesCriterion (my columnLabels [icol].get(), which, criterion, true)) {
+			if (matcher. matches (my columnLabels [icol].get())) {
 				copyColumn (me, icol, thee.get(), ++ n);
 			}
 		}
@@ -182,37 +182,52 @@ void Data_readText (Daata me, MelderReadText text, int formatVersion) {
 	}
 }
 
+static autoDaata Data_readFromText (MelderReadText text, MelderFile file) {
+	const mutablestring32 line = MelderReadText_readLine (text);
+	if (! line)
+		Melder_throw (U"No lines.");
+	/*
+		Allow for a future version of text files (we have no plans).
+		This check was written on 2017-09-10.
+		See below at `Data_readFromBinaryFile` for a more serious proposal.
+	*/
+	if (str32str (line, U"ooText2File"))
+		Melder_throw (U"This Praat version cannot read this Praat file. Please download a newer version of Praat.");
+	char32 *end = str32str (line, U"ooTextFile");   // oo format?
+	autoDaata me;
+	int formatVersion;
+	if (end) {
+		autostring32 klas = texgetw16 (text);
+		me = Thing_newFromClassName (klas.get(), & formatVersion).static_cast_move <structDaata> ();
+	} else {
+		end = str32str (line, U"TextFile");
+		if (! end)
+			Melder_throw (U"Not an old-type text file; should not occur.");
+		*end = U'\0';
+		me = Thing_newFromClassName (line, nullptr).static_cast_move <structDaata> ();
+		formatVersion = -1;   // old version
+	}
+	MelderFile_getParentDir (file, & Data_directoryBeingRead);
+	Data_readText (me.get(), text, formatVersion);
+	file -> format = structMelderFile :: Format :: text;
+	return me;
+}
+
 autoDaata Data_readFromTextFile (MelderFile file) {
 	try {
-		autoMelderReadText text = MelderReadText_createFromFile (file);
-		const mutablestring32 line = MelderReadText_readLine (text.get());
-		if (! line)
-			Melder_throw (U"No lines.");
-		/*
-			Allow for a future version of text files (we have no plans).
-			This check was written on 2017-09-10.
-			See below at `Data_readFromBinaryFile` for a more serious proposal.
-		*/
-		if (str32str (line, U"ooText2File"))
-			Melder_throw (U"This Praat version cannot read this Praat file. Please download a newer version of Praat.");
-		char32 *end = str32str (line, U"ooTextFile");   // oo format?
-		autoDaata me;
-		int formatVersion;
-		if (end) {
-			autostring32 klas = texgetw16 (text.get());
-			me = Thing_newFromClassName (klas.get(), & formatVersion).static_cast_move <structDaata> ();
-		} else {
-			end = str32str (line, U"TextFile");
-			if (! end)
-				Melder_throw (U"Not an old-type text file; should not occur.");
-			*end = U'\0';
-			me = Thing_newFromClassName (line, nullptr).static_cast_move <structDaata> ();
-			formatVersion = -1;   // old version
+		autoMelderReadText text = MelderReadText_openFromFile (file);
+		try {
+			autoDaata me = Data_readFromText (text.get(), file);
+			if (text -> numberOfNullBytes > 0)
+				Melder_warning (U"Ignored ", text -> numberOfNullBytes, U" null bytes in text file ", file, U".");
+			return me;
+		} catch (MelderError) {
+			if (! text -> mustBeReadAsAWhole)
+				throw;
+			Melder_clearError ();   // the file is a mixture of UTF-8 and another encoding
 		}
-		MelderFile_getParentDir (file, & Data_directoryBeingRead);
-		Data_readText (me.get(), text.get(), formatVersion);
-		file -> format = structMelderFile :: Format :: text;
-		return me;
+		text = MelderReadText_createFromFile (file);
+		return Data_readFromText (text.get(), file);
 	} catch (MelderError) {
 		Melder_throw (U"Data not read from text file ", file, U".");
 	}
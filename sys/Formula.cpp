@@ -147,7 +147,8 @@ enum { NO_SYMBOL_,
 		VEC_RANDOM_GAUSS_, MAT_RANDOM_GAUSS_,
 		MAT_PEAKS_,
 		SIZE_, NUMBER_OF_ROWS_, NUMBER_OF_COLUMNS_, EDITOR_, HASH_,
-	#define HIGH_FUNCTION_N  HASH_
+		RANDOM_INITIALIZE_WITH_SEED_UNSAFELY_BUT_PREDICTABLY_, RANDOM_INITIALIZE_SAFELY_AND_UNPREDICTABLY_,
+	#define HIGH_FUNCTION_N  RANDOM_INITIALIZE_SAFELY_AND_UNPREDICTABLY_
 
 	/* String functions. */
 	#define LOW_STRING_FUNCTION  LOW_FUNCTION_STR1
@@ -263,6 +264,7 @@ static const conststring32 Formula_instructionNames [1 + highestSymbol] = { U"",
 	U"randomGauss#", U"randomGauss##",
 	U"peaks##",
 	U"size", U"numberOfRows", U"numberOfColumns", U"editor", U"hash",
+	U"random_initializeWithSeedUnsafelyButPredictably", U"random_initializeSafelyAndUnpredictably",
 
 	U"length", U"number", U"fileReadable",	U"deleteFile", U"createDirectory", U"variableExists",
 	U"readFile", U"readFile$", U"unicodeToBackslashTrigraphs$", U"backslashTrigraphsToUnicode$", U"environment$",
@@ -3245,7 +3247,7 @@ static void do_function_dd_d (double (*f) (double, double)) {
 			x->whichText(), U" and ", y->whichText(), U".");
 	}
 }
-static void do_function_VECdd_d (double (*f) (double, double)) {
+static void do_function_VECdd_fill (void (*fill) (VEC const&, double, double)) {
 	Stackel n = pop;
 	Melder_assert (n -> which == Stackel_NUMBER);
 	if (n -> number != 3)
@@ -3254,9 +3256,7 @@ static void do_function_VECdd_d (double (*f) (double, double)) {
 	if ((a->which == Stackel_NUMERIC_VECTOR || a->which == Stackel_NUMBER) && x->which == Stackel_NUMBER && y->which == Stackel_NUMBER) {
 		integer numberOfElements = ( a->which == Stackel_NUMBER ? a->number : a->numericVector.size );
 		autoVEC newData (numberOfElements, kTensorInitializationType::RAW);
-		for (integer ielem = 1; ielem <= numberOfElements; ielem ++) {
-			newData [ielem] = f (x->number, y->number);
-		}
+		fill (newData.get(), x->number, y->number);
 		pushNumericVector (newData.move());
 	} else {
 		Melder_throw (U"The function ", Formula_instructionNames [parse [programPointer]. symbol],
@@ -3264,21 +3264,15 @@ static void do_function_VECdd_d (double (*f) (double, double)) {
 			a->whichText(), U", ", x->whichText(), U" and ", y->whichText(), U".");
 	}
 }
-static void do_function_MATdd_d (double (*f) (double, double)) {
+static void do_function_MATdd_fill (void (*fill) (VEC const&, double, double)) {
 	Stackel n = pop;
 	Melder_assert (n -> which == Stackel_NUMBER);
 	if (n -> number != 3)
 		Melder_throw (U"The function ", Formula_instructionNames [parse [programPointer]. symbol], U" requires three arguments.");
 	Stackel y = pop, x = pop, a = pop;
 	if (a->which == Stackel_NUMERIC_MATRIX && x->which == Stackel_NUMBER && y->which == Stackel_NUMBER) {
-		integer numberOfRows = a->numericMatrix.nrow;
-		integer numberOfColumns = a->numericMatrix.ncol;
-		autoMAT newData (numberOfRows, numberOfColumns, kTensorInitializationType::RAW);
-		for (integer irow = 1; irow <= numberOfRows; irow ++) {
-			for (integer icol = 1; icol <= numberOfColumns; icol ++) {
-				newData [irow] [icol] = f (x->number, y->number);
-			}
-		}
+		autoMAT newData (a->numericMatrix.nrow, a->numericMatrix.ncol, kTensorInitializationType::RAW);
+		fill (asvector (newData.get()), x->number, y->number);
 		pushNumericMatrix (newData.move());
 	} else {
 		Melder_throw (U"The function ", Formula_instructionNames [parse [programPointer]. symbol],
@@ -4138,6 +4132,25 @@ static void do_hash () {
 		Melder_throw (U"The function \"hash\" requires 1 argument, not ", n->number, U".");
 	}
 }
+static void do_random_initializeWithSeedUnsafelyButPredictably () {
+	Stackel n = pop;
+	Melder_assert (n->which == Stackel_NUMBER);
+	if (n->number != 1)
+		Melder_throw (U"The function \"random_initializeWithSeedUnsafelyButPredictably\" requires 1 argument (the seed), not ", n->number, U".");
+	Stackel seed = pop;
+	if (seed->which != Stackel_NUMBER || isundef (seed->number))
+		Melder_throw (U"The function \"random_initializeWithSeedUnsafelyButPredictably\" requires a defined number, not ", seed->whichText(), U".");
+	NUMrandom_initializeWithSeedUnsafelyButPredictably ((uint64) (int64) Melder_iround (seed->number));
+	pushNumber (1);
+}
+static void do_random_initializeSafelyAndUnpredictably () {
+	Stackel n = pop;
+	Melder_assert (n->which == Stackel_NUMBER);
+	if (n->number != 0)
+		Melder_throw (U"The function \"random_initializeSafelyAndUnpredictably\" requires 0 arguments, not ", n->number, U".");
+	NUMrandom_initializeSafelyAndUnpredictably ();
+	pushNumber (1);
+}
 
 static void do_numericVectorElement () {
 	InterpreterVariable vector = parse [programPointer]. content.variable;
@@ -6366,18 +6379,20 @@ case NUMBER_: { pushNumber (f [programPointer]. content.number);
 } break; case MAT_ZERO_: { do_MATzero ();
 } break; case VEC_LINEAR_: { do_VEClinear ();
 } break; case VEC_TO_: { do_VECto ();
-} break; case VEC_RANDOM_UNIFORM_: { do_function_VECdd_d (NUMrandomUniform);
-} break; case MAT_RANDOM_UNIFORM_: { do_function_MATdd_d (NUMrandomUniform);
+} break; case VEC_RANDOM_UNIFORM_: { do_function_VECdd_fill (VECrandomUniform_inplace);
+} break; case MAT_RANDOM_UNIFORM_: { do_function_MATdd_fill (VECrandomUniform_inplace);
 } break; case VEC_RANDOM_INTEGER_: { do_function_VECll_l (NUMrandomInteger);
 } break; case MAT_RANDOM_INTEGER_: { do_function_MATll_l (NUMrandomInteger);
-} break; case VEC_RANDOM_GAUSS_: { do_function_VECdd_d (NUMrandomGauss);
-} break; case MAT_RANDOM_GAUSS_: { do_function_MATdd_d (NUMrandomGauss);
+} break; case VEC_RANDOM_GAUSS_: { do_function_VECdd_fill (VECrandomGauss_inplace);
+} break; case MAT_RANDOM_GAUSS_: { do_function_MATdd_fill (VECrandomGauss_inplace);
 } break; case MAT_PEAKS_: { do_MATpeaks ();
 } break; case SIZE_: { do_size ();
 } break; case NUMBER_OF_ROWS_: { do_numberOfRows ();
 } break; case NUMBER_OF_COLUMNS_: { do_numberOfColumns ();
 } break; case EDITOR_: { do_editor ();
 } break; case HASH_: { do_hash ();
+} break; case RANDOM_INITIALIZE_WITH_SEED_UNSAFELY_BUT_PREDICTABLY_: { do_random_initializeWithSeedUnsafelyButPredictably ();
+} break; case RANDOM_INITIALIZE_SAFELY_AND_UNPREDICTABLY_: { do_random_initializeSafelyAndUnpredictably ();
 /********** String functions: **********/
 } break; case LENGTH_: { do_length ();
 } break; case STRING_TO_NUMBER_: { do_number ();